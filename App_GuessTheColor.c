@@ -6,26 +6,116 @@
 #include <stdbool.h>
 #include <string.h>
 #include <stdio.h>
+#include <assert.h>
 
 /* HAL and Application includes */
 #include <HAL/HAL.h>
 #include <HAL/Timer.h>
+#include <HAL/Profiler.h>
+#include <HAL/LatencyTrace.h>
+#include <HAL/LEDEffects.h>
+#include <HAL/FSM.h>
+#include <HAL/EventQueue.h>
 #include <App_GuessTheColor.h>
 
 extern const Graphics_Image colors8BPP_UNCOMP;
 extern const Graphics_Image sad8BPP_UNCOMP;
 extern const Graphics_Image happy8BPP_UNCOMP;
 
+/**
+ * The four screens of the game. Every screen is cleared before it is drawn,
+ * so texts need no trailing spaces, except on the title where they cover the
+ * image behind them.
+ */
+static const UIWidget titleWidgets[] =
+{
+    UI_IMAGE(0, 0, &colors8BPP_UNCOMP),
+    UI_TEXT(0, 0, "Guess the RGB color  "),
+    UI_TEXT(1, 0, "---------------------"),
+    UI_TEXT(2, 0, "By: Leyla Nazhand-Ali"),
+    UI_TEXT(3, 0, "Edit: Matthew Zhong  ")
+};
+
+/**
+ * The widgets of the instructions and game screens which never change. With
+ * STATIC_FRAMES_ENABLED, each list is replaced by a frame rendered from it by
+ * the host build; see STATIC_FRAMES_ENABLED.
+ */
+#define INSTRUCTIONS_STATIC_WIDGETS \
+    UI_TEXT(0, 0, "Instructions"), \
+    UI_TEXT(1, 0, "---------------------"), \
+    UI_TEXT(2, 0, "Guess the RGB mix."), \
+    UI_TEXT(3, 0, "Controls during guessing:"), \
+    UI_TEXT(5, 0, "B1: Select choice"), \
+    UI_TEXT(6, 0, "B2/JS: Move arrow"), \
+    UI_TEXT(8, 0, "Press B2 to start.")
+
+#define GAME_STATIC_WIDGETS \
+    UI_TEXT(0, 0, "Game"), \
+    UI_TEXT(1, 0, "---------------------"), \
+    UI_TEXT(2, 2, "Red"), \
+    UI_TEXT(3, 2, "Green"), \
+    UI_TEXT(4, 2, "Blue"), \
+    UI_TEXT(5, 2, "End Guessing"), \
+    UI_TEXT(7, 0, "B1: Select choice"), \
+    UI_TEXT(8, 0, "B2/JS: Move arrow")
+
+static const UIWidget instructionsStaticWidgets[] = { INSTRUCTIONS_STATIC_WIDGETS };
+static const UIWidget gameStaticWidgets[] = { GAME_STATIC_WIDGETS };
+
+const UIScreen instructionsStaticScreen = UI_SCREEN(INSTRUCTIONS_SCREEN, instructionsStaticWidgets);
+const UIScreen gameStaticScreen         = UI_SCREEN(GAME_SCREEN, gameStaticWidgets);
+
+#if STATIC_FRAMES_ENABLED
+static const UIWidget instructionsWidgets[] =
+{
+    UI_FRAME(&instructionsFrame)
+};
+
+static const UIWidget gameWidgets[] =
+{
+    UI_FRAME(&gameFrame),
+    UI_CURSOR(2, 0, NUM_TEST_OPTIONS, UI_VALUE_CURSOR),
+    UI_CHECK(2, 8, UI_VALUE_RED),
+    UI_CHECK(3, 8, UI_VALUE_GREEN),
+    UI_CHECK(4, 8, UI_VALUE_BLUE)
+};
+#else
+static const UIWidget instructionsWidgets[] =
+{
+    INSTRUCTIONS_STATIC_WIDGETS
+};
+
+static const UIWidget gameWidgets[] =
+{
+    GAME_STATIC_WIDGETS,
+    UI_CURSOR(2, 0, NUM_TEST_OPTIONS, UI_VALUE_CURSOR),
+    UI_CHECK(2, 8, UI_VALUE_RED),
+    UI_CHECK(3, 8, UI_VALUE_GREEN),
+    UI_CHECK(4, 8, UI_VALUE_BLUE)
+};
+#endif
+
+static const UIWidget resultWidgets[] =
+{
+    UI_TEXT(0, 0, "Result"),
+    UI_TEXT(1, 0, "---------------------"),
+    UI_TEXT_CHOICE(2, 0, UI_VALUE_MATCH, "Wrong!", "Right!"),
+    UI_IMAGE_CHOICE(60, 60, UI_VALUE_MATCH, &sad8BPP_UNCOMP, &happy8BPP_UNCOMP)
+};
+
+// The screen ids double as the GameState of each screen
+static const UIScreen titleScreen        = UI_SCREEN(TITLE_SCREEN, titleWidgets);
+static const UIScreen instructionsScreen = UI_SCREEN(INSTRUCTIONS_SCREEN, instructionsWidgets);
+static const UIScreen gameScreen         = UI_SCREEN(GAME_SCREEN, gameWidgets);
+static const UIScreen resultScreen       = UI_SCREEN(RESULT_SCREEN, resultWidgets);
+
 /**
  * The main entry point of your project. The main function should immediately
  * stop the Watchdog timer, call the Application constructor, and then
- * repeatedly call the main super-loop function. The App_GuessTheColor
- * constructor should be responsible for initializing all hardware components as
- * well as all other finite state machines you choose to use in this project.
- *
- * THIS FUNCTION IS ALREADY COMPLETE. Unless you want to temporarily experiment
- * with some behavior of a code snippet you may have, we DO NOT RECOMMEND
- * modifying this function in any way.
+ * repeatedly run the scheduler. The App_GuessTheColor constructor should be
+ * responsible for initializing all hardware components as well as all other
+ * finite state machines you choose to use in this project.
  */
 int main(void)
 {
@@ -36,97 +126,316 @@ int main(void)
     // software timers to time their measurements properly.
     InitSystemTiming();
 
+    // Start the cycle counter used by the PROF_BEGIN()/PROF_END() probes and
+    // record the cost of a single probe pair for reference.
+    Profiler_init();
+    Profiler_measureOverhead();
+
     // Initialize the main Application object and the HAL.
     HAL hal = HAL_construct();
+
+    // Compare a driverlib pin write with a bit-band one, on an LED which is
+    // still off at this point. See PROF_GPIO_DRIVERLIB and PROF_GPIO_FAST.
+    FastGPIO_benchmark(LAUNCHPAD_LED1_PORT, LAUNCHPAD_LED1_PIN);
     App_GuessTheColor app = App_GuessTheColor_construct(&hal);
-    App_GuessTheColor_showTitleScreen(&hal.gfx);
+    App_GuessTheColor_start(&app);
+
+    // The scheduler is static since its task table is too large for the stack
+    static Scheduler scheduler;
+    scheduler = Scheduler_construct();
+
+    App_GuessTheColor_Tasks tasks;
+    tasks.app_p = &app;
+    tasks.hal_p = &hal;
+    tasks.scheduler_p = &scheduler;
+
+    // Inputs are sampled at a fixed rate and turned into events. The FSM only
+    // runs when there are events waiting for it.
+    tasks.inputTask = Scheduler_addTask(&scheduler, "input", App_GuessTheColor_inputTask, &tasks,
+                                        INPUT_TASK_PRIORITY, INPUT_TASK_PERIOD, INPUT_TASK_DEADLINE);
+    tasks.fsmTask = Scheduler_addTask(&scheduler, "fsm", App_GuessTheColor_fsmTask, &tasks,
+                                      FSM_TASK_PRIORITY, FSM_TASK_PERIOD, FSM_TASK_DEADLINE);
+
+    // Flash is only programmed and erased between rounds, at the lowest
+    // priority, so a sector erase never delays an input.
+    tasks.storeTask = Scheduler_addTask(&scheduler, "store", App_GuessTheColor_storeTask, &tasks,
+                                        STORE_TASK_PRIORITY, STORE_TASK_PERIOD, STORE_TASK_DEADLINE);
+
+#if SPI_TRACE_ENABLED
+    // The bytes sent to the LCD follow the telemetry records, whenever the
+    // link has room for them. See tools/spitrace.py.
+    tasks.traceTask = Scheduler_addTask(&scheduler, "trace", App_GuessTheColor_traceTask, &tasks,
+                                        TRACE_TASK_PRIORITY, TRACE_TASK_PERIOD, TRACE_TASK_DEADLINE);
+#endif
+
+    // Every pass of the super-loop which ran a task is timed, and attributed
+    // to the screen which was showing when the pass started. Launchpad LED1
+    // flashes after any pass which took longer than the budget.
+    static LoopMonitor monitor;
+    monitor = LoopMonitor_construct(LOOP_BUDGET_US);
+    LoopMonitor_setAlertLED(&monitor, &hal.launchpadLED1);
+
+#if LOOP_WATCHDOG_ENABLED
+    LoopMonitor_armWatchdog(&monitor);
+#endif
+
+    // Main super-loop! Each pass runs at most one ready task. When no task is
+    // ready, the CPU sleeps until the next interrupt. Every hardware timer is
+    // taken, so the scheduler has no wake-up of its own: it relies on the
+    // SysTick of the port debouncer, which must tick at least once per input
+    // task period or inputs would wait for an unrelated interrupt.
+    assert(PortDebouncer_isSampling());
+    assert(PORT_DEBOUNCE_RATE_HZ >= MS_DIVISION_FACTOR / INPUT_TASK_PERIOD);
 
-    // Main super-loop! In a polling architecture, this function should call
-    // your main FSM function over and over.
     while (true)
     {
-        App_GuessTheColor_loop(&app, &hal);  //update my program, application state, output
-        HAL_refresh(&hal); // check the inputs
+        if (Scheduler_runOnce(&scheduler)) {
+            LoopMonitor_mark(&monitor, App_GuessTheColor_getState(&app));
+        }
+        else
+        {
+            // Time asleep is not loop latency, so the pass is not recorded
+            PCM_gotoLPM0();
+            LoopMonitor_skip(&monitor, App_GuessTheColor_getState(&app));
+        }
+    }
+}
+
+/**
+ * The input task. Samples every input in the HAL, posts an event for every
+ * tap, and posts the events of due alarms. The FSM task is released only if
+ * any event is waiting, so nothing else runs while the user does nothing.
+ *
+ * @param context:  The App_GuessTheColor_Tasks shared by every task
+ */
+void App_GuessTheColor_inputTask(void* context)
+{
+    App_GuessTheColor_Tasks* tasks_p = (App_GuessTheColor_Tasks*) context;
+    HAL* hal_p = tasks_p->hal_p;
+    EventQueue* events_p = &tasks_p->app_p->events;
+
+    HAL_refresh(hal_p);
+
+#if BOOSTERPACK_BUTTONS_DMA_SAMPLED
+    if (Button_isTapped(&hal_p->boosterpackS1)) {
+        EventQueue_post(events_p, EVENT_S1_TAP);
+    }
+
+    if (Button_isTapped(&hal_p->boosterpackS2)) {
+        EventQueue_post(events_p, EVENT_S2_TAP);
+    }
+#else
+    // The edge-interrupt buttons report every debounced press, including the
+    // repeats of a held button, in the order they happened. Releases are not
+    // needed by the game.
+    ButtonEvent buttonEvent;
+    while (Button_pollEvent(&buttonEvent))
+    {
+        if (buttonEvent.pushState != PRESSED) {
+            continue;
+        }
+
+        if (buttonEvent.port == BOOSTERPACK_S1_PORT && buttonEvent.pin == BOOSTERPACK_S1_PIN) {
+            EventQueue_post(events_p, EVENT_S1_TAP);
+        }
+        else if (buttonEvent.port == BOOSTERPACK_S2_PORT && buttonEvent.pin == BOOSTERPACK_S2_PIN) {
+            EventQueue_post(events_p, EVENT_S2_TAP);
+        }
+    }
+#endif
+
+    if (Joystick_isTapped(&hal_p->joystick, JOYSTICK_UP)) {
+        EventQueue_post(events_p, EVENT_JOYSTICK_UP);
+    }
+    else if (Joystick_isTapped(&hal_p->joystick, JOYSTICK_DOWN)) {
+        EventQueue_post(events_p, EVENT_JOYSTICK_DOWN);
+    }
+
+    EventQueue_refresh(events_p);
+
+    // A tap of an input which posts no event, such as the joystick button,
+    // must not hold the latency trace
+    if (!EventQueue_isEmpty(events_p)) {
+        Scheduler_signal(tasks_p->scheduler_p, tasks_p->fsmTask);
+    }
+    else {
+        LatencyTrace_cancel();
+    }
+}
+
+/**
+ * The FSM task. Dispatches every waiting event to the application FSM.
+ *
+ * @param context:  The App_GuessTheColor_Tasks shared by every task
+ */
+void App_GuessTheColor_fsmTask(void* context)
+{
+    App_GuessTheColor_Tasks* tasks_p = (App_GuessTheColor_Tasks*) context;
+    uint8_t event;
+
+    while (EventQueue_get(&tasks_p->app_p->events, &event)) {
+        App_GuessTheColor_dispatch(tasks_p->app_p, (AppEvent) event);
     }
 }
 
+/**
+ * The store task. Writes the statistics changed by the last round to flash,
+ * or erases the spare sector of the store, one step per run. It only does so
+ * on the title and result screens, which wait for their alarm and ignore the
+ * buttons, so the few milliseconds of a sector erase cannot swallow a tap.
+ *
+ * @param context:  The App_GuessTheColor_Tasks shared by every task
+ */
+void App_GuessTheColor_storeTask(void* context)
+{
+    App_GuessTheColor_Tasks* tasks_p = (App_GuessTheColor_Tasks*) context;
+    GameState state = App_GuessTheColor_getState(tasks_p->app_p);
+
+    if (state == TITLE_SCREEN || state == RESULT_SCREEN) {
+        KVStore_service();
+    }
+}
+
+/**
+ * The trace task. Streams the SPI trace over the telemetry link, as much of
+ * it as fits in half the telemetry ring.
+ *
+ * @param context:  The App_GuessTheColor_Tasks shared by every task
+ */
+void App_GuessTheColor_traceTask(void* context)
+{
+    SpiTrace_send(TELEMETRY_SPI_TRACE);
+}
+
+/**
+ * The transition table of the game, stored in flash. Rows for the same state
+ * and event are tried in order, so a guarded row must come before its
+ * guard-less fallback.
+ */
+static const FSMTransition transitions[] =
+{
+    // state               event                 guard                               action                                  next
+    { TITLE_SCREEN       , EVENT_TIMEOUT       , NULL                              , NULL                                  , INSTRUCTIONS_SCREEN },
+    { INSTRUCTIONS_SCREEN, EVENT_S2_TAP        , NULL                              , App_GuessTheColor_newRound            , GAME_SCREEN         },
+    { GAME_SCREEN        , EVENT_S2_TAP        , NULL                              , App_GuessTheColor_cursorDown          , GAME_SCREEN         },
+    { GAME_SCREEN        , EVENT_JOYSTICK_DOWN , NULL                              , App_GuessTheColor_cursorDown          , GAME_SCREEN         },
+    { GAME_SCREEN        , EVENT_JOYSTICK_UP   , NULL                              , App_GuessTheColor_cursorUp            , GAME_SCREEN         },
+    { GAME_SCREEN        , EVENT_S1_TAP        , App_GuessTheColor_isCursorOnColor , App_GuessTheColor_selectColor         , GAME_SCREEN         },
+    { GAME_SCREEN        , EVENT_S1_TAP        , NULL                              , App_GuessTheColor_endGuessing         , RESULT_SCREEN       },
+    { RESULT_SCREEN      , EVENT_TIMEOUT       , NULL                              , NULL                                  , INSTRUCTIONS_SCREEN },
+};
+
+/** The on-enter and on-exit hooks of each GameState, in enum order. */
+static const FSMStateHooks hooks[NUM_GAME_STATES] =
+{
+    { App_GuessTheColor_enterTitleScreen       , App_GuessTheColor_exitTitleScreen  },
+    { App_GuessTheColor_enterInstructionsScreen, NULL                               },
+    { App_GuessTheColor_enterGameScreen        , App_GuessTheColor_exitGameScreen   },
+    { App_GuessTheColor_enterResultScreen      , App_GuessTheColor_exitResultScreen },
+};
+
+static const FSMTable guessTheColorFSM =
+{
+    transitions, sizeof(transitions) / sizeof(FSMTransition),
+    hooks, NUM_GAME_STATES
+};
+
+/** The profiler probe charged with the events handled in each GameState. */
+static const ProfileProbe stateProbes[NUM_GAME_STATES] =
+{
+    PROF_HANDLE_TITLE, PROF_HANDLE_INSTRUCTIONS, PROF_HANDLE_GAME, PROF_HANDLE_RESULT
+};
+
 /**
  * The main constructor for your application. This function initializes each
- * state variable required for the GuessTheColor game.
+ * state variable required for the GuessTheColor game. The FSM is not entered
+ * until App_GuessTheColor_start() is called on the final copy of the object.
  */
 App_GuessTheColor App_GuessTheColor_construct(HAL* hal_p)
 {
     // The App_GuessTheColor object to initialize
     App_GuessTheColor app;
 
-    // Predetermined random numbers for this application. In an actual project,
-    // you should probably use some form of noise generator instead, like the
-    // noise from your ADC.
-    app.randomNumbers[0] = 5;
-    app.randomNumbers[1] = 2;
-    app.randomNumbers[2] = 7;
-    app.randomNumbers[3] = 1;
-    app.randomNumbers[4] = 3;
+    app.hal_p = hal_p;
 
-    app.randomNumberChoice = 0;
+    // The colors to guess come from a generator seeded by ADC noise and
+    // button timing. It is reseeded every round, once more noise is in.
+    app.random = Random_construct();
 
-    // Initialization of FSM variables
-    app.state = TITLE_SCREEN;
-    app.timer = SWTimer_construct(TITLE_SCREEN_WAIT);
-    SWTimer_start(&app.timer);
+    // Statistics from earlier sessions are read back from flash. This is one
+    // scan of at most a sector, and never waits for an erase.
+    KVStore_mount();
 
-    App_GuessTheColor_initGameVariables(&app, hal_p);
+    // Round outcomes and health counters are streamed to the PC from now on
+    Telemetry_init(TELEMETRY_BAUD);
 
-    app.cursor = CURSOR_0;
+    TelemetryRecord record;
+    Telemetry_begin(&record, TELEMETRY_BOOT);
+    Telemetry_putVarint(&record, KVStore_get(STAT_ROUNDS));
+    Telemetry_putVarint(&record, KVStore_get(STAT_WINS));
+    Telemetry_putVarint(&record, KVStore_get(STAT_LOSSES));
+    Telemetry_send(&record);
+
+    app.roundStart = 0;
+
+    // Events are queued by the input task; screens which time out set alarms
+    app.events = EventQueue_construct();
+
+    // Screens are drawn from their const descriptions by the UI
+    app.ui = UI_construct(&hal_p->gfx);
+
+    App_GuessTheColor_initGameVariables(&app, hal_p);
 
     // Return the completed Application struct to the user
     return app;
 }
 
 /**
- * The main super-loop function of the application. We place this inside of a
- * single infinite loop in main. In this way, we can model a polling system of
- * FSMs. Every cycle of this loop function, we poll each of the FSMs one time.
+ * Builds the FSM around the application and enters the title screen. The FSM
+ * keeps a pointer to the application, and the event queue's rate window is
+ * tracked by address, so this must be called on the object main() keeps, not
+ * on a temporary copy.
  */
-void App_GuessTheColor_loop(App_GuessTheColor* app_p, HAL* hal_p)
+void App_GuessTheColor_start(App_GuessTheColor* app_p)
 {
-    switch (app_p->state)
-    {
-        case TITLE_SCREEN:
-            App_GuessTheColor_handleTitleScreen(app_p, hal_p);
-            break;
+    EventQueue_start(&app_p->events);
 
-        case INSTRUCTIONS_SCREEN:
-            App_GuessTheColor_handleInstructionsScreen(app_p, hal_p);
-            break;
+    app_p->fsm = FSM_construct(&guessTheColorFSM, TITLE_SCREEN, app_p);
+    FSM_start(&app_p->fsm);
+}
 
-        case GAME_SCREEN:
-            App_GuessTheColor_handleGameScreen(app_p, hal_p);
-            break;
+/**
+ * Returns the screen which is currently shown.
+ */
+GameState App_GuessTheColor_getState(App_GuessTheColor* app_p)
+{
+    return (GameState) FSM_getState(&app_p->fsm);
+}
 
-        case RESULT_SCREEN:
-            App_GuessTheColor_handleResultScreen(app_p, hal_p);
-            break;
+/**
+ * The main FSM function of the application, run by the FSM task for every
+ * event taken out of the queue. The time spent is charged to the screen which
+ * was showing when the event arrived. A user input which causes a transition
+ * has its latency recorded once the transition, including its redraw, is done.
+ */
+void App_GuessTheColor_dispatch(App_GuessTheColor* app_p, AppEvent event)
+{
+    ProfileProbe probe = stateProbes[App_GuessTheColor_getState(app_p)];
+    PROF_BEGIN(probe);
 
-        default:
-            break;
-    }
+    FSM_dispatch(&app_p->fsm, event);
+    LatencyTrace_complete();
+
+    PROF_END(probe);
 }
 
 /**
  * Sets up the GuessTheColors game by initializing the game state to the Title
  * Screen state.
  */
-void App_GuessTheColor_showTitleScreen(GFX* gfx_p)
+void App_GuessTheColor_showTitleScreen(App_GuessTheColor* app_p)
 {
-
-    GFX_clear(gfx_p);
-    Graphics_drawImage(&gfx_p->context, &colors8BPP_UNCOMP, 0, 0);
-
-    GFX_print(gfx_p, "Guess the RGB color  ", 0, 0);
-    GFX_print(gfx_p, "---------------------", 1, 0);
-    GFX_print(gfx_p, "By: Leyla Nazhand-Ali", 2, 0);
-    GFX_print(gfx_p, "Edit: Matthew Zhong  ", 3, 0);
+    UI_show(&app_p->ui, &titleScreen);
 }
 
 /**
@@ -144,197 +453,246 @@ void App_GuessTheColor_initGameVariables(App_GuessTheColor* app_p, HAL* hal_p)
     app_p->blueSelected = false;
 
     // Turn off all LEDs - they don't turn on until a random number is generated
-    LED_turnOff(&hal_p->boosterpackRed);
-    LED_turnOff(&hal_p->boosterpackGreen);
-    LED_turnOff(&hal_p->boosterpackBlue);
+    LEDGroup_apply(&hal_p->boosterpackLEDs, 0);
 }
 
 /**
- * Callback function for when the game is in the TITLE_SCREEN state. Used to
- * break down the main App_GuessTheColor_loop() function into smaller
- * sub-functions.
+ * On-enter hook of TITLE_SCREEN. Draws the title, sets the alarm which
+ * leaves it, and cycles the RGB LED through the color wheel for as long as
+ * it is shown. The effect runs entirely from its timer ISR.
  */
-void App_GuessTheColor_handleTitleScreen(App_GuessTheColor* app_p, HAL* hal_p)
+void App_GuessTheColor_enterTitleScreen(void* context)
 {
-    if (SWTimer_expired(&app_p->timer))
-    {
-        app_p->state = INSTRUCTIONS_SCREEN;
-        App_GuessTheColor_showInstructionsScreen(app_p, &hal_p->gfx);
+    App_GuessTheColor* app_p = (App_GuessTheColor*) context;
 
-    }
+    App_GuessTheColor_showTitleScreen(app_p);
+    EventQueue_setAlarm(&app_p->events, EVENT_TIMEOUT, TITLE_SCREEN_WAIT);
+
+    RGBLED_enable(&app_p->hal_p->boosterpackRGB);
+    LEDEffects_start(&app_p->hal_p->boosterpackRGB, LED_EFFECT_RAINBOW, LED_EFFECT_WHITE);
 }
 
 /**
- * Callback function for when the game is in the INSTRUCTIONS_SCREEN state. Used
- * to break down the main App_GuessTheColor_loop() function into smaller
- * sub-functions.
+ * On-exit hook of TITLE_SCREEN.
  */
-void App_GuessTheColor_handleInstructionsScreen(App_GuessTheColor* app_p, HAL* hal_p)
+void App_GuessTheColor_exitTitleScreen(void* context)
 {
-    // Transition to start the game when B2 is pressed
-    if (Button_isTapped(&hal_p->boosterpackS2))
-    {
-        // Update internal logical state
-        app_p->state = GAME_SCREEN;
+    App_GuessTheColor* app_p = (App_GuessTheColor*) context;
 
-        // Turn on LEDs based off of the lowest three bits of a random number.
-        uint32_t randomNumber = app_p->randomNumbers[app_p->randomNumberChoice];
+    App_GuessTheColor_stopEffect(app_p->hal_p);
+}
 
-        if (randomNumber & BIT0) { LED_turnOn(&hal_p->boosterpackRed  ); }
-        if (randomNumber & BIT1) { LED_turnOn(&hal_p->boosterpackGreen); }
-        if (randomNumber & BIT2) { LED_turnOn(&hal_p->boosterpackBlue ); }
+/**
+ * On-enter hook of INSTRUCTIONS_SCREEN.
+ */
+void App_GuessTheColor_enterInstructionsScreen(void* context)
+{
+    App_GuessTheColor* app_p = (App_GuessTheColor*) context;
 
-        // Increment the random number choice with a mod loopback to 0 when reaching
-        // NUM_RANDOM_NUMBERS.
-        app_p->randomNumberChoice = (app_p->randomNumberChoice + 1) % NUM_RANDOM_NUMBERS;
+    App_GuessTheColor_showInstructionsScreen(app_p);
+}
 
-        // Display the next state's screen to the user
-        App_GuessTheColor_showGameScreen(app_p, &hal_p->gfx);
-    }
+/**
+ * Action of INSTRUCTIONS_SCREEN -> GAME_SCREEN. Picks the color to guess and
+ * shows it on the LEDs.
+ */
+void App_GuessTheColor_newRound(void* context)
+{
+    App_GuessTheColor* app_p = (App_GuessTheColor*) context;
+
+    // Fold in the entropy gathered since the last round, including the
+    // timing of the B2 press which started this one.
+    Random_reseed(&app_p->random);
+
+    // Turn on a random, non-empty combination of the three LEDs, all in the
+    // same instant.
+    uint32_t randomNumber = 1 + Random_below(&app_p->random, NUM_COLOR_COMBINATIONS - 1);
+    LEDGroup_apply(&app_p->hal_p->boosterpackLEDs, randomNumber & (BIT0 | BIT1 | BIT2));
+
+    app_p->roundStart = HWTimer_getCycles();
+
+    TelemetryRecord record;
+    Telemetry_begin(&record, TELEMETRY_ROUND_START);
+    Telemetry_putVarint(&record, KVStore_get(STAT_ROUNDS) + 1);
+    Telemetry_putVarint(&record, randomNumber & (BIT0 | BIT1 | BIT2));
+    Telemetry_send(&record);
 }
 
 /**
- * Callback function for when the game is in the GAME_SCREEN state. Used to
- * break down the main App_GuessTheColors_loop() function into smaller
- * sub-functions.
+ * On-enter hook of GAME_SCREEN. B2 moves the cursor from now on, so it is
+ * allowed to repeat while held.
  */
-void App_GuessTheColor_handleGameScreen(App_GuessTheColor* app_p, HAL* hal_p)
+void App_GuessTheColor_enterGameScreen(void* context)
 {
-    // If B2 is pressed, increment the cursor and circle it around to 0 if it
-    // reaches the bottom
-    if (Button_isTapped(&hal_p->boosterpackS2)) {
-        app_p->cursor = (Cursor) (((int) app_p->cursor + 1) % NUM_TEST_OPTIONS);
-        App_GuessTheColor_updateGameScreen(app_p, &hal_p->gfx);
-    }
+    App_GuessTheColor* app_p = (App_GuessTheColor*) context;
 
-    // If B1 is pressed, either add a selection to the proper color choice OR
-    // transition to the SHOW_RESULT state if the user chooses to end the test.
-    if (Button_isTapped(&hal_p->boosterpackS1))
-    {
-        switch (app_p->cursor)
-        {
-            // In the first three choices, we need to re-display the game screen
-            // to reflect updated choices.
-            // -----------------------------------------------------------------
-            case CURSOR_0: // Red choice
-                app_p->redSelected = true;
-                App_GuessTheColor_updateGameScreen(app_p, &hal_p->gfx);
-                break;
-
-            case CURSOR_1: // Green choice
-                app_p->greenSelected = true;
-                App_GuessTheColor_updateGameScreen(app_p, &hal_p->gfx);
-                break;
-
-            case CURSOR_2: // Blue choice
-                app_p->blueSelected = true;
-                App_GuessTheColor_updateGameScreen(app_p, &hal_p->gfx);
-                break;
-
-            // In the final choice, we must setup a transition to RESULT_SCREEN
-            // by starting a timer and calling the proper draw function.
-            // -----------------------------------------------------------------
-            case CURSOR_3:
-                app_p->state = RESULT_SCREEN;
-
-                app_p->timer = SWTimer_construct(RESULT_SCREEN_WAIT);
-                SWTimer_start(&app_p->timer);
-
-                App_GuessTheColor_showResultScreen(app_p, hal_p);
-                break;
-
-            default:
-                break;
-        }
-    }
+    Button_setAutoRepeat(&app_p->hal_p->boosterpackS2, CURSOR_REPEAT_DELAY_MS, CURSOR_REPEAT_RATE_MS);
+    App_GuessTheColor_showGameScreen(app_p);
 }
 
 /**
- * Callback function for when the game is in the RESULT_SCREEN state. Used to
- * break down the main App_GuessTheColor_loop() function into smaller
- * sub-functions.
+ * On-exit hook of GAME_SCREEN.
  */
-void App_GuessTheColor_handleResultScreen(App_GuessTheColor* app_p, HAL* hal_p)
+void App_GuessTheColor_exitGameScreen(void* context)
 {
-    // Transition to instructions and reset game variables when the timer expires
-    if (SWTimer_expired(&app_p->timer))
-    {
-        app_p->state = INSTRUCTIONS_SCREEN;
-        App_GuessTheColor_initGameVariables(app_p, hal_p);
-        App_GuessTheColor_showInstructionsScreen(app_p, &hal_p->gfx);
-    }
+    App_GuessTheColor* app_p = (App_GuessTheColor*) context;
+
+    Button_setAutoRepeat(&app_p->hal_p->boosterpackS2, 0, 0);
 }
 
 /**
- * A helper function which clears the screen and prints the instructions for how
- * to play the game.
+ * Internal action of GAME_SCREEN. Moves the cursor down, circling around to
+ * the top when it reaches the bottom.
  */
-void App_GuessTheColor_showInstructionsScreen(App_GuessTheColor* app_p, GFX* gfx_p)
+void App_GuessTheColor_cursorDown(void* context)
 {
-    // Clear the screen from any old text state
-    GFX_clear(gfx_p);
+    App_GuessTheColor* app_p = (App_GuessTheColor*) context;
 
-    // Display the text
-    GFX_print(gfx_p, "Instructions         ", 0, 0);
-    GFX_print(gfx_p, "---------------------", 1, 0);
-    GFX_print(gfx_p, "Guess the RGB mix.   ", 2, 0);
-    GFX_print(gfx_p, "Controls during guessing:", 3, 0);
+    LatencyTrace_markTransition(LATENCY_CURSOR_MOVE);
+    app_p->cursor = (Cursor) (((int) app_p->cursor + 1) % NUM_TEST_OPTIONS);
+    App_GuessTheColor_updateGameScreen(app_p);
+}
 
-    GFX_print(gfx_p, "B1: Select choice    ", 5, 0);
-    GFX_print(gfx_p, "B2: Move arrow       ", 6, 0);
+/**
+ * Internal action of GAME_SCREEN. Moves the cursor up, circling around to the
+ * bottom when it reaches the top.
+ */
+void App_GuessTheColor_cursorUp(void* context)
+{
+    App_GuessTheColor* app_p = (App_GuessTheColor*) context;
 
-    GFX_print(gfx_p, "Press B2 to start.   ", 8, 0);
+    LatencyTrace_markTransition(LATENCY_CURSOR_MOVE);
+    app_p->cursor = (Cursor) (((int) app_p->cursor + NUM_TEST_OPTIONS - 1) % NUM_TEST_OPTIONS);
+    App_GuessTheColor_updateGameScreen(app_p);
 }
 
 /**
- * A helper function which clears the screen and draws an updated display of
- * each color and its selection, intended for use when setting up the
- * GAME_SCREEN state.
+ * Guard of the B1 transitions of GAME_SCREEN: true while the cursor is on one
+ * of the three colors rather than on "End Guessing".
+ */
+bool App_GuessTheColor_isCursorOnColor(void* context)
+{
+    App_GuessTheColor* app_p = (App_GuessTheColor*) context;
+
+    return app_p->cursor != CURSOR_3;
+}
+
+/**
+ * Returns the time since the current round started, in milliseconds.
  */
-void App_GuessTheColor_showGameScreen(App_GuessTheColor* app_p, GFX* gfx_p)
+static uint32_t App_GuessTheColor_roundElapsedMS(App_GuessTheColor* app_p)
 {
-    // Clear the screen from any old text state
-    GFX_clear(gfx_p);
+    return (uint32_t) ((HWTimer_getCycles() - app_p->roundStart) / (SYSTEM_CLOCK / MS_DIVISION_FACTOR));
+}
 
-    // Display the text
-    GFX_print(gfx_p, "Game                 ", 0, 0);
-    GFX_print(gfx_p, "---------------------", 1, 0);
-    GFX_print(gfx_p, "  Red                ", 2, 0);
-    GFX_print(gfx_p, "  Green              ", 3, 0);
-    GFX_print(gfx_p, "  Blue               ", 4, 0);
-    GFX_print(gfx_p, "  End Guessing       ", 5, 0);
+/**
+ * Internal action of GAME_SCREEN. Selects the color under the cursor and
+ * redraws the choices.
+ */
+void App_GuessTheColor_selectColor(void* context)
+{
+    App_GuessTheColor* app_p = (App_GuessTheColor*) context;
 
-    GFX_print(gfx_p, "B1: Select choice    ", 7, 0);
-    GFX_print(gfx_p, "B2: Move arrow       ", 8, 0);
+    LatencyTrace_markTransition(LATENCY_SELECT);
 
-    // Draw the cursor
-    GFX_print(gfx_p, ">", 2 + app_p->cursor, 0);
+    switch (app_p->cursor)
+    {
+        case CURSOR_0: // Red choice
+            app_p->redSelected = true;
+            break;
 
-    // Draw the stars for LED guesses
-    if (app_p->redSelected  ) { GFX_print(gfx_p, "*", 2, 8); }
-    if (app_p->greenSelected) { GFX_print(gfx_p, "*", 3, 8); }
-    if (app_p->blueSelected ) { GFX_print(gfx_p, "*", 4, 8); }
+        case CURSOR_1: // Green choice
+            app_p->greenSelected = true;
+            break;
+
+        case CURSOR_2: // Blue choice
+            app_p->blueSelected = true;
+            break;
+
+        default:
+            break;
+    }
+
+    App_GuessTheColor_updateGameScreen(app_p);
+
+    TelemetryRecord record;
+    Telemetry_begin(&record, TELEMETRY_GUESS);
+    Telemetry_putVarint(&record, app_p->cursor);
+    Telemetry_putVarint(&record, App_GuessTheColor_roundElapsedMS(app_p));
+    Telemetry_send(&record);
+}
+
+/**
+ * Action of GAME_SCREEN -> RESULT_SCREEN.
+ */
+void App_GuessTheColor_endGuessing(void* context)
+{
+    LatencyTrace_markTransition(LATENCY_END_GUESSING);
+}
+
+/**
+ * On-enter hook of RESULT_SCREEN. Shows the result for RESULT_SCREEN_WAIT.
+ */
+void App_GuessTheColor_enterResultScreen(void* context)
+{
+    App_GuessTheColor* app_p = (App_GuessTheColor*) context;
+
+    EventQueue_setAlarm(&app_p->events, EVENT_TIMEOUT, RESULT_SCREEN_WAIT);
+    App_GuessTheColor_showResultScreen(app_p, app_p->hal_p);
 }
 
 /**
- * A helper function which updates the main game screen by redrawing only the
- * positions where the cursor could possibly be updated.
+ * On-exit hook of RESULT_SCREEN. Resets the game for the next round.
  */
-void App_GuessTheColor_updateGameScreen(App_GuessTheColor* app_p, GFX* gfx_p)
+void App_GuessTheColor_exitResultScreen(void* context)
 {
-    // Clear the cursors from any previous game screen
-    GFX_print(gfx_p, "  ", 2, 0);
-    GFX_print(gfx_p, "  ", 3, 0);
-    GFX_print(gfx_p, "  ", 4, 0);
-    GFX_print(gfx_p, "  ", 5, 0);
+    App_GuessTheColor* app_p = (App_GuessTheColor*) context;
 
-    // Draw the cursor
-    GFX_print(gfx_p, ">", 2 + app_p->cursor, 0);
+    App_GuessTheColor_stopEffect(app_p->hal_p);
+    App_GuessTheColor_initGameVariables(app_p, app_p->hal_p);
+}
 
-    // Draw the stars for LED guesses
-    if (app_p->redSelected  ) { GFX_print(gfx_p, "*", 2, 8); }
-    if (app_p->greenSelected) { GFX_print(gfx_p, "*", 3, 8); }
-    if (app_p->blueSelected ) { GFX_print(gfx_p, "*", 4, 8); }
+/**
+ * A helper function which clears the screen and prints the instructions for how
+ * to play the game.
+ */
+void App_GuessTheColor_showInstructionsScreen(App_GuessTheColor* app_p)
+{
+    UI_show(&app_p->ui, &instructionsScreen);
+}
+
+/**
+ * A helper function which copies the cursor and the selections into the
+ * values the game screen's widgets are bound to.
+ */
+static void App_GuessTheColor_bindGameValues(App_GuessTheColor* app_p)
+{
+    UI_setValue(&app_p->ui, UI_VALUE_CURSOR, app_p->cursor);
+    UI_setValue(&app_p->ui, UI_VALUE_RED, app_p->redSelected);
+    UI_setValue(&app_p->ui, UI_VALUE_GREEN, app_p->greenSelected);
+    UI_setValue(&app_p->ui, UI_VALUE_BLUE, app_p->blueSelected);
+}
+
+/**
+ * A helper function which clears the screen and draws an updated display of
+ * each color and its selection, intended for use when setting up the
+ * GAME_SCREEN state.
+ */
+void App_GuessTheColor_showGameScreen(App_GuessTheColor* app_p)
+{
+    App_GuessTheColor_bindGameValues(app_p);
+    UI_show(&app_p->ui, &gameScreen);
+}
+
+/**
+ * A helper function which updates the main game screen. Only the widgets
+ * whose values changed are redrawn: a cursor move rewrites two characters,
+ * and a selection one.
+ */
+void App_GuessTheColor_updateGameScreen(App_GuessTheColor* app_p)
+{
+    App_GuessTheColor_bindGameValues(app_p);
+    UI_refresh(&app_p->ui);
 }
 
 /**
@@ -343,25 +701,77 @@ void App_GuessTheColor_updateGameScreen(App_GuessTheColor* app_p, GFX* gfx_p)
  */
 void App_GuessTheColor_showResultScreen(App_GuessTheColor* app_p, HAL* hal_p)
 {
-    // Print the splash text
-    GFX_clear(&hal_p->gfx);
-    GFX_print(&hal_p->gfx, "Result               ", 0, 0);
-    GFX_print(&hal_p->gfx, "---------------------", 1, 0);
-
     // Determine if each selection matched correctly
-    bool match = app_p->redSelected   == LED_isLit(&hal_p->boosterpackRed  )
-              && app_p->greenSelected == LED_isLit(&hal_p->boosterpackGreen)
-              && app_p->blueSelected  == LED_isLit(&hal_p->boosterpackBlue );
-
-    // Print the correct string based on if the user won or not
-    if (match) {
-        GFX_print(&hal_p->gfx, "Right!", 2, 0);
-        Graphics_drawImage((const Graphics_Context *)&hal_p->gfx, &happy8BPP_UNCOMP, 60, 60);
+    bool match = app_p->redSelected   == LEDGroup_isLit(&hal_p->boosterpackLEDs, BOOSTERPACK_LED_RED_BIT  )
+              && app_p->greenSelected == LEDGroup_isLit(&hal_p->boosterpackLEDs, BOOSTERPACK_LED_GREEN_BIT)
+              && app_p->blueSelected  == LEDGroup_isLit(&hal_p->boosterpackLEDs, BOOSTERPACK_LED_BLUE_BIT );
+
+    // Count the round in RAM; the store task writes it to flash later
+    KVStore_add(STAT_ROUNDS, 1);
+    KVStore_add(match ? STAT_WINS : STAT_LOSSES, 1);
+    App_GuessTheColor_sendResult(app_p, match);
+
+    // The result screen shows the text and image chosen by the match
+    UI_setValue(&app_p->ui, UI_VALUE_MATCH, match);
+    UI_show(&app_p->ui, &resultScreen);
+
+    // The RGB LED takes over the three LEDs in the color which was guessed:
+    // a slow pulse for a win, a hard blink for a loss.
+    uint32_t tint = 0;
+    if (LEDGroup_isLit(&hal_p->boosterpackLEDs, BOOSTERPACK_LED_RED_BIT)) {
+        tint |= 0xFF0000;
+    }
+    if (LEDGroup_isLit(&hal_p->boosterpackLEDs, BOOSTERPACK_LED_GREEN_BIT)) {
+        tint |= 0x00FF00;
+    }
+    if (LEDGroup_isLit(&hal_p->boosterpackLEDs, BOOSTERPACK_LED_BLUE_BIT)) {
+        tint |= 0x0000FF;
     }
-    else {
-        GFX_print(&hal_p->gfx, "Wrong!", 2, 0);
-        Graphics_drawImage((const Graphics_Context *)&hal_p->gfx, &sad8BPP_UNCOMP, 60, 60);
 
+    RGBLED_enable(&hal_p->boosterpackRGB);
+    LEDEffects_start(&hal_p->boosterpackRGB, match ? LED_EFFECT_PULSE : LED_EFFECT_BLINK, tint);
+}
 
-    }
+/**
+ * A helper function which sends the outcome of the round that just ended,
+ * followed by the health counters of the event queue, the FSM and the
+ * telemetry link itself.
+ */
+void App_GuessTheColor_sendResult(App_GuessTheColor* app_p, bool match)
+{
+    LEDGroup* leds_p = &app_p->hal_p->boosterpackLEDs;
+    TelemetryRecord record;
+
+    uint32_t selected = (app_p->redSelected   ? BIT0 : 0)
+                      | (app_p->greenSelected ? BIT1 : 0)
+                      | (app_p->blueSelected  ? BIT2 : 0);
+    uint32_t target = (LEDGroup_isLit(leds_p, BOOSTERPACK_LED_RED_BIT)   ? BIT0 : 0)
+                    | (LEDGroup_isLit(leds_p, BOOSTERPACK_LED_GREEN_BIT) ? BIT1 : 0)
+                    | (LEDGroup_isLit(leds_p, BOOSTERPACK_LED_BLUE_BIT)  ? BIT2 : 0);
+
+    Telemetry_begin(&record, TELEMETRY_RESULT);
+    Telemetry_putVarint(&record, match);
+    Telemetry_putVarint(&record, selected);
+    Telemetry_putVarint(&record, target);
+    Telemetry_putVarint(&record, App_GuessTheColor_roundElapsedMS(app_p));
+    Telemetry_send(&record);
+
+    Telemetry_begin(&record, TELEMETRY_HEALTH);
+    Telemetry_putVarint(&record, EventQueue_getDropped(&app_p->events));
+    Telemetry_putVarint(&record, EventQueue_getMaxDepth(&app_p->events));
+    Telemetry_putVarint(&record, FSM_getEventsIgnored(&app_p->fsm));
+    Telemetry_putVarint(&record, Telemetry_getStats()->recordsDropped);
+    Telemetry_putVarint(&record, Telemetry_getStats()->maxFill);
+    Telemetry_putVarint(&record, EventQueue_getEventsPerSecond(&app_p->events));
+    Telemetry_send(&record);
+}
+
+/**
+ * A helper function which stops the running LED effect and hands the three
+ * boosterpack LEDs back to the LEDGroup.
+ */
+void App_GuessTheColor_stopEffect(HAL* hal_p)
+{
+    LEDEffects_stop();
+    RGBLED_disable(&hal_p->boosterpackRGB);
 }
@@ -11,19 +11,128 @@
 #include <HAL/HAL.h>
 #include <HAL/Graphics.h>
 #include <HAL/Timer.h>
+#include <HAL/Scheduler.h>
+#include <HAL/LoopMonitor.h>
+#include <HAL/FSM.h>
+#include <HAL/EventQueue.h>
+#include <HAL/Random.h>
+#include <HAL/UI.h>
+#include <HAL/KVStore.h>
+#include <HAL/Telemetry.h>
+#include <HAL/SpiTrace.h>
 
 #define TITLE_SCREEN_WAIT   3000  //3 seconds
 #define RESULT_SCREEN_WAIT  3000  // 3 seconds
 
+// Task timing for the scheduler. Inputs are sampled every millisecond, which
+// keeps debouncing well within DEBOUNCE_TIME_MS. The FSM has no period: it
+// only runs when the input task finds events in the queue.
+#define INPUT_TASK_PERIOD     1     // 1 ms
+#define INPUT_TASK_DEADLINE   1     // 1 ms
+#define FSM_TASK_PERIOD       0     // Signal only
+#define FSM_TASK_DEADLINE     100   // 100 ms - a full redraw must still feel instant
+#define STORE_TASK_PERIOD     100   // 100 ms
+#define STORE_TASK_DEADLINE   1000  // 1 s - only runs between rounds anyway
+#define TRACE_TASK_PERIOD     10    // 10 ms - only added when SPI_TRACE_ENABLED
+#define TRACE_TASK_DEADLINE   1000  // 1 s
+
+// Priorities of the scheduled tasks. The FSM outranks the input task so that
+// the queue is drained before the next input sample adds to it.
+#define INPUT_TASK_PRIORITY   1
+#define FSM_TASK_PRIORITY     2
+#define STORE_TASK_PRIORITY   0
+#define TRACE_TASK_PRIORITY   0
+
+// Main loop monitoring. Any single pass of the main loop longer than the
+// debounce time risks a missed or late tap, so that is the budget. Set
+// LOOP_WATCHDOG_ENABLED to 1 to reset the board on a hard stall instead of
+// holding the watchdog.
+#define LOOP_BUDGET_US          (DEBOUNCE_TIME_MS * 1000)
+#define LOOP_WATCHDOG_ENABLED   0
+
+// Holding B2 on the game screen keeps moving the cursor: first after
+// CURSOR_REPEAT_DELAY_MS, then every CURSOR_REPEAT_RATE_MS.
+#define CURSOR_REPEAT_DELAY_MS  400
+#define CURSOR_REPEAT_RATE_MS   100
+
+// The rate of the telemetry stream on the launchpad's backchannel UART. Either
+// TELEMETRY_BAUD_115200, which any terminal program can open, or
+// TELEMETRY_BAUD_1M. See tools/telemetry.py for the decoder.
+#define TELEMETRY_BAUD          TELEMETRY_BAUD_115200
+
+// Set STATIC_FRAMES_ENABLED to 1 to draw the static parts of the instructions
+// and game screens from pre-rendered frames in flash instead of text by text.
+// The frames are rendered from the static widgets below with the grlib of an
+// SDK, so they are not committed: "make -C host SDK=... frames" writes them
+// to frames.c, using the SDK the firmware is built with. Run it again
+// whenever those widgets or the SDK change. The host build renders its own
+// copy on every build, and "make -C host golden" checks it against the
+// widgets.
+#ifndef STATIC_FRAMES_ENABLED
+#define STATIC_FRAMES_ENABLED   0
+#endif
+
+extern const GFXFrame instructionsFrame;
+extern const GFXFrame gameFrame;
+
+// The widgets the frames are rendered from, as screens of their own
+extern const UIScreen instructionsStaticScreen;
+extern const UIScreen gameStaticScreen;
+
 #define NUM_TEST_OPTIONS    4
-#define NUM_RANDOM_NUMBERS  5
+#define NUM_COLOR_COMBINATIONS  8   // Every on/off combination of the three LEDs
 
+// The states of the application FSM, one per screen
 enum _GameState
 {
-    TITLE_SCREEN, INSTRUCTIONS_SCREEN, GAME_SCREEN, RESULT_SCREEN
+    TITLE_SCREEN, INSTRUCTIONS_SCREEN, GAME_SCREEN, RESULT_SCREEN, NUM_GAME_STATES
 };
 typedef enum _GameState GameState;
 
+// The events of the application FSM, passed through the EventQueue. Each one
+// is only posted when it actually happens.
+enum _AppEvent
+{
+    EVENT_TIMEOUT,          // The alarm of the current screen went off
+    EVENT_S1_TAP,
+    EVENT_S2_TAP,           // Also sent for every auto-repeat of a held B2
+    EVENT_JOYSTICK_UP,
+    EVENT_JOYSTICK_DOWN,
+    NUM_APP_EVENTS
+};
+typedef enum _AppEvent AppEvent;
+
+// The statistics kept in flash across resets, as KVStore keys
+enum _Stat
+{
+    STAT_ROUNDS, STAT_WINS, STAT_LOSSES, NUM_STATS
+};
+typedef enum _Stat Stat;
+
+// The record types of the telemetry stream. tools/telemetry.py must agree.
+enum _TelemetryType
+{
+    TELEMETRY_BOOT = 1,     // rounds, wins, losses kept in flash
+    TELEMETRY_ROUND_START,  // round number, target LED bits
+    TELEMETRY_GUESS,        // color selected (0 = red .. 2 = blue), ms since the round started
+    TELEMETRY_RESULT,       // match, selected bits, target bits, round duration in ms
+    TELEMETRY_HEALTH,       // events dropped, max queue depth, events ignored, records dropped,
+                            // max ring fill, events per second over the last second
+    TELEMETRY_SPI_TRACE     // LCD bytes, as laid out by SpiTrace_send()
+};
+typedef enum _TelemetryType TelemetryType;
+
+// The values the widgets of the screens are bound to
+enum _UIValue
+{
+    UI_VALUE_CURSOR,        // The Cursor of the game screen
+    UI_VALUE_RED,           // Whether each color is selected
+    UI_VALUE_GREEN,
+    UI_VALUE_BLUE,
+    UI_VALUE_MATCH          // Whether the guess was right
+};
+typedef enum _UIValue UIValue;
+
 enum _Cursor
 {
     CURSOR_0 = 0, CURSOR_1 = 1, CURSOR_2 = 2, CURSOR_3 = 3
@@ -37,8 +146,10 @@ typedef enum _Cursor Cursor;
  */
 struct _App_GuessTheColor
 {
-    GameState state;  // Determines which screen is currently shown
-    SWTimer timer;    // General-purpose timer for when screens must disappear
+    HAL* hal_p;       // The HAL used by the FSM actions and hooks
+    FSM fsm;          // Determines which screen is currently shown
+    EventQueue events;// Inputs and alarms waiting to be dispatched to the FSM
+    UI ui;            // Draws the screens and redraws what changes on them
 
     // Booleans to determine which colors the user has picked
     bool redSelected;
@@ -48,32 +159,84 @@ struct _App_GuessTheColor
     // Cursor tracker variable
     Cursor cursor;
 
-    // List of predetermined random numbers
-    int randomNumbers[NUM_RANDOM_NUMBERS];
-    int randomNumberChoice;
+    // Picks the color to guess in each round
+    Random random;
+
+    // When the current round started, in hardware timer cycles
+    uint64_t roundStart;
 };
 typedef struct _App_GuessTheColor App_GuessTheColor;
 
-// Boilerplate constructor function for the Application
-App_GuessTheColor App_GuessTheColor_construct(HAL* hal_p);
-void App_GuessTheColor_loop(App_GuessTheColor* app_p, HAL* hal_p);
+/**
+ * Every scheduled task receives a single context pointer, so the objects the
+ * tasks share are bundled together here.
+ */
+struct _App_GuessTheColor_Tasks
+{
+    App_GuessTheColor* app_p;
+    HAL* hal_p;
+    Scheduler* scheduler_p;
+
+    int inputTask;
+    int fsmTask;
+    int storeTask;
+    int traceTask;
+};
+typedef struct _App_GuessTheColor_Tasks App_GuessTheColor_Tasks;
 
-// Handle callback functions used for each state of the App_GuessTheColor_loop()
-// function. State transitions are embedded inside of each of these functions.
-void App_GuessTheColor_handleTitleScreen(App_GuessTheColor* app, HAL* hal);
-void App_GuessTheColor_handleInstructionsScreen(App_GuessTheColor* app, HAL* hal_p);
-void App_GuessTheColor_handleGameScreen(App_GuessTheColor* app, HAL* hal_p);
-void App_GuessTheColor_handleResultScreen(App_GuessTheColor* app, HAL* hal_p);
+// Boilerplate constructor function for the Application. The FSM is entered
+// by App_GuessTheColor_start(), once the object is in its final place.
+App_GuessTheColor App_GuessTheColor_construct(HAL* hal_p);
+void App_GuessTheColor_start(App_GuessTheColor* app_p);
+
+// Delivers one event to the FSM, and returns the screen currently shown.
+void App_GuessTheColor_dispatch(App_GuessTheColor* app_p, AppEvent event);
+GameState App_GuessTheColor_getState(App_GuessTheColor* app_p);
+
+// Tasks run by the scheduler. All four take an App_GuessTheColor_Tasks context.
+//  - input: every 1 ms, samples the buttons and joystick and posts events.
+//  - fsm:   only when signalled, drains the event queue into the FSM.
+//  - store: every 100 ms, writes the statistics to flash between rounds.
+//  - trace: every 10 ms, streams the SPI trace. Only scheduled when
+//           SPI_TRACE_ENABLED is set.
+void App_GuessTheColor_inputTask(void* context);
+void App_GuessTheColor_fsmTask(void* context);
+void App_GuessTheColor_storeTask(void* context);
+void App_GuessTheColor_traceTask(void* context);
+
+// On-enter and on-exit hooks of each state. The transition table itself is
+// in App_GuessTheColor.c. All of these take the App_GuessTheColor as context.
+void App_GuessTheColor_enterTitleScreen(void* context);
+void App_GuessTheColor_exitTitleScreen(void* context);
+void App_GuessTheColor_enterInstructionsScreen(void* context);
+void App_GuessTheColor_enterGameScreen(void* context);
+void App_GuessTheColor_exitGameScreen(void* context);
+void App_GuessTheColor_enterResultScreen(void* context);
+void App_GuessTheColor_exitResultScreen(void* context);
+
+// Guards and actions of the transitions
+void App_GuessTheColor_newRound(void* context);
+void App_GuessTheColor_cursorDown(void* context);
+void App_GuessTheColor_cursorUp(void* context);
+bool App_GuessTheColor_isCursorOnColor(void* context);
+void App_GuessTheColor_selectColor(void* context);
+void App_GuessTheColor_endGuessing(void* context);
 
 // Helper functions which clear the screen and draw the text for each state
-void App_GuessTheColor_showTitleScreen(GFX* gfx_p);
-void App_GuessTheColor_showInstructionsScreen(App_GuessTheColor* app_p, GFX* gfx_p);
-void App_GuessTheColor_showGameScreen(App_GuessTheColor* app_p, GFX* gfx_p);
+void App_GuessTheColor_showTitleScreen(App_GuessTheColor* app_p);
+void App_GuessTheColor_showInstructionsScreen(App_GuessTheColor* app_p);
+void App_GuessTheColor_showGameScreen(App_GuessTheColor* app_p);
 void App_GuessTheColor_showResultScreen(App_GuessTheColor* app_p, HAL* hal_p);
 
 // Helper function which reduces the number of redraws required when moving the
 // cursor.
-void App_GuessTheColor_updateGameScreen(App_GuessTheColor* app_p, GFX* gfx_p);
+void App_GuessTheColor_updateGameScreen(App_GuessTheColor* app_p);
+
+// Stops the title or result LED effect and returns the LEDs to the LEDGroup
+void App_GuessTheColor_stopEffect(HAL* hal_p);
+
+// Sends the telemetry records which end a round
+void App_GuessTheColor_sendResult(App_GuessTheColor* app_p, bool match);
 
 // Used to reset the internal game variables
 void App_GuessTheColor_initGameVariables(App_GuessTheColor* app_p, HAL* hal_p);
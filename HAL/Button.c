@@ -7,6 +7,65 @@
 
 #include <HAL/Button.h>
 
+/**
+ * A raw edge captured by a port ISR. The ISR reads the pin right after the
+ * edge, so pushState is the level the pin settled to, not the edge direction.
+ */
+struct _ButtonEdge
+{
+    int8_t channel;
+    int8_t pushState;
+    uint32_t timestamp;
+};
+typedef struct _ButtonEdge ButtonEdge;
+
+/**
+ * The debouncing state of one edge-interrupt button. Button structs are
+ * returned by value and copied around, so the state which the ISRs and the
+ * queues refer to lives here instead, indexed by the button's channel.
+ */
+struct _EdgeChannel
+{
+    uint8_t port;
+    uint16_t pin;
+
+    int queuedState;        // The level of the last edge the ISR queued. ISR only.
+    int rawState;           // The level reported by the most recent edge
+    uint32_t rawTime;       // When the most recent edge happened
+    int debouncedState;     // The level after debouncing
+    uint32_t pendingTaps;   // Debounced presses not yet seen by Button_isTapped()
+
+    bool leadingEdge;           // Accept the first edge, then lock out bounces
+    uint32_t lockoutCycles;     // How long the lockout lasts
+    uint32_t lastAcceptTime;    // When the debounced level last changed
+    uint32_t lastPressTime;     // The raw edge of the latest debounced press
+};
+typedef struct _EdgeChannel EdgeChannel;
+
+static EdgeChannel edgeChannels[MAX_EDGE_BUTTONS];
+static int numEdgeChannels = 0;
+
+/**
+ * The raw edge queue. This is a single-producer, single-consumer ring buffer:
+ * only the port ISRs write edgeQueueHead, and only the main loop writes
+ * edgeQueueTail, so no locking is needed. The ISRs for different ports never
+ * nest (they share a priority level), which keeps them a single producer.
+ */
+static volatile ButtonEdge edgeQueue[BUTTON_EDGE_QUEUE_SIZE];
+static volatile uint32_t edgeQueueHead = 0;
+static volatile uint32_t edgeQueueTail = 0;
+
+/** Debounced events waiting for Button_pollEvent(). Only used from the main loop. */
+static ButtonEvent eventQueue[BUTTON_EVENT_QUEUE_SIZE];
+static uint32_t eventQueueHead = 0;
+static uint32_t eventQueueTail = 0;
+
+/** See ButtonEdgeStats for which fields the port ISRs write. */
+static volatile ButtonEdgeStats edgeStats;
+
+/** The number of hardware timer cycles a level must be stable to be accepted */
+#define DEBOUNCE_CYCLES     ((SYSTEM_CLOCK / PRESCALER / MS_DIVISION_FACTOR) * DEBOUNCE_TIME_MS)
+
 /**
  * Constructs a button as a GPIO pushbutton, given a proper port and pin.
  * Initializes the debouncing and output FSMs.
@@ -24,6 +83,9 @@ Button Button_construct(uint8_t port, uint16_t pin)
     // Initialize the member variables for port and pin of the button.
     button.port = port;
     button.pin = pin;
+    button.fastPin = FastPin_construct(port, pin);
+    button.mode = BUTTON_POLLED;
+    button.channel = NO_EDGE_CHANNEL;
 
     // Here's a trick: All buttons on the board can be initialized with a
     // pullup resistor, since a double pullup resistor has no impact on the
@@ -32,9 +94,16 @@ Button Button_construct(uint8_t port, uint16_t pin)
 
     // Initialize all FSM variables for the button to their RELEASED states
     button.debounceState = StableR;
+    button.policy = DEBOUNCE_INTEGRATING;
     button.timer = SWTimer_construct(DEBOUNCE_TIME_MS);
     SWTimer_start(&button.timer);
 
+    // Auto-repeat is off until Button_setAutoRepeat() is called
+    button.autoRepeat = false;
+    button.repeating = false;
+    button.repeatDelayTimer = SWTimer_construct(0);
+    button.repeatRateTimer = SWTimer_construct(0);
+
     // Initialize all buffered outputs of the button
     button.pushState = RELEASED;
     button.isTapped = false;
@@ -43,6 +112,387 @@ Button Button_construct(uint8_t port, uint16_t pin)
     return button;
 }
 
+/**
+ * Selects the edge which the port interrupt of a channel should fire on next.
+ * A released (high) pin waits for a falling edge and a pressed (low) pin waits
+ * for a rising edge, so every change of level raises an interrupt.
+ */
+static void Button_selectNextEdge(EdgeChannel* channel_p, int pushState)
+{
+    if (pushState == PRESSED) {
+        GPIO_interruptEdgeSelect(channel_p->port, channel_p->pin, GPIO_LOW_TO_HIGH_TRANSITION);
+    }
+    else {
+        GPIO_interruptEdgeSelect(channel_p->port, channel_p->pin, GPIO_HIGH_TO_LOW_TRANSITION);
+    }
+}
+
+/**
+ * Constructs a button whose edges are captured by its port interrupt rather
+ * than by polling. The port ISR must forward to Button_handlePortInterrupt(),
+ * as PORT3_IRQHandler() and PORT5_IRQHandler() below do for the Boosterpack
+ * buttons. Falls back to a polled button if every edge channel is taken.
+ *
+ * @param port:     The GPIO port used to initialize this button
+ * @param pin:      The GPIO pin  used to initialize this button
+ *
+ * @return a constructed button which is debounced from its queued edges
+ */
+Button Button_constructInterrupt(uint8_t port, uint16_t pin)
+{
+    Button button = Button_construct(port, pin);
+
+    if (numEdgeChannels >= MAX_EDGE_BUTTONS) {
+        return button;
+    }
+
+    button.mode = BUTTON_EDGE_INTERRUPT;
+    button.channel = numEdgeChannels++;
+
+    EdgeChannel* channel_p = &edgeChannels[button.channel];
+    channel_p->port = port;
+    channel_p->pin = pin;
+    channel_p->rawState = GPIO_getInputPinValue(port, pin);
+    channel_p->queuedState = channel_p->rawState;
+    channel_p->rawTime = (uint32_t) HWTimer_getCycles();
+    channel_p->debouncedState = channel_p->rawState;
+    channel_p->pendingTaps = 0;
+    channel_p->leadingEdge = false;
+    channel_p->lockoutCycles = 0;
+    channel_p->lastAcceptTime = channel_p->rawTime;
+    channel_p->lastPressTime = channel_p->rawTime;
+
+    // Arm the interrupt for the opposite of the current level. The port
+    // interrupts are numbered consecutively from INT_PORT1.
+    Button_selectNextEdge(channel_p, channel_p->rawState);
+    GPIO_clearInterruptFlag(port, pin);
+    GPIO_enableInterrupt(port, pin);
+    Interrupt_enableInterrupt(INT_PORT1 + (port - GPIO_PORT_P1));
+
+    return button;
+}
+
+/**
+ * Constructs a button which is debounced by the PortDebouncer. Every button on
+ * the same port shares a single register read per SysTick, which makes this
+ * the cheapest mode once several buttons are in use.
+ *
+ * @param port:     The GPIO port used to initialize this button
+ * @param pin:      The GPIO pin  used to initialize this button
+ *
+ * @return a constructed button whose state comes from the port debouncer
+ */
+Button Button_constructSampled(uint8_t port, uint16_t pin)
+{
+    Button button = Button_construct(port, pin);
+
+    button.mode = BUTTON_TICK_SAMPLED;
+    PortDebouncer_enablePins(port, (uint8_t) pin);
+
+    return button;
+}
+
+/**
+ * Constructs a button which is debounced from port samples captured by DMA.
+ * The samples are only debounced when PortSampler_process() runs, which
+ * HAL_refresh() does before refreshing any button. Only ports 3 through 6 can
+ * be DMA-sampled; other ports fall back to a tick-sampled button.
+ *
+ * @param port:     The GPIO port used to initialize this button
+ * @param pin:      The GPIO pin  used to initialize this button
+ *
+ * @return a constructed button whose state comes from the port debouncer
+ */
+Button Button_constructDMASampled(uint8_t port, uint16_t pin)
+{
+    if (port < GPIO_PORT_P3 || port > GPIO_PORT_P6) {
+        return Button_constructSampled(port, pin);
+    }
+
+    Button button = Button_construct(port, pin);
+
+    button.mode = BUTTON_DMA_SAMPLED;
+    PortSampler_enablePins(port, (uint8_t) pin);
+
+    return button;
+}
+
+/**
+ * The shared body of every port ISR. Re-arms each edge-interrupt button on the
+ * port whose flag is set for the opposite of its current level, then queues
+ * that level as an edge. DO NOT CALL THIS FUNCTION FROM THE MAIN LOOP.
+ *
+ * The level is read some time after the edge, so a bounce may already have
+ * taken the pin back; and writing PxIES can itself set the flag again when the
+ * pin already sits at the level the new edge leads to. Either way, the ISR
+ * finds the level it queued last time. Such an interrupt is only counted as a
+ * duplicate, so the queue always alternates between the two levels.
+ *
+ * @param port:     The port whose interrupt fired
+ */
+void Button_handlePortInterrupt(uint8_t port)
+{
+    uint_fast16_t status = GPIO_getEnabledInterruptStatus(port);
+    GPIO_clearInterruptFlag(port, status);
+
+    uint32_t timestamp = (uint32_t) HWTimer_getCycles();
+    int i;
+
+    for (i = 0; i < numEdgeChannels; i++)
+    {
+        EdgeChannel* channel_p = &edgeChannels[i];
+        if (channel_p->port != port || !(status & channel_p->pin)) {
+            continue;
+        }
+
+        // Read the level AFTER clearing the flag, so a bounce which happens
+        // now raises a new interrupt instead of being missed
+        int pushState = GPIO_getInputPinValue(port, channel_p->pin);
+        Button_selectNextEdge(channel_p, pushState);
+
+        if (pushState == channel_p->queuedState) {
+            edgeStats.duplicates++;
+            continue;
+        }
+
+        uint32_t head = edgeQueueHead;
+        uint32_t next = (head + 1) & (BUTTON_EDGE_QUEUE_SIZE - 1);
+        if (next == edgeQueueTail) {
+            edgeStats.overflows++;
+            continue;
+        }
+
+        edgeQueue[head].channel = i;
+        edgeQueue[head].pushState = pushState;
+        edgeQueue[head].timestamp = timestamp;
+
+        // Publish the entry only after it has been completely written
+        edgeQueueHead = next;
+        channel_p->queuedState = pushState;
+        edgeStats.queued++;
+    }
+}
+
+/** Boosterpack S2 lives on port 3. */
+void PORT3_IRQHandler()
+{
+    Button_handlePortInterrupt(GPIO_PORT_P3);
+}
+
+/** Boosterpack S1 lives on port 5. */
+void PORT5_IRQHandler()
+{
+    Button_handlePortInterrupt(GPIO_PORT_P5);
+}
+
+/**
+ * Queues an event for Button_pollEvent(). The queue is drained by the input
+ * task; if it is full, the event is dropped and counted.
+ */
+static void Button_queueEvent(EdgeChannel* channel_p, int pushState, bool repeat, uint32_t timestamp)
+{
+    uint32_t next = (eventQueueHead + 1) & (BUTTON_EVENT_QUEUE_SIZE - 1);
+    if (next == eventQueueTail) {
+        edgeStats.eventOverflows++;
+        return;
+    }
+
+    eventQueue[eventQueueHead].port = channel_p->port;
+    eventQueue[eventQueueHead].pin = channel_p->pin;
+    eventQueue[eventQueueHead].pushState = pushState;
+    eventQueue[eventQueueHead].repeat = repeat;
+    eventQueue[eventQueueHead].timestamp = timestamp;
+    eventQueueHead = next;
+}
+
+/**
+ * Accepts a new debounced level for a channel, recording a tap for presses
+ * and queuing an event for Button_pollEvent().
+ */
+static void Button_acceptEdge(int channel, int pushState, uint32_t timestamp)
+{
+    EdgeChannel* channel_p = &edgeChannels[channel];
+    channel_p->debouncedState = pushState;
+    channel_p->lastAcceptTime = timestamp;
+
+    if (pushState == PRESSED) {
+        channel_p->pendingTaps++;
+        channel_p->lastPressTime = timestamp;
+    }
+
+    Button_queueEvent(channel_p, pushState, false, timestamp);
+}
+
+/**
+ * Debounces every queued raw edge. A level is accepted once it has been
+ * stable for DEBOUNCE_TIME_MS, measured between edge timestamps rather than
+ * between calls, so a whole press and release captured while the main loop
+ * was stalled still produces a tap. Leading-edge channels instead accept an
+ * edge at once, unless it falls inside the lockout after the previous change.
+ */
+static void Button_processEdges()
+{
+    while (edgeQueueTail != edgeQueueHead)
+    {
+        uint32_t tail = edgeQueueTail;
+        int channel = edgeQueue[tail].channel;
+        int pushState = edgeQueue[tail].pushState;
+        uint32_t timestamp = edgeQueue[tail].timestamp;
+
+        // Free the slot only after the entry has been completely read
+        edgeQueueTail = (tail + 1) & (BUTTON_EDGE_QUEUE_SIZE - 1);
+
+        EdgeChannel* channel_p = &edgeChannels[channel];
+        if (channel_p->leadingEdge)
+        {
+            if (pushState != channel_p->debouncedState &&
+                timestamp - channel_p->lastAcceptTime >= channel_p->lockoutCycles)
+            {
+                Button_acceptEdge(channel, pushState, timestamp);
+            }
+        }
+
+        // The previous level held until this edge. If it held long enough,
+        // it was a real change rather than a bounce.
+        else if (channel_p->rawState != channel_p->debouncedState &&
+                 timestamp - channel_p->rawTime >= DEBOUNCE_CYCLES)
+        {
+            Button_acceptEdge(channel, channel_p->rawState, channel_p->rawTime);
+        }
+
+        channel_p->rawState = pushState;
+        channel_p->rawTime = timestamp;
+    }
+
+    // Finally, accept any level which has been stable until now. For a
+    // leading-edge channel, that is a level which changed during the lockout
+    // and stayed changed once the lockout ended.
+    uint32_t now = (uint32_t) HWTimer_getCycles();
+    int i;
+
+    for (i = 0; i < numEdgeChannels; i++)
+    {
+        EdgeChannel* channel_p = &edgeChannels[i];
+        if (channel_p->rawState == channel_p->debouncedState) {
+            continue;
+        }
+
+        if (channel_p->leadingEdge)
+        {
+            if (now - channel_p->lastAcceptTime >= channel_p->lockoutCycles) {
+                Button_acceptEdge(i, channel_p->rawState, now);
+            }
+        }
+        else if (now - channel_p->rawTime >= DEBOUNCE_CYCLES) {
+            Button_acceptEdge(i, channel_p->rawState, channel_p->rawTime);
+        }
+    }
+}
+
+/**
+ * Retrieves the next debounced press or release of any edge-interrupt button,
+ * in the order they happened. Any raw edges queued by the ISRs are debounced
+ * first. This is the consumer side of the edge queue; [Button_isTapped()]
+ * reports the same presses, one per refresh, for code written against
+ * polled buttons.
+ *
+ * @param event_p:  Filled in with the event, if there is one
+ *
+ * @return true if an event was retrieved, and false if there were none
+ */
+bool Button_pollEvent(ButtonEvent* event_p)
+{
+    Button_processEdges();
+
+    if (eventQueueTail == eventQueueHead) {
+        return false;
+    }
+
+    *event_p = eventQueue[eventQueueTail];
+    eventQueueTail = (eventQueueTail + 1) & (BUTTON_EVENT_QUEUE_SIZE - 1);
+
+    return true;
+}
+
+/**
+ * Returns what has happened to raw edges so far. Overflows mean the main loop
+ * did not drain the edge queue quickly enough, and the queue should be made
+ * larger. Duplicates are harmless, and only show how often the level had
+ * already bounced back by the time the ISR read it. Event overflows mean
+ * Button_pollEvent() was not called often enough.
+ *
+ * @return a read-only pointer to the edge statistics
+ */
+const ButtonEdgeStats* Button_getEdgeStats()
+{
+    return (const ButtonEdgeStats*) &edgeStats;
+}
+
+/**
+ * Selects the debounce policy of a button. Tick- and DMA-sampled buttons are
+ * debounced by the shared PortDebouncer, which only integrates, so they keep
+ * their policy and this returns false.
+ *
+ * @param button_p:     The Button to configure
+ * @param policy:       DEBOUNCE_INTEGRATING or DEBOUNCE_LEADING_EDGE
+ * @param lockout_ms:   For leading-edge buttons, how long to ignore the input
+ *                      after each change; ignored for integrating buttons
+ *
+ * @return true if the policy was applied
+ */
+bool Button_setDebouncePolicy(Button* button_p, DebouncePolicy policy, uint32_t lockout_ms)
+{
+    if (button_p->mode == BUTTON_TICK_SAMPLED || button_p->mode == BUTTON_DMA_SAMPLED) {
+        return false;
+    }
+
+    button_p->policy = policy;
+
+    if (policy == DEBOUNCE_LEADING_EDGE) {
+        button_p->timer = SWTimer_construct(lockout_ms);
+    }
+    else {
+        button_p->timer = SWTimer_construct(DEBOUNCE_TIME_MS);
+    }
+    SWTimer_start(&button_p->timer);
+
+    // Both policies agree when the input is stable, so resume from a stable
+    // state matching the last output
+    button_p->debounceState = button_p->pushState == PRESSED ? StableP : StableR;
+
+    if (button_p->mode == BUTTON_EDGE_INTERRUPT)
+    {
+        EdgeChannel* channel_p = &edgeChannels[button_p->channel];
+
+        channel_p->leadingEdge = policy == DEBOUNCE_LEADING_EDGE;
+        channel_p->lockoutCycles = (SYSTEM_CLOCK / PRESCALER / MS_DIVISION_FACTOR) * lockout_ms;
+    }
+
+    return true;
+}
+
+/**
+ * Makes a held button report extra taps, like a held key on a keyboard. The
+ * first repeat comes delay_ms after the press and the rest every rate_ms
+ * until the button is released. Works with every button mode.
+ *
+ * @param button_p:     The Button to configure
+ * @param delay_ms:     The time from the press to the first repeat, or 0 to
+ *                      turn auto-repeat off
+ * @param rate_ms:      The time between later repeats
+ */
+void Button_setAutoRepeat(Button* button_p, uint32_t delay_ms, uint32_t rate_ms)
+{
+    button_p->autoRepeat = delay_ms != 0;
+    button_p->repeating = false;
+    button_p->repeatDelayTimer = SWTimer_construct(delay_ms);
+    button_p->repeatRateTimer = SWTimer_construct(rate_ms);
+
+    // A button held when auto-repeat is turned on, such as the press which
+    // turned it on, waits a whole delay before its first repeat
+    SWTimer_start(&button_p->repeatDelayTimer);
+}
+
 /**
  * A getter method which should just return whether the user currently has held
  * down the button. This should be determined using the pushState which was
@@ -76,21 +526,70 @@ bool Button_isTapped(Button* button_p)
 }
 
 /**
- * Refreshes the input of the provided Button by polling for the new GPIO input
- * pin value and advancing the debouncing FSM by one step.
- *
- * @param button_p:   The Button object to refresh
+ * Advances a leading-edge polled button. Outside the lockout, any change of
+ * the raw input is reported immediately and starts a new lockout. During the
+ * lockout, the input is ignored entirely.
  */
-void Button_refresh(Button* button_p)
+static int Button_leadingEdgeStep(Button* button_p, uint16_t rawButtonStatus)
+{
+    int pushState = button_p->pushState;
+
+    if (rawButtonStatus != pushState && SWTimer_expired(&button_p->timer))
+    {
+        pushState = rawButtonStatus;
+        SWTimer_start(&button_p->timer);
+    }
+
+    button_p->debounceState = pushState == PRESSED ? StableP : StableR;
+    return pushState;
+}
+
+/**
+ * Refreshes the debounced state of the provided Button, without auto-repeat.
+ */
+static void Button_refreshInput(Button* button_p)
 {
-    // Retrieve the port and pin targets
-    uint8_t port = button_p->port;
-    uint16_t pin = button_p->pin;
+    // Edge-interrupt buttons take their state from the debounced edge queue.
+    // Each refresh reports at most one tap, so taps which arrived together
+    // during a stall are reported on consecutive refreshes instead of merged.
+    if (button_p->mode == BUTTON_EDGE_INTERRUPT)
+    {
+        EdgeChannel* channel_p = &edgeChannels[button_p->channel];
+        Button_processEdges();
+
+        button_p->pushState = channel_p->debouncedState;
+        button_p->isTapped = channel_p->pendingTaps > 0;
+        if (button_p->isTapped) {
+            channel_p->pendingTaps--;
+        }
+        return;
+    }
 
-    // Poll for updated values from port and pin status through GPIO directly
-    uint16_t rawButtonStatus = GPIO_getInputPinValue(port, pin);
+    // Tick- and DMA-sampled buttons were already debounced by the
+    // PortDebouncer, so refreshing only reads out the result
+    if (button_p->mode == BUTTON_TICK_SAMPLED || button_p->mode == BUTTON_DMA_SAMPLED)
+    {
+        bool isPressed = PortDebouncer_getPressed(button_p->port) & button_p->pin;
+
+        button_p->pushState = isPressed ? PRESSED : RELEASED;
+        button_p->isTapped = PortDebouncer_consumeTapped(button_p->port, (uint8_t) button_p->pin) != 0;
+        return;
+    }
+
+    // Poll for updated values from port and pin status with a single load of
+    // the pin's bit-band alias
+    uint16_t rawButtonStatus = FastPin_read(&button_p->fastPin);
     int newPushState = RELEASED;
 
+    if (button_p->policy == DEBOUNCE_LEADING_EDGE)
+    {
+        newPushState = Button_leadingEdgeStep(button_p, rawButtonStatus);
+
+        button_p->isTapped = newPushState == PRESSED && button_p->pushState == RELEASED;
+        button_p->pushState = newPushState;
+        return;
+    }
+
     // Main debouncing FSM
     switch (button_p->debounceState)
     {
@@ -143,3 +642,57 @@ void Button_refresh(Button* button_p)
     button_p->isTapped = newPushState == PRESSED && button_p->pushState == RELEASED;
     button_p->pushState = newPushState;
 }
+
+/**
+ * Refreshes the input of the provided Button. Polled buttons poll for the new
+ * GPIO input pin value and advance the debouncing FSM by one step. If
+ * auto-repeat is on, a held button also reports a tap whenever a repeat is due.
+ *
+ * @param button_p:   The Button object to refresh
+ */
+void Button_refresh(Button* button_p)
+{
+    Button_refreshInput(button_p);
+
+    // Every real tap starts a latency trace. Only edge-interrupt buttons know
+    // when their raw edge happened; the rest are traced from now. The same
+    // timestamp feeds the entropy pool, with more credit for a raw edge.
+    if (button_p->isTapped)
+    {
+        uint32_t edgeTime = (uint32_t) HWTimer_getCycles();
+        uint8_t bits = ENTROPY_BITS_PER_TAP;
+        if (button_p->mode == BUTTON_EDGE_INTERRUPT) {
+            edgeTime = edgeChannels[button_p->channel].lastPressTime;
+            bits = ENTROPY_BITS_PER_EDGE;
+        }
+        LatencyTrace_markInput(edgeTime);
+        Entropy_addSample(edgeTime, bits);
+    }
+
+    if (!button_p->autoRepeat) {
+        return;
+    }
+
+    // A new press restarts the delay before the first repeat
+    if (button_p->isTapped) {
+        button_p->repeating = false;
+        SWTimer_start(&button_p->repeatDelayTimer);
+    }
+    else if (button_p->pushState == PRESSED)
+    {
+        SWTimer* due_p = button_p->repeating ? &button_p->repeatRateTimer
+                                             : &button_p->repeatDelayTimer;
+        if (SWTimer_expired(due_p)) {
+            uint32_t now = (uint32_t) HWTimer_getCycles();
+
+            button_p->isTapped = true;
+            button_p->repeating = true;
+            SWTimer_start(&button_p->repeatRateTimer);
+
+            LatencyTrace_markInput(now);
+            if (button_p->mode == BUTTON_EDGE_INTERRUPT) {
+                Button_queueEvent(&edgeChannels[button_p->channel], PRESSED, true, now);
+            }
+        }
+    }
+}
@@ -9,12 +9,26 @@
 #define HAL_BUTTON_H_
 
 #include <HAL/Timer.h>
+#include <HAL/PortDebouncer.h>
+#include <HAL/PortSampler.h>
+#include <HAL/LatencyTrace.h>
+#include <HAL/Entropy.h>
+#include <HAL/FastGPIO.h>
 #include <ti/devices/msp432p4xx/driverlib/driverlib.h>
 
 #define DEBOUNCE_TIME_MS    5
 #define PRESSED             0
 #define RELEASED            1
 
+// Interrupt-driven buttons. Both queue sizes MUST be powers of two.
+#define MAX_EDGE_BUTTONS            4   // Buttons which may use edge interrupts
+#define BUTTON_EDGE_QUEUE_SIZE      32  // Raw edges waiting to be debounced
+#define BUTTON_EVENT_QUEUE_SIZE     8   // Debounced events waiting for Button_pollEvent()
+#define NO_EDGE_CHANNEL             -1
+
+// Leading-edge buttons ignore every edge for this long after a change
+#define DEFAULT_LOCKOUT_TIME_MS     30
+
 /**
  * Predefined Button ports and pins for EACH BUTTON. Consult datasheets like
  * the Launchpad User Guide and the Boostepack User Guide to determine which
@@ -41,6 +55,58 @@
 enum _DebounceState { StableP, TransitionPR, TransitionRP, StableR };
 typedef enum _DebounceState DebounceState;
 
+/**
+ * How a button gets its input. Polled buttons sample their pin every time they
+ * are refreshed. Edge-interrupt buttons capture every edge in a port ISR, so
+ * taps are never lost while the main loop is busy. Tick-sampled buttons are
+ * debounced a whole port at a time by the PortDebouncer in the SysTick ISR.
+ * DMA-sampled buttons are debounced by the same PortDebouncer, but from port
+ * samples which the PortSampler's DMA channels collect without any ISR.
+ */
+enum _ButtonMode { BUTTON_POLLED, BUTTON_EDGE_INTERRUPT, BUTTON_TICK_SAMPLED, BUTTON_DMA_SAMPLED };
+typedef enum _ButtonMode ButtonMode;
+
+/**
+ * How a button turns a bouncy input into clean presses. An integrating button
+ * only accepts a level once it has been stable for DEBOUNCE_TIME_MS, so every
+ * press is reported that late. A leading-edge button accepts the very first
+ * edge and then ignores the input for a lockout time, so presses are reported
+ * immediately. The price is that a single glitch is reported as a press.
+ */
+enum _DebouncePolicy { DEBOUNCE_INTEGRATING, DEBOUNCE_LEADING_EDGE };
+typedef enum _DebouncePolicy DebouncePolicy;
+
+/**
+ * A debounced press or release of an edge-interrupt button, as returned by
+ * [Button_pollEvent()]. The timestamp is the low 32 bits of HWTimer_getCycles()
+ * at the raw edge which started the debounced change. The extra taps of a
+ * held auto-repeat button are presses with repeat set, timestamped when the
+ * repeat was reported.
+ */
+struct _ButtonEvent
+{
+    uint8_t port;       // The port of the button which changed
+    uint16_t pin;       // The pin  of the button which changed
+    int pushState;      // The new debounced state (PRESSED or RELEASED)
+    bool repeat;        // Reported by auto-repeat rather than by the pin
+    uint32_t timestamp;
+};
+typedef struct _ButtonEvent ButtonEvent;
+
+/**
+ * What has happened to the edges of every edge-interrupt button, as returned
+ * by [Button_getEdgeStats()]. The first three are only written by the port
+ * ISRs, and the last only by the main loop.
+ */
+struct _ButtonEdgeStats
+{
+    uint32_t queued;        // Edges queued for debouncing
+    uint32_t overflows;     // Edges dropped because the queue was full
+    uint32_t duplicates;    // Interrupts which found the level of the last queued edge
+    uint32_t eventOverflows; // Debounced events dropped because nobody polled them
+};
+typedef struct _ButtonEdgeStats ButtonEdgeStats;
+
 /**=============================================================================
  * A simple Button object, implemented in the C object-oriented style. Use the
  * constructor [Button_construct()] to create a Button object. Afterwards, when
@@ -72,13 +138,28 @@ struct _Button
 {
     uint8_t port;   // The port on the Launchpad to which this Button is mapped
     uint16_t pin;   // The pin  on the Launchpad to which this Button is mapped
+    FastPin fastPin; // Bit-band alias of the pin, for single-load reads
+
+    // Where the button gets its input, and for edge-interrupt buttons, which
+    // edge channel holds its debouncing state
+    ButtonMode mode;
+    int channel;
 
     // Keeps track of FSM progress in the Debouncing FSM
     DebounceState debounceState;
+    DebouncePolicy policy;
 
-    // The timer which is used to wait out a bouncy input
+    // The timer which is used to wait out a bouncy input. For leading-edge
+    // buttons, this times the lockout instead.
     SWTimer timer;
 
+    // Auto-repeat: while held, the button reports another tap after
+    // repeatDelayTimer and then every time repeatRateTimer expires
+    bool autoRepeat;
+    bool repeating;
+    SWTimer repeatDelayTimer;
+    SWTimer repeatRateTimer;
+
     // The outputs of the FSM.
     int pushState;  // The output of the debouncing FSM (PRESSED or RELEASED)
     bool isTapped;  // The output of the buttonpushed FSM (true or false).
@@ -88,6 +169,21 @@ typedef struct _Button Button;
 /** Constructs a new button object, given a valid port and pin. */
 Button Button_construct(uint8_t port, uint16_t pin);
 
+/** Constructs a new button whose edges are captured by port interrupts */
+Button Button_constructInterrupt(uint8_t port, uint16_t pin);
+
+/** Constructs a new button which is debounced by the SysTick port debouncer */
+Button Button_constructSampled(uint8_t port, uint16_t pin);
+
+/** Constructs a new button which is debounced from DMA-captured port samples */
+Button Button_constructDMASampled(uint8_t port, uint16_t pin);
+
+/** Selects how a polled or edge-interrupt button is debounced */
+bool Button_setDebouncePolicy(Button* button, DebouncePolicy policy, uint32_t lockout_ms);
+
+/** Makes a held button report repeated taps, or stops it with a delay of 0 */
+void Button_setAutoRepeat(Button* button, uint32_t delay_ms, uint32_t rate_ms);
+
 /** Given a button, determines if the switch is currently pushed down */
 bool Button_isPressed(Button* button);
 
@@ -97,4 +193,13 @@ bool Button_isTapped(Button* button);
 /** Refreshes this button so the Button FSM now has new outputs to interpret */
 void Button_refresh(Button* button);
 
+/** The shared body of every port ISR which has edge-interrupt buttons */
+void Button_handlePortInterrupt(uint8_t port);
+
+/** Retrieves the next debounced event from any edge-interrupt button */
+bool Button_pollEvent(ButtonEvent* event_p);
+
+/** Returns how many raw edges were queued, dropped and found to be duplicates */
+const ButtonEdgeStats* Button_getEdgeStats();
+
 #endif /* HAL_BUTTON_H_ */
@@ -0,0 +1,35 @@
+/*
+ * DMAControl.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <HAL/DMAControl.h>
+
+/** The shared DMA control table, aligned as the DMA controller requires. */
+#if defined(__TI_COMPILER_VERSION__)
+#pragma DATA_ALIGN(dmaControlTable, 1024)
+static DMA_ControlTable dmaControlTable[DMA_CONTROL_TABLE_ENTRIES];
+#elif defined(__GNUC__)
+static DMA_ControlTable dmaControlTable[DMA_CONTROL_TABLE_ENTRIES] __attribute__((aligned(1024)));
+#else
+static DMA_ControlTable dmaControlTable[DMA_CONTROL_TABLE_ENTRIES];
+#endif
+
+static bool dmaInitialized = false;
+
+/**
+ * Enables the DMA module and points it at the shared control table. Only the
+ * first call has any effect.
+ */
+void DMAControl_init()
+{
+    if (dmaInitialized) {
+        return;
+    }
+
+    DMA_enableModule();
+    DMA_setControlBase(dmaControlTable);
+
+    dmaInitialized = true;
+}
@@ -0,0 +1,31 @@
+/*
+ * DMAControl.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HAL_DMACONTROL_H_
+#define HAL_DMACONTROL_H_
+
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+// The MSP432 DMA has 8 channels, each with a primary and an alternate control
+// structure. The table must be aligned to its own (power of two) size.
+#define DMA_CONTROL_TABLE_ENTRIES   32
+
+/**
+ * The DMA controller has a single control table shared by every channel, so
+ * every module which uses DMA must call DMAControl_init() before configuring
+ * its channel, rather than enabling the DMA module itself.
+ *
+ * Channel assignments in this project:
+ *   CH0        - Telemetry (eUSCI_A0 TX trigger, DMA_INT0)
+ *   CH2 / CH3  - PortSampler (Timer_A1 CCR0 / CCR2 triggers, DMA_INT1 / DMA_INT2)
+ *   CH7        - Joystick (ADC14 trigger, DMA_INT3)
+ */
+
+// Enables the DMA module and installs the shared control table. Safe to call
+// more than once.
+void DMAControl_init();
+
+#endif /* HAL_DMACONTROL_H_ */
@@ -0,0 +1,76 @@
+/*
+ * Entropy.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <HAL/Entropy.h>
+
+/** The pool starts from arbitrary non-zero constants, so it is never all zero. */
+static volatile uint32_t pool[ENTROPY_POOL_WORDS] =
+{
+    0x243F6A88, 0x85A308D3, 0x13198A2E, 0x03707344
+};
+
+static volatile uint8_t poolIndex = 0;
+static volatile uint32_t poolBits = 0;
+static uint32_t readCounter = 0;
+
+/** Rotates a word left by k bits. */
+static uint32_t Entropy_rotl(uint32_t x, int k)
+{
+    return (x << k) | (x >> (32 - k));
+}
+
+/**
+ * Mixes one sample into the next word of the pool. The odd multiplier
+ * spreads each sample bit upwards through the word, and the rotation brings
+ * the high bits back down, so even a sample with a single noisy bit changes
+ * the whole word.
+ *
+ * @param sample:   The raw sample. Its predictable bits do no harm.
+ * @param bits:     The estimated number of unpredictable bits in the sample
+ */
+void Entropy_addSample(uint32_t sample, uint8_t bits)
+{
+    uint8_t i = poolIndex;
+    poolIndex = (i + 1) & (ENTROPY_POOL_WORDS - 1);
+
+    uint32_t word = pool[i] ^ sample;
+    pool[i] = Entropy_rotl(word * 0x9E3779B1, 13) ^ pool[(i + 1) & (ENTROPY_POOL_WORDS - 1)];
+
+    poolBits += bits;
+}
+
+/**
+ * Copies the pool out through a splitmix-style finalizer. A counter is mixed
+ * in, so two reads differ even if no sample arrived in between, and the raw
+ * pool words are never exposed.
+ *
+ * @param words:    Receives ENTROPY_POOL_WORDS words
+ */
+void Entropy_read(uint32_t words[ENTROPY_POOL_WORDS])
+{
+    int i;
+
+    readCounter++;
+
+    for (i = 0; i < ENTROPY_POOL_WORDS; i++)
+    {
+        uint32_t z = pool[i] + readCounter * 0x9E3779B9 + i;
+        z = (z ^ (z >> 16)) * 0x85EBCA6B;
+        z = (z ^ (z >> 13)) * 0xC2B2AE35;
+        words[i] = z ^ (z >> 16);
+    }
+}
+
+/**
+ * Returns the estimated number of bits of entropy added to the pool since
+ * reset. Compare this against the size of a seed before trusting the seed.
+ *
+ * @return the estimated number of bits
+ */
+uint32_t Entropy_getBits()
+{
+    return poolBits;
+}
@@ -0,0 +1,52 @@
+/*
+ * Entropy.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HAL_ENTROPY_H_
+#define HAL_ENTROPY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Number of 32-bit words in the pool. Must be a power of two.
+#define ENTROPY_POOL_WORDS      4
+
+// Conservative estimates of the unpredictable bits in each kind of sample
+#define ENTROPY_BITS_PER_ADC_BLOCK  4   // Folded LSBs of one block of joystick conversions
+#define ENTROPY_BITS_PER_EDGE       4   // Timer32 value at a button's raw GPIO edge
+#define ENTROPY_BITS_PER_TAP        1   // Timer32 value at a polled button's tap
+
+/**=============================================================================
+ * A global entropy pool. Noisy samples are mixed into the pool as they
+ * happen, wherever they happen - the pool is never waited on. The current
+ * sources are:
+ *
+ *   1. the least significant bits of every joystick ADC14 conversion, folded
+ *      together by the joystick's DMA ISR (see Joystick.c)
+ *   2. the 48 MHz Timer32 value at every button press, whose low bits depend
+ *      on the exact moment a human finger closes the switch (see Button.c)
+ *
+ * Samples are mixed in with a multiply-rotate step, so each sample affects
+ * every bit of its pool word. The pool is read by [Entropy_read()], usually
+ * to seed a Random generator.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * The pool is shared by ISRs and the main loop without masking. A sample
+ * added by an ISR in the middle of a main-loop update may be lost, which
+ * only costs that sample's entropy. The bit count is only an estimate, and
+ * a lower bound only if the per-source estimates above are.
+ */
+
+// Mixes one sample into the pool, crediting it with the given number of bits.
+void Entropy_addSample(uint32_t sample, uint8_t bits);
+
+// Copies the pool out, mixing a counter in so two reads never match.
+void Entropy_read(uint32_t words[ENTROPY_POOL_WORDS]);
+
+// Returns the estimated number of bits of entropy added so far.
+uint32_t Entropy_getBits();
+
+#endif /* HAL_ENTROPY_H_ */
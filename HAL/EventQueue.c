@@ -0,0 +1,252 @@
+/*
+ * EventQueue.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <HAL/EventQueue.h>
+
+/** Converts a time in milliseconds to hardware timer cycles. */
+static uint64_t EventQueue_msToCycles(uint32_t time_ms)
+{
+    uint32_t cyclesPerMillisecond = (SYSTEM_CLOCK / PRESCALER) / MS_DIVISION_FACTOR;
+    return (uint64_t) cyclesPerMillisecond * time_ms;
+}
+
+/**
+ * Constructs an empty event queue.
+ *
+ * @return an EventQueue with no events and no alarms
+ */
+EventQueue EventQueue_construct()
+{
+    EventQueue queue;
+    int i;
+
+    queue.head = 0;
+    queue.tail = 0;
+
+    for (i = 0; i < EVENT_QUEUE_MAX_ALARMS; i++) {
+        queue.alarms[i].armed = false;
+    }
+
+    queue.dropped = 0;
+    queue.maxDepth = 0;
+    queue.windowEvents = 0;
+    queue.windowStart = HWTimer_getCycles();
+    queue.eventsPerSecond = 0;
+
+    return queue;
+}
+
+/**
+ * Starts the first rate window. The end of every window is a deadline which
+ * the host simulator tracks by its address, so this must be called on the
+ * queue the application keeps, not on the copy EventQueue_construct()
+ * returned.
+ *
+ * @param queue_p:  The queue to start
+ */
+void EventQueue_start(EventQueue* queue_p)
+{
+    queue_p->windowEvents = 0;
+    queue_p->windowStart = HWTimer_getCycles();
+
+    HWTimer_noteDeadline(&queue_p->windowStart,
+                         queue_p->windowStart + EventQueue_msToCycles(EVENT_QUEUE_RATE_WINDOW_MS), 0);
+}
+
+/**
+ * Adds an event at the back of the queue. Interrupts are masked for the few
+ * instructions which claim the slot, so ISRs and the main loop may all post
+ * to the same queue.
+ *
+ * @param queue_p:  The queue to post to
+ * @param event:    The event
+ * @return true if the event was queued, false if the queue was full
+ */
+bool EventQueue_post(EventQueue* queue_p, uint8_t event)
+{
+    bool wasDisabled = Interrupt_disableMaster();
+    bool queued = false;
+
+    uint8_t depth = (uint8_t) (queue_p->tail - queue_p->head);
+
+    if (depth < EVENT_QUEUE_SIZE)
+    {
+        queue_p->events[queue_p->tail & (EVENT_QUEUE_SIZE - 1)] = event;
+        queue_p->tail++;
+        queued = true;
+
+        if (depth + 1 > queue_p->maxDepth) {
+            queue_p->maxDepth = depth + 1;
+        }
+    }
+    else {
+        queue_p->dropped++;
+    }
+
+    if (!wasDisabled) {
+        Interrupt_enableMaster();
+    }
+
+    return queued;
+}
+
+/**
+ * Takes the oldest event out of the queue. Only the main loop takes events
+ * out, so no masking is needed: head is only written here, and an ISR which
+ * posts meanwhile only moves tail.
+ *
+ * @param queue_p:  The queue to read from
+ * @param event_p:  Receives the event
+ * @return true if an event was taken out, false if the queue was empty
+ */
+bool EventQueue_get(EventQueue* queue_p, uint8_t* event_p)
+{
+    if (queue_p->head == queue_p->tail) {
+        return false;
+    }
+
+    *event_p = queue_p->events[queue_p->head & (EVENT_QUEUE_SIZE - 1)];
+    queue_p->head++;
+    queue_p->windowEvents++;
+
+    return true;
+}
+
+/**
+ * Returns whether there is no event waiting.
+ *
+ * @param queue_p:  The queue to query
+ * @return true if the queue is empty
+ */
+bool EventQueue_isEmpty(EventQueue* queue_p)
+{
+    return queue_p->head == queue_p->tail;
+}
+
+/**
+ * Arms a one-shot alarm. An event has at most one alarm, so setting the alarm
+ * of an event which already has one restarts it.
+ *
+ * @param queue_p:  The queue the event will be posted to
+ * @param event:    The event to post
+ * @param delay_ms: How long from now to post it
+ */
+void EventQueue_setAlarm(EventQueue* queue_p, uint8_t event, uint32_t delay_ms)
+{
+    EventAlarm* free_p = NULL;
+    int i;
+
+    for (i = 0; i < EVENT_QUEUE_MAX_ALARMS; i++)
+    {
+        EventAlarm* alarm_p = &queue_p->alarms[i];
+
+        if (alarm_p->armed && alarm_p->event == event) {
+            free_p = alarm_p;
+            break;
+        }
+
+        if (!alarm_p->armed && free_p == NULL) {
+            free_p = alarm_p;
+        }
+    }
+
+    if (free_p == NULL) {
+        return;
+    }
+
+    free_p->event = event;
+    free_p->dueTime = HWTimer_getCycles() + EventQueue_msToCycles(delay_ms);
+    free_p->armed = true;
+
+    HWTimer_noteDeadline(free_p, free_p->dueTime, 0);
+}
+
+/**
+ * Cancels the alarm of an event, so that it is never posted.
+ *
+ * @param queue_p:  The queue which holds the alarm
+ * @param event:    The event whose alarm to cancel
+ */
+void EventQueue_cancelAlarm(EventQueue* queue_p, uint8_t event)
+{
+    int i;
+
+    for (i = 0; i < EVENT_QUEUE_MAX_ALARMS; i++)
+    {
+        if (queue_p->alarms[i].event == event) {
+            queue_p->alarms[i].armed = false;
+        }
+    }
+}
+
+/**
+ * Posts the event of every alarm which has come due, and closes the event
+ * rate window once it is EVENT_QUEUE_RATE_WINDOW_MS long. Costs one timer
+ * read and a comparison per alarm.
+ *
+ * @param queue_p:  The queue to refresh
+ */
+void EventQueue_refresh(EventQueue* queue_p)
+{
+    uint64_t now = HWTimer_getCycles();
+    int i;
+
+    for (i = 0; i < EVENT_QUEUE_MAX_ALARMS; i++)
+    {
+        EventAlarm* alarm_p = &queue_p->alarms[i];
+
+        if (alarm_p->armed && now >= alarm_p->dueTime) {
+            alarm_p->armed = false;
+            EventQueue_post(queue_p, alarm_p->event);
+        }
+    }
+
+    uint64_t window = EventQueue_msToCycles(EVENT_QUEUE_RATE_WINDOW_MS);
+    if (now - queue_p->windowStart >= window)
+    {
+        queue_p->eventsPerSecond = (uint32_t) ((uint64_t) queue_p->windowEvents * MS_DIVISION_FACTOR
+                                               / EVENT_QUEUE_RATE_WINDOW_MS);
+        queue_p->windowEvents = 0;
+        queue_p->windowStart = now;
+
+        HWTimer_noteDeadline(&queue_p->windowStart, now + window, 0);
+    }
+}
+
+/**
+ * Returns the rate at which events were taken out of the queue, measured over
+ * the last complete window. An idle application handles 0 events per second.
+ *
+ * @param queue_p:  The queue to query
+ * @return the number of events per second
+ */
+uint32_t EventQueue_getEventsPerSecond(EventQueue* queue_p)
+{
+    return queue_p->eventsPerSecond;
+}
+
+/**
+ * Returns the number of events dropped because the queue was full.
+ *
+ * @param queue_p:  The queue to query
+ * @return the number of dropped events
+ */
+uint32_t EventQueue_getDropped(EventQueue* queue_p)
+{
+    return queue_p->dropped;
+}
+
+/**
+ * Returns the largest number of events which were ever waiting at once. A
+ * value close to EVENT_QUEUE_SIZE means the queue should be made larger.
+ *
+ * @param queue_p:  The queue to query
+ * @return the high-water mark of the queue
+ */
+uint8_t EventQueue_getMaxDepth(EventQueue* queue_p)
+{
+    return queue_p->maxDepth;
+}
@@ -0,0 +1,104 @@
+/*
+ * EventQueue.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HAL_EVENTQUEUE_H_
+#define HAL_EVENTQUEUE_H_
+
+#include <HAL/Timer.h>
+
+// Capacity of the queue. Must be a power of two.
+#define EVENT_QUEUE_SIZE            16
+
+// Number of alarms which may be pending at once
+#define EVENT_QUEUE_MAX_ALARMS      4
+
+// The window over which the event rate is measured
+#define EVENT_QUEUE_RATE_WINDOW_MS  1000
+
+/**
+ * A one-shot alarm, which posts its event once its due time has passed.
+ */
+struct _EventAlarm
+{
+    uint8_t event;
+    bool armed;
+    uint64_t dueTime;           // In hardware timer cycles
+};
+typedef struct _EventAlarm EventAlarm;
+
+/**=============================================================================
+ * A FIFO of application events, implemented in the C object-oriented style.
+ * Producers [EventQueue_post()] events as they happen, and the consumer takes
+ * them out one at a time with [EventQueue_get()], so the application only
+ * runs when there is something to react to. An event is a small number whose
+ * meaning is up to the application.
+ *
+ * The queue also holds one-shot alarms, which replace polling a software
+ * timer: [EventQueue_setAlarm()] posts an event after a delay. Alarms are
+ * checked, and the event rate measured, by [EventQueue_refresh()], which
+ * must be called regularly, after [EventQueue_start()] has been called on
+ * the queue the application keeps.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * EventQueue_post() may be called from ISRs; everything else must be called
+ * from the main loop only. When the queue is full, new events are dropped
+ * and counted.
+ *
+ * When using this object, DO NOT DIRECTLY ACCESS ANY MEMBER VARIABLES of the
+ * EventQueue struct.
+ */
+struct _EventQueue
+{
+    volatile uint8_t events[EVENT_QUEUE_SIZE];
+    volatile uint8_t head;      // Index of the next event to take out
+    volatile uint8_t tail;      // Index of the next free slot
+
+    EventAlarm alarms[EVENT_QUEUE_MAX_ALARMS];
+
+    // Statistics
+    volatile uint32_t dropped;
+    uint8_t maxDepth;
+    uint32_t windowEvents;      // Events taken out in the current rate window
+    uint64_t windowStart;
+    uint32_t eventsPerSecond;   // Rate over the last complete window
+};
+typedef struct _EventQueue EventQueue;
+
+// Constructs an empty event queue with no alarms.
+EventQueue EventQueue_construct();
+
+// Starts the first rate window, once the queue is in its final place.
+void EventQueue_start(EventQueue* queue_p);
+
+// Adds an event at the back of the queue. Returns false if it was dropped.
+bool EventQueue_post(EventQueue* queue_p, uint8_t event);
+
+// Takes the oldest event out of the queue. Returns false if it was empty.
+bool EventQueue_get(EventQueue* queue_p, uint8_t* event_p);
+
+// Returns whether there is no event waiting.
+bool EventQueue_isEmpty(EventQueue* queue_p);
+
+// Posts event once delay_ms has passed, replacing any alarm for the same event.
+void EventQueue_setAlarm(EventQueue* queue_p, uint8_t event, uint32_t delay_ms);
+
+// Cancels the pending alarm for an event, if any.
+void EventQueue_cancelAlarm(EventQueue* queue_p, uint8_t event);
+
+// Posts the events of due alarms and updates the event rate.
+void EventQueue_refresh(EventQueue* queue_p);
+
+// Returns the number of events taken out during the last rate window.
+uint32_t EventQueue_getEventsPerSecond(EventQueue* queue_p);
+
+// Returns the number of events dropped because the queue was full.
+uint32_t EventQueue_getDropped(EventQueue* queue_p);
+
+// Returns the largest number of events ever waiting at once.
+uint8_t EventQueue_getMaxDepth(EventQueue* queue_p);
+
+#endif /* HAL_EVENTQUEUE_H_ */
@@ -0,0 +1,134 @@
+/*
+ * FSM.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <HAL/FSM.h>
+
+/** Runs a hook or an action, if there is one. */
+static void FSM_run(FSMAction action, void* context)
+{
+    if (action != NULL) {
+        action(context);
+    }
+}
+
+/**
+ * Constructs an FSM. No hook runs until FSM_start() is called, so that the
+ * context may still be moved into place in between.
+ *
+ * @param table_p:      The const description of the machine
+ * @param initialState: The state the machine starts in
+ * @param context:      The argument passed to every guard, action and hook
+ * @return an FSM in its initial state
+ */
+FSM FSM_construct(const FSMTable* table_p, uint8_t initialState, void* context)
+{
+    FSM fsm;
+
+    fsm.table_p = table_p;
+    fsm.context = context;
+    fsm.state = initialState;
+
+    fsm.eventsDispatched = 0;
+    fsm.eventsIgnored = 0;
+
+    return fsm;
+}
+
+/**
+ * Enters the initial state by running its on-enter hook.
+ *
+ * @param fsm_p:    The FSM to start
+ */
+void FSM_start(FSM* fsm_p)
+{
+    const FSMTable* table_p = fsm_p->table_p;
+
+    if (table_p->hooks != NULL) {
+        FSM_run(table_p->hooks[fsm_p->state].onEnter, fsm_p->context);
+    }
+}
+
+/**
+ * Delivers one event to the FSM. The first row of the table matching the
+ * current state and the event, and whose guard passes, is taken: the on-exit
+ * hook of the old state, the action of the row, then the on-enter hook of the
+ * new state run in that order. Internal transitions only run the action.
+ *
+ * @param fsm_p:    The FSM to deliver the event to
+ * @param event:    The event
+ * @return true if a transition was taken, false if the event was ignored
+ */
+bool FSM_dispatch(FSM* fsm_p, uint8_t event)
+{
+    const FSMTable* table_p = fsm_p->table_p;
+    int i;
+
+    fsm_p->eventsDispatched++;
+
+    for (i = 0; i < table_p->numTransitions; i++)
+    {
+        const FSMTransition* row_p = &table_p->transitions[i];
+
+        if (row_p->state != fsm_p->state || row_p->event != event) {
+            continue;
+        }
+
+        if (row_p->guard != NULL && !row_p->guard(fsm_p->context)) {
+            continue;
+        }
+
+        bool external = row_p->next != fsm_p->state;
+
+        if (external && table_p->hooks != NULL) {
+            FSM_run(table_p->hooks[fsm_p->state].onExit, fsm_p->context);
+        }
+
+        FSM_run(row_p->action, fsm_p->context);
+        fsm_p->state = row_p->next;
+
+        if (external && table_p->hooks != NULL) {
+            FSM_run(table_p->hooks[fsm_p->state].onEnter, fsm_p->context);
+        }
+
+        return true;
+    }
+
+    fsm_p->eventsIgnored++;
+    return false;
+}
+
+/**
+ * Returns the current state of the FSM.
+ *
+ * @param fsm_p:    The FSM to query
+ * @return the current state
+ */
+uint8_t FSM_getState(FSM* fsm_p)
+{
+    return fsm_p->state;
+}
+
+/**
+ * Returns the number of events delivered since the FSM was constructed.
+ *
+ * @param fsm_p:    The FSM to query
+ * @return the number of FSM_dispatch() calls
+ */
+uint32_t FSM_getEventsDispatched(FSM* fsm_p)
+{
+    return fsm_p->eventsDispatched;
+}
+
+/**
+ * Returns the number of delivered events which matched no transition.
+ *
+ * @param fsm_p:    The FSM to query
+ * @return the number of ignored events
+ */
+uint32_t FSM_getEventsIgnored(FSM* fsm_p)
+{
+    return fsm_p->eventsIgnored;
+}
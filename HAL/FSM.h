@@ -0,0 +1,110 @@
+/*
+ * FSM.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HAL_FSM_H_
+#define HAL_FSM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// A guard decides whether a transition may be taken. A NULL guard always passes.
+typedef bool (*FSMGuard)(void* context);
+
+// An action, or an on-enter/on-exit hook. NULL means nothing to do.
+typedef void (*FSMAction)(void* context);
+
+/**
+ * One row of a transition table: in state, on event, if guard passes, run
+ * action and move to next. A transition whose next state is its own state is
+ * internal: it runs its action without leaving and re-entering the state.
+ */
+struct _FSMTransition
+{
+    uint8_t state;
+    uint8_t event;
+    FSMGuard guard;
+    FSMAction action;
+    uint8_t next;
+};
+typedef struct _FSMTransition FSMTransition;
+
+/**
+ * The hooks of one state. onEnter runs every time the state is entered, after
+ * the action of the transition into it; onExit runs before that action.
+ */
+struct _FSMStateHooks
+{
+    FSMAction onEnter;
+    FSMAction onExit;
+};
+typedef struct _FSMStateHooks FSMStateHooks;
+
+/**
+ * A whole machine description, meant to be declared const so that it lives in
+ * flash. hooks is indexed by state and may be NULL.
+ */
+struct _FSMTable
+{
+    const FSMTransition* transitions;
+    uint8_t numTransitions;
+
+    const FSMStateHooks* hooks;
+    uint8_t numStates;
+};
+typedef struct _FSMTable FSMTable;
+
+/**=============================================================================
+ * A table-driven finite state machine, implemented in the C object-oriented
+ * style. The behavior of the machine is entirely described by a const
+ * [FSMTable]; the FSM object only holds the current state. Use the
+ * constructor [FSM_construct()], enter the initial state with [FSM_start()],
+ * then feed it events with [FSM_dispatch()].
+ *
+ * On each event, the rows of the table are searched in order, and the first
+ * row for the current state and event whose guard passes is taken. Rows with
+ * guards should therefore come before the guard-less row for the same state
+ * and event, which then acts as the "else". An event with no matching row is
+ * ignored.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * Actions and hooks must not dispatch events themselves. The context pointer
+ * is stored, so the object it points to must outlive the FSM.
+ *
+ * When using this object, DO NOT DIRECTLY ACCESS ANY MEMBER VARIABLES of the
+ * FSM struct.
+ */
+struct _FSM
+{
+    const FSMTable* table_p;
+    void* context;
+
+    uint8_t state;
+
+    // Statistics
+    uint32_t eventsDispatched;
+    uint32_t eventsIgnored;     // Events which matched no row
+};
+typedef struct _FSM FSM;
+
+// Constructs an FSM in its initial state without running any hook.
+FSM FSM_construct(const FSMTable* table_p, uint8_t initialState, void* context);
+
+// Runs the on-enter hook of the initial state.
+void FSM_start(FSM* fsm_p);
+
+// Delivers one event. Returns whether a transition was taken.
+bool FSM_dispatch(FSM* fsm_p, uint8_t event);
+
+// Returns the current state.
+uint8_t FSM_getState(FSM* fsm_p);
+
+// Returns the number of events delivered, and how many of them were ignored.
+uint32_t FSM_getEventsDispatched(FSM* fsm_p);
+uint32_t FSM_getEventsIgnored(FSM* fsm_p);
+
+#endif /* HAL_FSM_H_ */
@@ -0,0 +1,67 @@
+/*
+ * FastGPIO.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <HAL/FastGPIO.h>
+#include <HAL/Profiler.h>
+
+// Number of set/clear pairs timed through each path by FastGPIO_benchmark()
+#define FAST_GPIO_BENCHMARK_ITERATIONS  32
+
+/**
+ * Computes the bit-band aliases of a pin's OUT and IN bits. Use this for pins
+ * which are only known at run time, such as the pin of an LED object.
+ *
+ * @param port:     The GPIO port of the pin, from P1 to P10
+ * @param pin:      The GPIO pin, with exactly one bit set
+ * @return a FastPin for the pin
+ */
+FastPin FastPin_construct(uint8_t port, uint16_t pin)
+{
+    FastPin fastPin;
+
+#if defined(__MSP432P401R__)
+    int bit = 31 - __CLZ(pin);
+
+    fastPin.outAlias = &FAST_GPIO_ALIAS(FAST_GPIO_OUT_ADDR(port), bit);
+    fastPin.inAlias = &FAST_GPIO_ALIAS(FAST_GPIO_IN_ADDR(port), bit);
+#else
+    fastPin.port = port;
+    fastPin.pin = pin;
+#endif
+
+    return fastPin;
+}
+
+/**
+ * Times FAST_GPIO_BENCHMARK_ITERATIONS set/clear pairs on an output pin,
+ * first through the driverlib functions and then through a FastPin. Read the
+ * results with Profiler_getStats(); the minimum of each probe, less that of
+ * PROF_OVERHEAD, is the cost of one pair. The pin is left low.
+ *
+ * @param port:     The GPIO port of an output pin which may safely flicker
+ * @param pin:      The GPIO pin
+ */
+void FastGPIO_benchmark(uint8_t port, uint16_t pin)
+{
+    FastPin fastPin = FastPin_construct(port, pin);
+    int i;
+
+    for (i = 0; i < FAST_GPIO_BENCHMARK_ITERATIONS; i++)
+    {
+        PROF_BEGIN(PROF_GPIO_DRIVERLIB);
+        GPIO_setOutputHighOnPin(port, pin);
+        GPIO_setOutputLowOnPin(port, pin);
+        PROF_END(PROF_GPIO_DRIVERLIB);
+    }
+
+    for (i = 0; i < FAST_GPIO_BENCHMARK_ITERATIONS; i++)
+    {
+        PROF_BEGIN(PROF_GPIO_FAST);
+        FastPin_set(&fastPin);
+        FastPin_clear(&fastPin);
+        PROF_END(PROF_GPIO_FAST);
+    }
+}
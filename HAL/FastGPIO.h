@@ -0,0 +1,117 @@
+/*
+ * FastGPIO.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HAL_FASTGPIO_H_
+#define HAL_FASTGPIO_H_
+
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/**=============================================================================
+ * Single-instruction GPIO through the Cortex-M4 bit-band region. Every bit of
+ * the peripheral region has its own 32-bit alias word: storing 0 or 1 to the
+ * alias clears or sets just that bit, and loading the alias reads just that
+ * bit. The bus performs the read-modify-write itself, so a store is atomic
+ * against ISRs touching other pins of the same port.
+ *
+ * Two ways to use it:
+ *
+ *   1. With a constant port and pin, the FAST_GPIO_*() macros fold into a
+ *      constant alias address, so each one compiles to a single load or store:
+ *
+ *          FAST_GPIO_SET(LCD_DC_PORT, LCD_DC_PIN);
+ *
+ *   2. With a port and pin only known at run time, FastPin_construct()
+ *      computes both alias addresses once, and the FastPin_*() macros then
+ *      cost one load or store through a stored pointer.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * Only ports P1 through P10 are supported, and pin must have exactly one bit
+ * set. Host builds have no bit-band region, so both forms fall back to the
+ * driverlib GPIO functions there.
+ */
+
+// Base address of the port registers and of the peripheral bit-band aliases
+#define FAST_GPIO_PORT_BASE         0x40004C00
+#define FAST_GPIO_PERIPH_BASE       0x40000000
+#define FAST_GPIO_BITBAND_BASE      0x42000000
+
+// Ports come in pairs 0x20 bytes apart; the even port of a pair sits one byte
+// above the odd one. OUT is two bytes above IN.
+#define FAST_GPIO_IN_ADDR(port)     (FAST_GPIO_PORT_BASE + (((port) - 1) >> 1) * 0x20 + (((port) - 1) & 1))
+#define FAST_GPIO_OUT_ADDR(port)    (FAST_GPIO_IN_ADDR(port) + 2)
+
+// The bit number of a single-bit pin mask, folded at compile time
+#define FAST_GPIO_BIT(pin)                                              \
+    (((pin) & 0x0F) ? (((pin) & 0x03) ? (((pin) & 0x01) ? 0 : 1)        \
+                                      : (((pin) & 0x04) ? 2 : 3))       \
+                    : (((pin) & 0x30) ? (((pin) & 0x10) ? 4 : 5)        \
+                                      : (((pin) & 0x40) ? 6 : 7)))
+
+// The bit-band alias word of one bit of a peripheral register
+#define FAST_GPIO_ALIAS(addr, bit)                                      \
+    (*(volatile uint32_t*) (FAST_GPIO_BITBAND_BASE + ((addr) - FAST_GPIO_PERIPH_BASE) * 32 + (bit) * 4))
+
+#if defined(__MSP432P401R__)
+
+#define FAST_GPIO_SET(port, pin)    (FAST_GPIO_ALIAS(FAST_GPIO_OUT_ADDR(port), FAST_GPIO_BIT(pin)) = 1)
+#define FAST_GPIO_CLEAR(port, pin)  (FAST_GPIO_ALIAS(FAST_GPIO_OUT_ADDR(port), FAST_GPIO_BIT(pin)) = 0)
+#define FAST_GPIO_WRITE(port, pin, value) \
+                                    (FAST_GPIO_ALIAS(FAST_GPIO_OUT_ADDR(port), FAST_GPIO_BIT(pin)) = (value))
+#define FAST_GPIO_READ(port, pin)   (FAST_GPIO_ALIAS(FAST_GPIO_IN_ADDR(port), FAST_GPIO_BIT(pin)))
+
+#else
+
+#define FAST_GPIO_SET(port, pin)    GPIO_setOutputHighOnPin(port, pin)
+#define FAST_GPIO_CLEAR(port, pin)  GPIO_setOutputLowOnPin(port, pin)
+#define FAST_GPIO_WRITE(port, pin, value) \
+                                    ((value) ? GPIO_setOutputHighOnPin(port, pin) : GPIO_setOutputLowOnPin(port, pin))
+#define FAST_GPIO_READ(port, pin)   GPIO_getInputPinValue(port, pin)
+
+#endif
+
+/**
+ * A pin whose bit-band aliases have been computed ahead of time. The aliases
+ * are absolute addresses, so a FastPin may be copied freely.
+ */
+struct _FastPin
+{
+#if defined(__MSP432P401R__)
+    volatile uint32_t* outAlias;
+    volatile uint32_t* inAlias;
+#else
+    uint8_t port;
+    uint16_t pin;
+#endif
+};
+typedef struct _FastPin FastPin;
+
+#if defined(__MSP432P401R__)
+
+#define FastPin_set(fastPin_p)              (*(fastPin_p)->outAlias = 1)
+#define FastPin_clear(fastPin_p)            (*(fastPin_p)->outAlias = 0)
+#define FastPin_write(fastPin_p, value)     (*(fastPin_p)->outAlias = (value))
+#define FastPin_toggle(fastPin_p)           (*(fastPin_p)->outAlias ^= 1)
+#define FastPin_read(fastPin_p)             (*(fastPin_p)->inAlias)
+
+#else
+
+#define FastPin_set(fastPin_p)              GPIO_setOutputHighOnPin((fastPin_p)->port, (fastPin_p)->pin)
+#define FastPin_clear(fastPin_p)            GPIO_setOutputLowOnPin((fastPin_p)->port, (fastPin_p)->pin)
+#define FastPin_write(fastPin_p, value)     ((value) ? FastPin_set(fastPin_p) : FastPin_clear(fastPin_p))
+#define FastPin_toggle(fastPin_p)           GPIO_toggleOutputOnPin((fastPin_p)->port, (fastPin_p)->pin)
+#define FastPin_read(fastPin_p)             GPIO_getInputPinValue((fastPin_p)->port, (fastPin_p)->pin)
+
+#endif
+
+// Computes the bit-band aliases of a pin. Does not configure the pin.
+FastPin FastPin_construct(uint8_t port, uint16_t pin);
+
+// Times set/clear pairs on an output pin through driverlib and through its
+// bit-band alias, recording them under PROF_GPIO_DRIVERLIB and PROF_GPIO_FAST.
+void FastGPIO_benchmark(uint8_t port, uint16_t pin);
+
+#endif /* HAL_FASTGPIO_H_ */
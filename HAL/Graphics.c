@@ -6,6 +6,8 @@
  */
 
 #include <HAL/Graphics.h>
+#include <HAL/Profiler.h>
+#include <HAL/LcdDriver/HAL_MSP_EXP432P401R_Crystalfontz128x128_ST7735.h>
 
 GFX GFX_construct(uint32_t defaultForeground, uint32_t defaultBackground)
 {
@@ -39,15 +41,63 @@ void GFX_resetColors(GFX* gfx_p)
 
 void GFX_clear(GFX* gfx_p)
 {
+    PROF_BEGIN(PROF_GFX_CLEAR);
     Graphics_clearDisplay(&gfx_p->context);
+    PROF_END(PROF_GFX_CLEAR);
 }
 
 void GFX_print(GFX* gfx_p, char* string, int row, int col)
 {
+    PROF_BEGIN(PROF_GFX_PRINT);
+
     int yPosition = row * Graphics_getFontHeight(gfx_p->context.font);
     int xPosition = col * Graphics_getFontMaxWidth(gfx_p->context.font);
 
     Graphics_drawString(&gfx_p->context, (int8_t*) string, -1, xPosition, yPosition, OPAQUE_TEXT);
+
+    PROF_END(PROF_GFX_PRINT);
+}
+
+// Streams a compressed frame into the panel. The whole frame is one drawing
+// window, so after the window is set the bytes go out back to back, with no
+// per-glyph or per-line addressing.
+void GFX_showFrame(GFX* gfx_p, const GFXFrame* frame_p)
+{
+    PROF_BEGIN(PROF_SHOW_FRAME);
+
+    const uint8_t* data = frame_p->data;
+    const uint8_t* end = data + frame_p->size;
+
+    Crystalfontz128x128_SetDrawFrame(frame_p->x, frame_p->y,
+                                     frame_p->x + frame_p->width - 1, frame_p->y + frame_p->height - 1);
+    HAL_LCD_writeCommand(CM_RAMWR);
+
+    while (data < end)
+    {
+        uint8_t header = *data++;
+        int count = (header & (GFX_FRAME_RUN - 1)) + 1;
+
+        if (header & GFX_FRAME_RUN)
+        {
+            uint8_t high = data[0];
+            uint8_t low = data[1];
+            data += 2;
+
+            while (count--) {
+                HAL_LCD_writeData(high);
+                HAL_LCD_writeData(low);
+            }
+        }
+        else
+        {
+            count *= 2;
+            while (count--) {
+                HAL_LCD_writeData(*data++);
+            }
+        }
+    }
+
+    PROF_END(PROF_SHOW_FRAME);
 }
 
 void GFX_setForeground(GFX* gfx_p, uint32_t foreground)
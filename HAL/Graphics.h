@@ -25,6 +25,29 @@ struct _GFX
 };
 typedef struct _GFX GFX;
 
+/**
+ * A pre-rendered picture, stored in flash as RLE-compressed RGB565 pixels in
+ * the byte order of the panel. Frames are generated on the host by
+ * tools/mkframes.py. The stream is a sequence of packets, each starting with
+ * a header byte h:
+ *
+ *   h & 0x80:  a run of (h & 0x7F) + 1 pixels of the 2-byte color which follows
+ *   otherwise: h + 1 literal pixels, 2 bytes each, follow
+ */
+struct _GFXFrame
+{
+    uint8_t x;
+    uint8_t y;
+    uint8_t width;
+    uint8_t height;
+    uint32_t size;          // Bytes of compressed data
+    const uint8_t* data;
+};
+typedef struct _GFXFrame GFXFrame;
+
+#define GFX_FRAME_RUN       0x80
+#define GFX_FRAME_MAX_RUN   128
+
 GFX GFX_construct(uint32_t defaultForeground, uint32_t defaultBackground);
 
 void GFX_resetColors(GFX* gfx_p);
@@ -34,6 +57,8 @@ void GFX_print(GFX* gfx_p, char* string, int row, int col);
 void GFX_setForeground(GFX* gfx_p, uint32_t foreground);
 void GFX_setBackground(GFX* gfx_p, uint32_t background);
 
+void GFX_showFrame(GFX* gfx_p, const GFXFrame* frame_p);
+
 void GFX_drawSolidCircle(GFX* gfx_p, int x, int y, int radius);
 void GFX_drawHollowCircle(GFX* gfx_p, int x, int y, int radius);
 
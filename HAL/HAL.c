@@ -6,6 +6,7 @@
  */
 
 #include <HAL/HAL.h>
+#include <HAL/Profiler.h>
 
 /**
  * Constructs a new HAL object. The HAL constructor should simply call the constructors of each
@@ -19,13 +20,45 @@ HAL HAL_construct()
     HAL hal;
 
     // Initialize all LEDs by calling their constructors with correctly-defined arguments.
+    hal.launchpadLED1    = LED_construct(LAUNCHPAD_LED1_PORT       , LAUNCHPAD_LED1_PIN       );
     hal.boosterpackRed   = LED_construct(BOOSTERPACK_LED_RED_PORT  , BOOSTERPACK_LED_RED_PIN  );
     hal.boosterpackGreen = LED_construct(BOOSTERPACK_LED_GREEN_PORT, BOOSTERPACK_LED_GREEN_PIN);
     hal.boosterpackBlue  = LED_construct(BOOSTERPACK_LED_BLUE_PORT , BOOSTERPACK_LED_BLUE_PIN );
 
+    // Group the Boosterpack LEDs so that a whole color is shown with one write per port. The
+    // order of the calls must match the BOOSTERPACK_LED_*_BIT definitions.
+    hal.boosterpackLEDs = LEDGroup_construct();
+    LEDGroup_addLED(&hal.boosterpackLEDs, BOOSTERPACK_LED_RED_PORT  , BOOSTERPACK_LED_RED_PIN  );
+    LEDGroup_addLED(&hal.boosterpackLEDs, BOOSTERPACK_LED_GREEN_PORT, BOOSTERPACK_LED_GREEN_PIN);
+    LEDGroup_addLED(&hal.boosterpackLEDs, BOOSTERPACK_LED_BLUE_PORT , BOOSTERPACK_LED_BLUE_PIN );
+
+    // Start the PWM timers of the Boosterpack LED. Its pins stay GPIO until it is enabled.
+    hal.boosterpackRGB   = RGBLED_construct();
+
     // Initialize all Buttons by calling their constructors with correctly-defined arguments.
-    hal.boosterpackS1 = Button_construct(BOOSTERPACK_S1_PORT, BOOSTERPACK_S1_PIN);  // Boosterpack S1
-    hal.boosterpackS2 = Button_construct(BOOSTERPACK_S2_PORT, BOOSTERPACK_S2_PIN);  // Boosterpack S2
+    // The Boosterpack buttons either capture their edges with port interrupts or are sampled by
+    // DMA. Either way, a tap is never lost while the main loop is busy drawing.
+#if BOOSTERPACK_BUTTONS_DMA_SAMPLED
+    hal.boosterpackS1 = Button_constructDMASampled(BOOSTERPACK_S1_PORT, BOOSTERPACK_S1_PIN); // Boosterpack S1
+    hal.boosterpackS2 = Button_constructDMASampled(BOOSTERPACK_S2_PORT, BOOSTERPACK_S2_PIN); // Boosterpack S2
+    hal.boosterpackJS = Button_constructDMASampled(BOOSTERPACK_JS_PORT, BOOSTERPACK_JS_PIN); // Boosterpack JS
+#else
+    hal.boosterpackS1 = Button_constructInterrupt(BOOSTERPACK_S1_PORT, BOOSTERPACK_S1_PIN);  // Boosterpack S1
+    hal.boosterpackS2 = Button_constructInterrupt(BOOSTERPACK_S2_PORT, BOOSTERPACK_S2_PIN);  // Boosterpack S2
+    hal.boosterpackJS = Button_constructSampled(BOOSTERPACK_JS_PORT, BOOSTERPACK_JS_PIN);    // Boosterpack JS
+#endif
+
+    // The Boosterpack buttons step the cursor, so they report a press on its very first edge
+    // instead of after DEBOUNCE_TIME_MS. DMA-sampled buttons always integrate.
+    Button_setDebouncePolicy(&hal.boosterpackS1, DEBOUNCE_LEADING_EDGE, DEFAULT_LOCKOUT_TIME_MS);
+    Button_setDebouncePolicy(&hal.boosterpackS2, DEBOUNCE_LEADING_EDGE, DEFAULT_LOCKOUT_TIME_MS);
+
+    // The Launchpad buttons are debounced a whole port at a time by the SysTick port debouncer.
+    hal.launchpadS1   = Button_constructSampled(LAUNCHPAD_S1_PORT  , LAUNCHPAD_S1_PIN  );    // Launchpad S1
+    hal.launchpadS2   = Button_constructSampled(LAUNCHPAD_S2_PORT  , LAUNCHPAD_S2_PIN  );    // Launchpad S2
+
+    // Initialize the joystick, which is sampled in the background by the ADC and DMA.
+    hal.joystick = Joystick_construct();
 
     // Initialize the LCD by calling its constructor with user-defined foreground and background colors.
     hal.gfx = GFX_construct(GRAPHICS_COLOR_WHITE, GRAPHICS_COLOR_BLACK);
@@ -45,7 +78,22 @@ HAL HAL_construct()
  */
 void HAL_refresh(HAL* hal_p)
 {
+    PROF_BEGIN(PROF_HAL_REFRESH);
+
+    // Debounce every port sample the DMA collected since the last refresh
+    PortSampler_process();
+
     // Refresh Boosterpack buttons
     Button_refresh(&hal_p->boosterpackS1);
     Button_refresh(&hal_p->boosterpackS2);
+    Button_refresh(&hal_p->boosterpackJS);
+
+    // Refresh Launchpad buttons
+    Button_refresh(&hal_p->launchpadS1);
+    Button_refresh(&hal_p->launchpadS2);
+
+    // Classify the latest joystick position
+    Joystick_refresh(&hal_p->joystick);
+
+    PROF_END(PROF_HAL_REFRESH);
 }
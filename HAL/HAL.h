@@ -9,12 +9,25 @@
 #define HAL_HAL_H_
 
 #include <HAL/Button.h>
+#include <HAL/Joystick.h>
 #include <HAL/LED.h>
+#include <HAL/RGBLED.h>
+#include <HAL/LEDGroup.h>
 #include <HAL/Timer.h>
 #include <HAL/Graphics.h>
 
 #include <ti/devices/msp432p4xx/driverlib/driverlib.h>
 
+// Set to 1 to debounce the Boosterpack buttons from DMA-captured port samples
+// instead of port interrupts. This costs no CPU time per edge or per sample,
+// at the price of Timer_A1 and DMA channels 2 and 3.
+#define BOOSTERPACK_BUTTONS_DMA_SAMPLED     0
+
+// The bit of each color in a boosterpackLEDs pattern
+#define BOOSTERPACK_LED_RED_BIT             0
+#define BOOSTERPACK_LED_GREEN_BIT           1
+#define BOOSTERPACK_LED_BLUE_BIT            2
+
 /**============================================================================
  * The main HAL struct. This struct encapsulates all of the other input structs
  * in this application as individual members. This includes all LEDs, all
@@ -30,14 +43,28 @@
  */
 struct _HAL
 {
-    // LEDs - Boosterpack LED (one LED struct for red, one for blue, etc.)
+    // LEDs - Launchpad LED1 and Boosterpack LED (one LED struct for red, one for blue, etc.)
+    LED launchpadLED1;
     LED boosterpackRed;
     LED boosterpackBlue;
     LED boosterpackGreen;
 
-    // Buttons - Boosterpack S1, S2, and JS (press down on the joystick)
+    // The same three LEDs as one group, switched together by a color pattern
+    LEDGroup boosterpackLEDs;
+
+    // The same Boosterpack LED as a single PWM-driven RGB LED. Disabled until
+    // RGBLED_enable() is called, so that the three LEDs above work by default.
+    RGBLED boosterpackRGB;
+
+    // Buttons - Boosterpack S1, S2, and JS (press down on the joystick), and Launchpad S1 and S2
     Button boosterpackS1;
     Button boosterpackS2;
+    Button boosterpackJS;
+    Button launchpadS1;
+    Button launchpadS2;
+
+    // Joystick - both analog axes of the Boosterpack joystick
+    Joystick joystick;
 
     // Graphics - LCD control
     GFX gfx;
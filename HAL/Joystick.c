@@ -0,0 +1,269 @@
+/*
+ * Joystick.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <HAL/Joystick.h>
+
+// Each frame is one X and one Y conversion
+#define JOYSTICK_SAMPLES_PER_BLOCK  (JOYSTICK_FRAMES_PER_BLOCK * 2)
+
+/**
+ * Two block buffers, each with its own scatter-gather task list. While the
+ * DMA fills one, the other holds the last complete block.
+ */
+static uint16_t joystickBlocks[2][JOYSTICK_SAMPLES_PER_BLOCK];
+static DMA_ControlTable joystickTasks[2][JOYSTICK_FRAMES_PER_BLOCK];
+static volatile int activeBlock = 0;
+
+// The average position of the last complete block, written by the DMA ISR
+static volatile uint16_t averageX = JOYSTICK_CENTER;
+static volatile uint16_t averageY = JOYSTICK_CENTER;
+
+/**
+ * Builds the task list of one block. Every task copies ADC14MEM0 and
+ * ADC14MEM1 (the low halves of two consecutive 32-bit registers) into the
+ * next frame of the block, on a single ADC14 DMA request. The last task is a
+ * basic transfer, which ends the list and raises the channel's interrupt.
+ */
+static void Joystick_buildTasks(int block)
+{
+    int frame;
+
+    for (frame = 0; frame < JOYSTICK_FRAMES_PER_BLOCK; frame++)
+    {
+        uint32_t mode = frame == JOYSTICK_FRAMES_PER_BLOCK - 1 ? UDMA_MODE_BASIC
+                                                               : UDMA_MODE_PER_SCATTER_GATHER;
+
+        joystickTasks[block][frame] = (DMA_ControlTable)
+            DMA_TaskStructEntry(2, UDMA_SIZE_16,
+                                UDMA_SRC_INC_32, (void*) &ADC14->MEM[0],
+                                UDMA_DST_INC_16, &joystickBlocks[block][frame * 2],
+                                UDMA_ARB_2, mode);
+    }
+}
+
+/** Points DMA channel 7 at the task list of a block and enables it. */
+static void Joystick_armBlock(int block)
+{
+    DMA_setChannelScatterGather(DMA_CH7_ADC14, JOYSTICK_FRAMES_PER_BLOCK,
+                                joystickTasks[block], true);
+    DMA_enableChannel(7);
+}
+
+/**
+ * DMA channel 7 finished a block. Switches the DMA to the other block first,
+ * so at most a single frame is missed, then averages the finished block. DO
+ * NOT DIRECTLY INVOKE THIS FUNCTION FROM YOUR CODE.
+ */
+void DMA_INT3_IRQHandler()
+{
+    DMA_clearInterruptFlag(7);
+
+    int finished = activeBlock;
+    activeBlock = finished ^ 1;
+    Joystick_armBlock(activeBlock);
+
+    const uint16_t* samples = joystickBlocks[finished];
+    uint32_t sumX = 0;
+    uint32_t sumY = 0;
+    uint32_t noise = 0;
+    int i;
+
+    // The lowest bit of each conversion is mostly thermal noise, even while
+    // the stick rests; gather them into one word for the entropy pool.
+    for (i = 0; i < JOYSTICK_SAMPLES_PER_BLOCK; i += 2)
+    {
+        sumX += samples[i];
+        sumY += samples[i + 1];
+        noise = (noise << 2) ^ (samples[i] & 1) ^ ((samples[i + 1] & 1) << 1);
+    }
+
+    averageX = sumX / JOYSTICK_FRAMES_PER_BLOCK;
+    averageY = sumY / JOYSTICK_FRAMES_PER_BLOCK;
+
+    Entropy_addSample(noise, ENTROPY_BITS_PER_ADC_BLOCK);
+}
+
+/** Converts both axes, once per Timer_A3 period, into ADC14MEM0 and ADC14MEM1. */
+static void Joystick_initADC()
+{
+    GPIO_setAsPeripheralModuleFunctionInputPin(BOOSTERPACK_JS_X_PORT, BOOSTERPACK_JS_X_PIN,
+                                               GPIO_TERTIARY_MODULE_FUNCTION);
+    GPIO_setAsPeripheralModuleFunctionInputPin(BOOSTERPACK_JS_Y_PORT, BOOSTERPACK_JS_Y_PIN,
+                                               GPIO_TERTIARY_MODULE_FUNCTION);
+
+    ADC14_enableModule();
+    ADC14_initModule(ADC_CLOCKSOURCE_ADCOSC, ADC_PREDIVIDER_1, ADC_DIVIDER_1, 0);
+
+    // Repeat the MEM0-MEM1 sequence on every trigger. The DMA request of the
+    // ADC comes from the end of the sequence, so both results are ready.
+    ADC14_configureMultiSequenceMode(ADC_MEM0, ADC_MEM1, true);
+    ADC14_configureConversionMemory(ADC_MEM0, ADC_VREFPOS_AVCC_VREFNEG_VSS,
+                                    BOOSTERPACK_JS_X_INPUT, ADC_NONDIFFERENTIAL_INPUTS);
+    ADC14_configureConversionMemory(ADC_MEM1, ADC_VREFPOS_AVCC_VREFNEG_VSS,
+                                    BOOSTERPACK_JS_Y_INPUT, ADC_NONDIFFERENTIAL_INPUTS);
+
+    // Timer_A3 CCR1 is trigger source 7
+    ADC14_setSampleHoldTrigger(ADC_TRIGGER_SOURCE7, false);
+    ADC14_enableConversion();
+}
+
+/** Starts Timer_A3, whose CCR1 output rises once per sample period. */
+static void Joystick_initTimer()
+{
+    Timer_A_UpModeConfig upConfig =
+    {
+        TIMER_A_CLOCKSOURCE_SMCLK,
+        TIMER_A_CLOCKSOURCE_DIVIDER_48,
+        JOYSTICK_TIMER_HZ / JOYSTICK_SAMPLE_RATE_HZ - 1,
+        TIMER_A_TAIE_INTERRUPT_DISABLE,
+        TIMER_A_CCIE_CCR0_INTERRUPT_DISABLE,
+        TIMER_A_DO_CLEAR
+    };
+
+    Timer_A_CompareModeConfig compareConfig =
+    {
+        TIMER_A_CAPTURECOMPARE_REGISTER_1,
+        TIMER_A_CAPTURECOMPARE_INTERRUPT_DISABLE,
+        TIMER_A_OUTPUTMODE_SET_RESET,
+        JOYSTICK_TIMER_HZ / JOYSTICK_SAMPLE_RATE_HZ / 2
+    };
+
+    Timer_A_configureUpMode(TIMER_A3_BASE, &upConfig);
+    Timer_A_initCompare(TIMER_A3_BASE, &compareConfig);
+    Timer_A_startCounter(TIMER_A3_BASE, TIMER_A_UP_MODE);
+}
+
+/**
+ * Constructs the joystick and starts the ADC, DMA and timer which sample it.
+ * From now on, the only CPU time spent on the joystick is one short interrupt
+ * per block and whatever Joystick_refresh() costs.
+ *
+ * @return a constructed Joystick, centered
+ */
+Joystick Joystick_construct()
+{
+    Joystick joystick;
+
+    joystick.x = JOYSTICK_CENTER;
+    joystick.y = JOYSTICK_CENTER;
+    joystick.xState = 0;
+    joystick.yState = 0;
+    joystick.direction = JOYSTICK_CENTERED;
+    joystick.tapped = JOYSTICK_CENTERED;
+
+    DMAControl_init();
+
+    Joystick_buildTasks(0);
+    Joystick_buildTasks(1);
+
+    DMA_assignChannel(DMA_CH7_ADC14);
+    DMA_assignInterrupt(DMA_INT3, 7);
+    Interrupt_enableInterrupt(INT_DMA_INT3);
+
+    activeBlock = 0;
+    Joystick_armBlock(0);
+
+    Joystick_initADC();
+    Joystick_initTimer();
+
+    return joystick;
+}
+
+/**
+ * Classifies the position of one axis as -1, 0 or +1. Leaving the center
+ * takes a deflection past JOYSTICK_PRESS_THRESHOLD, while staying deflected
+ * only takes one past JOYSTICK_RELEASE_THRESHOLD, so a joystick resting near
+ * a threshold does not chatter between states.
+ *
+ * @param value:            The raw 14-bit position of the axis
+ * @param previousState:    The result of the previous classification
+ * @return -1 if the axis is pushed low, +1 if it is pushed high, else 0
+ */
+int8_t Joystick_classifyAxis(uint16_t value, int8_t previousState)
+{
+    int32_t offset = (int32_t) value - JOYSTICK_CENTER;
+    int8_t side = offset < 0 ? -1 : 1;
+    int32_t magnitude = offset < 0 ? -offset : offset;
+
+    int32_t threshold = side == previousState ? JOYSTICK_RELEASE_THRESHOLD
+                                              : JOYSTICK_PRESS_THRESHOLD;
+
+    return magnitude > threshold ? side : 0;
+}
+
+/**
+ * Refreshes the joystick with the latest block average. Like a Button, this
+ * should be called exactly ONCE per pass of the main loop, since a tap is
+ * only reported for the single refresh in which the direction changed.
+ *
+ * @param joystick_p:   The Joystick to refresh
+ */
+void Joystick_refresh(Joystick* joystick_p)
+{
+    joystick_p->x = averageX;
+    joystick_p->y = averageY;
+
+    int8_t xState = Joystick_classifyAxis(joystick_p->x, joystick_p->xState);
+    int8_t yState = Joystick_classifyAxis(joystick_p->y, joystick_p->yState);
+
+    JoystickDirection xDirection = xState == 0 ? JOYSTICK_CENTERED
+                                 : xState > 0 ? JOYSTICK_RIGHT : JOYSTICK_LEFT;
+    JoystickDirection yDirection = yState == 0 ? JOYSTICK_CENTERED
+                                 : yState > 0 ? JOYSTICK_UP : JOYSTICK_DOWN;
+
+    // A diagonal keeps the direction of the axis which got there first, so
+    // the second axis crossing its threshold is not another tap. Otherwise
+    // the vertical axis wins.
+    JoystickDirection direction = yDirection != JOYSTICK_CENTERED ? yDirection : xDirection;
+    if (xDirection != JOYSTICK_CENTERED && joystick_p->direction == xDirection) {
+        direction = xDirection;
+    }
+
+    joystick_p->tapped = direction != joystick_p->direction ? direction : JOYSTICK_CENTERED;
+    if (joystick_p->tapped != JOYSTICK_CENTERED) {
+        LatencyTrace_markInput((uint32_t) HWTimer_getCycles());
+    }
+    joystick_p->direction = direction;
+    joystick_p->xState = xState;
+    joystick_p->yState = yState;
+}
+
+/**
+ * Returns the direction in which the joystick is pushed, as of the last
+ * refresh.
+ *
+ * @param joystick_p:   The Joystick to query
+ * @return the current direction, or JOYSTICK_CENTERED
+ */
+JoystickDirection Joystick_getDirection(Joystick* joystick_p)
+{
+    return joystick_p->direction;
+}
+
+/**
+ * Returns whether the joystick was pushed in a direction during the last
+ * refresh, the joystick equivalent of Button_isTapped().
+ *
+ * @param joystick_p:   The Joystick to query
+ * @param direction:    The direction to check
+ * @return true if the joystick just moved into the direction
+ */
+bool Joystick_isTapped(Joystick* joystick_p, JoystickDirection direction)
+{
+    return direction != JOYSTICK_CENTERED && joystick_p->tapped == direction;
+}
+
+/** Returns the latest block-averaged position of the X axis. */
+uint16_t Joystick_getX(Joystick* joystick_p)
+{
+    return joystick_p->x;
+}
+
+/** Returns the latest block-averaged position of the Y axis. */
+uint16_t Joystick_getY(Joystick* joystick_p)
+{
+    return joystick_p->y;
+}
@@ -0,0 +1,102 @@
+/*
+ * Joystick.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HAL_JOYSTICK_H_
+#define HAL_JOYSTICK_H_
+
+#include <HAL/DMAControl.h>
+#include <HAL/LatencyTrace.h>
+#include <HAL/Entropy.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/**
+ * Predefined joystick axis ports, pins and ADC inputs. The push button of the
+ * joystick is a regular Button (see BOOSTERPACK_JS_PORT in Button.h).
+ */
+#define BOOSTERPACK_JS_X_PORT       GPIO_PORT_P6
+#define BOOSTERPACK_JS_X_PIN        GPIO_PIN0
+#define BOOSTERPACK_JS_X_INPUT      ADC_INPUT_A15
+
+#define BOOSTERPACK_JS_Y_PORT       GPIO_PORT_P4
+#define BOOSTERPACK_JS_Y_PIN        GPIO_PIN4
+#define BOOSTERPACK_JS_Y_INPUT      ADC_INPUT_A9
+
+// Timer_A3 triggers one conversion of both axes at this rate. The DMA stores
+// JOYSTICK_FRAMES_PER_BLOCK of them before the CPU sees a single interrupt.
+#define JOYSTICK_SAMPLE_RATE_HZ     500
+#define JOYSTICK_TIMER_HZ           1000000
+#define JOYSTICK_FRAMES_PER_BLOCK   16
+
+// Thresholds of the classifier, as offsets from the 14-bit center. An axis
+// must move past the press threshold to count as deflected, and back inside
+// the release threshold (the dead zone) to count as centered again.
+#define JOYSTICK_CENTER             8192
+#define JOYSTICK_PRESS_THRESHOLD    5000
+#define JOYSTICK_RELEASE_THRESHOLD  3000
+
+/**
+ * The direction in which the joystick is pushed. Diagonals report the axis
+ * which moved past its press threshold first.
+ */
+enum _JoystickDirection
+{
+    JOYSTICK_CENTERED, JOYSTICK_UP, JOYSTICK_DOWN, JOYSTICK_LEFT, JOYSTICK_RIGHT
+};
+typedef enum _JoystickDirection JoystickDirection;
+
+/**=============================================================================
+ * The Boosterpack joystick, implemented in the C object-oriented style. Use
+ * the constructor [Joystick_construct()] to create the Joystick object, and
+ * refresh it once per pass of the main loop with [Joystick_refresh()], just
+ * like a Button.
+ *
+ * ADC14 converts both axes in a repeated sequence, triggered by Timer_A3. DMA
+ * channel 7 runs a peripheral scatter-gather list which copies each X/Y pair
+ * into a block buffer, so no code runs per sample. Once per block, the DMA
+ * interrupt averages the block and swaps to the other buffer.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * There is only ONE joystick. Do not construct more than one Joystick object.
+ * When using this object, DO NOT DIRECTLY ACCESS ANY MEMBER VARIABLES of the
+ * Joystick struct.
+ */
+struct _Joystick
+{
+    // The latest block-averaged position of each axis, 0 to 16383
+    uint16_t x;
+    uint16_t y;
+
+    // The classified position of each axis: -1, 0 or +1
+    int8_t xState;
+    int8_t yState;
+
+    // The outputs of the classifier
+    JoystickDirection direction;    // Where the joystick is pushed now
+    JoystickDirection tapped;       // Where it was just pushed, if anywhere
+};
+typedef struct _Joystick Joystick;
+
+// Constructs the joystick and starts sampling it in the background.
+Joystick Joystick_construct();
+
+// Classifies the latest samples. Call this once per pass of the main loop.
+void Joystick_refresh(Joystick* joystick_p);
+
+// Returns the direction the joystick is currently pushed in.
+JoystickDirection Joystick_getDirection(Joystick* joystick_p);
+
+// Returns whether the joystick was just pushed in the given direction.
+bool Joystick_isTapped(Joystick* joystick_p, JoystickDirection direction);
+
+// Returns the latest raw position of each axis.
+uint16_t Joystick_getX(Joystick* joystick_p);
+uint16_t Joystick_getY(Joystick* joystick_p);
+
+// Classifies one axis with hysteresis. Exposed for reuse by other analog inputs.
+int8_t Joystick_classifyAxis(uint16_t value, int8_t previousState);
+
+#endif /* HAL_JOYSTICK_H_ */
@@ -0,0 +1,404 @@
+/*
+ * KVStore.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <HAL/KVStore.h>
+#include <HAL/Profiler.h>
+
+#include <string.h>
+
+#define KV_ERASED_WORD      0xFFFFFFFF
+#define KV_NO_SECTOR        -1
+
+// The RAM copy of every key. A key is present once it has a record in flash
+// or has been set, and dirty until its latest value has a record in flash.
+static uint32_t values[KV_MAX_KEYS];
+static uint32_t presentKeys = 0;
+static uint32_t dirtyKeys = 0;
+
+static int8_t activeSector = KV_NO_SECTOR;
+static uint32_t generation = 0;
+static uint16_t nextSlot = 1;       // The first free slot of the active sector
+static bool spareErased = false;    // Whether the other sector is ready for a compaction
+
+static KVStoreStats stats;
+
+/** Returns the first byte of one of the two sectors. */
+static uint8_t* KVStore_sector(int sector)
+{
+    return (uint8_t*) (uintptr_t) (KV_FLASH_BASE + sector * KV_SECTOR_SIZE);
+}
+
+/** Returns one slot of a sector. Slot 0 holds the sector header. */
+static uint8_t* KVStore_slot(int sector, uint16_t slot)
+{
+    return KVStore_sector(sector) + slot * KV_RECORD_SIZE;
+}
+
+/** Returns the sector which is not the active one. */
+static int KVStore_spare()
+{
+    return (activeSector == KV_NO_SECTOR) ? 0 : 1 - activeSector;
+}
+
+/** Returns whether length bytes of flash, a multiple of 4, read as erased. */
+static bool KVStore_isBlank(const uint8_t* address, uint32_t length)
+{
+    const uint32_t* word_p = (const uint32_t*) address;
+    uint32_t i;
+
+    for (i = 0; i < length / 4; i++)
+    {
+        if (word_p[i] != KV_ERASED_WORD) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/** Returns the CRC-16-CCITT of a key and its value. */
+static uint16_t KVStore_crc(uint8_t key, uint32_t value)
+{
+    uint8_t bytes[5] = { key, value, value >> 8, value >> 16, value >> 24 };
+    uint16_t crc = 0xFFFF;
+    int i, bit;
+
+    for (i = 0; i < 5; i++)
+    {
+        crc ^= (uint16_t) bytes[i] << 8;
+        for (bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+
+    return crc;
+}
+
+/** Returns whether a sector starts with a valid header. */
+static bool KVStore_isFormatted(int sector)
+{
+    const KVSectorHeader* header_p = (const KVSectorHeader*) KVStore_sector(sector);
+
+    return header_p->magic == KV_SECTOR_MAGIC;
+}
+
+/** Programs length bytes into erased flash in the store's sectors. */
+static bool KVStore_program(const void* source, uint8_t* destination, uint32_t length)
+{
+    FlashCtl_unprotectSector(FLASH_MAIN_MEMORY_SPACE_BANK1, KV_FLASH_SECTORS);
+    bool ok = FlashCtl_programMemory((void*) source, destination, length);
+    FlashCtl_protectSector(FLASH_MAIN_MEMORY_SPACE_BANK1, KV_FLASH_SECTORS);
+
+    return ok;
+}
+
+/** Erases one of the store's sectors. */
+static bool KVStore_erase(int sector)
+{
+    PROF_BEGIN(PROF_KV_ERASE);
+
+    FlashCtl_unprotectSector(FLASH_MAIN_MEMORY_SPACE_BANK1, KV_FLASH_SECTORS);
+    bool ok = FlashCtl_eraseSector((uint32_t) (uintptr_t) KVStore_sector(sector));
+    FlashCtl_protectSector(FLASH_MAIN_MEMORY_SPACE_BANK1, KV_FLASH_SECTORS);
+
+    stats.erases++;
+
+    PROF_END(PROF_KV_ERASE);
+    return ok;
+}
+
+/**
+ * Writes the header of an erased sector. The generation goes first and the
+ * magic last, so a reset in between leaves a sector which is not formatted.
+ */
+static bool KVStore_format(int sector, uint32_t newGeneration)
+{
+    KVSectorHeader header;
+    header.generation = newGeneration;
+    header.magic = KV_SECTOR_MAGIC;
+
+    uint8_t* header_p = KVStore_sector(sector);
+
+    return KVStore_program(&header.generation, header_p, sizeof(header.generation))
+        && KVStore_program(&header.magic, header_p + sizeof(header.generation), sizeof(header.magic));
+}
+
+/** Programs one record into a free slot. */
+static bool KVStore_append(int sector, uint16_t slot, uint8_t key)
+{
+    KVRecord record;
+    record.key = key;
+    record.reserved = 0xFF;
+    record.crc = KVStore_crc(key, values[key]);
+    record.value = values[key];
+
+    stats.recordsWritten++;
+
+    return KVStore_program(&record, KVStore_slot(sector, slot), sizeof(record));
+}
+
+/**
+ * Copies the current value of every key into the erased spare sector, then
+ * formats it with the next generation. Until the header is written the old
+ * sector is still the valid one, so a reset halfway loses nothing that was
+ * already in flash. A key whose record fails to program stays dirty, and is
+ * appended again by the next flush, before the old sector is erased. If the
+ * header fails, the old sector stays active and the spare is erased again.
+ */
+static void KVStore_compact()
+{
+    int spare = KVStore_spare();
+    uint32_t failedKeys = 0;
+    uint16_t slot = 1;
+    uint8_t key;
+
+    for (key = 0; key < KV_MAX_KEYS; key++)
+    {
+        if ((presentKeys & (1 << key)) && !KVStore_append(spare, slot++, key)) {
+            failedKeys |= 1 << key;
+        }
+    }
+
+    spareErased = false;
+
+    if (!KVStore_format(spare, generation + 1)) {
+        return;
+    }
+
+    activeSector = spare;
+    generation++;
+    nextSlot = slot;
+    dirtyKeys = failedKeys;
+
+    stats.compactions++;
+}
+
+/**
+ * Appends one record per dirty key to the active sector, compacting first if
+ * they do not all fit.
+ *
+ * @return false if the flush has to wait for the spare sector to be erased
+ */
+static bool KVStore_flush()
+{
+    PROF_BEGIN(PROF_KV_FLUSH);
+
+    uint16_t needed = 0;
+    uint8_t key;
+
+    for (key = 0; key < KV_MAX_KEYS; key++)
+    {
+        if (dirtyKeys & (1 << key)) {
+            needed++;
+        }
+    }
+
+    if (nextSlot + needed > KV_SLOTS_PER_SECTOR + 1)
+    {
+        if (!spareErased)
+        {
+            stats.deferredFlushes++;
+            PROF_END(PROF_KV_FLUSH);
+            return false;
+        }
+
+        KVStore_compact();
+    }
+    else
+    {
+        for (key = 0; key < KV_MAX_KEYS; key++)
+        {
+            if ((dirtyKeys & (1 << key)) == 0) {
+                continue;
+            }
+
+            // A slot which fails to program is skipped, and the key retried
+            if (KVStore_append(activeSector, nextSlot++, key)) {
+                dirtyKeys &= ~(1 << key);
+            }
+        }
+    }
+
+    PROF_END(PROF_KV_FLUSH);
+    return true;
+}
+
+/**
+ * Finds the active sector, the formatted one with the higher generation, and
+ * reads every record in it into RAM, newest last. The scan stops at the
+ * first free slot. If neither sector is formatted, a blank one is formatted
+ * now; otherwise the store keeps values in RAM only until KVStore_service()
+ * has erased and formatted a sector. The RAM copy starts out empty, as after
+ * a reset, so mounting again sees only what reached flash.
+ */
+void KVStore_mount()
+{
+    uint32_t start = Profiler_now();
+    int sector;
+    uint16_t slot;
+
+    memset(values, 0, sizeof(values));
+    presentKeys = 0;
+    dirtyKeys = 0;
+    activeSector = KV_NO_SECTOR;
+    generation = 0;
+    nextSlot = 1;
+    stats.recordsScanned = 0;
+    stats.recordsTorn = 0;
+
+    for (sector = 0; sector < KV_NUM_SECTORS; sector++)
+    {
+        const KVSectorHeader* header_p = (const KVSectorHeader*) KVStore_sector(sector);
+
+        if (KVStore_isFormatted(sector) &&
+            (activeSector == KV_NO_SECTOR || header_p->generation > generation))
+        {
+            activeSector = sector;
+            generation = header_p->generation;
+        }
+    }
+
+    // First use: format a blank sector, which takes one header write
+    if (activeSector == KV_NO_SECTOR)
+    {
+        for (sector = 0; sector < KV_NUM_SECTORS; sector++)
+        {
+            if (KVStore_isBlank(KVStore_sector(sector), KV_SECTOR_SIZE) && KVStore_format(sector, 1))
+            {
+                activeSector = sector;
+                generation = 1;
+                break;
+            }
+        }
+    }
+
+    if (activeSector != KV_NO_SECTOR)
+    {
+        for (slot = 1; slot <= KV_SLOTS_PER_SECTOR; slot++)
+        {
+            const KVRecord* record_p = (const KVRecord*) KVStore_slot(activeSector, slot);
+
+            if (KVStore_isBlank((const uint8_t*) record_p, KV_RECORD_SIZE)) {
+                break;
+            }
+
+            stats.recordsScanned++;
+
+            if (record_p->key < KV_MAX_KEYS && record_p->crc == KVStore_crc(record_p->key, record_p->value))
+            {
+                values[record_p->key] = record_p->value;
+                presentKeys |= 1 << record_p->key;
+            }
+            else {
+                stats.recordsTorn++;
+            }
+        }
+
+        nextSlot = slot;
+    }
+
+    spareErased = KVStore_isBlank(KVStore_sector(KVStore_spare()), KV_SECTOR_SIZE);
+
+    stats.mountCycles = Profiler_now() - start;
+}
+
+/**
+ * Returns the value of a key from RAM.
+ *
+ * @param key:      The key, below KV_MAX_KEYS
+ * @return the latest value set, or 0 if the key was never set
+ */
+uint32_t KVStore_get(uint8_t key)
+{
+    return values[key];
+}
+
+/**
+ * Sets the value of a key in RAM and marks it dirty. Setting a key to the
+ * value it already has costs no flash write.
+ *
+ * @param key:      The key, below KV_MAX_KEYS
+ * @param value:    The new value
+ */
+void KVStore_set(uint8_t key, uint32_t value)
+{
+    if ((presentKeys & (1 << key)) && values[key] == value) {
+        return;
+    }
+
+    values[key] = value;
+    presentKeys |= 1 << key;
+    dirtyKeys |= 1 << key;
+}
+
+/**
+ * Adds to the value of a key in RAM, for counters.
+ *
+ * @param key:      The key, below KV_MAX_KEYS
+ * @param delta:    The amount to add
+ */
+void KVStore_add(uint8_t key, uint32_t delta)
+{
+    KVStore_set(key, values[key] + delta);
+}
+
+/**
+ * Returns whether any key has a value which is not in flash yet.
+ */
+bool KVStore_isDirty()
+{
+    return dirtyKeys != 0;
+}
+
+/**
+ * Does the next piece of flash work, in this order of preference: format a
+ * sector if none is formatted, write the dirty values, or erase the spare
+ * sector so that the next compaction never has to wait for an erase.
+ *
+ * @return true if anything was programmed or erased
+ */
+bool KVStore_service()
+{
+    int spare = KVStore_spare();
+
+    if (activeSector == KV_NO_SECTOR)
+    {
+        if (!spareErased) {
+            spareErased = KVStore_erase(spare);
+        }
+        else if (KVStore_format(spare, generation + 1))
+        {
+            activeSector = spare;
+            generation++;
+            nextSlot = 1;
+            spareErased = KVStore_isBlank(KVStore_sector(KVStore_spare()), KV_SECTOR_SIZE);
+            dirtyKeys = presentKeys;
+        }
+        return true;
+    }
+
+    if (dirtyKeys != 0 && KVStore_flush()) {
+        return true;
+    }
+
+    if (!spareErased)
+    {
+        spareErased = KVStore_erase(spare);
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * Returns what the store has done since reset.
+ *
+ * @return a read-only pointer to the statistics
+ */
+const KVStoreStats* KVStore_getStats()
+{
+    return &stats;
+}
@@ -0,0 +1,120 @@
+/*
+ * KVStore.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HAL_KVSTORE_H_
+#define HAL_KVSTORE_H_
+
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+// The two flash sectors the log rotates between: sectors 30 and 31 of bank 1,
+// the last 8 KB of main memory. The linker command file keeps code out of
+// them. A host build may point KV_FLASH_BASE at a simulated flash instead.
+#ifndef KV_FLASH_BASE
+#define KV_FLASH_BASE       0x0003E000
+#endif
+#define KV_SECTOR_SIZE      4096
+#define KV_NUM_SECTORS      2
+#define KV_FLASH_SECTORS    (FLASH_SECTOR30 | FLASH_SECTOR31)
+
+// Number of keys. Keys are small integers which index the RAM copy directly.
+#define KV_MAX_KEYS         8
+
+// Marks the header of a formatted sector
+#define KV_SECTOR_MAGIC     0x4B564C47  // "KVLG"
+
+// Every record is one 8-byte slot; the sector header takes the first slot
+#define KV_RECORD_SIZE      8
+#define KV_SLOTS_PER_SECTOR ((KV_SECTOR_SIZE / KV_RECORD_SIZE) - 1)
+
+/**
+ * The first slot of a formatted sector. The sector with the higher generation
+ * holds the current log. The magic is programmed last, so a header with a
+ * valid magic always has a valid generation.
+ */
+struct _KVSectorHeader
+{
+    uint32_t generation;
+    uint32_t magic;
+};
+typedef struct _KVSectorHeader KVSectorHeader;
+
+/**
+ * One appended value. A slot which still reads as all ones is free, and the
+ * first free slot ends the log. A slot whose CRC does not match was torn by a
+ * reset during programming, and is skipped.
+ */
+struct _KVRecord
+{
+    uint8_t key;
+    uint8_t reserved;
+    uint16_t crc;               // CRC-16-CCITT of the key and value
+    uint32_t value;
+};
+typedef struct _KVRecord KVRecord;
+
+/**
+ * What the store has done since reset, to check its cost against the boot
+ * and loop budgets.
+ */
+struct _KVStoreStats
+{
+    uint16_t recordsScanned;    // Slots read by KVStore_mount()
+    uint16_t recordsTorn;       // Slots skipped for a bad CRC or key
+    uint32_t mountCycles;       // Duration of KVStore_mount(), in Profiler_now() cycles
+    uint32_t recordsWritten;
+    uint32_t compactions;
+    uint32_t erases;
+    uint32_t deferredFlushes;   // Flushes put off because the spare sector was not erased yet
+};
+typedef struct _KVStoreStats KVStoreStats;
+
+/**=============================================================================
+ * A global, log-structured key/value store of 32-bit values in flash.
+ * [KVStore_set()] only changes a RAM copy, in constant time, and marks the
+ * key dirty. [KVStore_service()] later appends one record per dirty key to
+ * the log in the active sector. Nothing is ever overwritten in place.
+ *
+ * When the active sector is full, the current value of every key is copied
+ * into the other, pre-erased sector, which then becomes active with the next
+ * generation. The old sector is erased by a later call to KVStore_service().
+ * The two sectors take turns, so both wear at the same rate.
+ *
+ * [KVStore_mount()] rebuilds the RAM copy with one linear scan of the active
+ * sector, which is bounded by KV_SLOTS_PER_SECTOR slots. It never programs
+ * or erases anything, except for the header of a blank sector on first use.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * KVStore_service() blocks the CPU while it programs or erases; a sector
+ * erase takes milliseconds. Only call it while nothing time-critical is
+ * going on, and call it repeatedly: each call does one flush or one erase.
+ * Values set since the last flush are lost on reset.
+ *
+ * This store is not safe to use from ISRs.
+ */
+
+// Finds the active sector and builds the RAM copy of every key.
+void KVStore_mount();
+
+// Returns the value of a key, or 0 if it was never set.
+uint32_t KVStore_get(uint8_t key);
+
+// Sets the value of a key in RAM. It reaches flash with the next flush.
+void KVStore_set(uint8_t key, uint32_t value);
+
+// Adds delta to the value of a key in RAM.
+void KVStore_add(uint8_t key, uint32_t delta);
+
+// Returns whether any value is waiting to be written to flash.
+bool KVStore_isDirty();
+
+// Writes the dirty values, or erases the spare sector. Returns whether it did either.
+bool KVStore_service();
+
+// Returns what the store has done since reset.
+const KVStoreStats* KVStore_getStats();
+
+#endif /* HAL_KVSTORE_H_ */
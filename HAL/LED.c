@@ -29,6 +29,7 @@ LED LED_construct(uint8_t port, uint16_t pin)
     led.isLit = false;  // The LED starts off unlit
     led.port  = port;   // The port comes from the constructor arguments
     led.pin   = pin;    // The pin  comes from the constructor arguments
+    led.fastPin = FastPin_construct(port, pin);
 
     GPIO_setAsOutputPin(led.port, led.pin);
     GPIO_setOutputLowOnPin(led.port, led.pin);
@@ -44,14 +45,11 @@ LED LED_construct(uint8_t port, uint16_t pin)
  */
 void LED_turnOn(LED* led_p)
 {
-    // Retrieve the port and pin target from the selected LED
-    uint8_t port = led_p->port;
-    uint16_t pin = led_p->pin;
-
     // Internal logic: when we turn on the LED, update the isLit flag
     led_p->isLit = true;
 
-    GPIO_setOutputHighOnPin(port, pin);
+    // A single store to the pin's bit-band alias
+    FastPin_set(&led_p->fastPin);
 }
 
 /**
@@ -61,14 +59,10 @@ void LED_turnOn(LED* led_p)
  */
 void LED_turnOff(LED* led_p)
 {
-    // Retrieve the port and pin target from the selected LED
-    uint8_t port = led_p->port;
-    uint16_t pin = led_p->pin;
-
     // Internal logic: when we turn off the LED, update the isLit flag
     led_p->isLit = false;
 
-    GPIO_setOutputLowOnPin(port, pin);
+    FastPin_clear(&led_p->fastPin);
 }
 
 /**
@@ -78,14 +72,11 @@ void LED_turnOff(LED* led_p)
  */
 void LED_toggle(LED* led_p)
 {
-    // Retrieve the port and pin target from the selected LED
-    uint8_t port = led_p->port;
-    uint16_t pin = led_p->pin;
-
     // Internal logic: when we toggle the LED, toggle the isLit flag.
     led_p->isLit = !led_p->isLit;
 
-    GPIO_toggleOutputOnPin(port, pin);
+    // Write the new state rather than toggling, which would need a read
+    FastPin_write(&led_p->fastPin, led_p->isLit);
 }
 
 /**
@@ -8,6 +8,7 @@
 #ifndef HAL_LED_H_
 #define HAL_LED_H_
 
+#include <HAL/FastGPIO.h>
 #include <ti/devices/msp432p4xx/driverlib/driverlib.h>
 
 /**
@@ -56,6 +57,7 @@ struct _LED
 {
     uint8_t port;
     uint16_t pin;
+    FastPin fastPin;    // Bit-band alias of the pin, for single-store writes
     bool isLit;
 };
 typedef struct _LED LED;
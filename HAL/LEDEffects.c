@@ -0,0 +1,220 @@
+/*
+ * LEDEffects.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <HAL/LEDEffects.h>
+
+#define WHITE   LED_EFFECT_WHITE
+#define BLACK   0x000000
+
+/** Red, green and blue, one second apart, fading into each other. */
+static const LEDKeyframe rainbowKeyframes[] =
+{
+    { 0xFF0000, 1000 },
+    { 0x00FF00, 1000 },
+    { 0x0000FF, 1000 }
+};
+
+/** Up to full brightness and back down to a glow, two seconds per breath. */
+static const LEDKeyframe pulseKeyframes[] =
+{
+    { WHITE,    1000 },
+    { 0x101010, 1000 }
+};
+
+/** A quarter second on, a quarter second off, with no fading in between. */
+static const LEDKeyframe blinkKeyframes[] =
+{
+    { WHITE, 250 },
+    { WHITE,   0 },
+    { BLACK, 250 },
+    { BLACK,   0 }
+};
+
+static const LEDEffect effects[NUM_LED_EFFECTS] =
+{
+    { rainbowKeyframes, sizeof(rainbowKeyframes) / sizeof(LEDKeyframe), true },
+    { pulseKeyframes  , sizeof(pulseKeyframes)   / sizeof(LEDKeyframe), true },
+    { blinkKeyframes  , sizeof(blinkKeyframes)   / sizeof(LEDKeyframe), true }
+};
+
+/** The effect being played. Written by the main loop only while the timer is halted. */
+static volatile bool effectRunning = false;
+static RGBLED* effectLED_p = NULL;
+static LEDEffectId effectId = LED_EFFECT_RAINBOW;
+static uint32_t effectTint = LED_EFFECT_WHITE;
+static uint8_t effectKeyframe = 0;
+static uint16_t effectElapsed_ms = 0;
+
+static LEDEffectLoad effectLoads[NUM_LED_EFFECTS];
+
+/** Fades one 8-bit component of a keyframe towards the next one. */
+static uint32_t LEDEffects_lerp(uint32_t from, uint32_t to, uint32_t elapsed, uint32_t duration)
+{
+    int32_t delta = (int32_t) to - (int32_t) from;
+    return (uint32_t) ((int32_t) from + delta * (int32_t) elapsed / (int32_t) duration);
+}
+
+/** Scales one 8-bit component by the matching component of the tint. */
+static uint32_t LEDEffects_tint(uint32_t component, uint32_t tint)
+{
+    return (component * (tint + 1)) >> 8;
+}
+
+/**
+ * Computes the color of the running effect at the current time and moves the
+ * effect forward by one tick.
+ */
+static void LEDEffects_tick()
+{
+    const LEDEffect* effect_p = &effects[effectId];
+    int skipped = 0;
+
+    // Zero-length keyframes are jumps: pass straight through them
+    while (effect_p->keyframes[effectKeyframe].duration_ms == 0 && skipped < effect_p->numKeyframes)
+    {
+        effectKeyframe = (effectKeyframe + 1) % effect_p->numKeyframes;
+        skipped++;
+    }
+
+    const LEDKeyframe* from_p = &effect_p->keyframes[effectKeyframe];
+    int next = effectKeyframe + 1;
+    bool last = next == effect_p->numKeyframes;
+
+    if (last && !effect_p->loop) {
+        next = effectKeyframe;
+    }
+    else if (last) {
+        next = 0;
+    }
+
+    const LEDKeyframe* to_p = &effect_p->keyframes[next];
+    uint32_t color = 0;
+    int shift;
+
+    for (shift = 16; shift >= 0; shift -= 8)
+    {
+        uint32_t component = LEDEffects_lerp((from_p->color >> shift) & 0xFF, (to_p->color >> shift) & 0xFF,
+                                             effectElapsed_ms, from_p->duration_ms);
+        color |= LEDEffects_tint(component, (effectTint >> shift) & 0xFF) << shift;
+    }
+
+    RGBLED_setColor(effectLED_p, color);
+
+    effectElapsed_ms += LED_EFFECT_TICK_MS;
+    if (effectElapsed_ms >= from_p->duration_ms)
+    {
+        effectElapsed_ms = 0;
+
+        // A one-shot effect holds its final keyframe and stops the timer
+        if (last && !effect_p->loop) {
+            LEDEffects_stop();
+        }
+        else {
+            effectKeyframe = next;
+        }
+    }
+}
+
+/**
+ * The Timer32_1 ISR. Plays one tick of the running effect and charges its own
+ * duration to that effect. DO NOT DIRECTLY INVOKE THIS FUNCTION FROM YOUR CODE.
+ */
+void T32_INT2_IRQHandler()
+{
+    uint32_t start = Profiler_now();
+
+    Timer32_clearInterruptFlag(TIMER32_1_BASE);
+
+    LEDEffectLoad* load_p = &effectLoads[effectId];
+    if (effectRunning) {
+        LEDEffects_tick();
+    }
+
+    uint32_t cycles = Profiler_now() - start;
+    load_p->ticks++;
+    load_p->busyCycles += cycles;
+    if (cycles > load_p->maxCycles) {
+        load_p->maxCycles = cycles;
+    }
+}
+
+/**
+ * Starts an effect from its first keyframe, replacing any effect which is
+ * already running. Timer32_1 is (re)started at LED_EFFECT_TICK_HZ.
+ *
+ * @param rgbLED_p:     The RGB LED to play the effect on
+ * @param effect:       The effect to play
+ * @param tint:         The 0xRRGGBB color the effect is multiplied by;
+ *                      LED_EFFECT_WHITE plays the effect as defined
+ */
+void LEDEffects_start(RGBLED* rgbLED_p, LEDEffectId effect, uint32_t tint)
+{
+    Timer32_haltTimer(TIMER32_1_BASE);
+
+    effectLED_p = rgbLED_p;
+    effectId = effect;
+    effectTint = tint;
+    effectKeyframe = 0;
+    effectElapsed_ms = 0;
+    effectRunning = true;
+
+    Timer32_initModule(TIMER32_1_BASE, TIMER32_PRESCALER_1, TIMER32_32BIT, TIMER32_PERIODIC_MODE);
+    Timer32_setCount(TIMER32_1_BASE, SYSTEM_CLOCK / LED_EFFECT_TICK_HZ);
+    Timer32_enableInterrupt(TIMER32_1_BASE);
+    Interrupt_enableInterrupt(INT_T32_INT2);
+    Timer32_startTimer(TIMER32_1_BASE, false);
+}
+
+/**
+ * Stops the running effect. The timer is halted, so no ISR runs at all until
+ * the next effect starts. The LED keeps showing the last color it was given.
+ */
+void LEDEffects_stop()
+{
+    Timer32_haltTimer(TIMER32_1_BASE);
+    effectRunning = false;
+}
+
+/**
+ * Returns whether an effect is still running. One-shot effects stop by
+ * themselves once they reach their last keyframe.
+ *
+ * @return true if an effect is running
+ */
+bool LEDEffects_isRunning()
+{
+    return effectRunning;
+}
+
+/**
+ * Returns the ISR cost measured so far for one effect.
+ *
+ * @param effect:   The effect to query
+ * @return a read-only pointer to the measurements
+ */
+const LEDEffectLoad* LEDEffects_getLoad(LEDEffectId effect)
+{
+    return &effectLoads[effect];
+}
+
+/**
+ * Returns the share of the CPU the ISR took while an effect was running, as
+ * the ISR's busy cycles over the cycles of all the ticks it ran for.
+ *
+ * @param effect:   The effect to query
+ * @return the CPU load of the effect in permille, or 0 if it never ran
+ */
+uint32_t LEDEffects_getLoadPermille(LEDEffectId effect)
+{
+    const LEDEffectLoad* load_p = &effectLoads[effect];
+    uint64_t tickCycles = (uint64_t) load_p->ticks * (SYSTEM_CLOCK / LED_EFFECT_TICK_HZ);
+
+    if (tickCycles == 0) {
+        return 0;
+    }
+
+    return (uint32_t) (load_p->busyCycles * 1000 / tickCycles);
+}
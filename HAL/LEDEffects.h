@@ -0,0 +1,101 @@
+/*
+ * LEDEffects.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HAL_LEDEFFECTS_H_
+#define HAL_LEDEFFECTS_H_
+
+#include <HAL/RGBLED.h>
+#include <HAL/Timer.h>
+#include <HAL/Profiler.h>
+
+// The rate at which the Timer32_1 ISR advances the running effect. Each tick
+// interpolates a new color and writes it to the PWM compare registers.
+#define LED_EFFECT_TICK_HZ      100
+#define LED_EFFECT_TICK_MS      (MS_DIVISION_FACTOR / LED_EFFECT_TICK_HZ)
+
+// The tint which plays an effect in its own colors
+#define LED_EFFECT_WHITE        0xFFFFFF
+
+/**
+ * One point of an effect. The color fades linearly from one keyframe to the
+ * next over duration_ms; a keyframe with a duration of 0 jumps straight to
+ * the next one, which is how hard blinks are made.
+ */
+struct _LEDKeyframe
+{
+    uint32_t color;         // 0xRRGGBB, before the tint is applied
+    uint16_t duration_ms;
+};
+typedef struct _LEDKeyframe LEDKeyframe;
+
+/**
+ * A keyframe sequence, stored in flash. A looping effect fades from its last
+ * keyframe back to its first; otherwise it stops on the last keyframe.
+ */
+struct _LEDEffect
+{
+    const LEDKeyframe* keyframes;
+    uint8_t numKeyframes;
+    bool loop;
+};
+typedef struct _LEDEffect LEDEffect;
+
+/**
+ * Every predefined effect. Add a new entry (and a matching table in
+ * LEDEffects.c) for a new effect.
+ */
+enum _LEDEffectId
+{
+    LED_EFFECT_RAINBOW,     // Loops through the color wheel
+    LED_EFFECT_PULSE,       // Breathes slowly in the tint color
+    LED_EFFECT_BLINK,       // Blinks hard in the tint color
+    NUM_LED_EFFECTS
+};
+typedef enum _LEDEffectId LEDEffectId;
+
+/**
+ * The cost of running one effect, measured by the ISR with the DWT counter.
+ */
+struct _LEDEffectLoad
+{
+    uint32_t ticks;         // Number of ISR runs while the effect was active
+    uint32_t maxCycles;     // Longest single ISR run
+    uint64_t busyCycles;    // Total cycles spent in the ISR
+};
+typedef struct _LEDEffectLoad LEDEffectLoad;
+
+/**=============================================================================
+ * An interrupt-driven effect engine for the RGB LED. The main loop only
+ * starts, replaces or stops effects; Timer32_1 then plays the keyframes from
+ * its ISR at LED_EFFECT_TICK_HZ, so an effect costs the main loop nothing,
+ * however long the screen takes to draw. The timer only runs while an effect
+ * is active.
+ *
+ * Every effect is multiplied by a tint color when it starts, so a single
+ * white keyframe table can pulse in any color.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * The RGBLED must be enabled (see RGBLED_enable()) for an effect to be seen,
+ * and must outlive the effect. Only one effect runs at a time.
+ */
+
+// Starts an effect on the RGB LED, replacing any running effect.
+void LEDEffects_start(RGBLED* rgbLED_p, LEDEffectId effect, uint32_t tint);
+
+// Stops the running effect and the timer. The LED keeps its last color.
+void LEDEffects_stop();
+
+// Returns whether an effect is running.
+bool LEDEffects_isRunning();
+
+// Returns the measured ISR cost of one effect.
+const LEDEffectLoad* LEDEffects_getLoad(LEDEffectId effect);
+
+// Returns the average CPU share of the ISR while an effect ran, in permille.
+uint32_t LEDEffects_getLoadPermille(LEDEffectId effect);
+
+#endif /* HAL_LEDEFFECTS_H_ */
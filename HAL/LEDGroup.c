@@ -0,0 +1,149 @@
+/*
+ * LEDGroup.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <HAL/LEDGroup.h>
+
+/** Output registers of ports P1 through P6, indexed by port number minus one */
+static volatile uint8_t* const portOutputs[6] =
+{
+    &P1->OUT, &P2->OUT, &P3->OUT, &P4->OUT, &P5->OUT, &P6->OUT
+};
+
+/**
+ * Constructs an empty LED group showing the pattern 0.
+ *
+ * @return an LEDGroup with no LEDs
+ */
+LEDGroup LEDGroup_construct()
+{
+    LEDGroup group;
+
+    group.numPorts = 0;
+    group.numLEDs = 0;
+    group.pattern = 0;
+
+    return group;
+}
+
+/**
+ * Adds an LED to the group. The pin is configured as an output and switched
+ * off. The output tables of its port are updated for every pattern, so that
+ * LEDGroup_apply() never has to work out which pins a pattern touches.
+ *
+ * @param group_p:  The group to add to
+ * @param port:     The GPIO port of the LED, from P1 to P6
+ * @param pin:      The GPIO pin of the LED
+ * @return the bit of the LED in a pattern, or -1 if the group is full
+ */
+int LEDGroup_addLED(LEDGroup* group_p, uint8_t port, uint16_t pin)
+{
+    int i, pattern;
+
+    if (group_p->numLEDs >= LED_GROUP_MAX_LEDS) {
+        return -1;
+    }
+
+    // Find the entry of the port, or start a new one
+    LEDGroupPort* port_p = NULL;
+    for (i = 0; i < group_p->numPorts; i++)
+    {
+        if (group_p->ports[i].port == port) {
+            port_p = &group_p->ports[i];
+        }
+    }
+
+    if (port_p == NULL)
+    {
+        port_p = &group_p->ports[group_p->numPorts++];
+        port_p->port = port;
+        port_p->mask = 0;
+
+        for (pattern = 0; pattern < LED_GROUP_PATTERNS; pattern++) {
+            port_p->outputs[pattern] = 0;
+        }
+    }
+
+    int led = group_p->numLEDs++;
+    port_p->mask |= (uint8_t) pin;
+
+    for (pattern = 0; pattern < LED_GROUP_PATTERNS; pattern++)
+    {
+        if (pattern & (1 << led)) {
+            port_p->outputs[pattern] |= (uint8_t) pin;
+        }
+    }
+
+    GPIO_setAsOutputPin(port, pin);
+    GPIO_setOutputLowOnPin(port, pin);
+    group_p->pattern &= ~(1 << led);
+
+    return led;
+}
+
+/**
+ * Shows a pattern on the group. For each port, the pins which change are
+ * found by comparing the precomputed outputs of the old and new patterns. A
+ * single changed pin is written through its bit-band alias, which is atomic
+ * against ISRs touching other pins of the port. Several changed pins are
+ * written together with one masked store, so they switch in the same cycle.
+ *
+ * @param group_p:  The group to update
+ * @param pattern:  Bit N lights the Nth LED added to the group
+ */
+void LEDGroup_apply(LEDGroup* group_p, uint8_t pattern)
+{
+    int i;
+
+    pattern &= LED_GROUP_PATTERNS - 1;
+
+    for (i = 0; i < group_p->numPorts; i++)
+    {
+        LEDGroupPort* port_p = &group_p->ports[i];
+        uint8_t output = port_p->outputs[pattern];
+        uint8_t changed = output ^ port_p->outputs[group_p->pattern];
+
+        if (changed == 0) {
+            continue;
+        }
+
+        volatile uint8_t* out_p = portOutputs[port_p->port - GPIO_PORT_P1];
+
+        // A power of two means exactly one pin changes
+        if ((changed & (changed - 1)) == 0)
+        {
+            int bit = 31 - __CLZ(changed);
+            BITBAND_PERI(*out_p, bit) = (output & changed) != 0;
+        }
+        else {
+            *out_p = (*out_p & ~port_p->mask) | output;
+        }
+    }
+
+    group_p->pattern = pattern;
+}
+
+/**
+ * Returns the pattern currently shown on the group.
+ *
+ * @param group_p:  The group to query
+ * @return the pattern last passed to LEDGroup_apply()
+ */
+uint8_t LEDGroup_getPattern(LEDGroup* group_p)
+{
+    return group_p->pattern;
+}
+
+/**
+ * The LEDGroup equivalent of LED_isLit().
+ *
+ * @param group_p:  The group to query
+ * @param led:      The bit of the LED, as returned by LEDGroup_addLED()
+ * @return true if the LED is lit
+ */
+bool LEDGroup_isLit(LEDGroup* group_p, int led)
+{
+    return (group_p->pattern & (1 << led)) != 0;
+}
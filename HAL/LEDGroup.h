@@ -0,0 +1,75 @@
+/*
+ * LEDGroup.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HAL_LEDGROUP_H_
+#define HAL_LEDGROUP_H_
+
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+// A group holds up to this many LEDs, one bit of a pattern each. The output
+// of every port is precomputed for all 2^LED_GROUP_MAX_LEDS patterns.
+#define LED_GROUP_MAX_LEDS      4
+#define LED_GROUP_PATTERNS      (1 << LED_GROUP_MAX_LEDS)
+#define LED_GROUP_MAX_PORTS     LED_GROUP_MAX_LEDS
+
+/**
+ * One port touched by a group. outputs[pattern] holds the levels of the
+ * group's pins on this port for every pattern.
+ */
+struct _LEDGroupPort
+{
+    uint8_t port;
+    uint8_t mask;
+    uint8_t outputs[LED_GROUP_PATTERNS];
+};
+typedef struct _LEDGroupPort LEDGroupPort;
+
+/**=============================================================================
+ * A group of LEDs which are switched together, implemented in the C
+ * object-oriented style. Use the constructor [LEDGroup_construct()], add each
+ * LED with [LEDGroup_addLED()], then show patterns with [LEDGroup_apply()].
+ * Bit N of a pattern is the Nth LED added.
+ *
+ * Every pin of a port changes with a single store: a bit-band alias store
+ * when only one pin of the port changes, and one masked write of the output
+ * register otherwise. A pattern therefore costs at most one write per port,
+ * and all LEDs on the same port change at exactly the same time.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * LEDGroup only tracks its own pattern, so LED_isLit() on an LED object which
+ * shares a pin with a group does not see the group's changes. Use
+ * LEDGroup_isLit() instead.
+ *
+ * When using this object, DO NOT DIRECTLY ACCESS ANY MEMBER VARIABLES of the
+ * LEDGroup struct.
+ */
+struct _LEDGroup
+{
+    LEDGroupPort ports[LED_GROUP_MAX_PORTS];
+    int numPorts;
+    int numLEDs;
+
+    uint8_t pattern;    // The pattern currently shown
+};
+typedef struct _LEDGroup LEDGroup;
+
+// Constructs an empty LED group.
+LEDGroup LEDGroup_construct();
+
+// Adds an LED to the group and returns its bit in a pattern, or -1 if full.
+int LEDGroup_addLED(LEDGroup* group_p, uint8_t port, uint16_t pin);
+
+// Shows a pattern, with at most one write per port.
+void LEDGroup_apply(LEDGroup* group_p, uint8_t pattern);
+
+// Returns the pattern currently shown.
+uint8_t LEDGroup_getPattern(LEDGroup* group_p);
+
+// Returns whether one LED of the group is lit.
+bool LEDGroup_isLit(LEDGroup* group_p, int led);
+
+#endif /* HAL_LEDGROUP_H_ */
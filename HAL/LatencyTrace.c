@@ -0,0 +1,271 @@
+/*
+ * LatencyTrace.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <HAL/LatencyTrace.h>
+
+#define CYCLES_PER_US   ((SYSTEM_CLOCK / PRESCALER) / US_DIVISION_FACTOR)
+
+#if LATENCY_TRACE_ENABLED
+volatile uint32_t latencyTraceLastSpiByte = 0;
+#endif
+
+/**
+ * The input currently being traced. All stamps are low 32 bits of
+ * HWTimer_getCycles().
+ */
+struct _LatencyInFlight
+{
+    bool inputPending;
+    bool transitionPending;
+    LatencyType type;
+
+    uint32_t edgeTime;
+    uint32_t debouncedTime;
+    uint32_t transitionTime;
+};
+typedef struct _LatencyInFlight LatencyInFlight;
+
+static LatencyInFlight inFlight = { false, false, LATENCY_CURSOR_MOVE, 0, 0, 0 };
+static LatencyStats latencyStats[NUM_LATENCY_TYPES];
+static LatencyInputStats inputStats;
+
+static const char* latencyNames[NUM_LATENCY_TYPES] =
+{
+    "cursor move",
+    "select",
+    "end guessing"
+};
+
+/**
+ * Finds the histogram bucket of a latency. Values below LATENCY_SUB_BUCKETS
+ * get a bucket each; above that, every power of two is split into
+ * LATENCY_SUB_BUCKETS equal buckets by the two bits below the leading one.
+ */
+static int LatencyTrace_bucket(uint32_t value_us)
+{
+    if (value_us < LATENCY_SUB_BUCKETS) {
+        return value_us;
+    }
+
+    int exponent = 31 - __CLZ(value_us);
+    int sub = (value_us >> (exponent - 2)) & (LATENCY_SUB_BUCKETS - 1);
+    int bucket = (exponent - 1) * LATENCY_SUB_BUCKETS + sub;
+
+    return bucket < LATENCY_BUCKETS ? bucket : LATENCY_BUCKETS - 1;
+}
+
+/** Returns the largest latency which falls into a bucket. */
+static uint32_t LatencyTrace_bucketUpperEdge(int bucket)
+{
+    if (bucket < LATENCY_SUB_BUCKETS) {
+        return bucket;
+    }
+
+    int exponent = bucket / LATENCY_SUB_BUCKETS + 1;
+    int sub = bucket % LATENCY_SUB_BUCKETS;
+    uint32_t lowerEdge = (uint32_t) (LATENCY_SUB_BUCKETS + sub) << (exponent - 2);
+
+    return lowerEdge + ((uint32_t) 1 << (exponent - 2)) - 1;
+}
+
+/**
+ * Clears the statistics of every transition type and drops any input which
+ * is currently being traced.
+ */
+void LatencyTrace_reset()
+{
+    int type, i;
+
+    for (type = 0; type < NUM_LATENCY_TYPES; type++)
+    {
+        latencyStats[type].count = 0;
+        latencyStats[type].max_us = 0;
+
+        for (i = 0; i < NUM_LATENCY_STAGES; i++) {
+            latencyStats[type].stageTotal_us[i] = 0;
+        }
+        for (i = 0; i < LATENCY_BUCKETS; i++) {
+            latencyStats[type].histogram[i] = 0;
+        }
+    }
+
+    inputStats.traced = 0;
+    inputStats.skipped = 0;
+    inputStats.dropped = 0;
+
+    inFlight.inputPending = false;
+    inFlight.transitionPending = false;
+}
+
+/**
+ * Starts tracing an input. Called by Button_refresh() whenever it reports a
+ * tap. Buttons which do not capture their raw edges pass the current time,
+ * which makes their debounce stage read as zero. If an input is already being
+ * traced, this one is only counted as skipped: its event is queued behind the
+ * traced one, so replacing the trace would charge the earlier transition to
+ * the later input.
+ *
+ * @param edgeTime:     When the raw edge of the input happened
+ */
+void LatencyTrace_markInput(uint32_t edgeTime)
+{
+    if (inFlight.inputPending)
+    {
+        inputStats.skipped++;
+        return;
+    }
+
+    inputStats.traced++;
+    inFlight.inputPending = true;
+    inFlight.transitionPending = false;
+    inFlight.edgeTime = edgeTime;
+    inFlight.debouncedTime = (uint32_t) HWTimer_getCycles();
+}
+
+/**
+ * Stamps the FSM transition caused by the traced input. Does nothing if no
+ * input is being traced, e.g. for a transition caused by a timer.
+ *
+ * @param type:     The kind of transition which is about to be drawn
+ */
+void LatencyTrace_markTransition(LatencyType type)
+{
+    if (!inFlight.inputPending) {
+        return;
+    }
+
+    inFlight.transitionPending = true;
+    inFlight.type = type;
+    inFlight.transitionTime = (uint32_t) HWTimer_getCycles();
+}
+
+/**
+ * Ends the trace after the redraw of a transition. The time of the last SPI
+ * byte is converted from DWT cycles by measuring how long ago it was sent. If
+ * no byte was sent since the transition, the redraw stage is zero. Called
+ * after every dispatch, so an input whose event caused no transition is
+ * dropped here rather than left to block later inputs.
+ */
+void LatencyTrace_complete()
+{
+    if (!inFlight.transitionPending)
+    {
+        LatencyTrace_cancel();
+        return;
+    }
+
+    uint32_t photonTime = (uint32_t) HWTimer_getCycles();
+
+#if LATENCY_TRACE_ENABLED
+    photonTime -= Profiler_now() - latencyTraceLastSpiByte;
+#endif
+
+    if ((int32_t) (photonTime - inFlight.transitionTime) < 0) {
+        photonTime = inFlight.transitionTime;
+    }
+
+    LatencyStats* stats_p = &latencyStats[inFlight.type];
+    uint32_t total_us = (photonTime - inFlight.edgeTime) / CYCLES_PER_US;
+
+    stats_p->stageTotal_us[LATENCY_STAGE_DEBOUNCE] += (inFlight.debouncedTime - inFlight.edgeTime) / CYCLES_PER_US;
+    stats_p->stageTotal_us[LATENCY_STAGE_DISPATCH] += (inFlight.transitionTime - inFlight.debouncedTime) / CYCLES_PER_US;
+    stats_p->stageTotal_us[LATENCY_STAGE_REDRAW] += (photonTime - inFlight.transitionTime) / CYCLES_PER_US;
+
+    stats_p->count++;
+    stats_p->histogram[LatencyTrace_bucket(total_us)]++;
+    if (total_us > stats_p->max_us) {
+        stats_p->max_us = total_us;
+    }
+
+    inFlight.inputPending = false;
+    inFlight.transitionPending = false;
+}
+
+/**
+ * Drops the input being traced, unless it has already caused a transition
+ * which is waiting for LatencyTrace_complete(). The application calls this
+ * once it knows the input posted no event.
+ */
+void LatencyTrace_cancel()
+{
+    if (!inFlight.inputPending || inFlight.transitionPending) {
+        return;
+    }
+
+    inputStats.dropped++;
+    inFlight.inputPending = false;
+}
+
+/**
+ * Returns the statistics of one transition type. Divide a stage total by the
+ * count for the mean time spent in that stage.
+ *
+ * @param type:     The transition type to query
+ * @return a read-only pointer to the statistics
+ */
+const LatencyStats* LatencyTrace_getStats(LatencyType type)
+{
+    return &latencyStats[type];
+}
+
+/**
+ * Returns how many inputs started a trace, how many were skipped because
+ * another was already being traced, and how many traces ended without a
+ * transition.
+ *
+ * @return a read-only pointer to the input statistics
+ */
+const LatencyInputStats* LatencyTrace_getInputStats()
+{
+    return &inputStats;
+}
+
+/**
+ * Estimates a percentile of the end-to-end latency of one transition type,
+ * e.g. 500 for p50 or 990 for p99. The result is the upper edge of the bucket
+ * holding the percentile, clamped to the maximum, so it never underestimates.
+ *
+ * @param type:         The transition type to query
+ * @param permille:     The percentile, in tenths of a percent
+ * @return an upper bound on the percentile in microseconds, or 0 if empty
+ */
+uint32_t LatencyTrace_getPercentileUS(LatencyType type, uint32_t permille)
+{
+    const LatencyStats* stats_p = &latencyStats[type];
+    uint32_t target = (uint32_t) (((uint64_t) stats_p->count * permille + 999) / 1000);
+    uint32_t cumulative = 0;
+    int bucket;
+
+    if (stats_p->count == 0) {
+        return 0;
+    }
+
+    for (bucket = 0; bucket < LATENCY_BUCKETS - 1; bucket++)
+    {
+        cumulative += stats_p->histogram[bucket];
+        if (cumulative >= target) {
+            break;
+        }
+    }
+
+    uint32_t upperEdge = LatencyTrace_bucketUpperEdge(bucket);
+    if (bucket == LATENCY_BUCKETS - 1 || upperEdge > stats_p->max_us) {
+        return stats_p->max_us;
+    }
+
+    return upperEdge;
+}
+
+/**
+ * Returns the human-readable name of a transition type.
+ *
+ * @param type:     The transition type
+ * @return a constant string
+ */
+const char* LatencyTrace_getName(LatencyType type)
+{
+    return latencyNames[type];
+}
@@ -0,0 +1,135 @@
+/*
+ * LatencyTrace.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HAL_LATENCYTRACE_H_
+#define HAL_LATENCYTRACE_H_
+
+#include <HAL/Timer.h>
+#include <HAL/Profiler.h>
+
+// Set to 0 to compile every trace point, including the one in the LCD
+// driver's byte loop, down to nothing.
+#ifndef LATENCY_TRACE_ENABLED
+#define LATENCY_TRACE_ENABLED   1
+#endif
+
+// Latencies are kept in a histogram with four buckets per power of two, so a
+// reported percentile is never more than 25% above the true value. 96
+// buckets reach past 16 seconds.
+#define LATENCY_SUB_BUCKETS     4
+#define LATENCY_BUCKETS         96
+
+/**
+ * The kinds of transition whose latency is tracked separately.
+ */
+enum _LatencyType
+{
+    LATENCY_CURSOR_MOVE,
+    LATENCY_SELECT,
+    LATENCY_END_GUESSING,
+    NUM_LATENCY_TYPES
+};
+typedef enum _LatencyType LatencyType;
+
+/**
+ * The stages of a single input, from the finger to the LCD. Each stage is the
+ * time from the previous stamp to this one.
+ */
+enum _LatencyStage
+{
+    LATENCY_STAGE_DEBOUNCE,     // Raw GPIO edge to debounced tap in Button_refresh()
+    LATENCY_STAGE_DISPATCH,     // Debounced tap to FSM transition
+    LATENCY_STAGE_REDRAW,       // FSM transition to the last SPI byte of the redraw
+    NUM_LATENCY_STAGES
+};
+typedef enum _LatencyStage LatencyStage;
+
+/**
+ * The statistics kept for one transition type. Latencies are in microseconds.
+ */
+struct _LatencyStats
+{
+    uint32_t count;
+    uint32_t max_us;
+    uint64_t stageTotal_us[NUM_LATENCY_STAGES];
+    uint32_t histogram[LATENCY_BUCKETS];
+};
+typedef struct _LatencyStats LatencyStats;
+
+/**
+ * What became of the inputs which could have started a trace.
+ */
+struct _LatencyInputStats
+{
+    uint32_t traced;        // Inputs which started a trace
+    uint32_t skipped;       // Inputs which arrived while another was being traced
+    uint32_t dropped;       // Traces which ended without a transition
+};
+typedef struct _LatencyInputStats LatencyInputStats;
+
+/**=============================================================================
+ * Input-to-photon latency tracing. A single input is followed through four
+ * timestamps:
+ *
+ *   1. the raw GPIO edge, captured by the port ISR of an edge-interrupt button
+ *   2. the debounced tap, when Button_refresh() reports it
+ *   3. the FSM transition, marked by the action of the transition
+ *   4. the last SPI byte of the redraw, stamped in HAL_LCD_writeData()
+ *
+ * The application calls LatencyTrace_complete() once the redraw of a
+ * transition is done, which adds the end-to-end latency to the distribution
+ * of that transition type. Only one input is in flight at a time: an input
+ * which arrives while another is being traced is skipped, since its event is
+ * queued behind the traced one. A trace ends after the next dispatch, or at
+ * LatencyTrace_cancel(), even if the input caused no transition, so an input
+ * which posts no event at all cannot hold the trace.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * The SPI byte stamp is a single store of the DWT cycle counter, while every
+ * other stamp uses HWTimer_getCycles(). Both count CPU cycles, so the SPI
+ * stamp is converted when the trace is completed. Call Profiler_init() before
+ * tracing so that the DWT counter is running.
+ */
+
+#if LATENCY_TRACE_ENABLED
+extern volatile uint32_t latencyTraceLastSpiByte;
+#define LATENCY_TRACE_SPI_BYTE()    (latencyTraceLastSpiByte = Profiler_now())
+#else
+#define LATENCY_TRACE_SPI_BYTE()
+#endif
+
+// Clears every distribution.
+void LatencyTrace_reset();
+
+// Starts tracing an input whose raw edge happened at edgeTime (low 32 bits of
+// HWTimer_getCycles()), unless one is already being traced. The debounced
+// stamp is taken now.
+void LatencyTrace_markInput(uint32_t edgeTime);
+
+// Stamps the FSM transition caused by the input being traced.
+void LatencyTrace_markTransition(LatencyType type);
+
+// Stamps the end of the redraw and records the trace, if one is complete.
+// Ends the trace either way.
+void LatencyTrace_complete();
+
+// Drops the input being traced, if it has not caused a transition yet.
+void LatencyTrace_cancel();
+
+// Returns the statistics of one transition type.
+const LatencyStats* LatencyTrace_getStats(LatencyType type);
+
+// Returns how many inputs were traced, skipped and dropped.
+const LatencyInputStats* LatencyTrace_getInputStats();
+
+// Returns an upper bound on a percentile (in tenths of a percent) of one type.
+uint32_t LatencyTrace_getPercentileUS(LatencyType type, uint32_t permille);
+
+// Returns the name of a transition type, for reports.
+const char* LatencyTrace_getName(LatencyType type);
+
+#endif /* HAL_LATENCYTRACE_H_ */
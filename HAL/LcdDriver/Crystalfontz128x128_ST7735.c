@@ -262,9 +262,9 @@ static void Crystalfontz128x128_PixelDrawMultiple(const Graphics_Display *pDispl
     uint16_t Data;
 
     //
-    // Set the cursor increment to left to right, followed by top to bottom.
+    // Open a window of exactly the pixels drawn, on this row only.
     //
-    Crystalfontz128x128_SetDrawFrame(lX,lY,lX+lCount,127);
+    Crystalfontz128x128_SetDrawFrame(lX,lY,lX+lCount-1,lY);
     HAL_LCD_writeCommand(CM_RAMWR);
 
     //
@@ -508,7 +508,7 @@ static void Crystalfontz128x128_RectFill(const Graphics_Display *pDisplay,
     int16_t i;
     int16_t pixels = (x1 - x0 + 1) * (y1 - y0 + 1);
     HAL_LCD_writeCommand(CM_RAMWR);
-    for (i = 0; i <= pixels; i++)
+    for (i = 0; i < pixels; i++)
     {
         HAL_LCD_writeData(ulValue>>8);
         HAL_LCD_writeData(ulValue);
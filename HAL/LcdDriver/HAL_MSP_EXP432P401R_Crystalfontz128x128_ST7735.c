@@ -38,10 +38,15 @@
 //*****************************************************************************
 
 #include <HAL/LcdDriver/HAL_MSP_EXP432P401R_Crystalfontz128x128_ST7735.h>
+#include <HAL/LatencyTrace.h>
+#include <HAL/SpiTrace.h>
+#include <HAL/FastGPIO.h>
 #include <ti/grlib/grlib.h>
 #include <ti/devices/msp432p4xx/driverlib/driverlib.h>
 #include <stdint.h>
 
+volatile uint32_t HAL_LCD_bytesSent = 0;
+
 void HAL_LCD_PortInit(void)
 {
     // LCD_SCK
@@ -86,7 +91,7 @@ void HAL_LCD_SpiInit(void)
 void HAL_LCD_writeCommand(uint8_t command)
 {
     // Set to command mode
-    GPIO_setOutputLowOnPin(LCD_DC_PORT, LCD_DC_PIN);
+    FAST_GPIO_CLEAR(LCD_DC_PORT, LCD_DC_PIN);
 
     // USCI_B0 Busy? //
     while (UCB0STATW & UCBUSY);
@@ -94,11 +99,16 @@ void HAL_LCD_writeCommand(uint8_t command)
     // Transmit data
     UCB0TXBUF = command;
 
+    // Record the byte while it shifts out
+    SPI_TRACE_BYTE(command, false);
+
     // USCI_B0 Busy? //
     while (UCB0STATW & UCBUSY);
 
     // Set back to data mode
-    GPIO_setOutputHighOnPin(LCD_DC_PORT, LCD_DC_PIN);
+    FAST_GPIO_SET(LCD_DC_PORT, LCD_DC_PIN);
+
+    HAL_LCD_bytesSent++;
 }
 
 
@@ -116,8 +126,15 @@ void HAL_LCD_writeData(uint8_t data)
     // Transmit data
     UCB0TXBUF = data;
 
+    // Record the byte while it shifts out
+    SPI_TRACE_BYTE(data, true);
+
     // USCI_B0 Busy? //
     while (UCB0STATW & UCBUSY);
+
+    // Remember when the latest byte reached the panel
+    LATENCY_TRACE_SPI_BYTE();
+    HAL_LCD_bytesSent++;
 }
 
 //*****************************************************************************
@@ -83,6 +83,10 @@ extern void HAL_LCD_writeData(uint8_t data);
 extern void HAL_LCD_PortInit(void);
 extern void HAL_LCD_SpiInit(void);
 
+// Every byte sent to the LCD, commands and data alike. Wraps around; take
+// the difference of two readings to measure a redraw.
+extern volatile uint32_t HAL_LCD_bytesSent;
+
 // Custom __delay_cycles() for non CCS Compiler
 #if !defined( __TI_ARM__ )
 #undef __delay_cycles
@@ -0,0 +1,206 @@
+/*
+ * LoopMonitor.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <HAL/LoopMonitor.h>
+
+/**
+ * Constructs a loop monitor. The first iteration is measured from the moment
+ * of construction.
+ *
+ * @param budget_us:    The longest acceptable iteration, in microseconds
+ * @return a LoopMonitor with all statistics cleared
+ */
+LoopMonitor LoopMonitor_construct(uint32_t budget_us)
+{
+    LoopMonitor monitor;
+    int tag, bucket;
+
+    monitor.budget_us = budget_us;
+    monitor.lastMark = HWTimer_getCycles();
+    monitor.lastTag = 0;
+    monitor.watchdogArmed = false;
+
+    monitor.alertLED_p = NULL;
+    monitor.alertTimer = SWTimer_construct(LOOP_MONITOR_BLINK_MS);
+
+    monitor.totalOverBudget = 0;
+    for (tag = 0; tag < LOOP_MONITOR_MAX_TAGS; tag++)
+    {
+        monitor.stats[tag].iterations = 0;
+        monitor.stats[tag].max_us = 0;
+        monitor.stats[tag].overBudget = 0;
+
+        for (bucket = 0; bucket < LOOP_MONITOR_BUCKETS; bucket++) {
+            monitor.stats[tag].histogram[bucket] = 0;
+        }
+    }
+
+    return monitor;
+}
+
+/**
+ * Selects an LED to light for LOOP_MONITOR_BLINK_MS after every over-budget
+ * iteration. The LED must outlive the monitor.
+ *
+ * @param monitor_p:    The monitor to configure
+ * @param led_p:        The LED to use as an alert
+ */
+void LoopMonitor_setAlertLED(LoopMonitor* monitor_p, LED* led_p)
+{
+    monitor_p->alertLED_p = led_p;
+}
+
+/**
+ * Replaces the held watchdog with a running one. From now on, every
+ * LoopMonitor_mark() and LoopMonitor_skip() kicks the watchdog, and a single
+ * iteration or sleep which takes longer than LOOP_MONITOR_WDT_TIMEOUT resets
+ * the board.
+ *
+ * @param monitor_p:    The monitor which will kick the watchdog
+ */
+void LoopMonitor_armWatchdog(LoopMonitor* monitor_p)
+{
+    WDT_A_initWatchdogTimer(WDT_A_CLOCKSOURCE_SMCLK, LOOP_MONITOR_WDT_TIMEOUT);
+    WDT_A_startTimer();
+
+    monitor_p->watchdogArmed = true;
+}
+
+/**
+ * Ends the current iteration. Its duration is added to the statistics of the
+ * tag passed to the previous mark, and the new tag is remembered for the
+ * iteration which starts now.
+ *
+ * @param monitor_p:    The monitor to update
+ * @param tag:          The tag of the iteration which starts now
+ */
+void LoopMonitor_mark(LoopMonitor* monitor_p, int tag)
+{
+    uint64_t now = HWTimer_getCycles();
+    uint32_t cyclesPerMicrosecond = (SYSTEM_CLOCK / PRESCALER) / US_DIVISION_FACTOR;
+    uint32_t elapsed_us = (uint32_t) ((now - monitor_p->lastMark) / cyclesPerMicrosecond);
+    LoopStats* stats_p = &monitor_p->stats[monitor_p->lastTag];
+
+    if (monitor_p->watchdogArmed) {
+        WDT_A_clearTimer();
+    }
+
+    int bucket = 0;
+    if (elapsed_us != 0) {
+        bucket = 31 - __CLZ(elapsed_us);
+    }
+    if (bucket >= LOOP_MONITOR_BUCKETS) {
+        bucket = LOOP_MONITOR_BUCKETS - 1;
+    }
+
+    stats_p->iterations++;
+    stats_p->histogram[bucket]++;
+
+    if (elapsed_us > stats_p->max_us) {
+        stats_p->max_us = elapsed_us;
+    }
+
+    if (elapsed_us > monitor_p->budget_us)
+    {
+        stats_p->overBudget++;
+        monitor_p->totalOverBudget++;
+
+        if (monitor_p->alertLED_p != NULL) {
+            LED_turnOn(monitor_p->alertLED_p);
+            SWTimer_start(&monitor_p->alertTimer);
+        }
+    }
+    else if (monitor_p->alertLED_p != NULL && LED_isLit(monitor_p->alertLED_p) &&
+             SWTimer_expired(&monitor_p->alertTimer))
+    {
+        LED_turnOff(monitor_p->alertLED_p);
+    }
+
+    if (tag >= 0 && tag < LOOP_MONITOR_MAX_TAGS) {
+        monitor_p->lastTag = tag;
+    }
+
+    // Restart from a fresh timestamp so that the monitor's own cost is
+    // charged to nobody
+    monitor_p->lastMark = HWTimer_getCycles();
+}
+
+/**
+ * Starts a new iteration without adding the current one to the statistics.
+ * Call this instead of LoopMonitor_mark() after a pass of the main loop which
+ * only slept, so that the time spent asleep is not taken for loop latency.
+ * It still kicks the watchdog.
+ *
+ * @param monitor_p:    The monitor to update
+ * @param tag:          The tag of the iteration which starts now
+ */
+void LoopMonitor_skip(LoopMonitor* monitor_p, int tag)
+{
+    if (monitor_p->watchdogArmed) {
+        WDT_A_clearTimer();
+    }
+
+    if (tag >= 0 && tag < LOOP_MONITOR_MAX_TAGS) {
+        monitor_p->lastTag = tag;
+    }
+
+    monitor_p->lastMark = HWTimer_getCycles();
+}
+
+/**
+ * Returns the statistics collected so far for one tag.
+ *
+ * @param monitor_p:    The monitor to query
+ * @param tag:          The tag to retrieve
+ * @return a read-only pointer to the statistics of the tag
+ */
+const LoopStats* LoopMonitor_getStats(LoopMonitor* monitor_p, int tag)
+{
+    return &monitor_p->stats[tag];
+}
+
+/**
+ * Estimates the 99th percentile iteration time of one tag from its histogram.
+ * The result is the upper edge of the bucket holding the 99th percentile,
+ * clamped to the maximum ever seen, so it never underestimates.
+ *
+ * @param monitor_p:    The monitor to query
+ * @param tag:          The tag to measure
+ * @return an upper bound on the 99th percentile, in microseconds
+ */
+uint32_t LoopMonitor_getP99US(LoopMonitor* monitor_p, int tag)
+{
+    const LoopStats* stats_p = &monitor_p->stats[tag];
+    uint32_t target = stats_p->iterations - stats_p->iterations / 100;
+    uint32_t cumulative = 0;
+    int bucket;
+
+    for (bucket = 0; bucket < LOOP_MONITOR_BUCKETS - 1; bucket++)
+    {
+        cumulative += stats_p->histogram[bucket];
+        if (cumulative >= target) {
+            break;
+        }
+    }
+
+    uint32_t upperEdge = ((uint32_t) 2 << bucket) - 1;
+    if (bucket == LOOP_MONITOR_BUCKETS - 1 || upperEdge > stats_p->max_us) {
+        return stats_p->max_us;
+    }
+
+    return upperEdge;
+}
+
+/**
+ * Returns the number of over-budget iterations across all tags.
+ *
+ * @param monitor_p:    The monitor to query
+ * @return the total count of over-budget iterations
+ */
+uint32_t LoopMonitor_getOverBudgetCount(LoopMonitor* monitor_p)
+{
+    return monitor_p->totalOverBudget;
+}
@@ -0,0 +1,96 @@
+/*
+ * LoopMonitor.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HAL_LOOPMONITOR_H_
+#define HAL_LOOPMONITOR_H_
+
+#include <HAL/LED.h>
+#include <HAL/Timer.h>
+
+// The number of distinct tags (for example, one per application state) for
+// which separate statistics are kept
+#define LOOP_MONITOR_MAX_TAGS       4
+
+// Number of log2 histogram buckets. Bucket N counts iterations lasting
+// [2^N, 2^(N+1)) microseconds; the last bucket also collects longer ones.
+#define LOOP_MONITOR_BUCKETS        20
+
+// How long the alert LED stays lit after an over-budget iteration
+#define LOOP_MONITOR_BLINK_MS       100
+
+// The watchdog timeout, in SMCLK cycles. At 48 MHz, 128M cycles is ~2.8 s,
+// over ten times the slowest full-screen redraw (~210 ms). The next shorter
+// setting, 8192K cycles, is only ~175 ms and would reset the board mid-redraw.
+#define LOOP_MONITOR_WDT_TIMEOUT    WDT_A_CLOCKITERATIONS_128M
+
+/**
+ * Iteration statistics collected for a single tag.
+ */
+struct _LoopStats
+{
+    uint32_t iterations;
+    uint32_t max_us;
+    uint32_t overBudget;
+    uint32_t histogram[LOOP_MONITOR_BUCKETS];
+};
+typedef struct _LoopStats LoopStats;
+
+/**=============================================================================
+ * A super-loop monitor, implemented in the C object-oriented style. Call
+ * [LoopMonitor_mark()] once per iteration of the main loop which did some
+ * work, and [LoopMonitor_skip()] instead after one which only slept. The time
+ * since the previous mark or skip is attributed to the tag passed to it, so
+ * pass the application state as it was when the iteration started. Sleep is
+ * never counted as loop latency.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * Treat all members as PRIVATE. Once [LoopMonitor_armWatchdog()] has been
+ * called, the board RESETS if two marks or skips are ever more than
+ * LOOP_MONITOR_WDT_TIMEOUT apart, so only arm it after all slow start-up work
+ * (such as initializing the LCD) has finished. Like the Scheduler, this
+ * object is large and should be given static storage.
+ */
+struct _LoopMonitor
+{
+    uint32_t budget_us;         // Iterations longer than this are counted as over budget
+    uint64_t lastMark;          // Timestamp of the previous mark, in hardware timer cycles
+    int lastTag;                // Tag passed to the previous mark
+    bool watchdogArmed;
+
+    LED* alertLED_p;            // Optional LED lit after an over-budget iteration
+    SWTimer alertTimer;         // Turns the alert LED back off
+
+    uint32_t totalOverBudget;
+    LoopStats stats[LOOP_MONITOR_MAX_TAGS];
+};
+typedef struct _LoopMonitor LoopMonitor;
+
+// Constructs a loop monitor which flags iterations longer than budget_us.
+LoopMonitor LoopMonitor_construct(uint32_t budget_us);
+
+// Lights the given LED briefly after every over-budget iteration.
+void LoopMonitor_setAlertLED(LoopMonitor* monitor_p, LED* led_p);
+
+// Starts the WDT_A as a hard stall detector, kicked by every mark and skip.
+void LoopMonitor_armWatchdog(LoopMonitor* monitor_p);
+
+// Marks the end of one iteration and the start of the next.
+void LoopMonitor_mark(LoopMonitor* monitor_p, int tag);
+
+// Starts the next iteration without recording this one, as after a sleep.
+void LoopMonitor_skip(LoopMonitor* monitor_p, int tag);
+
+// Returns the statistics for one tag.
+const LoopStats* LoopMonitor_getStats(LoopMonitor* monitor_p, int tag);
+
+// Returns an upper bound on the 99th percentile iteration time of one tag.
+uint32_t LoopMonitor_getP99US(LoopMonitor* monitor_p, int tag);
+
+// Returns how many iterations of any tag have exceeded the budget.
+uint32_t LoopMonitor_getOverBudgetCount(LoopMonitor* monitor_p);
+
+#endif /* HAL_LOOPMONITOR_H_ */
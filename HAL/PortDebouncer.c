@@ -0,0 +1,193 @@
+/*
+ * PortDebouncer.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <HAL/PortDebouncer.h>
+
+/**
+ * The debouncing state of one port. Each field holds one bit per pin.
+ */
+struct _PortState
+{
+    uint8_t enabledPins;    // Pins which belong to debounced buttons
+    uint8_t state;          // Debounced levels (1 = high = released)
+    uint8_t count0;         // Low bit of each pin's vertical counter
+    uint8_t count1;         // High bit of each pin's vertical counter
+    uint8_t tapped;         // Pins pressed since last consumed
+    uint8_t released;       // Pins released since last consumed
+};
+typedef struct _PortState PortState;
+
+static volatile PortState portStates[NUM_DEBOUNCED_PORTS];
+
+/** Input registers of each debounced port, indexed by port number minus one */
+static const volatile uint8_t* const portInputs[NUM_DEBOUNCED_PORTS] =
+{
+    &P1->IN, &P2->IN, &P3->IN, &P4->IN, &P5->IN, &P6->IN
+};
+
+/** Bit N is set when port N+1 has at least one enabled pin */
+static volatile uint8_t enabledPorts = 0;
+
+/**
+ * The SysTick ISR. Reads each enabled port register once and feeds it to the
+ * debouncer. DO NOT DIRECTLY INVOKE THIS FUNCTION FROM YOUR CODE.
+ */
+void SysTick_Handler()
+{
+    uint8_t ports = enabledPorts;
+    int i;
+
+    for (i = 0; ports != 0; i++, ports >>= 1)
+    {
+        if (ports & 1) {
+            PortDebouncer_sample(i + GPIO_PORT_P1, *portInputs[i]);
+        }
+    }
+}
+
+/**
+ * Enables debouncing for some pins of a port. The pins must already be
+ * configured as inputs. The first call starts SysTick at PORT_DEBOUNCE_RATE_HZ.
+ *
+ * @param port:     The GPIO port of the pins
+ * @param pins:     The mask of pins to debounce
+ */
+void PortDebouncer_enablePins(uint8_t port, uint8_t pins)
+{
+    volatile PortState* state_p = &portStates[port - GPIO_PORT_P1];
+
+    SysTick_disableInterrupt();
+
+    // Start the new pins from their current level, so a button which is
+    // already held down does not register as a tap
+    uint8_t rawInput = *portInputs[port - GPIO_PORT_P1];
+    state_p->state = (state_p->state & ~pins) | (rawInput & pins);
+    state_p->enabledPins |= pins;
+
+    bool firstPort = enabledPorts == 0;
+    enabledPorts |= 1 << (port - GPIO_PORT_P1);
+
+    if (firstPort) {
+        SysTick_setPeriod(SYSTEM_CLOCK / PORT_DEBOUNCE_RATE_HZ);
+        SysTick_enableModule();
+    }
+
+    SysTick_enableInterrupt();
+}
+
+/**
+ * Enables debouncing for some pins of a port without sampling them on
+ * SysTick. The caller is responsible for feeding the port's samples to
+ * PortDebouncer_sample(), as the PortSampler does with its DMA buffers.
+ *
+ * @param port:     The GPIO port of the pins
+ * @param pins:     The mask of pins to debounce
+ */
+void PortDebouncer_enableExternalPins(uint8_t port, uint8_t pins)
+{
+    volatile PortState* state_p = &portStates[port - GPIO_PORT_P1];
+
+    uint8_t rawInput = *portInputs[port - GPIO_PORT_P1];
+    state_p->state = (state_p->state & ~pins) | (rawInput & pins);
+    state_p->enabledPins |= pins;
+}
+
+/**
+ * Advances every pin of a port by one sample. A pin whose raw level differs
+ * from its debounced level counts up; a pin whose raw level matches resets its
+ * counter. When a counter wraps around after PORT_DEBOUNCE_SAMPLES samples,
+ * the pin's debounced level toggles.
+ *
+ * @param port:         The GPIO port which was sampled
+ * @param rawInput:     The value of the port's input register
+ */
+void PortDebouncer_sample(uint8_t port, uint8_t rawInput)
+{
+    volatile PortState* state_p = &portStates[port - GPIO_PORT_P1];
+
+    uint8_t state = state_p->state;
+    uint8_t delta = (rawInput ^ state) & state_p->enabledPins;
+    uint8_t count0 = state_p->count0;
+    uint8_t count1 = state_p->count1;
+
+    count1 = (count1 ^ count0) & delta;
+    count0 = ~count0 & delta;
+    uint8_t toggle = delta & ~(count0 | count1);
+    state ^= toggle;
+
+    state_p->count0 = count0;
+    state_p->count1 = count1;
+    state_p->state = state;
+
+    // A toggled pin which is now low was just pressed, and vice versa
+    state_p->tapped |= toggle & ~state;
+    state_p->released |= toggle & state;
+}
+
+/**
+ * Returns whether the SysTick ISR is sampling any port. Since SysTick is only
+ * started, and never stopped, by PortDebouncer_enablePins(), it then runs with
+ * its interrupt enabled at PORT_DEBOUNCE_RATE_HZ.
+ *
+ * @return true once any pin is debounced on SysTick
+ */
+bool PortDebouncer_isSampling()
+{
+    return enabledPorts != 0;
+}
+
+/**
+ * Returns the debounced pressed pins of a port.
+ *
+ * @param port:     The GPIO port to query
+ * @return a mask with a 1 for every enabled pin which is held down
+ */
+uint8_t PortDebouncer_getPressed(uint8_t port)
+{
+    volatile PortState* state_p = &portStates[port - GPIO_PORT_P1];
+    return ~state_p->state & state_p->enabledPins;
+}
+
+/**
+ * Returns and clears the tapped flags of some pins. The flags are set by the
+ * ISR, so SysTick is masked for the few instructions of the read-modify-write.
+ *
+ * @param port:     The GPIO port to query
+ * @param pins:     The pins whose flags to consume
+ * @return a mask with a 1 for every pin in pins which was pressed since the
+ *         last time it was consumed
+ */
+uint8_t PortDebouncer_consumeTapped(uint8_t port, uint8_t pins)
+{
+    volatile PortState* state_p = &portStates[port - GPIO_PORT_P1];
+
+    SysTick_disableInterrupt();
+    uint8_t tapped = state_p->tapped & pins;
+    state_p->tapped &= ~pins;
+    SysTick_enableInterrupt();
+
+    return tapped;
+}
+
+/**
+ * Returns and clears the released flags of some pins.
+ *
+ * @param port:     The GPIO port to query
+ * @param pins:     The pins whose flags to consume
+ * @return a mask with a 1 for every pin in pins which was released since the
+ *         last time it was consumed
+ */
+uint8_t PortDebouncer_consumeReleased(uint8_t port, uint8_t pins)
+{
+    volatile PortState* state_p = &portStates[port - GPIO_PORT_P1];
+
+    SysTick_disableInterrupt();
+    uint8_t released = state_p->released & pins;
+    state_p->released &= ~pins;
+    SysTick_enableInterrupt();
+
+    return released;
+}
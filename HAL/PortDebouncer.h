@@ -0,0 +1,64 @@
+/*
+ * PortDebouncer.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HAL_PORTDEBOUNCER_H_
+#define HAL_PORTDEBOUNCER_H_
+
+#include <HAL/Timer.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+// How often every enabled port is sampled. A level must be seen on four
+// consecutive samples to be accepted, so at 1 kHz the debounce time is 4 ms.
+#define PORT_DEBOUNCE_RATE_HZ   1000
+#define PORT_DEBOUNCE_SAMPLES   4
+
+// Ports P1 through P6 can be debounced
+#define NUM_DEBOUNCED_PORTS     6
+
+/**=============================================================================
+ * A whole-port debouncer. Every SysTick, each enabled input port register is
+ * read exactly once, and all eight pins of the port are debounced in parallel
+ * with a 2-bit vertical counter: bit N of count0 and count1 together form the
+ * counter for pin N. A pin's debounced level only changes after it has
+ * differed from the debounced level for PORT_DEBOUNCE_SAMPLES samples in a
+ * row, which takes a handful of bitwise instructions per port, no matter how
+ * many buttons are on it.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * All buttons are assumed to be active-low, as every button on the Launchpad
+ * and Boosterpack is. The pressed, tapped and released masks therefore have a
+ * 1 for each pin whose button is pressed, tapped or released.
+ *
+ * There is only ONE debouncer, owned by the SysTick ISR, so this module has no
+ * object to construct. Use the Button API (see Button_constructSampled())
+ * rather than calling this module directly.
+ */
+
+// Enables debouncing for the given pins, starting SysTick on first use.
+void PortDebouncer_enablePins(uint8_t port, uint8_t pins);
+
+// Enables debouncing for the given pins, leaving the sampling to the caller.
+void PortDebouncer_enableExternalPins(uint8_t port, uint8_t pins);
+
+// Returns whether SysTick is sampling, at PORT_DEBOUNCE_RATE_HZ, which it does
+// once any pin has been enabled with PortDebouncer_enablePins().
+bool PortDebouncer_isSampling();
+
+// Advances the debouncer of one port by one sample. Called by the SysTick
+// ISR; may also be fed samples captured by other means.
+void PortDebouncer_sample(uint8_t port, uint8_t rawInput);
+
+// Returns the pins of a port whose buttons are currently held down.
+uint8_t PortDebouncer_getPressed(uint8_t port);
+
+// Returns, and clears, the pins of a port which were pressed since last asked.
+uint8_t PortDebouncer_consumeTapped(uint8_t port, uint8_t pins);
+
+// Returns, and clears, the pins of a port which were released since last asked.
+uint8_t PortDebouncer_consumeReleased(uint8_t port, uint8_t pins);
+
+#endif /* HAL_PORTDEBOUNCER_H_ */
@@ -0,0 +1,230 @@
+/*
+ * PortSampler.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <HAL/PortSampler.h>
+
+#define PORT_SAMPLE_HALF_SIZE   (PORT_SAMPLE_BUFFER_SIZE / 2)
+
+/**
+ * One DMA channel copying a 16-bit port pair into its own circular buffer.
+ */
+struct _SampleChannel
+{
+    uint32_t dmaChannel;            // Channel number, including its trigger mapping
+    uint32_t dmaInterrupt;          // DMA_INTn assigned to the channel
+    const volatile uint16_t* source;// The 16-bit input register of the port pair
+    uint8_t lowPort;                // The port in the low byte of each sample
+
+    uint16_t samples[PORT_SAMPLE_BUFFER_SIZE];
+    volatile uint32_t halvesCompleted;  // Incremented by the DMA ISR
+    uint32_t samplesProcessed;          // Only touched by the main loop
+};
+typedef struct _SampleChannel SampleChannel;
+
+static SampleChannel sampleChannels[2] =
+{
+    { DMA_CH2_TIMERA1CCR0, DMA_INT1, &PB->IN, GPIO_PORT_P3 },
+    { DMA_CH3_TIMERA1CCR2, DMA_INT2, &PC->IN, GPIO_PORT_P5 }
+};
+
+static bool samplerStarted = false;
+static uint32_t sampleOverruns = 0;
+
+/** Arms one half of a channel's buffer. Half 0 is primary, half 1 is alternate. */
+static void PortSampler_armHalf(SampleChannel* channel_p, int half)
+{
+    uint32_t structure = half == 0 ? UDMA_PRI_SELECT : UDMA_ALT_SELECT;
+
+    DMA_setChannelTransfer(structure | channel_p->dmaChannel, UDMA_MODE_PINGPONG,
+                           (void*) channel_p->source,
+                           &channel_p->samples[half * PORT_SAMPLE_HALF_SIZE],
+                           PORT_SAMPLE_HALF_SIZE);
+}
+
+/**
+ * The shared body of both DMA ISRs. The controller has already switched to
+ * the other half, so the half which just completed is re-armed for its next
+ * turn.
+ */
+static void PortSampler_handleInterrupt(SampleChannel* channel_p)
+{
+    uint32_t channelNum = channel_p->dmaChannel & 0x0F;
+    DMA_clearInterruptFlag(channelNum);
+
+    uint32_t completed = channel_p->halvesCompleted;
+    PortSampler_armHalf(channel_p, completed & 1);
+    channel_p->halvesCompleted = completed + 1;
+}
+
+/** DMA channel 2 (P3/P4) finished a half buffer. */
+void DMA_INT1_IRQHandler()
+{
+    PortSampler_handleInterrupt(&sampleChannels[0]);
+}
+
+/** DMA channel 3 (P5/P6) finished a half buffer. */
+void DMA_INT2_IRQHandler()
+{
+    PortSampler_handleInterrupt(&sampleChannels[1]);
+}
+
+/** Configures both DMA channels and starts Timer_A1 triggering them. */
+static void PortSampler_start()
+{
+    int i;
+
+    DMAControl_init();
+
+    for (i = 0; i < 2; i++)
+    {
+        SampleChannel* channel_p = &sampleChannels[i];
+        uint32_t channelNum = channel_p->dmaChannel & 0x0F;
+
+        // Seed the buffer with the current levels, so unwritten samples read
+        // as "nothing changed"
+        int sample;
+        for (sample = 0; sample < PORT_SAMPLE_BUFFER_SIZE; sample++) {
+            channel_p->samples[sample] = *channel_p->source;
+        }
+
+        channel_p->halvesCompleted = 0;
+        channel_p->samplesProcessed = 0;
+
+        DMA_assignChannel(channel_p->dmaChannel);
+        DMA_setChannelControl(UDMA_PRI_SELECT | channel_p->dmaChannel,
+                              UDMA_SIZE_16 | UDMA_SRC_INC_NONE | UDMA_DST_INC_16 | UDMA_ARB_1);
+        DMA_setChannelControl(UDMA_ALT_SELECT | channel_p->dmaChannel,
+                              UDMA_SIZE_16 | UDMA_SRC_INC_NONE | UDMA_DST_INC_16 | UDMA_ARB_1);
+        PortSampler_armHalf(channel_p, 0);
+        PortSampler_armHalf(channel_p, 1);
+
+        DMA_assignInterrupt(channel_p->dmaInterrupt, channelNum);
+        Interrupt_enableInterrupt(channel_p->dmaInterrupt == DMA_INT1 ? INT_DMA_INT1 : INT_DMA_INT2);
+        DMA_enableChannel(channelNum);
+    }
+
+    // CCR0 ends each period and triggers channel 2; CCR2 fires halfway
+    // through and triggers channel 3
+    Timer_A_UpModeConfig upConfig =
+    {
+        TIMER_A_CLOCKSOURCE_SMCLK,
+        TIMER_A_CLOCKSOURCE_DIVIDER_48,
+        PORT_SAMPLE_TIMER_HZ / PORT_SAMPLE_RATE_HZ - 1,
+        TIMER_A_TAIE_INTERRUPT_DISABLE,
+        TIMER_A_CCIE_CCR0_INTERRUPT_DISABLE,
+        TIMER_A_DO_CLEAR
+    };
+
+    Timer_A_CompareModeConfig compareConfig =
+    {
+        TIMER_A_CAPTURECOMPARE_REGISTER_2,
+        TIMER_A_CAPTURECOMPARE_INTERRUPT_DISABLE,
+        TIMER_A_OUTPUTMODE_OUTBITVALUE,
+        PORT_SAMPLE_TIMER_HZ / PORT_SAMPLE_RATE_HZ / 2
+    };
+
+    Timer_A_configureUpMode(TIMER_A1_BASE, &upConfig);
+    Timer_A_initCompare(TIMER_A1_BASE, &compareConfig);
+    Timer_A_startCounter(TIMER_A1_BASE, TIMER_A_UP_MODE);
+
+    samplerStarted = true;
+}
+
+/**
+ * Enables sampling for some pins. The pins must already be configured as
+ * inputs. The first call starts the DMA channels and Timer_A1.
+ *
+ * @param port:     The GPIO port of the pins, from P3 to P6
+ * @param pins:     The mask of pins to debounce
+ */
+void PortSampler_enablePins(uint8_t port, uint8_t pins)
+{
+    PortDebouncer_enableExternalPins(port, pins);
+
+    if (!samplerStarted) {
+        PortSampler_start();
+    }
+}
+
+/**
+ * Works out how many samples a channel has written in total. The write
+ * position inside the active half comes from the remaining transfer count of
+ * the active control structure. When the controller has already switched
+ * halves but the ISR has not run yet, the completed half is counted here.
+ */
+static uint32_t PortSampler_samplesWritten(SampleChannel* channel_p)
+{
+    uint32_t channelNum = channel_p->dmaChannel & 0x0F;
+    uint32_t halves = channel_p->halvesCompleted;
+
+    bool alternateActive = (DMA_getChannelAttribute(channelNum) & UDMA_ATTR_ALTSELECT) != 0;
+    if ((alternateActive ? 1 : 0) != (halves & 1)) {
+        halves++;
+    }
+
+    uint32_t structure = alternateActive ? UDMA_ALT_SELECT : UDMA_PRI_SELECT;
+    uint32_t remaining = DMA_getChannelSize(structure | channel_p->dmaChannel);
+    if (remaining > PORT_SAMPLE_HALF_SIZE) {
+        remaining = PORT_SAMPLE_HALF_SIZE;
+    }
+
+    return halves * PORT_SAMPLE_HALF_SIZE + (PORT_SAMPLE_HALF_SIZE - remaining);
+}
+
+/**
+ * Feeds every new sample of both channels to the PortDebouncer, oldest first.
+ * Call this once per pass of the main loop, before refreshing any buttons.
+ * If more than a whole buffer was written since the last call, the oldest
+ * samples were overwritten; they are counted as overruns and skipped.
+ */
+void PortSampler_process()
+{
+    int i;
+
+    if (!samplerStarted) {
+        return;
+    }
+
+    for (i = 0; i < 2; i++)
+    {
+        SampleChannel* channel_p = &sampleChannels[i];
+        uint32_t written = PortSampler_samplesWritten(channel_p);
+
+        // A stale position read right at a half boundary can look like time
+        // went backwards; just wait for the next call
+        if ((int32_t) (written - channel_p->samplesProcessed) <= 0) {
+            continue;
+        }
+
+        if (written - channel_p->samplesProcessed > PORT_SAMPLE_BUFFER_SIZE) {
+            uint32_t lost = written - channel_p->samplesProcessed - PORT_SAMPLE_BUFFER_SIZE;
+            sampleOverruns += lost;
+            channel_p->samplesProcessed += lost;
+        }
+
+        while (channel_p->samplesProcessed != written)
+        {
+            uint16_t sample = channel_p->samples[channel_p->samplesProcessed % PORT_SAMPLE_BUFFER_SIZE];
+
+            PortDebouncer_sample(channel_p->lowPort, (uint8_t) sample);
+            PortDebouncer_sample(channel_p->lowPort + 1, (uint8_t) (sample >> 8));
+
+            channel_p->samplesProcessed++;
+        }
+    }
+}
+
+/**
+ * Returns the number of samples which were overwritten before
+ * PortSampler_process() got to them. This only happens when the main loop
+ * stalls for longer than a whole buffer.
+ *
+ * @return the total number of lost samples
+ */
+uint32_t PortSampler_getOverruns()
+{
+    return sampleOverruns;
+}
@@ -0,0 +1,47 @@
+/*
+ * PortSampler.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HAL_PORTSAMPLER_H_
+#define HAL_PORTSAMPLER_H_
+
+#include <HAL/DMAControl.h>
+#include <HAL/PortDebouncer.h>
+
+// The rate at which Timer_A1 triggers a sample of every sampled port. The
+// timer runs from SMCLK divided by 48, i.e. at 1 MHz.
+#define PORT_SAMPLE_RATE_HZ         1000
+#define PORT_SAMPLE_TIMER_HZ        1000000
+
+// Samples kept per port pair. The DMA fills each half of the buffer in turn,
+// so the main loop may stall for up to this many sample periods (512 ms at
+// 1 kHz) without losing a single sample. MUST be even.
+#define PORT_SAMPLE_BUFFER_SIZE     512
+
+/**=============================================================================
+ * A DMA-driven port sampler. Timer_A1 raises two DMA requests per period: the
+ * CCR0 request makes channel 2 copy PBIN (P3 in the low byte, P4 in the high
+ * byte) and the CCR2 request makes channel 3 copy PCIN (P5 and P6) into
+ * circular SRAM buffers. The CPU is only involved once per half buffer, to
+ * re-arm the finished half. [PortSampler_process()] then feeds every sample
+ * collected since its last call to the PortDebouncer in one batch.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * Only ports 3 through 6 can be sampled. Port 1 would need a third DMA
+ * channel and trigger, so Launchpad buttons should stay tick-sampled. A port
+ * whose pins are sampled here must not also be sampled by SysTick.
+ */
+
+// Enables DMA sampling for some pins of P3-P6, starting the sampler on first use.
+void PortSampler_enablePins(uint8_t port, uint8_t pins);
+
+// Debounces every sample collected since the last call.
+void PortSampler_process();
+
+// Returns how many samples were overwritten before they could be processed.
+uint32_t PortSampler_getOverruns();
+
+#endif /* HAL_PORTSAMPLER_H_ */
@@ -0,0 +1,298 @@
+/*
+ * Profiler.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <HAL/Profiler.h>
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#define PROF_BINARY_MAGIC_0     'P'
+#define PROF_BINARY_MAGIC_1     'F'
+#define PROF_BINARY_VERSION     1
+#define PROF_BINARY_HEADER_SIZE 5
+#define PROF_BINARY_PROBE_SIZE  (4 + 4 + 4 + 8 + 4 * PROF_HISTOGRAM_BUCKETS)
+
+/** The statistics table. Indexed by ProfileProbe. */
+static ProfileStats profileTable[NUM_PROF_PROBES];
+
+/** Printable names for each probe, in the same order as ProfileProbe. */
+static const char* const profileNames[NUM_PROF_PROBES] =
+{
+    "GFX_clear",
+    "GFX_print",
+    "Graphics_drawImage",
+    "GFX_showFrame",
+    "UI_show",
+    "HAL_refresh",
+    "TITLE_SCREEN events",
+    "INSTRUCTIONS_SCREEN events",
+    "GAME_SCREEN events",
+    "RESULT_SCREEN events",
+    "KVStore flush",
+    "KVStore erase",
+    "GPIO driverlib",
+    "GPIO bit-band",
+    "overhead"
+};
+
+#if !defined(__MSP432P401R__)
+/** The default host clock never advances until a real one is installed. */
+static uint32_t Profiler_nullClock()
+{
+    return 0;
+}
+
+uint32_t (*Profiler_clock)(void) = Profiler_nullClock;
+#endif
+
+/**
+ * Enables the DWT cycle counter, which is disabled out of reset, and clears
+ * the statistics table. Call this once after InitSystemTiming().
+ */
+void Profiler_init()
+{
+#if defined(__MSP432P401R__)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+    Profiler_reset();
+}
+
+/**
+ * Installs the function used to timestamp probes in host builds. The clock
+ * must count up and may wrap around at 32 bits.
+ *
+ * @param clock:    The function returning the current cycle count
+ */
+void Profiler_setClock(uint32_t (*clock)(void))
+{
+#if !defined(__MSP432P401R__)
+    Profiler_clock = clock;
+#endif
+}
+
+/**
+ * Clears the statistics of every probe.
+ */
+void Profiler_reset()
+{
+    int i;
+    for (i = 0; i < NUM_PROF_PROBES; i++)
+    {
+        ProfileStats* stats_p = &profileTable[i];
+        int bucket;
+
+        stats_p->count = 0;
+        stats_p->min = UINT32_MAX;
+        stats_p->max = 0;
+        stats_p->total = 0;
+
+        for (bucket = 0; bucket < PROF_HISTOGRAM_BUCKETS; bucket++) {
+            stats_p->histogram[bucket] = 0;
+        }
+    }
+}
+
+/**
+ * Adds one measured duration to a probe. The histogram bucket is the position
+ * of the most significant set bit, which is a single CLZ instruction on the
+ * Cortex-M4.
+ *
+ * @param probe:    The probe to update
+ * @param cycles:   The duration of the measured block, in cycles
+ */
+void Profiler_record(ProfileProbe probe, uint32_t cycles)
+{
+    ProfileStats* stats_p = &profileTable[probe];
+    int bucket = 0;
+
+    if (cycles != 0) {
+        bucket = 31 - __CLZ(cycles);
+    }
+
+    if (bucket >= PROF_HISTOGRAM_BUCKETS) {
+        bucket = PROF_HISTOGRAM_BUCKETS - 1;
+    }
+
+    stats_p->count++;
+    stats_p->total += cycles;
+    stats_p->histogram[bucket]++;
+
+    if (cycles < stats_p->min) {
+        stats_p->min = cycles;
+    }
+
+    if (cycles > stats_p->max) {
+        stats_p->max = cycles;
+    }
+}
+
+/**
+ * Returns the statistics collected so far for a probe.
+ *
+ * @param probe:    The probe to retrieve
+ * @return a read-only pointer into the statistics table
+ */
+const ProfileStats* Profiler_getStats(ProfileProbe probe)
+{
+    return &profileTable[probe];
+}
+
+/**
+ * Returns the printable name of a probe.
+ *
+ * @param probe:    The probe to name
+ * @return the name of the probe
+ */
+const char* Profiler_getName(ProfileProbe probe)
+{
+    return profileNames[probe];
+}
+
+/**
+ * The overhead benchmark. Times PROF_OVERHEAD_ITERATIONS empty probe pairs
+ * into the PROF_OVERHEAD probe. The minimum is reported rather than the mean
+ * so that an interrupt landing inside one pair does not skew the result.
+ *
+ * @return the minimum cost of one PROF_BEGIN()/PROF_END() pair, in cycles
+ */
+uint32_t Profiler_measureOverhead()
+{
+    int i;
+    for (i = 0; i < PROF_OVERHEAD_ITERATIONS; i++)
+    {
+        PROF_BEGIN(PROF_OVERHEAD);
+        PROF_END(PROF_OVERHEAD);
+    }
+
+    return profileTable[PROF_OVERHEAD].min;
+}
+
+/** Appends formatted text to a report, never writing past the end of it. */
+static size_t Profiler_append(char* buffer, size_t size, size_t used, const char* format, ...)
+{
+    va_list args;
+    int written;
+
+    if (used >= size) {
+        return used;
+    }
+
+    va_start(args, format);
+    written = vsnprintf(buffer + used, size - used, format, args);
+    va_end(args);
+
+    if (written < 0) {
+        return used;
+    }
+
+    used += written;
+    return used < size ? used : size - 1;
+}
+
+/**
+ * Writes one line per probe which has been hit at least once, in the form
+ *     name count min avg max | h0 h1 ... hN
+ * where hN is the count in histogram bucket N. Output is truncated (but
+ * always terminated) when the buffer is too small.
+ *
+ * @param buffer:   The destination character buffer
+ * @param size:     The size of the destination buffer
+ * @return the number of characters written, excluding the terminator
+ */
+size_t Profiler_dumpText(char* buffer, size_t size)
+{
+    size_t used = 0;
+    int i;
+
+    if (size == 0) {
+        return 0;
+    }
+    buffer[0] = '\0';
+
+    for (i = 0; i < NUM_PROF_PROBES; i++)
+    {
+        const ProfileStats* stats_p = &profileTable[i];
+        int bucket;
+
+        if (stats_p->count == 0) {
+            continue;
+        }
+
+        used = Profiler_append(buffer, size, used, "%s %lu %lu %lu %lu |",
+                               profileNames[i],
+                               (unsigned long) stats_p->count,
+                               (unsigned long) stats_p->min,
+                               (unsigned long) (stats_p->total / stats_p->count),
+                               (unsigned long) stats_p->max);
+
+        for (bucket = 0; bucket < PROF_HISTOGRAM_BUCKETS; bucket++) {
+            used = Profiler_append(buffer, size, used, " %lu", (unsigned long) stats_p->histogram[bucket]);
+        }
+
+        used = Profiler_append(buffer, size, used, "\n");
+    }
+
+    return used;
+}
+
+/** Appends a little-endian value of the given width to a binary report. */
+static uint8_t* Profiler_putLE(uint8_t* out_p, uint64_t value, int width)
+{
+    int i;
+    for (i = 0; i < width; i++) {
+        *out_p++ = (uint8_t) (value >> (8 * i));
+    }
+
+    return out_p;
+}
+
+/**
+ * Writes the whole statistics table in a fixed little-endian layout:
+ *     'P' 'F' version numProbes numBuckets
+ * followed, for every probe in ProfileProbe order, by
+ *     count(u32) min(u32) max(u32) total(u64) histogram(u32 x numBuckets)
+ * The table is always dumped in full so a decoder can index it by probe.
+ *
+ * @param buffer:   The destination byte buffer
+ * @param size:     The size of the destination buffer
+ * @return the number of bytes written, or 0 if the buffer is too small
+ */
+size_t Profiler_dumpBinary(uint8_t* buffer, size_t size)
+{
+    size_t required = PROF_BINARY_HEADER_SIZE + NUM_PROF_PROBES * PROF_BINARY_PROBE_SIZE;
+    uint8_t* out_p = buffer;
+    int i;
+
+    if (size < required) {
+        return 0;
+    }
+
+    *out_p++ = PROF_BINARY_MAGIC_0;
+    *out_p++ = PROF_BINARY_MAGIC_1;
+    *out_p++ = PROF_BINARY_VERSION;
+    *out_p++ = NUM_PROF_PROBES;
+    *out_p++ = PROF_HISTOGRAM_BUCKETS;
+
+    for (i = 0; i < NUM_PROF_PROBES; i++)
+    {
+        const ProfileStats* stats_p = &profileTable[i];
+        int bucket;
+
+        out_p = Profiler_putLE(out_p, stats_p->count, 4);
+        out_p = Profiler_putLE(out_p, stats_p->min, 4);
+        out_p = Profiler_putLE(out_p, stats_p->max, 4);
+        out_p = Profiler_putLE(out_p, stats_p->total, 8);
+
+        for (bucket = 0; bucket < PROF_HISTOGRAM_BUCKETS; bucket++) {
+            out_p = Profiler_putLE(out_p, stats_p->histogram[bucket], 4);
+        }
+    }
+
+    return required;
+}
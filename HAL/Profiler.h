@@ -0,0 +1,134 @@
+/*
+ * Profiler.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HAL_PROFILER_H_
+#define HAL_PROFILER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+// Set to 0 to compile every PROF_BEGIN()/PROF_END() pair down to nothing.
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED        1
+#endif
+
+// Number of log2 histogram buckets kept per probe. Bucket N counts durations
+// in [2^N, 2^(N+1)) cycles, and the last bucket also collects everything
+// longer. With 24 buckets the last bucket starts at ~350 ms at 48 MHz.
+#define PROF_HISTOGRAM_BUCKETS  24
+
+// Number of empty PROF_BEGIN()/PROF_END() pairs timed by Profiler_measureOverhead()
+#define PROF_OVERHEAD_ITERATIONS 64
+
+/**
+ * Every named probe in the project. Add a new entry (and a matching name in
+ * Profiler.c) to time a new section of code.
+ */
+enum _ProfileProbe
+{
+    PROF_GFX_CLEAR,
+    PROF_GFX_PRINT,
+    PROF_DRAW_IMAGE,
+    PROF_SHOW_FRAME,
+    PROF_UI_SHOW,
+    PROF_HAL_REFRESH,
+    PROF_HANDLE_TITLE,
+    PROF_HANDLE_INSTRUCTIONS,
+    PROF_HANDLE_GAME,
+    PROF_HANDLE_RESULT,
+    PROF_KV_FLUSH,
+    PROF_KV_ERASE,
+    PROF_GPIO_DRIVERLIB,
+    PROF_GPIO_FAST,
+    PROF_OVERHEAD,
+    NUM_PROF_PROBES
+};
+typedef enum _ProfileProbe ProfileProbe;
+
+/**
+ * The statistics kept for a single probe. All durations are in CPU cycles.
+ */
+struct _ProfileStats
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint32_t histogram[PROF_HISTOGRAM_BUCKETS];
+};
+typedef struct _ProfileStats ProfileStats;
+
+/**
+ * The clock used to timestamp probes. On the MSP432 this reads the Cortex-M4
+ * DWT cycle counter directly. Host builds have no DWT, so they read whatever
+ * function was installed with Profiler_setClock().
+ */
+#if defined(__MSP432P401R__)
+#define Profiler_now()  (DWT->CYCCNT)
+#else
+extern uint32_t (*Profiler_clock)(void);
+#define Profiler_now()  (Profiler_clock())
+#endif
+
+/**=============================================================================
+ * Usage: place PROF_BEGIN(id) at the start of a block and PROF_END(id) at the
+ * end of the SAME block. Both macros must be used in the same scope, since
+ * PROF_BEGIN() declares the local variable which holds the start timestamp.
+ *
+ * Cost: an empty pair reads CYCCNT 5 to 7 cycles apart in the shipped Debug
+ * configuration (TI ARM 18.12, no --opt_level, so unoptimized). The window
+ * holds the first CYCCNT load (2), the store of the start time (1), the
+ * literal-pool load of the DWT address (2, plus up to 2 flash wait states)
+ * and the address phase of the second load. Every probe reads that much
+ * long, and a probe nested inside another also adds its Profiler_record()
+ * call to the outer one. The figure is counted from Cortex-M4 instruction
+ * timings and checked with llvm-mca -mcpu=cortex-m4, not read off a board.
+ * main() runs Profiler_measureOverhead() at boot, which times
+ * PROF_OVERHEAD_ITERATIONS empty pairs; the board's own figure is then the
+ * minimum of PROF_OVERHEAD. Re-read it after changing the optimization level
+ * or the flash wait states.
+ * =============================================================================
+ */
+#if PROFILER_ENABLED
+#define PROF_BEGIN(id)  uint32_t prof_start_##id = Profiler_now()
+#define PROF_END(id)    Profiler_record(id, Profiler_now() - prof_start_##id)
+#else
+#define PROF_BEGIN(id)
+#define PROF_END(id)
+#endif
+
+// Enables the DWT cycle counter and clears every probe.
+void Profiler_init();
+
+// Installs the clock used by host builds. Ignored on the MSP432.
+void Profiler_setClock(uint32_t (*clock)(void));
+
+// Clears the statistics of every probe.
+void Profiler_reset();
+
+// Adds one measured duration to a probe. Normally only called by PROF_END().
+void Profiler_record(ProfileProbe probe, uint32_t cycles);
+
+// Returns the statistics collected so far for a probe.
+const ProfileStats* Profiler_getStats(ProfileProbe probe);
+
+// Returns the printable name of a probe.
+const char* Profiler_getName(ProfileProbe probe);
+
+// Times empty probe pairs and returns the minimum cost of one pair in cycles.
+uint32_t Profiler_measureOverhead();
+
+// Writes a human-readable report into buffer, returning the number of
+// characters written (excluding the terminator).
+size_t Profiler_dumpText(char* buffer, size_t size);
+
+// Writes a compact little-endian binary report into buffer, returning the
+// number of bytes written, or 0 if the buffer is too small.
+size_t Profiler_dumpBinary(uint8_t* buffer, size_t size);
+
+#endif /* HAL_PROFILER_H_ */
@@ -0,0 +1,162 @@
+/*
+ * RGBLED.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <HAL/RGBLED.h>
+
+/**
+ * Maps an 8-bit color component to a 10-bit duty cycle with a gamma of 2.2,
+ * so that equal steps in a component look like equal steps in brightness.
+ * Generated with round(1023 * (i / 255) ^ 2.2).
+ */
+static const uint16_t gammaTable[256] =
+{
+       0,    0,    0,    0,    0,    0,    0,    0,    1,    1,    1,    1,    1,    1,    2,    2,
+       2,    3,    3,    3,    4,    4,    5,    5,    6,    6,    7,    7,    8,    9,    9,   10,
+      11,   11,   12,   13,   14,   15,   16,   16,   17,   18,   19,   20,   21,   23,   24,   25,
+      26,   27,   28,   30,   31,   32,   34,   35,   36,   38,   39,   41,   42,   44,   46,   47,
+      49,   51,   52,   54,   56,   58,   60,   61,   63,   65,   67,   69,   71,   73,   76,   78,
+      80,   82,   84,   87,   89,   91,   94,   96,   98,  101,  103,  106,  109,  111,  114,  117,
+     119,  122,  125,  128,  130,  133,  136,  139,  142,  145,  148,  151,  155,  158,  161,  164,
+     167,  171,  174,  177,  181,  184,  188,  191,  195,  198,  202,  206,  209,  213,  217,  221,
+     225,  228,  232,  236,  240,  244,  248,  252,  257,  261,  265,  269,  274,  278,  282,  287,
+     291,  295,  300,  304,  309,  314,  318,  323,  328,  333,  337,  342,  347,  352,  357,  362,
+     367,  372,  377,  382,  387,  393,  398,  403,  408,  414,  419,  425,  430,  436,  441,  447,
+     452,  458,  464,  470,  475,  481,  487,  493,  499,  505,  511,  517,  523,  529,  535,  542,
+     548,  554,  561,  567,  573,  580,  586,  593,  599,  606,  613,  619,  626,  633,  640,  647,
+     653,  660,  667,  674,  681,  689,  696,  703,  710,  717,  725,  732,  739,  747,  754,  762,
+     769,  777,  784,  792,  800,  807,  815,  823,  831,  839,  847,  855,  863,  871,  879,  887,
+     895,  903,  912,  920,  928,  937,  945,  954,  962,  971,  979,  988,  997, 1005, 1014, 1023
+};
+
+/** Starts one timer in up mode with a reset/set PWM output on each given CCR. */
+static void RGBLED_startTimer(uint32_t timer, uint_fast16_t firstCCR, uint_fast16_t secondCCR)
+{
+    Timer_A_PWMConfig pwmConfig =
+    {
+        TIMER_A_CLOCKSOURCE_SMCLK,
+        TIMER_A_CLOCKSOURCE_DIVIDER_1,
+        RGBLED_PWM_PERIOD - 1,
+        firstCCR,
+        TIMER_A_OUTPUTMODE_RESET_SET,
+        0
+    };
+
+    // Timer_A_generatePWM() also starts the timer in up mode
+    Timer_A_generatePWM(timer, &pwmConfig);
+
+    if (secondCCR != 0) {
+        pwmConfig.compareRegister = secondCCR;
+        Timer_A_generatePWM(timer, &pwmConfig);
+    }
+}
+
+/**
+ * Constructs the RGB LED. Both timers start running with every channel at a
+ * duty cycle of zero, but the pins are left as GPIO until RGBLED_enable().
+ *
+ * @return a constructed, disabled RGBLED showing black
+ */
+RGBLED RGBLED_construct()
+{
+    RGBLED rgbLED;
+
+    rgbLED.color = 0;
+    rgbLED.enabled = false;
+
+    RGBLED_startTimer(TIMER_A0_BASE, TIMER_A_CAPTURECOMPARE_REGISTER_1, TIMER_A_CAPTURECOMPARE_REGISTER_3);
+    RGBLED_startTimer(TIMER_A2_BASE, TIMER_A_CAPTURECOMPARE_REGISTER_1, 0);
+
+    return rgbLED;
+}
+
+/**
+ * Connects the three LED pins to their timer outputs. From now on, the LED
+ * shows the color last passed to RGBLED_setColor().
+ *
+ * @param rgbLED_p:     The RGBLED to enable
+ */
+void RGBLED_enable(RGBLED* rgbLED_p)
+{
+    GPIO_setAsPeripheralModuleFunctionOutputPin(BOOSTERPACK_LED_RED_PORT, BOOSTERPACK_LED_RED_PIN,
+                                                GPIO_PRIMARY_MODULE_FUNCTION);
+    GPIO_setAsPeripheralModuleFunctionOutputPin(BOOSTERPACK_LED_GREEN_PORT, BOOSTERPACK_LED_GREEN_PIN,
+                                                GPIO_PRIMARY_MODULE_FUNCTION);
+    GPIO_setAsPeripheralModuleFunctionOutputPin(BOOSTERPACK_LED_BLUE_PORT, BOOSTERPACK_LED_BLUE_PIN,
+                                                GPIO_PRIMARY_MODULE_FUNCTION);
+
+    rgbLED_p->enabled = true;
+}
+
+/**
+ * Returns the three LED pins to plain GPIO outputs. Their output latches still
+ * hold whatever the LED objects last wrote, so those LEDs reappear as they
+ * were. The timers keep running in the background.
+ *
+ * @param rgbLED_p:     The RGBLED to disable
+ */
+void RGBLED_disable(RGBLED* rgbLED_p)
+{
+    GPIO_setAsOutputPin(BOOSTERPACK_LED_RED_PORT, BOOSTERPACK_LED_RED_PIN);
+    GPIO_setAsOutputPin(BOOSTERPACK_LED_GREEN_PORT, BOOSTERPACK_LED_GREEN_PIN);
+    GPIO_setAsOutputPin(BOOSTERPACK_LED_BLUE_PORT, BOOSTERPACK_LED_BLUE_PIN);
+
+    rgbLED_p->enabled = false;
+}
+
+/**
+ * Sets the color of the LED. Each component goes through the gamma table and
+ * straight into its compare register; the new duty cycles take effect at the
+ * end of the current PWM period.
+ *
+ * @param rgbLED_p:     The RGBLED to update
+ * @param color:        The new color, as 0xRRGGBB
+ */
+void RGBLED_setColor(RGBLED* rgbLED_p, uint32_t color)
+{
+    rgbLED_p->color = color;
+
+    RGBLED_RED_TIMER->CCR[RGBLED_RED_CCR]     = gammaTable[(color >> 16) & 0xFF];
+    RGBLED_GREEN_TIMER->CCR[RGBLED_GREEN_CCR] = gammaTable[(color >> 8) & 0xFF];
+    RGBLED_BLUE_TIMER->CCR[RGBLED_BLUE_CCR]   = gammaTable[color & 0xFF];
+}
+
+/**
+ * Returns the color last passed to RGBLED_setColor().
+ *
+ * @param rgbLED_p:     The RGBLED to query
+ * @return the color, as 0xRRGGBB
+ */
+uint32_t RGBLED_getColor(RGBLED* rgbLED_p)
+{
+    return rgbLED_p->color;
+}
+
+/**
+ * The RGBLED equivalent of LED_isLit(). A channel counts as lit if the gamma
+ * table gives its component of the last color set a duty cycle above zero.
+ * Components 1 to 7 round down to a duty cycle of zero, so they are not lit.
+ *
+ * @param rgbLED_p:     The RGBLED to query
+ * @param channel:      The channel to check
+ * @return true if the channel's PWM output is ever high
+ */
+bool RGBLED_isLit(RGBLED* rgbLED_p, RGBChannel channel)
+{
+    int shift = 16 - 8 * (int) channel;
+    return gammaTable[(rgbLED_p->color >> shift) & 0xFF] != 0;
+}
+
+/**
+ * Returns the duty cycle, out of RGBLED_PWM_PERIOD, which a color component
+ * is shown with.
+ *
+ * @param component:    An 8-bit color component
+ * @return the gamma-corrected 10-bit duty cycle
+ */
+uint16_t RGBLED_gamma(uint8_t component)
+{
+    return gammaTable[component];
+}
@@ -0,0 +1,86 @@
+/*
+ * RGBLED.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HAL_RGBLED_H_
+#define HAL_RGBLED_H_
+
+#include <HAL/LED.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+// The PWM period in SMCLK cycles. At 48 MHz, 1024 counts give a 46.9 kHz PWM
+// with 10 bits of resolution, which the gamma table needs to keep the dim end
+// of the 8-bit color range distinguishable.
+#define RGBLED_PWM_PERIOD       1024
+
+/**
+ * The Timer_A channel behind each Boosterpack LED pin. The pins are the same
+ * as BOOSTERPACK_LED_*_PORT/PIN in LED.h.
+ *
+ *   Red   P2.6  TA0.3
+ *   Green P2.4  TA0.1
+ *   Blue  P5.6  TA2.1
+ */
+#define RGBLED_RED_TIMER        TIMER_A0
+#define RGBLED_RED_CCR          3
+#define RGBLED_GREEN_TIMER      TIMER_A0
+#define RGBLED_GREEN_CCR        1
+#define RGBLED_BLUE_TIMER       TIMER_A2
+#define RGBLED_BLUE_CCR         1
+
+// Packs 8-bit components into a 24-bit 0xRRGGBB color.
+#define RGB_COLOR(r, g, b)      (((uint32_t) (r) << 16) | ((uint32_t) (g) << 8) | (uint32_t) (b))
+
+/**
+ * The three channels of the RGB LED, for per-channel readback.
+ */
+enum _RGBChannel { RGB_RED, RGB_GREEN, RGB_BLUE };
+typedef enum _RGBChannel RGBChannel;
+
+/**=============================================================================
+ * The Boosterpack RGB LED, driven by hardware PWM. Use the constructor
+ * [RGBLED_construct()] to start the timers, then [RGBLED_enable()] to hand the
+ * three pins over to them. Setting a color looks each component up in a gamma
+ * table and writes three compare registers; the timers do everything else.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * The three pins are shared with the boosterpackRed/Green/Blue LED objects.
+ * While the RGBLED is disabled, the pins stay plain GPIO outputs and the LED
+ * objects work as before. While it is enabled, the LED objects have no
+ * effect. Do not construct more than one RGBLED.
+ *
+ * When using this object, DO NOT DIRECTLY ACCESS ANY MEMBER VARIABLES of the
+ * RGBLED struct.
+ */
+struct _RGBLED
+{
+    uint32_t color;     // The last color set, as 0xRRGGBB
+    bool enabled;       // Whether the pins are connected to the timers
+};
+typedef struct _RGBLED RGBLED;
+
+// Constructs the RGB LED and starts its PWM timers, with the pins still GPIO.
+RGBLED RGBLED_construct();
+
+// Connects the pins to the PWM timers.
+void RGBLED_enable(RGBLED* rgbLED_p);
+
+// Returns the pins to plain GPIO, for the LED objects.
+void RGBLED_disable(RGBLED* rgbLED_p);
+
+// Sets the 24-bit 0xRRGGBB color. Costs three register writes.
+void RGBLED_setColor(RGBLED* rgbLED_p, uint32_t color);
+
+// Returns the last color set.
+uint32_t RGBLED_getColor(RGBLED* rgbLED_p);
+
+// Returns whether a channel of the last color set has a duty cycle above zero.
+bool RGBLED_isLit(RGBLED* rgbLED_p, RGBChannel channel);
+
+// Returns the 10-bit duty cycle the gamma table maps an 8-bit component to.
+uint16_t RGBLED_gamma(uint8_t component);
+
+#endif /* HAL_RGBLED_H_ */
@@ -0,0 +1,94 @@
+/*
+ * Random.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <HAL/Random.h>
+
+/** Rotates a word left by k bits. */
+static uint32_t Random_rotl(uint32_t x, int k)
+{
+    return (x << k) | (x >> (32 - k));
+}
+
+/**
+ * Constructs a generator from the current contents of the entropy pool.
+ *
+ * @return a seeded Random generator
+ */
+Random Random_construct()
+{
+    Random random;
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        random.state[i] = 0;
+    }
+
+    Random_reseed(&random);
+
+    return random;
+}
+
+/**
+ * XORs a fresh read of the entropy pool into the state, so the generator
+ * keeps whatever entropy it already had. The all-zero state is the one state
+ * xoshiro can never leave, so it is replaced.
+ *
+ * @param random_p: The generator to reseed
+ */
+void Random_reseed(Random* random_p)
+{
+    uint32_t words[ENTROPY_POOL_WORDS];
+    int i;
+
+    Entropy_read(words);
+
+    for (i = 0; i < 4; i++) {
+        random_p->state[i] ^= words[i % ENTROPY_POOL_WORDS];
+    }
+
+    if ((random_p->state[0] | random_p->state[1] | random_p->state[2] | random_p->state[3]) == 0) {
+        random_p->state[0] = 1;
+    }
+}
+
+/**
+ * Advances the generator by one step. This is the reference xoshiro128**
+ * algorithm by Blackman and Vigna.
+ *
+ * @param random_p: The generator to draw from
+ * @return 32 random bits
+ */
+uint32_t Random_next(Random* random_p)
+{
+    uint32_t* s = random_p->state;
+
+    uint32_t result = Random_rotl(s[1] * 5, 7) * 9;
+    uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+
+    s[2] ^= t;
+    s[3] = Random_rotl(s[3], 11);
+
+    return result;
+}
+
+/**
+ * Draws a number in [0, bound) by taking the high word of a 32x32 bit
+ * product, which the Cortex-M4 computes in a single UMULL. The bias is below
+ * bound / 2^32, which is negligible for the small bounds used here.
+ *
+ * @param random_p: The generator to draw from
+ * @param bound:    The exclusive upper bound
+ * @return a random number below bound
+ */
+uint32_t Random_below(Random* random_p, uint32_t bound)
+{
+    return (uint32_t) (((uint64_t) Random_next(random_p) * bound) >> 32);
+}
@@ -0,0 +1,47 @@
+/*
+ * Random.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HAL_RANDOM_H_
+#define HAL_RANDOM_H_
+
+#include <HAL/Entropy.h>
+
+/**=============================================================================
+ * A xoshiro128** pseudo-random number generator, implemented in the C
+ * object-oriented style. The constructor [Random_construct()] seeds it from
+ * the entropy pool, and [Random_reseed()] folds fresh entropy into it later.
+ * Drawing a number with [Random_next()] or [Random_below()] is a handful of
+ * shifts, rotations and multiplications: it never waits for the ADC.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * A generator seeded right after reset holds little entropy, since few
+ * samples have been collected by then. Reseed it once the user has had time
+ * to interact, for example at the start of each round. This is not a
+ * cryptographic generator.
+ *
+ * When using this object, DO NOT DIRECTLY ACCESS ANY MEMBER VARIABLES of the
+ * Random struct.
+ */
+struct _Random
+{
+    uint32_t state[4];
+};
+typedef struct _Random Random;
+
+// Constructs a generator seeded from the entropy pool.
+Random Random_construct();
+
+// Mixes the current contents of the entropy pool into the generator.
+void Random_reseed(Random* random_p);
+
+// Returns 32 random bits.
+uint32_t Random_next(Random* random_p);
+
+// Returns a random number in [0, bound), without division.
+uint32_t Random_below(Random* random_p, uint32_t bound);
+
+#endif /* HAL_RANDOM_H_ */
@@ -0,0 +1,291 @@
+/*
+ * Scheduler.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <HAL/Scheduler.h>
+
+#include <stdio.h>
+
+/** Converts a time in milliseconds to hardware timer cycles. */
+static uint32_t Scheduler_msToCycles(uint32_t time_ms)
+{
+    uint32_t cyclesPerMillisecond = (SYSTEM_CLOCK / PRESCALER) / MS_DIVISION_FACTOR;
+    return cyclesPerMillisecond * time_ms;
+}
+
+/** Converts a number of hardware timer cycles to microseconds. */
+static uint32_t Scheduler_cyclesToUS(uint64_t cycles)
+{
+    uint32_t cyclesPerMicrosecond = (SYSTEM_CLOCK / PRESCALER) / US_DIVISION_FACTOR;
+    return (uint32_t) (cycles / cyclesPerMicrosecond);
+}
+
+/**
+ * Constructs an empty scheduler. Tasks must be added with Scheduler_addTask()
+ * before the scheduler does anything useful.
+ *
+ * @return a Scheduler with no tasks
+ */
+Scheduler Scheduler_construct()
+{
+    Scheduler scheduler;
+
+    scheduler.numTasks = 0;
+    scheduler.startTime = HWTimer_getCycles();
+
+    return scheduler;
+}
+
+/**
+ * Adds a task to the scheduler. Periodic tasks are first released one period
+ * after they are added.
+ *
+ * @param scheduler_p:  The scheduler to add the task to
+ * @param name:         A printable name, used only for reports
+ * @param run:          The function to run each time the task is ready
+ * @param context:      The argument passed to run
+ * @param priority:     Higher priorities run first when several tasks are ready
+ * @param period_ms:    The period of the task, or 0 for a signal-only task
+ * @param deadline_ms:  How long after release the task must finish, or 0
+ *
+ * @return the id of the new task, or NO_TASK if the task table is full
+ */
+int Scheduler_addTask(Scheduler* scheduler_p, const char* name, TaskFunction run, void* context,
+                      int priority, uint32_t period_ms, uint32_t deadline_ms)
+{
+    if (scheduler_p->numTasks >= MAX_SCHEDULER_TASKS) {
+        return NO_TASK;
+    }
+
+    int taskId = scheduler_p->numTasks++;
+    Task* task_p = &scheduler_p->tasks[taskId];
+
+    task_p->name = name;
+    task_p->run = run;
+    task_p->context = context;
+    task_p->priority = priority;
+    task_p->periodCycles = Scheduler_msToCycles(period_ms);
+    task_p->deadlineCycles = Scheduler_msToCycles(deadline_ms);
+
+    task_p->ready = false;
+    task_p->releaseTime = 0;
+    task_p->nextReleaseTime = HWTimer_getCycles() + task_p->periodCycles;
+
+    if (task_p->periodCycles != 0) {
+        HWTimer_noteDeadline(task_p, task_p->nextReleaseTime, task_p->periodCycles);
+    }
+
+    task_p->runs = 0;
+    task_p->deadlineMisses = 0;
+    task_p->busyCycles = 0;
+    task_p->maxLatencyCycles = 0;
+    task_p->maxResponseCycles = 0;
+
+    return taskId;
+}
+
+/**
+ * Marks a task as ready. The release time used for latency and deadline
+ * statistics is the moment of the first signal since the task last ran.
+ *
+ * @param scheduler_p:  The scheduler which owns the task
+ * @param taskId:       The task to release
+ */
+void Scheduler_signal(Scheduler* scheduler_p, int taskId)
+{
+    Task* task_p = &scheduler_p->tasks[taskId];
+
+    if (!task_p->ready) {
+        task_p->ready = true;
+        task_p->releaseTime = HWTimer_getCycles();
+    }
+}
+
+/**
+ * Releases every periodic task which is due, then runs the ready task with
+ * the highest priority. If a periodic task has fallen more than one period
+ * behind, the missed releases are skipped rather than run back to back, and
+ * the late release is counted as a deadline miss once it completes. The
+ * releases after it stay on the same grid, so a task keeps its phase to the
+ * SysTick which wakes the CPU for it.
+ *
+ * @param scheduler_p:  The scheduler to run
+ * @return true if a task ran, and false if no task was ready
+ */
+bool Scheduler_runOnce(Scheduler* scheduler_p)
+{
+    uint64_t now = HWTimer_getCycles();
+    Task* next_p = NULL;
+    int i;
+
+    for (i = 0; i < scheduler_p->numTasks; i++)
+    {
+        Task* task_p = &scheduler_p->tasks[i];
+
+        if (task_p->periodCycles != 0 && now >= task_p->nextReleaseTime)
+        {
+            if (!task_p->ready) {
+                task_p->ready = true;
+                task_p->releaseTime = task_p->nextReleaseTime;
+            }
+
+            task_p->nextReleaseTime += task_p->periodCycles;
+            if (task_p->nextReleaseTime <= now)
+            {
+                uint64_t missed = (now - task_p->nextReleaseTime) / task_p->periodCycles;
+                task_p->nextReleaseTime += (missed + 1) * task_p->periodCycles;
+            }
+
+            HWTimer_noteDeadline(task_p, task_p->nextReleaseTime, task_p->periodCycles);
+        }
+
+        if (task_p->ready && (next_p == NULL || task_p->priority > next_p->priority)) {
+            next_p = task_p;
+        }
+    }
+
+    if (next_p == NULL) {
+        return false;
+    }
+
+    // Clear the ready flag before running, so the task may signal itself
+    next_p->ready = false;
+    uint64_t releaseTime = next_p->releaseTime;
+
+    next_p->run(next_p->context);
+    uint64_t end = HWTimer_getCycles();
+
+    uint32_t latency = (uint32_t) (now - releaseTime);
+    uint32_t response = (uint32_t) (end - releaseTime);
+
+    next_p->runs++;
+    next_p->busyCycles += end - now;
+
+    if (latency > next_p->maxLatencyCycles) {
+        next_p->maxLatencyCycles = latency;
+    }
+
+    if (response > next_p->maxResponseCycles) {
+        next_p->maxResponseCycles = response;
+    }
+
+    if (next_p->deadlineCycles != 0 && response > next_p->deadlineCycles) {
+        next_p->deadlineMisses++;
+    }
+
+    return true;
+}
+
+/**
+ * Returns a task so its statistics can be read.
+ *
+ * @param scheduler_p:  The scheduler which owns the task
+ * @param taskId:       The task to retrieve
+ * @return a read-only pointer to the task
+ */
+const Task* Scheduler_getTask(Scheduler* scheduler_p, int taskId)
+{
+    return &scheduler_p->tasks[taskId];
+}
+
+/**
+ * Computes the share of all time since the statistics were reset which was
+ * spent running a task.
+ *
+ * @param scheduler_p:  The scheduler which owns the task
+ * @param taskId:       The task to measure
+ * @return the CPU share of the task, in tenths of a percent
+ */
+uint32_t Scheduler_getCpuSharePermille(Scheduler* scheduler_p, int taskId)
+{
+    uint64_t elapsed = HWTimer_getCycles() - scheduler_p->startTime;
+
+    if (elapsed == 0) {
+        return 0;
+    }
+
+    return (uint32_t) ((scheduler_p->tasks[taskId].busyCycles * 1000) / elapsed);
+}
+
+/**
+ * Returns the longest time a task waited between becoming ready and starting.
+ *
+ * @param scheduler_p:  The scheduler which owns the task
+ * @param taskId:       The task to measure
+ * @return the worst-case latency of the task, in microseconds
+ */
+uint32_t Scheduler_getWorstLatencyUS(Scheduler* scheduler_p, int taskId)
+{
+    return Scheduler_cyclesToUS(scheduler_p->tasks[taskId].maxLatencyCycles);
+}
+
+/**
+ * Clears the statistics of every task and restarts the CPU share window.
+ *
+ * @param scheduler_p:  The scheduler to reset
+ */
+void Scheduler_resetStats(Scheduler* scheduler_p)
+{
+    int i;
+    for (i = 0; i < scheduler_p->numTasks; i++)
+    {
+        Task* task_p = &scheduler_p->tasks[i];
+
+        task_p->runs = 0;
+        task_p->deadlineMisses = 0;
+        task_p->busyCycles = 0;
+        task_p->maxLatencyCycles = 0;
+        task_p->maxResponseCycles = 0;
+    }
+
+    scheduler_p->startTime = HWTimer_getCycles();
+}
+
+/**
+ * Writes one line per task in the form
+ *     name runs cpu% worstLatency_us worstResponse_us deadlineMisses
+ * Output is truncated (but always terminated) when the buffer is too small.
+ *
+ * @param scheduler_p:  The scheduler to report on
+ * @param buffer:       The destination character buffer
+ * @param size:         The size of the destination buffer
+ * @return the number of characters written, excluding the terminator
+ */
+size_t Scheduler_dumpText(Scheduler* scheduler_p, char* buffer, size_t size)
+{
+    size_t used = 0;
+    int i;
+
+    if (size == 0) {
+        return 0;
+    }
+    buffer[0] = '\0';
+
+    for (i = 0; i < scheduler_p->numTasks && used < size - 1; i++)
+    {
+        const Task* task_p = &scheduler_p->tasks[i];
+        uint32_t share = Scheduler_getCpuSharePermille(scheduler_p, i);
+
+        int written = snprintf(buffer + used, size - used, "%s %lu %lu.%lu%% %lu %lu %lu\n",
+                               task_p->name,
+                               (unsigned long) task_p->runs,
+                               (unsigned long) (share / 10),
+                               (unsigned long) (share % 10),
+                               (unsigned long) Scheduler_cyclesToUS(task_p->maxLatencyCycles),
+                               (unsigned long) Scheduler_cyclesToUS(task_p->maxResponseCycles),
+                               (unsigned long) task_p->deadlineMisses);
+        if (written < 0) {
+            break;
+        }
+
+        used += written;
+    }
+
+    if (used >= size) {
+        used = size - 1;
+    }
+
+    return used;
+}
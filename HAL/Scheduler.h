@@ -0,0 +1,102 @@
+/*
+ * Scheduler.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HAL_SCHEDULER_H_
+#define HAL_SCHEDULER_H_
+
+#include <HAL/Timer.h>
+
+#include <stddef.h>
+
+#define MAX_SCHEDULER_TASKS     4
+#define NO_TASK                 -1
+
+// The function run by a task. Tasks run to completion and must never block.
+typedef void (*TaskFunction)(void* context);
+
+/**
+ * A single schedulable task. A task becomes ready either when its period
+ * elapses (periodic tasks) or when another task signals it (event tasks). A
+ * task may be both. Times are kept in hardware timer cycles.
+ */
+struct _Task
+{
+    const char* name;
+    TaskFunction run;
+    void* context;
+
+    int priority;               // Among ready tasks, the highest priority runs first
+    uint32_t periodCycles;      // 0 for tasks which only run when signaled
+    uint32_t deadlineCycles;    // 0 for tasks without a deadline
+
+    bool ready;                 // Whether the task has been released but not yet run
+    uint64_t releaseTime;       // When the task last became ready
+    uint64_t nextReleaseTime;   // When a periodic task is next due
+
+    // Statistics gathered every time the task runs
+    uint32_t runs;
+    uint32_t deadlineMisses;
+    uint64_t busyCycles;
+    uint32_t maxLatencyCycles;  // Longest wait from release to start
+    uint32_t maxResponseCycles; // Longest time from release to completion
+};
+typedef struct _Task Task;
+
+/**=============================================================================
+ * A cooperative run-to-completion scheduler, implemented in the C
+ * object-oriented style. Use [Scheduler_construct()] to create the scheduler,
+ * add tasks to it, and then call [Scheduler_runOnce()] over and over from the
+ * super-loop in main(). Each call runs at most one task - the ready task with
+ * the highest priority.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * Treat all members as PRIVATE. Since no task is ever preempted, a long task
+ * delays every other task; the statistics below exist to find those tasks.
+ * The Scheduler holds the whole task table, so it should be given static
+ * storage rather than placed on the (small) main() stack.
+ */
+struct _Scheduler
+{
+    Task tasks[MAX_SCHEDULER_TASKS];
+    int numTasks;
+
+    uint64_t startTime;         // When statistics were last reset
+};
+typedef struct _Scheduler Scheduler;
+
+// Constructs an empty scheduler.
+Scheduler Scheduler_construct();
+
+// Adds a task, returning its id or NO_TASK if the table is full. A period of
+// 0 creates a task which only runs when signaled.
+int Scheduler_addTask(Scheduler* scheduler_p, const char* name, TaskFunction run, void* context,
+                      int priority, uint32_t period_ms, uint32_t deadline_ms);
+
+// Marks a task as ready to run. Signaling an already ready task does nothing.
+void Scheduler_signal(Scheduler* scheduler_p, int taskId);
+
+// Runs the highest priority ready task, if any. Returns whether a task ran.
+bool Scheduler_runOnce(Scheduler* scheduler_p);
+
+// Returns the statistics of a task.
+const Task* Scheduler_getTask(Scheduler* scheduler_p, int taskId);
+
+// Returns the share of CPU time a task has used since the statistics were
+// reset, in tenths of a percent.
+uint32_t Scheduler_getCpuSharePermille(Scheduler* scheduler_p, int taskId);
+
+// Returns the longest release-to-start latency of a task, in microseconds.
+uint32_t Scheduler_getWorstLatencyUS(Scheduler* scheduler_p, int taskId);
+
+// Clears the statistics of every task.
+void Scheduler_resetStats(Scheduler* scheduler_p);
+
+// Writes one line of statistics per task into buffer, returning the number of
+// characters written (excluding the terminator).
+size_t Scheduler_dumpText(Scheduler* scheduler_p, char* buffer, size_t size);
+
+#endif /* HAL_SCHEDULER_H_ */
@@ -0,0 +1,156 @@
+/*
+ * SpiTrace.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <HAL/SpiTrace.h>
+
+#define SPI_TRACE_MASK          (SPI_TRACE_SIZE - 1)
+
+// The largest pair of fields a byte adds to a record: a five-byte stamp and
+// a two-byte value
+#define SPI_TRACE_MAX_FIELDS    7
+
+/**
+ * The ring. Both indexes run freely and are masked on use. head is where the
+ * next byte goes, and tail is the oldest byte SpiTrace_read() has not taken.
+ * Every byte is sent from the main loop, so neither needs protecting.
+ */
+static SpiTraceEntry ring[SPI_TRACE_SIZE];
+static uint32_t head = 0;
+static uint32_t tail = 0;
+
+static SpiTraceStats stats;
+
+/**
+ * Empties the ring and clears the statistics.
+ */
+void SpiTrace_reset()
+{
+    head = 0;
+    tail = 0;
+
+    stats.recorded = 0;
+    stats.overwritten = 0;
+    stats.recordsSent = 0;
+}
+
+/**
+ * Adds a byte to the ring, overwriting the oldest once it is full.
+ *
+ * @param value:    The byte, plus SPI_TRACE_DATA if it is a data byte
+ */
+void SpiTrace_record(uint16_t value)
+{
+    SpiTraceEntry* entry_p = &ring[head++ & SPI_TRACE_MASK];
+
+    entry_p->cycles = Profiler_now();
+    entry_p->value = value;
+
+    stats.recorded++;
+}
+
+/**
+ * Takes the oldest byte which was not read yet. If the ring wrapped around
+ * since the last read, the bytes it overwrote are counted and skipped.
+ *
+ * @param entry_p:  Where to store the byte
+ * @return false if every byte was read already
+ */
+bool SpiTrace_read(SpiTraceEntry* entry_p)
+{
+    if (head - tail > SPI_TRACE_SIZE)
+    {
+        stats.overwritten += head - tail - SPI_TRACE_SIZE;
+        tail = head - SPI_TRACE_SIZE;
+    }
+
+    if (tail == head) {
+        return false;
+    }
+
+    *entry_p = ring[tail++ & SPI_TRACE_MASK];
+    return true;
+}
+
+/**
+ * Returns the number of bytes still in the ring, whether they were read or
+ * not.
+ */
+uint32_t SpiTrace_getCount()
+{
+    return head < SPI_TRACE_SIZE ? head : SPI_TRACE_SIZE;
+}
+
+/**
+ * Returns one of the bytes still in the ring, without reading it.
+ *
+ * @param index:    From 0 for the oldest to SpiTrace_getCount() - 1
+ * @return the byte and its stamp
+ */
+SpiTraceEntry SpiTrace_peek(uint32_t index)
+{
+    return ring[(head - SpiTrace_getCount() + index) & SPI_TRACE_MASK];
+}
+
+/**
+ * Streams unread bytes over the telemetry link. Each record holds:
+ *
+ *   bytes overwritten since the last record | stamp | value | (delta | value)...
+ *
+ * where each delta is the number of cycles since the byte before it. Records
+ * are only sent while the telemetry ring is less than half full, so the
+ * trace never crowds out the application's own records.
+ *
+ * @param recordType:   The telemetry type of the records
+ * @return the number of bytes sent
+ */
+uint32_t SpiTrace_send(uint8_t recordType)
+{
+    uint32_t sent = 0;
+
+    while (Telemetry_getFill() < TELEMETRY_BUFFER_SIZE / 2)
+    {
+        uint32_t overwritten = stats.overwritten;
+        SpiTraceEntry entry;
+
+        if (!SpiTrace_read(&entry)) {
+            break;
+        }
+
+        TelemetryRecord record;
+        Telemetry_begin(&record, recordType);
+        Telemetry_putVarint(&record, stats.overwritten - overwritten);
+        Telemetry_putVarint(&record, entry.cycles);
+        Telemetry_putVarint(&record, entry.value);
+        sent++;
+
+        uint32_t last = entry.cycles;
+
+        while (record.length <= TELEMETRY_MAX_PAYLOAD - SPI_TRACE_MAX_FIELDS && tail != head)
+        {
+            SpiTrace_read(&entry);
+            Telemetry_putVarint(&record, entry.cycles - last);
+            Telemetry_putVarint(&record, entry.value);
+            last = entry.cycles;
+            sent++;
+        }
+
+        if (Telemetry_send(&record)) {
+            stats.recordsSent++;
+        }
+    }
+
+    return sent;
+}
+
+/**
+ * Returns what the trace has seen since it was reset.
+ *
+ * @return a read-only pointer to the statistics
+ */
+const SpiTraceStats* SpiTrace_getStats()
+{
+    return &stats;
+}
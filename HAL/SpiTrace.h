@@ -0,0 +1,103 @@
+/*
+ * SpiTrace.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HAL_SPITRACE_H_
+#define HAL_SPITRACE_H_
+
+#include <HAL/Profiler.h>
+#include <HAL/Telemetry.h>
+
+// Set to 1 to record every byte sent to the LCD. Off by default, since the
+// ring takes SPI_TRACE_SIZE * 8 bytes of RAM.
+#ifndef SPI_TRACE_ENABLED
+#define SPI_TRACE_ENABLED       0
+#endif
+
+// Number of bytes the ring holds. Must be a power of two. A full-screen
+// clear alone is 32 KB on the wire, so on the board the ring only ever
+// holds the tail of a redraw; host builds make it large enough for a run.
+#ifndef SPI_TRACE_SIZE
+#define SPI_TRACE_SIZE          1024
+#endif
+
+// Set in SpiTraceEntry.value for bytes sent with the data/command pin high
+#define SPI_TRACE_DATA          0x100
+
+/**
+ * One byte on the wire, stamped with the cycle counter as it was written
+ * to the transmit buffer.
+ */
+struct _SpiTraceEntry
+{
+    uint32_t cycles;
+    uint16_t value;             // The byte, plus SPI_TRACE_DATA for data bytes
+};
+typedef struct _SpiTraceEntry SpiTraceEntry;
+
+/**
+ * What the trace has seen since it was reset.
+ */
+struct _SpiTraceStats
+{
+    uint32_t recorded;          // Bytes recorded, including those overwritten since
+    uint32_t overwritten;       // Bytes overwritten before SpiTrace_read() got to them
+    uint32_t recordsSent;       // Telemetry records sent by SpiTrace_send()
+};
+typedef struct _SpiTraceStats SpiTraceStats;
+
+/**=============================================================================
+ * A capture of the bytes the LCD driver sends, for finding waste in the
+ * display path offline. HAL_LCD_writeCommand() and HAL_LCD_writeData() stamp
+ * each byte with Profiler_now() into a RAM ring, which always holds the
+ * latest SPI_TRACE_SIZE bytes.
+ *
+ * There are two ways to get the bytes out. [SpiTrace_send()] streams the
+ * ring over the telemetry link from the main loop, as records of a type the
+ * application picks; each record carries the absolute stamp of its first
+ * byte, so the stream recovers from a lost record. Host builds can instead
+ * walk the bytes still in the ring with [SpiTrace_peek()] and write them to
+ * a file. tools/spitrace.py decodes both, and replays them into a model of
+ * the controller to report redundant window setups, overdraw, bytes per
+ * screen transition and idle gaps on the bus.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * The stamp is taken while the byte is shifting out, so on the board the
+ * trace adds no time to the bus. Streaming cannot keep up with a redraw: at
+ * 115200 baud the link carries about 3000 traced bytes per second, and the
+ * bytes the ring overwrites in the meantime are counted and skipped. Call
+ * Profiler_init() before the LCD is initialized so the stamps are valid.
+ */
+
+#if SPI_TRACE_ENABLED
+#define SPI_TRACE_BYTE(byte, isData)    SpiTrace_record((byte) | ((isData) ? SPI_TRACE_DATA : 0))
+#else
+#define SPI_TRACE_BYTE(byte, isData)
+#endif
+
+// Empties the ring and clears the statistics.
+void SpiTrace_reset();
+
+// Adds a byte to the ring. Normally only called by SPI_TRACE_BYTE().
+void SpiTrace_record(uint16_t value);
+
+// Takes the oldest byte not read yet. Returns false if there is none.
+bool SpiTrace_read(SpiTraceEntry* entry_p);
+
+// Returns the number of bytes still in the ring, read or not.
+uint32_t SpiTrace_getCount();
+
+// Returns one of the bytes still in the ring, 0 being the oldest.
+SpiTraceEntry SpiTrace_peek(uint32_t index);
+
+// Streams unread bytes as telemetry records of the given type, while the
+// telemetry ring is less than half full. Returns the number of bytes sent.
+uint32_t SpiTrace_send(uint8_t recordType);
+
+// Returns what the trace has seen since it was reset.
+const SpiTraceStats* SpiTrace_getStats();
+
+#endif /* HAL_SPITRACE_H_ */
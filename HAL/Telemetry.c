@@ -0,0 +1,252 @@
+/*
+ * Telemetry.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <HAL/Telemetry.h>
+#include <HAL/DMAControl.h>
+
+#include <string.h>
+
+#define TELEMETRY_MASK          (TELEMETRY_BUFFER_SIZE - 1)
+#define TELEMETRY_DMA_CHANNEL   0
+
+/**
+ * The transmit ring. Both indexes run freely and are masked on use. The main
+ * loop only moves head, and the DMA ISR only moves tail, over the bytes of
+ * the transfer which just finished.
+ */
+static uint8_t ring[TELEMETRY_BUFFER_SIZE];
+static volatile uint16_t head = 0;
+static volatile uint16_t tail = 0;
+static volatile uint16_t inFlight = 0;  // Bytes of the running DMA transfer, or 0 when idle
+
+static uint8_t sequence = 0;
+static TelemetryStats stats;
+
+/**
+ * Baud rate settings for the 48 MHz SMCLK with 16x oversampling, as given by
+ * TI's eUSCI baud rate calculator. 1 Mbaud divides SMCLK exactly.
+ */
+static const eUSCI_UART_ConfigV1 uartConfig115200 =
+{
+    EUSCI_A_UART_CLOCKSOURCE_SMCLK,
+    26, 0, 111,
+    EUSCI_A_UART_NO_PARITY,
+    EUSCI_A_UART_LSB_FIRST,
+    EUSCI_A_UART_ONE_STOP_BIT,
+    EUSCI_A_UART_MODE,
+    EUSCI_A_UART_OVERSAMPLING_BAUDRATE_GENERATION,
+    EUSCI_A_UART_8_BIT_LEN
+};
+
+static const eUSCI_UART_ConfigV1 uartConfig1M =
+{
+    EUSCI_A_UART_CLOCKSOURCE_SMCLK,
+    3, 0, 0,
+    EUSCI_A_UART_NO_PARITY,
+    EUSCI_A_UART_LSB_FIRST,
+    EUSCI_A_UART_ONE_STOP_BIT,
+    EUSCI_A_UART_MODE,
+    EUSCI_A_UART_OVERSAMPLING_BAUDRATE_GENERATION,
+    EUSCI_A_UART_8_BIT_LEN
+};
+
+/**
+ * Starts a DMA transfer of the bytes waiting in the ring, up to the end of
+ * the ring buffer; the rest follows in the next transfer. Must be called with
+ * no transfer running, and with interrupts disabled outside the DMA ISR.
+ *
+ * The channel is triggered by a rising TXIFG. If TXIFG is already set, the
+ * UART is idle and no edge will come, so one is made by clearing and setting
+ * the flag. If it is clear, the UART still holds a byte, and the edge comes
+ * by itself once that byte moves to the shift register.
+ */
+static void Telemetry_startTransfer()
+{
+    uint16_t waiting = head - tail;
+    if (waiting == 0) {
+        return;
+    }
+
+    uint16_t offset = tail & TELEMETRY_MASK;
+    uint16_t length = TELEMETRY_BUFFER_SIZE - offset;
+    if (waiting < length) {
+        length = waiting;
+    }
+
+    inFlight = length;
+    stats.transfers++;
+
+    DMA_setChannelControl(UDMA_PRI_SELECT | DMA_CH0_EUSCIA0TX,
+                          UDMA_SIZE_8 | UDMA_SRC_INC_8 | UDMA_DST_INC_NONE | UDMA_ARB_1);
+    DMA_setChannelTransfer(UDMA_PRI_SELECT | DMA_CH0_EUSCIA0TX, UDMA_MODE_BASIC,
+                           &ring[offset], (void*) &EUSCI_A0->TXBUF, length);
+    DMA_enableChannel(TELEMETRY_DMA_CHANNEL);
+
+    if (EUSCI_A0->IFG & EUSCI_A_IFG_TXIFG)
+    {
+        EUSCI_A0->IFG &= ~EUSCI_A_IFG_TXIFG;
+        EUSCI_A0->IFG |= EUSCI_A_IFG_TXIFG;
+    }
+}
+
+/**
+ * DMA channel 0 sent a transfer. Releases its bytes and sends whatever was
+ * queued in the meantime. DMA_INT0 is shared by every channel which is not
+ * routed to DMA_INT1 to DMA_INT3, so the channel's own flag is checked. DO NOT
+ * DIRECTLY INVOKE THIS FUNCTION FROM YOUR CODE.
+ */
+void DMA_INT0_IRQHandler()
+{
+    if ((DMA_getInterruptStatus() & (1 << TELEMETRY_DMA_CHANNEL)) == 0) {
+        return;
+    }
+
+    DMA_clearInterruptFlag(TELEMETRY_DMA_CHANNEL);
+
+    tail += inFlight;
+    inFlight = 0;
+
+    Telemetry_startTransfer();
+}
+
+/**
+ * Configures eUSCI_A0 as a UART on the backchannel pins, and DMA channel 0
+ * to feed it. The ring, the sequence and the statistics start over.
+ *
+ * @param baudRate: TELEMETRY_BAUD_115200 or TELEMETRY_BAUD_1M
+ */
+void Telemetry_init(uint32_t baudRate)
+{
+    const eUSCI_UART_ConfigV1* config_p = baudRate == TELEMETRY_BAUD_1M ? &uartConfig1M
+                                                                        : &uartConfig115200;
+
+    GPIO_setAsPeripheralModuleFunctionInputPin(GPIO_PORT_P1, GPIO_PIN2 | GPIO_PIN3,
+                                               GPIO_PRIMARY_MODULE_FUNCTION);
+
+    UART_initModule(EUSCI_A0_BASE, config_p);
+    UART_enableModule(EUSCI_A0_BASE);
+
+    DMAControl_init();
+
+    DMA_assignChannel(DMA_CH0_EUSCIA0TX);
+    Interrupt_enableInterrupt(INT_DMA_INT0);
+
+    head = 0;
+    tail = 0;
+    inFlight = 0;
+    sequence = 0;
+    memset(&stats, 0, sizeof(stats));
+}
+
+/**
+ * Starts an empty record.
+ *
+ * @param record_p: The record to start, usually a local variable
+ * @param type:     What the record describes; the meaning is up to the sender
+ */
+void Telemetry_begin(TelemetryRecord* record_p, uint8_t type)
+{
+    record_p->type = type;
+    record_p->length = 0;
+}
+
+/**
+ * Appends a field as an unsigned LEB128 varint: seven bits per byte, least
+ * significant first, with the top bit set on every byte but the last. Values
+ * below 128 take one byte, and a full 32-bit value five.
+ *
+ * @param record_p: The record to append to
+ * @param value:    The value of the field
+ */
+void Telemetry_putVarint(TelemetryRecord* record_p, uint32_t value)
+{
+    do
+    {
+        if (record_p->length == TELEMETRY_MAX_PAYLOAD) {
+            return;
+        }
+
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+
+        record_p->payload[record_p->length++] = value != 0 ? byte | 0x80 : byte;
+    } while (value != 0);
+}
+
+/**
+ * Frames a record into the ring and starts the DMA if it is idle. This is
+ * the only copy made of the record.
+ *
+ * @param record_p: The record to send
+ * @return false if the ring was too full, in which case nothing is sent
+ */
+bool Telemetry_send(TelemetryRecord* record_p)
+{
+    uint16_t size = record_p->length + TELEMETRY_OVERHEAD;
+    uint8_t seq = sequence++;
+
+    if ((uint16_t) (TELEMETRY_BUFFER_SIZE - (uint16_t) (head - tail)) < size)
+    {
+        stats.recordsDropped++;
+        return false;
+    }
+
+    uint16_t at = head;
+    uint8_t checksum = record_p->type + (record_p->length + 1) + seq;
+    int i;
+
+    ring[at++ & TELEMETRY_MASK] = TELEMETRY_SYNC;
+    ring[at++ & TELEMETRY_MASK] = record_p->type;
+    ring[at++ & TELEMETRY_MASK] = record_p->length + 1;
+    ring[at++ & TELEMETRY_MASK] = seq;
+
+    for (i = 0; i < record_p->length; i++)
+    {
+        ring[at++ & TELEMETRY_MASK] = record_p->payload[i];
+        checksum += record_p->payload[i];
+    }
+
+    ring[at++ & TELEMETRY_MASK] = checksum;
+
+    bool wasDisabled = Interrupt_disableMaster();
+
+    head = at;
+    if (inFlight == 0) {
+        Telemetry_startTransfer();
+    }
+
+    uint16_t fill = head - tail;
+    if (fill > stats.maxFill) {
+        stats.maxFill = fill;
+    }
+
+    if (!wasDisabled) {
+        Interrupt_enableMaster();
+    }
+
+    stats.recordsSent++;
+    stats.bytesSent += size;
+
+    return true;
+}
+
+/**
+ * Returns the number of bytes which have not finished going to the UART.
+ */
+uint16_t Telemetry_getFill()
+{
+    return head - tail;
+}
+
+/**
+ * Returns what the link has done since it was started.
+ *
+ * @return a read-only pointer to the statistics
+ */
+const TelemetryStats* Telemetry_getStats()
+{
+    return &stats;
+}
@@ -0,0 +1,95 @@
+/*
+ * Telemetry.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HAL_TELEMETRY_H_
+#define HAL_TELEMETRY_H_
+
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+// The supported baud rates of the backchannel UART, from the 48 MHz SMCLK
+#define TELEMETRY_BAUD_115200   115200
+#define TELEMETRY_BAUD_1M       1000000
+
+// Size of the transmit ring. Must be a power of two.
+#define TELEMETRY_BUFFER_SIZE   512
+
+// Largest payload of a single record
+#define TELEMETRY_MAX_PAYLOAD   24
+
+// The first byte of every record, so a decoder can find the next record
+// after joining the stream halfway or losing bytes
+#define TELEMETRY_SYNC          0xA5
+
+// Bytes a record adds around its payload: sync, type, length, sequence and checksum
+#define TELEMETRY_OVERHEAD      5
+
+/**
+ * A record being built on the stack. Fields are appended to the payload as
+ * unsigned LEB128 varints, so small values take a single byte.
+ */
+struct _TelemetryRecord
+{
+    uint8_t type;
+    uint8_t length;
+    uint8_t payload[TELEMETRY_MAX_PAYLOAD];
+};
+typedef struct _TelemetryRecord TelemetryRecord;
+
+/**
+ * What the telemetry link has done since it was started.
+ */
+struct _TelemetryStats
+{
+    uint32_t recordsSent;       // Records queued for transmission
+    uint32_t recordsDropped;    // Records which did not fit in the ring
+    uint32_t bytesSent;         // Bytes handed to the DMA
+    uint32_t transfers;         // DMA transfers started
+    uint16_t maxFill;           // Most bytes ever waiting in the ring
+};
+typedef struct _TelemetryStats TelemetryStats;
+
+/**=============================================================================
+ * A global, binary telemetry link over the launchpad's backchannel UART
+ * (eUSCI_A0 on P1.2/P1.3, which shows up as a serial port on the PC).
+ *
+ * A record is built with [Telemetry_begin()] and [Telemetry_putVarint()],
+ * then [Telemetry_send()] copies it once, into a ring buffer. From there DMA
+ * channel 0 feeds it to the UART transmit buffer straight out of the ring,
+ * one byte per TXIFG request, so the CPU never touches the bytes again. Each
+ * record on the wire is:
+ *
+ *   0xA5 | type | length | sequence | payload (length - 1 bytes) | checksum
+ *
+ * where the sequence counts every record sent or dropped, modulo 256, and
+ * the checksum is the sum of type to payload, modulo 256. tools/telemetry.py
+ * decodes the stream.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * Records are only sent from the main loop. A record which does not fit in
+ * the ring is dropped whole, and the gap in the sequence shows it on the
+ * host. At 115200 baud the link carries about 11 KB per second.
+ */
+
+// Starts the UART at one of the TELEMETRY_BAUD_ rates, and its DMA channel.
+void Telemetry_init(uint32_t baudRate);
+
+// Starts a new, empty record of the given type.
+void Telemetry_begin(TelemetryRecord* record_p, uint8_t type);
+
+// Appends an unsigned field to a record. Fields past TELEMETRY_MAX_PAYLOAD are dropped.
+void Telemetry_putVarint(TelemetryRecord* record_p, uint32_t value);
+
+// Queues a record for transmission. Returns false if it was dropped.
+bool Telemetry_send(TelemetryRecord* record_p);
+
+// Returns the number of bytes waiting in the ring, including those in flight.
+uint16_t Telemetry_getFill();
+
+// Returns what the link has done since it was started.
+const TelemetryStats* Telemetry_getStats();
+
+#endif /* HAL_TELEMETRY_H_ */
@@ -10,6 +10,20 @@
 /** The reference counter which tracks how many rollovers have occurred. Used in timing SWTimers. */
 static volatile uint64_t hwTimerRollovers = 0;
 
+#if !defined(__MSP432P401R__)
+/**
+ * The clock installed with HWTimer_setClock(), if any, and its reading when the system timing was
+ * initialized. Host builds run on a virtual cycle counter, which is read directly rather than
+ * through a simulated Timer32.
+ */
+static uint64_t (*hwTimerClock)(void) = NULL;
+static uint64_t hwTimerClockStart = 0;
+
+/** The function told of every deadline noted with HWTimer_noteDeadline(), if any. */
+static void (*hwTimerDeadlineListener)(const void* owner_p, uint64_t cycles,
+                                       uint64_t periodCycles) = NULL;
+#endif
+
 /**
  * The ISR used to increment the total number of rollovers which have passed. When the
  * TIMER32_0_BASE timer expires, this ISR is automatically called. DO NOT DIRECTLY INVOKE THIS
@@ -69,14 +83,105 @@ void InitSystemTiming()
     // Enable interrupts again, after all system timing has been set up properly
     Interrupt_enableMaster();
     Interrupt_enableInterrupt(INT_T32_INT1);
+
+#if !defined(__MSP432P401R__)
+    if (hwTimerClock != NULL) {
+        hwTimerClockStart = hwTimerClock();
+    }
+#endif
+}
+
+/**
+ * Installs the clock read by HWTimer_getCycles(), and so by every SWTimer, in host builds. The
+ * clock must count up at SYSTEM_CLOCK / PRESCALER and never wrap. On the MSP432 the timers always
+ * run on TIMER32_0_BASE, and this function does nothing.
+ *
+ * @param clock:    The function returning the current cycle count, or NULL to go back to the
+ *                  simulated TIMER32_0_BASE
+ */
+void HWTimer_setClock(uint64_t (*clock)(void))
+{
+#if !defined(__MSP432P401R__)
+    hwTimerClock = clock;
+    hwTimerClockStart = clock != NULL ? clock() : 0;
+#endif
+}
+
+/**
+ * Installs the function told of every deadline noted with HWTimer_noteDeadline() in host builds.
+ * On the MSP432 no deadline is ever noted, and this function does nothing.
+ *
+ * @param listener: The function to tell, which receives the deadline in cycles of the clock
+ *                  installed with HWTimer_setClock(), or NULL to stop telling
+ */
+void HWTimer_setDeadlineListener(void (*listener)(const void* owner_p, uint64_t cycles,
+                                                  uint64_t periodCycles))
+{
+#if !defined(__MSP432P401R__)
+    hwTimerDeadlineListener = listener;
+#endif
+}
+
+#if !defined(__MSP432P401R__)
+/**
+ * Passes a deadline on to the listener installed with HWTimer_setDeadlineListener(), if any. Only
+ * host builds have this function; on the MSP432 the calls compile to nothing.
+ *
+ * @param owner_p:      The timer, alarm or task which falls due, whose last deadline this replaces
+ * @param cycles:       The value of HWTimer_getCycles() at which it falls due
+ * @param periodCycles: The period of a deadline which recurs, or 0
+ */
+void HWTimer_noteDeadline(const void* owner_p, uint64_t cycles, uint64_t periodCycles)
+{
+    if (hwTimerDeadlineListener != NULL) {
+        hwTimerDeadlineListener(owner_p, cycles + hwTimerClockStart, periodCycles);
+    }
 }
+#endif
 
 /**
- * Constructs a new Software Timer, using a wait time in milliseconds. The timer uses the
- * hwTimerRollovers variable to keep track of its reference time, and is based off of time passing
- * under the TIMER32_0_BASE. When first constructed, this timer is NOT conditioned to start. Before
- * any calls to SWTimer_expired(), SWTimer_elapsedTimeUS(), or SWTimer_percentElapsed(), you MUST
- * FIRST CALL the SWTimer_start() method.
+ * Returns the number of TIMER32_0_BASE cycles since the system timing was initialized. Since the
+ * rollover ISR may fire between reading the rollover count and the counter value, the rollover count
+ * is read again afterwards and the whole read is retried if it changed in the meantime.
+ *
+ * When called from an ISR or with interrupts masked, a rollover may have happened without its ISR
+ * having run yet. Its interrupt flag is then still set, so it is counted here, and the counter is
+ * read again after the flag so that the value read is known to come after that rollover.
+ *
+ * @return the number of hardware timer cycles since InitSystemTiming() was called
+ */
+uint64_t HWTimer_getCycles()
+{
+    uint64_t rollovers;
+    uint32_t pendingRollovers;
+    uint32_t currentCounter;
+
+#if !defined(__MSP432P401R__)
+    if (hwTimerClock != NULL) {
+        return hwTimerClock() - hwTimerClockStart;
+    }
+#endif
+
+    do {
+        rollovers = hwTimerRollovers;
+        currentCounter = Timer32_getValue(TIMER32_0_BASE);
+        pendingRollovers = 0;
+
+        if (Timer32_getInterruptStatus(TIMER32_0_BASE)) {
+            currentCounter = Timer32_getValue(TIMER32_0_BASE);
+            pendingRollovers = 1;
+        }
+    } while (rollovers != hwTimerRollovers);
+
+    return ((rollovers + pendingRollovers) * ((uint64_t) LOADVALUE + 1)) + (LOADVALUE - currentCounter);
+}
+
+/**
+ * Constructs a new Software Timer, using a wait time in milliseconds. The timer keeps its reference
+ * time in cycles of HWTimer_getCycles(), and is based off of time passing under the TIMER32_0_BASE.
+ * When first constructed, this timer is NOT conditioned to start. Before any calls to
+ * SWTimer_expired(), SWTimer_elapsedTimeUS(), or SWTimer_percentElapsed(), you MUST FIRST CALL the
+ * SWTimer_start() method.
  *
  * @param waitTime_ms:  The amount of time this timer measures before expiration
  * @return a SWTimer object
@@ -85,8 +190,7 @@ SWTimer SWTimer_construct(uint64_t waitTime_ms)
 {
     SWTimer timer;
 
-    timer.startCounter = 0;
-    timer.startRollovers = 0;
+    timer.startCycles = 0;
 
     uint64_t counterClock = SYSTEM_CLOCK / PRESCALER;
     uint64_t cyclesPerMillisecond = counterClock / MS_DIVISION_FACTOR;
@@ -96,15 +200,14 @@ SWTimer SWTimer_construct(uint64_t waitTime_ms)
 }
 
 /**
- * Starts a constructed timer by reading the current number of rollovers and current load value in
- * TIMER32_0_BASE.
+ * Starts a constructed timer by reading the current cycle count of the hardware timer.
  *
  * @param timer_p:    The SWTimer to start
  */
 void SWTimer_start(SWTimer* timer_p)
 {
-    timer_p->startCounter = Timer32_getValue(TIMER32_0_BASE);
-    timer_p->startRollovers = hwTimerRollovers;
+    timer_p->startCycles = HWTimer_getCycles();
+    HWTimer_noteDeadline(timer_p, timer_p->startCycles + timer_p->cyclesToWait, 0);
 }
 
 /**
@@ -119,12 +222,7 @@ void SWTimer_start(SWTimer* timer_p)
  */
 uint64_t SWTimer_elapsedCycles(SWTimer* timer_p)
 {
-    uint64_t rollovers = hwTimerRollovers - timer_p->startRollovers;
-    uint64_t startCounter = timer_p->startCounter;
-    uint64_t currentCounter = Timer32_getValue(TIMER32_0_BASE);
-    uint64_t elapsedCycles = (rollovers * (LOADVALUE + 1)) + startCounter - currentCounter;
-
-    return elapsedCycles;
+    return HWTimer_getCycles() - timer_p->startCycles;
 }
 
 /**
@@ -39,11 +39,8 @@ struct _SWTimer
     // The number of hardware timer cycles which must elapse before the timer expires
     uint64_t cyclesToWait;
 
-    // The starting counter value of the hardware timer, set when the timer is started
-    uint32_t startCounter;
-
-    // The starting rollover value of the hardware timer, set when the timer is started
-    uint32_t startRollovers;
+    // The value of HWTimer_getCycles() when the timer was started
+    uint64_t startCycles;
 };
 typedef struct _SWTimer SWTimer;
 
@@ -67,8 +64,33 @@ uint64_t SWTimer_elapsedTimeUS(SWTimer* timer_p);
 // is started, the value is 0.0, and as time elapses, the value rises to 1.0.
 double SWTimer_percentElapsed(SWTimer* timer_p);
 
+// Returns the total number of hardware timer cycles since InitSystemTiming()
+// was called. Unlike the SWTimer methods, this is an absolute timestamp which
+// can be compared across modules.
+uint64_t HWTimer_getCycles();
+
 // Initializes the global clock system for the MSP432, as well as a hardware
 // timer under which all of the software timers are based.
 void InitSystemTiming();
 
+// Host builds only: replaces TIMER32_0_BASE as the source of HWTimer_getCycles()
+// and of every SWTimer. The clock must count SYSTEM_CLOCK cycles upwards.
+void HWTimer_setClock(uint64_t (*clock)(void));
+
+// Host builds only: installs the function told of every deadline passed to
+// HWTimer_noteDeadline(), in cycles of the clock installed with HWTimer_setClock().
+void HWTimer_setDeadlineListener(void (*listener)(const void* owner_p, uint64_t cycles,
+                                                  uint64_t periodCycles));
+
+// Tells a host build when a timer, alarm or periodic task falls due, in cycles of
+// HWTimer_getCycles(), so that the simulation can sleep through the idle SysTicks
+// before it. A new deadline of the same owner replaces the last one. periodCycles
+// is the period of a deadline which recurs, and 0 otherwise. Compiles to nothing
+// on the MSP432.
+#if defined(__MSP432P401R__)
+#define HWTimer_noteDeadline(owner_p, cycles, periodCycles)
+#else
+void HWTimer_noteDeadline(const void* owner_p, uint64_t cycles, uint64_t periodCycles);
+#endif
+
 #endif /* HAL_TIMER_H_ */
@@ -0,0 +1,232 @@
+/*
+ * UI.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <HAL/UI.h>
+#include <HAL/Profiler.h>
+#include <HAL/LcdDriver/HAL_MSP_EXP432P401R_Crystalfontz128x128_ST7735.h>
+
+static UIScreenStats screenStats[UI_MAX_SCREENS];
+
+/** Returns the value a widget is bound to, or 0 for an unbound widget. */
+static int8_t UI_widgetValue(UI* ui_p, const UIWidget* widget_p)
+{
+    if (widget_p->value == UI_NO_VALUE) {
+        return 0;
+    }
+
+    return ui_p->values[widget_p->value];
+}
+
+/**
+ * Draws one widget showing value. previous is the value it was drawn with
+ * before, or UI_NO_VALUE if the screen has just been cleared; it only matters
+ * to the widgets which have to erase something.
+ */
+static void UI_drawWidget(UI* ui_p, const UIWidget* widget_p, int8_t value, int8_t previous)
+{
+    GFX* gfx_p = ui_p->gfx_p;
+
+    switch (widget_p->type)
+    {
+        case UI_LABEL:
+            GFX_print(gfx_p, (char*) widget_p->texts[value], widget_p->row, widget_p->col);
+            break;
+
+        case UI_IMAGE:
+        {
+            PROF_BEGIN(PROF_DRAW_IMAGE);
+            Graphics_drawImage(&gfx_p->context, widget_p->images[value], widget_p->col, widget_p->row);
+            PROF_END(PROF_DRAW_IMAGE);
+            break;
+        }
+
+        case UI_CURSOR:
+            if (previous != UI_NO_VALUE) {
+                GFX_print(gfx_p, " ", widget_p->row + previous, widget_p->col);
+            }
+            GFX_print(gfx_p, ">", widget_p->row + value, widget_p->col);
+            break;
+
+        case UI_FRAME:
+            GFX_showFrame(gfx_p, widget_p->frame);
+            break;
+
+        case UI_CHECK:
+            if (value != 0) {
+                GFX_print(gfx_p, "*", widget_p->row, widget_p->col);
+            }
+            else if (previous != UI_NO_VALUE) {
+                GFX_print(gfx_p, " ", widget_p->row, widget_p->col);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * Constructs a UI with every value at 0.
+ *
+ * @param gfx_p:    The graphics context to draw with. Must outlive the UI.
+ * @return a UI with no screen shown
+ */
+UI UI_construct(GFX* gfx_p)
+{
+    UI ui;
+    int i;
+
+    ui.gfx_p = gfx_p;
+    ui.screen_p = NULL;
+
+    for (i = 0; i < UI_MAX_VALUES; i++) {
+        ui.values[i] = 0;
+    }
+
+    return ui;
+}
+
+/**
+ * Sets a value. Nothing is drawn until the next UI_refresh(), so several
+ * values may change together.
+ *
+ * @param ui_p:     The UI to update
+ * @param value:    The index of the value
+ * @param newValue: The new value
+ */
+void UI_setValue(UI* ui_p, uint8_t value, int8_t newValue)
+{
+    ui_p->values[value] = newValue;
+}
+
+/**
+ * Returns a value.
+ *
+ * @param ui_p:     The UI to query
+ * @param value:    The index of the value
+ * @return the value last set
+ */
+int8_t UI_getValue(UI* ui_p, uint8_t value)
+{
+    return ui_p->values[value];
+}
+
+/** Returns whether a screen starts with a frame covering the whole LCD. */
+static bool UI_startsWithFullFrame(const UIScreen* screen_p)
+{
+    if (screen_p->numWidgets == 0 || screen_p->widgets[0].type != UI_FRAME) {
+        return false;
+    }
+
+    const GFXFrame* frame_p = screen_p->widgets[0].frame;
+    return frame_p->width == LCD_HORIZONTAL_MAX && frame_p->height == LCD_VERTICAL_MAX;
+}
+
+/**
+ * Returns how many widgets of a screen the UI can keep track of. UI_SCREEN()
+ * already refuses to compile a screen with too many, so this only guards
+ * screens built by hand: their widgets past UI_MAX_WIDGETS are never drawn,
+ * rather than overrunning the drawn values.
+ */
+static uint8_t UI_numWidgets(const UIScreen* screen_p)
+{
+    if (screen_p->numWidgets > UI_MAX_WIDGETS) {
+        return UI_MAX_WIDGETS;
+    }
+
+    return screen_p->numWidgets;
+}
+
+/**
+ * Clears the LCD and draws a screen from scratch, with the values as they are
+ * now. A screen which starts with a full-screen frame is not cleared, since
+ * the frame overwrites every pixel anyway. The SPI bytes and the time of the
+ * whole draw are recorded for the screen.
+ *
+ * @param ui_p:     The UI to draw on
+ * @param screen_p: The screen to show
+ */
+void UI_show(UI* ui_p, const UIScreen* screen_p)
+{
+    PROF_BEGIN(PROF_UI_SHOW);
+
+    uint32_t startBytes = HAL_LCD_bytesSent;
+    uint8_t numWidgets = UI_numWidgets(screen_p);
+    int i;
+
+    ui_p->screen_p = screen_p;
+
+    if (!UI_startsWithFullFrame(screen_p)) {
+        GFX_clear(ui_p->gfx_p);
+    }
+
+    for (i = 0; i < numWidgets; i++)
+    {
+        const UIWidget* widget_p = &screen_p->widgets[i];
+        int8_t value = UI_widgetValue(ui_p, widget_p);
+
+        UI_drawWidget(ui_p, widget_p, value, UI_NO_VALUE);
+        ui_p->drawn[i] = value;
+    }
+
+    UIScreenStats* stats_p = &screenStats[screen_p->id];
+    stats_p->shows++;
+    stats_p->showBytes = HAL_LCD_bytesSent - startBytes;
+
+    PROF_END(PROF_UI_SHOW);
+}
+
+/**
+ * Compares each widget of the current screen against the value it was last
+ * drawn with, and redraws only those which differ. Unbound widgets never
+ * change, so a refresh with no value changed sends nothing at all.
+ *
+ * @param ui_p:     The UI to refresh
+ */
+void UI_refresh(UI* ui_p)
+{
+    const UIScreen* screen_p = ui_p->screen_p;
+    uint32_t startBytes = HAL_LCD_bytesSent;
+    int i;
+
+    if (screen_p == NULL) {
+        return;
+    }
+
+    uint8_t numWidgets = UI_numWidgets(screen_p);
+    for (i = 0; i < numWidgets; i++)
+    {
+        const UIWidget* widget_p = &screen_p->widgets[i];
+        int8_t value = UI_widgetValue(ui_p, widget_p);
+
+        if (value != ui_p->drawn[i]) {
+            UI_drawWidget(ui_p, widget_p, value, ui_p->drawn[i]);
+            ui_p->drawn[i] = value;
+        }
+    }
+
+    uint32_t bytes = HAL_LCD_bytesSent - startBytes;
+    if (bytes != 0)
+    {
+        UIScreenStats* stats_p = &screenStats[screen_p->id];
+        stats_p->updates++;
+        stats_p->lastUpdateBytes = bytes;
+        if (bytes > stats_p->maxUpdateBytes) {
+            stats_p->maxUpdateBytes = bytes;
+        }
+    }
+}
+
+/**
+ * Returns the SPI traffic recorded for one screen.
+ *
+ * @param screenId: The id of the screen, as given in its UIScreen
+ * @return a read-only pointer to the statistics
+ */
+const UIScreenStats* UI_getScreenStats(uint8_t screenId)
+{
+    return &screenStats[screenId];
+}
@@ -0,0 +1,157 @@
+/*
+ * UI.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HAL_UI_H_
+#define HAL_UI_H_
+
+#include <HAL/Graphics.h>
+
+#define UI_MAX_WIDGETS      16  // Widgets on a single screen
+#define UI_MAX_VALUES       8   // Values widgets may be bound to
+#define UI_MAX_SCREENS      8   // Screens with their own redraw statistics
+
+// The value index of a widget which is not bound to any value
+#define UI_NO_VALUE         -1
+
+enum _UIWidgetType
+{
+    UI_LABEL,       // A text, or one of several texts chosen by a value
+    UI_IMAGE,       // An image, or one of several images chosen by a value
+    UI_CURSOR,      // A ">" on the row chosen by a value
+    UI_CHECK,       // A "*" shown while a value is non-zero
+    UI_FRAME        // A pre-rendered GFXFrame
+};
+typedef enum _UIWidgetType UIWidgetType;
+
+/**
+ * One widget of a screen. Widgets are declared const with the UI_TEXT() to
+ * UI_FRAME() macros below, so whole screens live in flash. Text positions are
+ * in character rows and columns; image positions are in pixels.
+ */
+struct _UIWidget
+{
+    uint8_t type;
+    int8_t value;                           // Index of the bound value, or UI_NO_VALUE
+    uint8_t row;                            // Or y, for images
+    uint8_t col;                            // Or x, for images
+    uint8_t count;                          // Number of rows a cursor moves over
+    const char* const* texts;               // UI_LABEL: one text per value
+    const Graphics_Image* const* images;    // UI_IMAGE: one image per value
+    const GFXFrame* frame;                  // UI_FRAME: the frame
+};
+typedef struct _UIWidget UIWidget;
+
+// A fixed text
+#define UI_TEXT(row, col, text) \
+    { UI_LABEL, UI_NO_VALUE, row, col, 0, (const char* const[]) { text }, NULL }
+
+// The text chosen by a value. All the texts should be the same length, so that
+// a new text completely covers the old one.
+#define UI_TEXT_CHOICE(row, col, value, ...) \
+    { UI_LABEL, value, row, col, 0, (const char* const[]) { __VA_ARGS__ }, NULL }
+
+// A fixed image
+#define UI_IMAGE(x, y, image_p) \
+    { UI_IMAGE, UI_NO_VALUE, y, x, 0, NULL, (const Graphics_Image* const[]) { image_p } }
+
+// The image chosen by a value
+#define UI_IMAGE_CHOICE(x, y, value, ...) \
+    { UI_IMAGE, value, y, x, 0, NULL, (const Graphics_Image* const[]) { __VA_ARGS__ } }
+
+// A cursor over count rows starting at row, on the row chosen by a value
+#define UI_CURSOR(row, col, count, value) \
+    { UI_CURSOR, value, row, col, count, NULL, NULL }
+
+// A check mark shown while a value is non-zero
+#define UI_CHECK(row, col, value) \
+    { UI_CHECK, value, row, col, 0, NULL, NULL }
+
+// A pre-rendered frame. A screen whose first widget is a frame covering the
+// whole LCD is not cleared before it is drawn.
+#define UI_FRAME(frame_p) \
+    { UI_FRAME, UI_NO_VALUE, 0, 0, 0, NULL, NULL, frame_p }
+
+/**
+ * A whole screen. The id selects the redraw statistics of the screen. A
+ * screen has at most UI_MAX_WIDGETS widgets, since the UI keeps the value
+ * each of them was last drawn with.
+ */
+struct _UIScreen
+{
+    uint8_t id;
+    const UIWidget* widgets;
+    uint8_t numWidgets;
+};
+typedef struct _UIScreen UIScreen;
+
+// Fails to compile, with a negative array size, if the screen has too many widgets
+#define UI_SCREEN(id, widgets) \
+    { id, widgets, sizeof(widgets) / sizeof(UIWidget) \
+                   + 0 * sizeof(char[sizeof(widgets) / sizeof(UIWidget) <= UI_MAX_WIDGETS ? 1 : -1]) }
+
+/**
+ * The SPI traffic caused by drawing one screen, counted in bytes sent to the
+ * LCD controller (commands and data).
+ */
+struct _UIScreenStats
+{
+    uint32_t shows;
+    uint32_t showBytes;         // Bytes of the latest full draw
+    uint32_t updates;           // Partial redraws which sent anything
+    uint32_t lastUpdateBytes;
+    uint32_t maxUpdateBytes;
+};
+typedef struct _UIScreenStats UIScreenStats;
+
+/**=============================================================================
+ * A retained-mode UI, implemented in the C object-oriented style. A screen is
+ * a const array of widgets, each of which may be bound to one of a handful of
+ * small integer values. The application never draws: it changes values with
+ * [UI_setValue()], and [UI_refresh()] redraws only the widgets whose value
+ * changed since they were last drawn. [UI_show()] clears the LCD and draws a
+ * new screen in full.
+ *
+ * Every draw is measured in bytes sent over SPI, per screen, so the cost of a
+ * screen and of its partial updates can be read back with
+ * [UI_getScreenStats()].
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * Widgets are drawn in order, so a text declared after an image is drawn on
+ * top of it, but an image redrawn by UI_refresh() covers the texts on it.
+ *
+ * When using this object, DO NOT DIRECTLY ACCESS ANY MEMBER VARIABLES of the
+ * UI struct.
+ */
+struct _UI
+{
+    GFX* gfx_p;
+    const UIScreen* screen_p;
+
+    int8_t values[UI_MAX_VALUES];
+    int8_t drawn[UI_MAX_WIDGETS];   // The value each widget was last drawn with
+};
+typedef struct _UI UI;
+
+// Constructs a UI which draws with gfx_p. No screen is shown yet.
+UI UI_construct(GFX* gfx_p);
+
+// Sets a value. Bound widgets are redrawn by the next UI_refresh().
+void UI_setValue(UI* ui_p, uint8_t value, int8_t newValue);
+
+// Returns a value.
+int8_t UI_getValue(UI* ui_p, uint8_t value);
+
+// Clears the LCD and draws every widget of a screen.
+void UI_show(UI* ui_p, const UIScreen* screen_p);
+
+// Redraws the widgets of the current screen whose bound value changed.
+void UI_refresh(UI* ui_p);
+
+// Returns the redraw statistics of a screen id.
+const UIScreenStats* UI_getScreenStats(uint8_t screenId);
+
+#endif /* HAL_UI_H_ */
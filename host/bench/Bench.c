@@ -0,0 +1,300 @@
+/*
+ * Bench.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <sim/Sim.h>
+#include <sim/SimCost.h>
+#include <sim/ST7735Model.h>
+
+#include <App_GuessTheColor.h>
+#include <HAL/Profiler.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Where the thresholds are kept, relative to host/
+#define BENCH_THRESHOLDS        "bench/thresholds.txt"
+
+// Headroom given to each threshold when they are written, in percent
+#define BENCH_MARGIN_PERCENT    10
+
+#define BENCH_MAX_RESULTS       32
+#define BENCH_NAME_SIZE         40
+
+/**
+ * One measured step, and the threshold it is held to.
+ */
+struct _BenchResult
+{
+    char name[BENCH_NAME_SIZE];
+    double ms;
+    uint64_t bytes;             // Bytes sent to the LCD
+    double estimated;           // Percentage of ms charged from the cost constants
+    double threshold;           // Negative if there is none yet
+};
+typedef struct _BenchResult BenchResult;
+
+/** The screens whose UI statistics are reported, indexed by GameState */
+static const char* const screenNames[] = { "title", "instructions", "game", "result" };
+
+static BenchResult results[BENCH_MAX_RESULTS];
+static int numResults = 0;
+
+static uint64_t startCycles;
+static uint64_t startBytes;
+static uint64_t startEstimated;
+
+// The grlib the stored thresholds were recorded against, from their "# grlib" line
+static char thresholdsGrlib[BENCH_NAME_SIZE];
+
+/** Starts measuring a step. */
+static void Bench_begin()
+{
+    startCycles = Sim_now();
+    startBytes = ST7735Model_getStats()->bytes;
+    startEstimated = SimCost_getEstimated();
+}
+
+/** Ends the step begun last, and records it under a name. */
+static void Bench_end(const char* name)
+{
+    BenchResult* result_p = &results[numResults++];
+
+    strncpy(result_p->name, name, BENCH_NAME_SIZE - 1);
+    result_p->ms = (Sim_now() - startCycles) / (double) SIM_CYCLES_PER_MS;
+    result_p->bytes = ST7735Model_getStats()->bytes - startBytes;
+    result_p->estimated = 100.0 * (SimCost_getEstimated() - startEstimated) / (Sim_now() - startCycles);
+    result_p->threshold = -1;
+}
+
+/** Runs one screen function, and records it. */
+#define BENCH_STEP(name, call)  do { Bench_begin(); call; Bench_end(name); } while (0)
+
+/**
+ * Reads the stored thresholds into the results of the same names. Lines are
+ * "name milliseconds", and # starts a comment. The comment "# grlib sum"
+ * names the grlib they were recorded against.
+ */
+static void Bench_readThresholds(const char* path)
+{
+    FILE* file = fopen(path, "r");
+    char line[128];
+
+    if (file == NULL) {
+        return;
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        char name[BENCH_NAME_SIZE];
+        double threshold;
+        int i;
+
+        if (sscanf(line, "# grlib %39s", thresholdsGrlib) == 1 ||
+            line[0] == '#' || sscanf(line, "%39s %lf", name, &threshold) != 2) {
+            continue;
+        }
+
+        for (i = 0; i < numResults; i++)
+        {
+            if (strcmp(results[i].name, name) == 0) {
+                results[i].threshold = threshold;
+            }
+        }
+    }
+
+    fclose(file);
+}
+
+/** Writes every result, plus the margin, as the new thresholds. */
+static void Bench_writeThresholds(const char* path)
+{
+    FILE* file = fopen(path, "w");
+    int i;
+
+    if (file == NULL)
+    {
+        perror(path);
+        exit(2);
+    }
+
+    fprintf(file, "# Predicted milliseconds each step of host/bench may take, written by\n");
+    fprintf(file, "# \"make bench-baseline\" with %d%% headroom. \"make bench\" fails past them.\n",
+            BENCH_MARGIN_PERCENT);
+    fprintf(file, "#\n# The predictions come from the cost model in sim/SimCost.c, which is not\n");
+    fprintf(file, "# calibrated on a board: they hold the tree to its own earlier predictions.\n");
+    fprintf(file, "#\n# Record them with the SDK's grlib, from the tree the budget applies to.\n");
+    fprintf(file, "# Against another grlib, \"make bench\" reports the wrong SDK and applies none.\n");
+
+    if (getenv("GRLIB_SUM") != NULL) {
+        fprintf(file, "# grlib %s\n", getenv("GRLIB_SUM"));
+    }
+
+    for (i = 0; i < numResults; i++) {
+        fprintf(file, "%-32s %.3f\n", results[i].name, results[i].ms * (100 + BENCH_MARGIN_PERCENT) / 100);
+    }
+
+    fclose(file);
+}
+
+/**
+ * Runs every screen function and every transition of the game the way
+ * main() sets them up, minus the scheduler: events are dispatched to the FSM
+ * directly, so each step is only the work of the transition itself.
+ */
+static void Bench_run()
+{
+    WDT_A_holdTimer();
+    InitSystemTiming();
+    Profiler_init();
+
+    HAL hal = HAL_construct();
+    App_GuessTheColor app = App_GuessTheColor_construct(&hal);
+
+    BENCH_STEP("boot/title", App_GuessTheColor_start(&app));
+
+    BENCH_STEP("screen/title", App_GuessTheColor_showTitleScreen(&app));
+    BENCH_STEP("screen/instructions", App_GuessTheColor_showInstructionsScreen(&app));
+    BENCH_STEP("screen/game", App_GuessTheColor_showGameScreen(&app));
+
+    app.cursor = CURSOR_1;
+    BENCH_STEP("screen/game-update", App_GuessTheColor_updateGameScreen(&app));
+    app.cursor = CURSOR_0;
+    App_GuessTheColor_updateGameScreen(&app);
+
+    BENCH_STEP("screen/result", App_GuessTheColor_showResultScreen(&app, &hal));
+    App_GuessTheColor_stopEffect(&hal);
+
+    // The static parts of two screens, from their widgets and from the frames
+    // the build rendered from them
+    BENCH_STEP("static/instructions", UI_show(&app.ui, &instructionsStaticScreen));
+    BENCH_STEP("frame/instructions", GFX_showFrame(&hal.gfx, &instructionsFrame));
+    BENCH_STEP("static/game", UI_show(&app.ui, &gameStaticScreen));
+    BENCH_STEP("frame/game", GFX_showFrame(&hal.gfx, &gameFrame));
+
+    // The same screens again, reached through the FSM from the title screen
+    App_GuessTheColor_start(&app);
+    BENCH_STEP("title->instructions", App_GuessTheColor_dispatch(&app, EVENT_TIMEOUT));
+    BENCH_STEP("instructions->game", App_GuessTheColor_dispatch(&app, EVENT_S2_TAP));
+    BENCH_STEP("game/cursor-down", App_GuessTheColor_dispatch(&app, EVENT_S2_TAP));
+    BENCH_STEP("game/cursor-up", App_GuessTheColor_dispatch(&app, EVENT_JOYSTICK_UP));
+    BENCH_STEP("game/select", App_GuessTheColor_dispatch(&app, EVENT_S1_TAP));
+
+    App_GuessTheColor_dispatch(&app, EVENT_JOYSTICK_UP);
+    BENCH_STEP("game->result", App_GuessTheColor_dispatch(&app, EVENT_S1_TAP));
+    BENCH_STEP("result->instructions", App_GuessTheColor_dispatch(&app, EVENT_TIMEOUT));
+}
+
+/**
+ * Prints the SPI bytes the UI counted for each screen over the whole run: the
+ * latest full draw, and the largest of its partial redraws.
+ */
+static void Bench_reportScreens()
+{
+    int i;
+
+    for (i = 0; i < sizeof(screenNames) / sizeof(screenNames[0]); i++)
+    {
+        const UIScreenStats* stats_p = UI_getScreenStats(i);
+
+        printf("ui: %-13s %2lu shows of %6lu bytes, %2lu updates of up to %4lu bytes\n", screenNames[i],
+               (unsigned long) stats_p->shows, (unsigned long) stats_p->showBytes,
+               (unsigned long) stats_p->updates, (unsigned long) stats_p->maxUpdateBytes);
+    }
+}
+
+/**
+ * Prints the predicted time of every step against its threshold, and fails
+ * if any step went past it. With -w, stores the results as the thresholds
+ * instead. Thresholds recorded against another grlib than the one in
+ * GRLIB_SUM are not applied: that is the wrong SDK for them, and text is
+ * drawn differently.
+ *
+ *   bench [-w] [thresholds file]
+ */
+int main(int argc, char** argv)
+{
+    bool write = argc > 1 && strcmp(argv[1], "-w") == 0;
+    const char* path = argc > 1 + write ? argv[1 + write] : BENCH_THRESHOLDS;
+    const char* grlib = getenv("GRLIB_SUM");
+    bool wrongGrlib;
+    double maxEstimated = 0;
+    int regressions = 0;
+    int i;
+
+    Bench_run();
+
+    if (write)
+    {
+        Bench_writeThresholds(path);
+        printf("%d thresholds written to %s\n", numResults, path);
+        return 0;
+    }
+
+    Bench_readThresholds(path);
+
+    wrongGrlib = grlib != NULL && thresholdsGrlib[0] != '\0' && strcmp(grlib, thresholdsGrlib) != 0;
+    if (wrongGrlib)
+    {
+        for (i = 0; i < numResults; i++) {
+            results[i].threshold = -1;
+        }
+    }
+
+    printf("%-28s %10s %9s %5s %10s\n", "step", "ms", "LCD bytes", "est%", "threshold");
+
+    for (i = 0; i < numResults; i++)
+    {
+        BenchResult* result_p = &results[i];
+        const char* verdict = "";
+
+        if (result_p->threshold < 0) {
+            verdict = "  (no threshold)";
+        }
+        else if (result_p->ms > result_p->threshold)
+        {
+            verdict = "  REGRESSED";
+            regressions++;
+        }
+
+        printf("%-28s %10.3f %9llu %5.1f ", result_p->name, result_p->ms, (unsigned long long) result_p->bytes,
+               result_p->estimated);
+
+        if (result_p->estimated > maxEstimated) {
+            maxEstimated = result_p->estimated;
+        }
+
+        if (result_p->threshold < 0) {
+            printf("%10s%s\n", "-", verdict);
+        }
+        else {
+            printf("%10.3f%s\n", result_p->threshold, verdict);
+        }
+    }
+
+    Bench_reportScreens();
+    printf("frames: instructions %lu bytes, game %lu bytes of flash\n",
+           (unsigned long) instructionsFrame.size, (unsigned long) gameFrame.size);
+    SimCost_report(stdout);
+
+    // The constants are not calibrated on a board; see SimCost.h
+    printf("cost model uncalibrated: est%% is the share of each step charged from the constants, the rest\n"
+           "is bus time set by the clocks. Constants off by 2x either way put a step off by -est/2%% to\n"
+           "+est%%, here at most -%.0f%% to +%.0f%%.\n", maxEstimated / 2, maxEstimated);
+
+    if (wrongGrlib)
+    {
+        printf("wrong SDK for %s: it was recorded against grlib %s, not this SDK's %s\n",
+               path, thresholdsGrlib, grlib);
+        printf("no step was held to a threshold; run make bench-baseline with the SDK the budget applies to\n");
+    }
+
+    if (regressions != 0) {
+        printf("%d of %d steps regressed past %s\n", regressions, numResults, path);
+    }
+
+    return regressions != 0;
+}
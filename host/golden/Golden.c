@@ -0,0 +1,742 @@
+/*
+ * Golden.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <golden/ReferenceDisplay.h>
+#include <sim/ST7735Model.h>
+
+#include <App_GuessTheColor.h>
+#include <HAL/Profiler.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Where the golden images are kept, and where the panels which do not match
+// them are written, relative to host/
+#define GOLDEN_IMAGES           "golden/images"
+#define GOLDEN_ACTUAL           "build/golden"
+
+// The file in the golden image directory which names the grlib they were drawn with
+#define GOLDEN_GRLIB            "grlib.txt"
+
+// The build renders the frames with a copy of this program which has none
+// yet, so that copy only knows the widgets of each frame, and only renders
+#ifndef GOLDEN_RENDER_ONLY
+#define GOLDEN_RENDER_ONLY      0
+#endif
+
+#if GOLDEN_RENDER_ONLY
+#define GOLDEN_FRAME(frame)     NULL
+#else
+#define GOLDEN_FRAME(frame)     (&frame)
+#endif
+
+#define GOLDEN_MAX_RESULTS      32
+#define GOLDEN_PATH_SIZE        256
+#define GOLDEN_PPM_SIZE         (3 * ST7735_PANEL_SIZE * ST7735_PANEL_SIZE)
+
+// Colors which come out differently in each of the 5-6-5 channels
+#define GOLDEN_RED              0x00FF0000
+#define GOLDEN_GREEN            0x0000FF00
+#define GOLDEN_BLUE             0x000000FF
+#define GOLDEN_YELLOW           0x00FFFF00
+#define GOLDEN_ORANGE           0x00FF8020
+#define GOLDEN_GRAY             0x00848484
+
+extern const Graphics_Image colors8BPP_UNCOMP;
+extern const Graphics_Image sad8BPP_UNCOMP;
+extern const Graphics_Image happy8BPP_UNCOMP;
+
+/**
+ * A drawing checked against the reference display, in one orientation.
+ */
+struct _GoldenCase
+{
+    const char* name;
+    uint8_t orientation;
+    void (*draw)(Graphics_Context* context_p);
+};
+typedef struct _GoldenCase GoldenCase;
+
+/**
+ * How one panel compared. The counts are -1 for a comparison which was not
+ * made.
+ */
+struct _GoldenResult
+{
+    const char* name;
+    int referenceDiffs;         // Pixels which differ from the reference display
+    int64_t extraPixels;        // Pixels the driver wrote beyond the reference's
+    int goldenDiffs;            // Pixels which differ from the golden image
+    bool goldenMissing;         // The golden image could not be read
+};
+typedef struct _GoldenResult GoldenResult;
+
+/**
+ * A frame the build rendered, and the static widgets it is rendered from.
+ */
+struct _GoldenFrame
+{
+    const char* name;
+    const UIScreen* screen_p;
+    const GFXFrame* frame_p;
+};
+typedef struct _GoldenFrame GoldenFrame;
+
+typedef uint16_t (*GoldenPanel)(int x, int y);
+
+static GoldenResult results[GOLDEN_MAX_RESULTS];
+static int numResults = 0;
+
+static const char* goldenDir = GOLDEN_IMAGES;
+static bool write = false;
+static bool renderFrames = false;
+
+// The golden images were drawn with another grlib than this SDK's, so
+// comparing with them would only show the difference between the two
+static bool wrongGrlib = false;
+
+// What the widgets of the frame being checked drew, in panel order
+static uint16_t widgetPixels[ST7735_PANEL_SIZE * ST7735_PANEL_SIZE];
+
+// A 1 bit per pixel arrow, 11 pixels wide so rows end partway through a byte
+static const uint32_t arrowPalette[2] = { GOLDEN_BLUE, GOLDEN_YELLOW };
+static const uint8_t arrowPixels[] =
+{
+    0x04, 0x00,
+    0x06, 0x00,
+    0xFF, 0x80,
+    0x06, 0x00,
+    0x04, 0x00,
+};
+static const Graphics_Image arrow = { IMAGE_FMT_1BPP_UNCOMP, 11, 5, 2, arrowPalette, arrowPixels };
+
+// A 4 bits per pixel ramp through the palette, 7 pixels wide for the same reason
+static const uint32_t rampPalette[16] =
+{
+    0x000000, 0x110000, 0x220000, 0x330000, 0x440044, 0x550055, 0x660066, 0x770077,
+    0x008800, 0x009900, 0x00AA00, 0x00BB00, 0x0000CC, 0x0000DD, 0x0000EE, 0xFFFFFF,
+};
+static const uint8_t rampPixels[] =
+{
+    0x01, 0x23, 0x45, 0x60,
+    0x78, 0x9A, 0xBC, 0xD0,
+    0xEF, 0x0F, 0x1E, 0x20,
+    0x3D, 0x4C, 0x5B, 0x60,
+};
+static const Graphics_Image ramp = { IMAGE_FMT_4BPP_UNCOMP, 7, 4, 16, rampPalette, rampPixels };
+
+static void Golden_drawClear(Graphics_Context* context_p)
+{
+    Graphics_setBackgroundColor(context_p, GOLDEN_GRAY);
+    Graphics_clearDisplay(context_p);
+}
+
+static void Golden_drawPixels(Graphics_Context* context_p)
+{
+    int i;
+
+    Graphics_drawPixel(context_p, 0, 0);
+    Graphics_drawPixel(context_p, 127, 0);
+    Graphics_drawPixel(context_p, 0, 127);
+    Graphics_drawPixel(context_p, 127, 127);
+
+    for (i = 1; i < 127; i += 7) {
+        Graphics_drawPixel(context_p, i, 127 - i);
+    }
+}
+
+static void Golden_drawLines(Graphics_Context* context_p)
+{
+    Graphics_drawLineH(context_p, 0, 127, 0);
+    Graphics_drawLineH(context_p, 0, 127, 127);
+    Graphics_drawLineV(context_p, 0, 1, 126);
+    Graphics_drawLineV(context_p, 127, 1, 126);
+
+    Graphics_setForegroundColor(context_p, GOLDEN_RED);
+    Graphics_drawLineH(context_p, 64, 64, 10);
+    Graphics_drawLineV(context_p, 10, 64, 64);
+    Graphics_drawLine(context_p, 1, 1, 126, 126);
+    Graphics_drawLine(context_p, 1, 100, 126, 90);
+    Graphics_drawLine(context_p, 100, 1, 90, 126);
+}
+
+static void Golden_drawRectangles(Graphics_Context* context_p)
+{
+    Graphics_Rectangle corner = { 0, 0, 0, 0 };
+    Graphics_Rectangle column = { 127, 0, 127, 127 };
+    Graphics_Rectangle row = { 0, 127, 127, 127 };
+    Graphics_Rectangle block = { 20, 30, 59, 59 };
+    Graphics_Rectangle outline = { 10, 10, 117, 117 };
+
+    Graphics_fillRectangle(context_p, &corner);
+
+    Graphics_setForegroundColor(context_p, GOLDEN_GREEN);
+    Graphics_fillRectangle(context_p, &column);
+    Graphics_fillRectangle(context_p, &row);
+
+    Graphics_setForegroundColor(context_p, GOLDEN_ORANGE);
+    Graphics_fillRectangle(context_p, &block);
+    Graphics_drawRectangle(context_p, &outline);
+}
+
+static void Golden_drawText(Graphics_Context* context_p)
+{
+    Graphics_Rectangle band = { 0, 40, 127, 55 };
+
+    Graphics_drawString(context_p, (int8_t*) "Guess the color", -1, 0, 0, OPAQUE_TEXT);
+
+    Graphics_setForegroundColor(context_p, GOLDEN_BLUE);
+    Graphics_fillRectangle(context_p, &band);
+    Graphics_setForegroundColor(context_p, GOLDEN_YELLOW);
+    Graphics_drawString(context_p, (int8_t*) "transparent", -1, 3, 44, TRANSPARENT_TEXT);
+
+    // Cut off by the right and the bottom edges
+    Graphics_drawString(context_p, (int8_t*) "edge", -1, 110, 70, OPAQUE_TEXT);
+    Graphics_drawString(context_p, (int8_t*) "bottom", -1, 30, 124, OPAQUE_TEXT);
+}
+
+static void Golden_drawImages(Graphics_Context* context_p)
+{
+    Graphics_drawImage(context_p, &happy8BPP_UNCOMP, 0, 0);
+    Graphics_drawImage(context_p, &sad8BPP_UNCOMP, 128 - 40, 128 - 40);
+
+    // Hanging off each edge
+    Graphics_drawImage(context_p, &happy8BPP_UNCOMP, -13, 50);
+    Graphics_drawImage(context_p, &sad8BPP_UNCOMP, 101, 44);
+    Graphics_drawImage(context_p, &happy8BPP_UNCOMP, 44, -29);
+    Graphics_drawImage(context_p, &sad8BPP_UNCOMP, 50, 117);
+}
+
+static void Golden_drawFullImage(Graphics_Context* context_p)
+{
+    Graphics_drawImage(context_p, &colors8BPP_UNCOMP, 0, 0);
+}
+
+static void Golden_drawPackedImages(Graphics_Context* context_p)
+{
+    int x;
+
+    // Every starting bit of the first byte, as the left edge clips them
+    for (x = 0; x > -8; x--) {
+        Graphics_drawImage(context_p, &arrow, x, 10 - 8 * x);
+    }
+    for (x = 0; x > -2; x--) {
+        Graphics_drawImage(context_p, &ramp, x, 90 - 8 * x);
+    }
+
+    Graphics_drawImage(context_p, &arrow, 61, 10);
+    Graphics_drawImage(context_p, &arrow, 122, 20);
+    Graphics_drawImage(context_p, &ramp, 61, 90);
+    Graphics_drawImage(context_p, &ramp, 124, 100);
+}
+
+static void Golden_drawCircles(Graphics_Context* context_p)
+{
+    Graphics_fillCircle(context_p, 64, 64, 30);
+
+    Graphics_setForegroundColor(context_p, GOLDEN_RED);
+    Graphics_drawCircle(context_p, 64, 64, 50);
+    Graphics_fillCircle(context_p, 0, 0, 20);
+    Graphics_drawCircle(context_p, 127, 127, 20);
+    Graphics_fillCircle(context_p, 64, 127, 10);
+}
+
+static void Golden_drawClipped(Graphics_Context* context_p)
+{
+    Graphics_Rectangle clip = { 20, 30, 99, 89 };
+    Graphics_Rectangle everything = { 0, 0, 127, 127 };
+    Graphics_Rectangle screen = { 0, 0, 127, 127 };
+
+    Graphics_setClipRegion(context_p, &clip);
+
+    Graphics_setForegroundColor(context_p, GOLDEN_BLUE);
+    Graphics_fillRectangle(context_p, &everything);
+
+    Graphics_setForegroundColor(context_p, GOLDEN_YELLOW);
+    Graphics_drawString(context_p, (int8_t*) "clipped text", -1, 5, 27, OPAQUE_TEXT);
+    Graphics_drawImage(context_p, &happy8BPP_UNCOMP, 75, 70);
+    Graphics_drawImage(context_p, &arrow, 15, 50);
+    Graphics_drawImage(context_p, &ramp, 17, 60);
+    Graphics_drawCircle(context_p, 20, 89, 15);
+    Graphics_drawLine(context_p, 0, 0, 127, 127);
+    Graphics_drawLineH(context_p, 0, 127, 60);
+    Graphics_drawLineV(context_p, 60, 0, 127);
+
+    Graphics_setClipRegion(context_p, &screen);
+}
+
+/** Something to tell the orientations apart by: where the corner is, and which way text runs. */
+static void Golden_drawOriented(Graphics_Context* context_p)
+{
+    Graphics_Rectangle corner = { 0, 0, 15, 7 };
+
+    Graphics_setForegroundColor(context_p, GOLDEN_RED);
+    Graphics_fillRectangle(context_p, &corner);
+
+    Graphics_setForegroundColor(context_p, GRAPHICS_COLOR_WHITE);
+    Graphics_drawString(context_p, (int8_t*) "top left", -1, 20, 0, OPAQUE_TEXT);
+    Graphics_drawLineV(context_p, 5, 10, 120);
+    Graphics_drawImage(context_p, &arrow, 30, 30);
+    Graphics_drawImage(context_p, &ramp, -1, 50);
+    Graphics_drawImage(context_p, &sad8BPP_UNCOMP, 100, 100);
+}
+
+static const GoldenCase cases[] =
+{
+    { "clear", LCD_ORIENTATION_UP, Golden_drawClear },
+    { "pixels", LCD_ORIENTATION_UP, Golden_drawPixels },
+    { "lines", LCD_ORIENTATION_UP, Golden_drawLines },
+    { "rectangles", LCD_ORIENTATION_UP, Golden_drawRectangles },
+    { "text", LCD_ORIENTATION_UP, Golden_drawText },
+    { "images", LCD_ORIENTATION_UP, Golden_drawImages },
+    { "full-image", LCD_ORIENTATION_UP, Golden_drawFullImage },
+    { "packed-images", LCD_ORIENTATION_UP, Golden_drawPackedImages },
+    { "circles", LCD_ORIENTATION_UP, Golden_drawCircles },
+    { "clipped", LCD_ORIENTATION_UP, Golden_drawClipped },
+    { "orientation-up", LCD_ORIENTATION_UP, Golden_drawOriented },
+    { "orientation-left", LCD_ORIENTATION_LEFT, Golden_drawOriented },
+    { "orientation-down", LCD_ORIENTATION_DOWN, Golden_drawOriented },
+    { "orientation-right", LCD_ORIENTATION_RIGHT, Golden_drawOriented },
+};
+
+static const GoldenFrame frames[] =
+{
+    { "frame-instructions", &instructionsStaticScreen, GOLDEN_FRAME(instructionsFrame) },
+    { "frame-game", &gameStaticScreen, GOLDEN_FRAME(gameFrame) },
+};
+
+static uint16_t Golden_getWidgetPixel(int x, int y)
+{
+    return widgetPixels[y * ST7735_PANEL_SIZE + x];
+}
+
+/** Converts a panel to the RGB bytes of a PPM image. */
+static void Golden_toRGB(GoldenPanel panel, uint8_t* rgb)
+{
+    int x, y;
+
+    for (y = 0; y < ST7735_PANEL_SIZE; y++)
+    {
+        for (x = 0; x < ST7735_PANEL_SIZE; x++)
+        {
+            uint16_t value = panel(x, y);
+            uint8_t red = (value >> 11) & 0x1F;
+            uint8_t green = (value >> 5) & 0x3F;
+            uint8_t blue = value & 0x1F;
+
+            *rgb++ = (red << 3) | (red >> 2);
+            *rgb++ = (green << 2) | (green >> 4);
+            *rgb++ = (blue << 3) | (blue >> 2);
+        }
+    }
+}
+
+/** Writes a panel as a PPM image, and ends the run if it cannot. */
+static void Golden_writePPM(const char* path, GoldenPanel panel)
+{
+    static uint8_t rgb[GOLDEN_PPM_SIZE];
+    FILE* file = fopen(path, "wb");
+
+    if (file == NULL)
+    {
+        perror(path);
+        exit(2);
+    }
+
+    Golden_toRGB(panel, rgb);
+    fprintf(file, "P6\n%d %d\n255\n", ST7735_PANEL_SIZE, ST7735_PANEL_SIZE);
+    fwrite(rgb, 1, sizeof(rgb), file);
+    fclose(file);
+}
+
+/**
+ * Reads a PPM image as written by Golden_writePPM().
+ *
+ * @return false if there is no such image, or it is not one of the panel
+ */
+static bool Golden_readPPM(const char* path, uint8_t* rgb)
+{
+    FILE* file = fopen(path, "rb");
+    int width, height, maximum;
+    bool ok;
+
+    if (file == NULL) {
+        return false;
+    }
+
+    ok = fscanf(file, "P6 %d %d %d", &width, &height, &maximum) == 3 && fgetc(file) != EOF
+         && width == ST7735_PANEL_SIZE && height == ST7735_PANEL_SIZE && maximum == 255
+         && fread(rgb, 1, GOLDEN_PPM_SIZE, file) == GOLDEN_PPM_SIZE;
+
+    fclose(file);
+    return ok;
+}
+
+/**
+ * Compares what the panel shows with its golden image, or stores it as the
+ * golden image with -w. A panel which differs is written to GOLDEN_ACTUAL.
+ * Nothing is compared when the images belong to another grlib.
+ */
+static void Golden_checkGolden(GoldenResult* result_p)
+{
+    static uint8_t expected[GOLDEN_PPM_SIZE];
+    static uint8_t actual[GOLDEN_PPM_SIZE];
+    char path[GOLDEN_PATH_SIZE];
+    int i;
+
+    snprintf(path, sizeof(path), "%s/%s.ppm", goldenDir, result_p->name);
+
+    if (write)
+    {
+        Golden_writePPM(path, ST7735Model_getPixel);
+        return;
+    }
+
+    if (wrongGrlib) {
+        return;
+    }
+
+    if (!Golden_readPPM(path, expected))
+    {
+        result_p->goldenMissing = true;
+        return;
+    }
+
+    Golden_toRGB(ST7735Model_getPixel, actual);
+    result_p->goldenDiffs = 0;
+
+    for (i = 0; i < GOLDEN_PPM_SIZE; i += 3)
+    {
+        if (memcmp(&expected[i], &actual[i], 3) != 0) {
+            result_p->goldenDiffs++;
+        }
+    }
+
+    if (result_p->goldenDiffs != 0)
+    {
+        snprintf(path, sizeof(path), "%s/%s.ppm", GOLDEN_ACTUAL, result_p->name);
+        Golden_writePPM(path, ST7735Model_getPixel);
+    }
+}
+
+/**
+ * Stores or reads the cksum of the grlib sources the golden images were drawn
+ * with, which the Makefile passes in GRLIB_SUM.
+ *
+ * @param sum:      The sum to store, or a buffer of GOLDEN_PATH_SIZE for the stored one
+ * @param store:    Whether to store it
+ */
+static void Golden_grlib(char* sum, bool store)
+{
+    char path[GOLDEN_PATH_SIZE];
+
+    snprintf(path, sizeof(path), "%s/%s", goldenDir, GOLDEN_GRLIB);
+    FILE* file = fopen(path, store ? "w" : "r");
+
+    if (file == NULL)
+    {
+        sum[0] = '\0';
+        return;
+    }
+
+    if (store) {
+        fprintf(file, "%s\n", sum);
+    }
+    else if (fscanf(file, "%255s", sum) != 1) {
+        sum[0] = '\0';
+    }
+
+    fclose(file);
+}
+
+/** Starts the result of a panel, with no comparisons made yet. */
+static GoldenResult* Golden_newResult(const char* name)
+{
+    GoldenResult* result_p = &results[numResults++];
+
+    result_p->name = name;
+    result_p->referenceDiffs = -1;
+    result_p->extraPixels = 0;
+    result_p->goldenDiffs = -1;
+    result_p->goldenMissing = false;
+
+    return result_p;
+}
+
+/** Records a screen of the game, which only has a golden image to go by. */
+static void Golden_screen(const char* name)
+{
+    Golden_checkGolden(Golden_newResult(name));
+}
+
+/**
+ * Draws a case on the panel and on the reference display, from the same
+ * blank screen, and compares both the pixels and how many were written.
+ */
+static void Golden_runCase(const GoldenCase* case_p)
+{
+    GoldenResult* result_p = Golden_newResult(case_p->name);
+    Graphics_Context lcd, reference;
+    char path[GOLDEN_PATH_SIZE];
+    uint64_t lcdPixels, referencePixels;
+    int x, y;
+
+    Crystalfontz128x128_SetOrientation(case_p->orientation);
+    ReferenceDisplay_setOrientation(case_p->orientation);
+
+    Graphics_initContext(&lcd, &g_sCrystalfontz128x128, &g_sCrystalfontz128x128_funcs);
+    Graphics_initContext(&reference, &ReferenceDisplay_display, &ReferenceDisplay_funcs);
+
+    Graphics_setFont(&lcd, &g_sFontFixed6x8);
+    Graphics_setFont(&reference, &g_sFontFixed6x8);
+    Graphics_setForegroundColor(&lcd, GRAPHICS_COLOR_WHITE);
+    Graphics_setForegroundColor(&reference, GRAPHICS_COLOR_WHITE);
+    Graphics_setBackgroundColor(&lcd, GRAPHICS_COLOR_BLACK);
+    Graphics_setBackgroundColor(&reference, GRAPHICS_COLOR_BLACK);
+
+    Graphics_clearDisplay(&lcd);
+    ReferenceDisplay_load();
+
+    lcdPixels = ST7735Model_getStats()->pixels;
+    referencePixels = ReferenceDisplay_getPixelCount();
+
+    case_p->draw(&lcd);
+    case_p->draw(&reference);
+
+    result_p->extraPixels = (int64_t) (ST7735Model_getStats()->pixels - lcdPixels)
+                            - (int64_t) (ReferenceDisplay_getPixelCount() - referencePixels);
+    result_p->referenceDiffs = 0;
+
+    for (y = 0; y < ST7735_PANEL_SIZE; y++)
+    {
+        for (x = 0; x < ST7735_PANEL_SIZE; x++)
+        {
+            if (ST7735Model_getPixel(x, y) != ReferenceDisplay_getPixel(x, y)) {
+                result_p->referenceDiffs++;
+            }
+        }
+    }
+
+    if (result_p->referenceDiffs != 0)
+    {
+        snprintf(path, sizeof(path), "%s/%s.reference.ppm", GOLDEN_ACTUAL, case_p->name);
+        Golden_writePPM(path, ReferenceDisplay_getPixel);
+        snprintf(path, sizeof(path), "%s/%s.ppm", GOLDEN_ACTUAL, case_p->name);
+        Golden_writePPM(path, ST7735Model_getPixel);
+    }
+
+    Golden_checkGolden(result_p);
+
+    Crystalfontz128x128_SetOrientation(LCD_ORIENTATION_UP);
+}
+
+/**
+ * Draws the static widgets of a frame, then the frame itself, and compares
+ * them pixel by pixel: the widgets stand in for the reference display. With
+ * -f, only writes what the widgets drew to GOLDEN_ACTUAL, for tools/mkframes.py.
+ */
+static void Golden_runFrame(UI* ui_p, GFX* gfx_p, const GoldenFrame* frame_p)
+{
+    GoldenResult* result_p;
+    char path[GOLDEN_PATH_SIZE];
+    int x, y;
+
+    UI_show(ui_p, frame_p->screen_p);
+
+    if (renderFrames)
+    {
+        snprintf(path, sizeof(path), "%s/%s.ppm", GOLDEN_ACTUAL, frame_p->name);
+        Golden_writePPM(path, ST7735Model_getPixel);
+        return;
+    }
+
+    for (y = 0; y < ST7735_PANEL_SIZE; y++)
+    {
+        for (x = 0; x < ST7735_PANEL_SIZE; x++) {
+            widgetPixels[y * ST7735_PANEL_SIZE + x] = ST7735Model_getPixel(x, y);
+        }
+    }
+
+    GFX_clear(gfx_p);
+    GFX_showFrame(gfx_p, frame_p->frame_p);
+
+    result_p = Golden_newResult(frame_p->name);
+    result_p->referenceDiffs = 0;
+
+    for (y = 0; y < ST7735_PANEL_SIZE; y++)
+    {
+        for (x = 0; x < ST7735_PANEL_SIZE; x++)
+        {
+            if (ST7735Model_getPixel(x, y) != Golden_getWidgetPixel(x, y)) {
+                result_p->referenceDiffs++;
+            }
+        }
+    }
+
+    if (result_p->referenceDiffs != 0)
+    {
+        snprintf(path, sizeof(path), "%s/%s.reference.ppm", GOLDEN_ACTUAL, frame_p->name);
+        Golden_writePPM(path, Golden_getWidgetPixel);
+        snprintf(path, sizeof(path), "%s/%s.ppm", GOLDEN_ACTUAL, frame_p->name);
+        Golden_writePPM(path, ST7735Model_getPixel);
+    }
+
+    Golden_checkGolden(result_p);
+}
+
+/**
+ * Draws every screen of the game the way main() sets them up, then every
+ * frame, then every case of the catalog.
+ */
+static void Golden_run()
+{
+    size_t i;
+
+    WDT_A_holdTimer();
+    InitSystemTiming();
+    Profiler_init();
+
+    HAL hal = HAL_construct();
+    App_GuessTheColor app = App_GuessTheColor_construct(&hal);
+
+    if (renderFrames)
+    {
+        for (i = 0; i < sizeof(frames) / sizeof(frames[0]); i++) {
+            Golden_runFrame(&app.ui, &hal.gfx, &frames[i]);
+        }
+        return;
+    }
+
+    App_GuessTheColor_showTitleScreen(&app);
+    Golden_screen("screen-title");
+    App_GuessTheColor_showInstructionsScreen(&app);
+    Golden_screen("screen-instructions");
+    App_GuessTheColor_showGameScreen(&app);
+    Golden_screen("screen-game");
+
+    app.cursor = CURSOR_2;
+    App_GuessTheColor_updateGameScreen(&app);
+    Golden_screen("screen-game-cursor");
+
+    App_GuessTheColor_showResultScreen(&app, &hal);
+    App_GuessTheColor_stopEffect(&hal);
+    Golden_screen("screen-result");
+
+    for (i = 0; i < sizeof(frames) / sizeof(frames[0]); i++) {
+        Golden_runFrame(&app.ui, &hal.gfx, &frames[i]);
+    }
+
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        Golden_runCase(&cases[i]);
+    }
+}
+
+/** Prints one comparison: ok, the number of pixels off, or a dash if it was not made. */
+static void Golden_printCount(int64_t count, bool made)
+{
+    if (!made) {
+        printf(" %12s", "-");
+    }
+    else if (count == 0) {
+        printf(" %12s", "ok");
+    }
+    else {
+        printf(" %12lld", (long long) count);
+    }
+}
+
+/**
+ * Draws every screen and case, and compares each with the reference display
+ * and with its golden image. Fails if any pixel differs, or if any golden
+ * image is missing. With -w, stores what the panel shows as the golden
+ * images instead, along with the grlib they were drawn with. With -f, only
+ * renders the static widgets of every frame into GOLDEN_ACTUAL.
+ *
+ * Golden images drawn with another grlib than the one in GRLIB_SUM are not
+ * compared at all: that is the wrong SDK for them, not a regression. Only
+ * the reference display is checked then.
+ *
+ *   golden [-w | -f] [golden image directory]
+ */
+int main(int argc, char** argv)
+{
+    char* grlib = getenv("GRLIB_SUM");
+    char goldenGrlib[GOLDEN_PATH_SIZE];
+    int failures = 0;
+    int missing = 0;
+    int i;
+
+    write = argc > 1 && strcmp(argv[1], "-w") == 0;
+    renderFrames = GOLDEN_RENDER_ONLY || (argc > 1 && strcmp(argv[1], "-f") == 0);
+    if (argc > 1 + (write || renderFrames)) {
+        goldenDir = argv[1 + (write || renderFrames)];
+    }
+
+    Golden_grlib(goldenGrlib, false);
+    wrongGrlib = !write && grlib != NULL && goldenGrlib[0] != '\0' && strcmp(grlib, goldenGrlib) != 0;
+
+    Golden_run();
+
+    if (renderFrames)
+    {
+        printf("%d frames rendered into %s\n", (int) (sizeof(frames) / sizeof(frames[0])), GOLDEN_ACTUAL);
+        return 0;
+    }
+
+    if (write)
+    {
+        if (grlib != NULL) {
+            Golden_grlib(grlib, true);
+        }
+        printf("%d golden images written to %s\n", numResults, goldenDir);
+        return 0;
+    }
+
+    printf("%-24s %12s %12s %12s\n", "panel", "reference", "pixels", "golden");
+
+    for (i = 0; i < numResults; i++)
+    {
+        GoldenResult* result_p = &results[i];
+        bool differs = result_p->referenceDiffs > 0 || result_p->extraPixels != 0 || result_p->goldenDiffs > 0;
+
+        printf("%-24s", result_p->name);
+        Golden_printCount(result_p->referenceDiffs, result_p->referenceDiffs >= 0);
+        Golden_printCount(result_p->extraPixels, result_p->referenceDiffs >= 0);
+        Golden_printCount(result_p->goldenDiffs, result_p->goldenDiffs >= 0);
+        printf("%s\n", differs ? "  FAILED" : result_p->goldenMissing ? "  MISSING" : "");
+
+        failures += differs;
+        missing += result_p->goldenMissing;
+    }
+
+    if (failures != 0) {
+        printf("%d of %d panels differ; see %s\n", failures, numResults, GOLDEN_ACTUAL);
+    }
+
+    if (missing != 0) {
+        printf("%d golden images are missing from %s; run make golden-update\n", missing, goldenDir);
+    }
+
+    if (wrongGrlib)
+    {
+        printf("wrong SDK for %s: it was drawn with grlib %s, not this SDK's %s\n",
+               goldenDir, goldenGrlib, grlib);
+        printf("only the reference display was checked; the screens were not checked at all\n");
+        printf("run make golden-update with the SDK the images should belong to\n");
+    }
+
+    for (i = 0; i < numResults; i++)
+    {
+        if (strncmp(results[i].name, "frame-", 6) == 0 && results[i].referenceDiffs > 0)
+        {
+            printf("a frame no longer matches the widgets it was rendered from: GFX_showFrame() or mkframes.py is wrong\n");
+            break;
+        }
+    }
+
+    return failures != 0 || missing != 0;
+}
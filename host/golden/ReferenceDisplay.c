@@ -0,0 +1,203 @@
+/*
+ * ReferenceDisplay.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <golden/ReferenceDisplay.h>
+#include <sim/ST7735Model.h>
+
+#include <HAL/LcdDriver/Crystalfontz128x128_ST7735.h>
+
+#define REFERENCE_DISPLAY_MAX   (REFERENCE_DISPLAY_SIZE - 1)
+
+static uint16_t frame[REFERENCE_DISPLAY_SIZE][REFERENCE_DISPLAY_SIZE];
+static uint8_t orientation = LCD_ORIENTATION_UP;
+static uint64_t pixelCount = 0;
+
+/**
+ * Stores one pixel, rotated into the frame buffer. Pixels off the display
+ * are a bug in the caller, and are dropped so the comparison shows them.
+ */
+static void ReferenceDisplay_store(int x, int y, uint16_t value)
+{
+    int frameX = x, frameY = y;
+
+    switch (orientation)
+    {
+        case LCD_ORIENTATION_LEFT:
+            frameX = REFERENCE_DISPLAY_MAX - y;
+            frameY = x;
+            break;
+        case LCD_ORIENTATION_DOWN:
+            frameX = REFERENCE_DISPLAY_MAX - x;
+            frameY = REFERENCE_DISPLAY_MAX - y;
+            break;
+        case LCD_ORIENTATION_RIGHT:
+            frameX = y;
+            frameY = REFERENCE_DISPLAY_MAX - x;
+            break;
+    }
+
+    pixelCount++;
+
+    if (frameX >= 0 && frameX < REFERENCE_DISPLAY_SIZE && frameY >= 0 && frameY < REFERENCE_DISPLAY_SIZE) {
+        frame[frameY][frameX] = value;
+    }
+}
+
+static void ReferenceDisplay_pixelDraw(const Graphics_Display* display_p, int16_t x, int16_t y, uint16_t value)
+{
+    ReferenceDisplay_store(x, y, value);
+}
+
+/**
+ * Draws a row of image pixels. Pixel i of the row starts (x0 + i) * bpp bits
+ * into the data, most significant bit first, except at 16 bits per pixel,
+ * where pixels are native values in the byte order of the host.
+ */
+static void ReferenceDisplay_pixelDrawMultiple(const Graphics_Display* display_p, int16_t x, int16_t y,
+                                               int16_t x0, int16_t count, int16_t bpp,
+                                               const uint8_t* data, const uint32_t* palette)
+{
+    int i;
+
+    for (i = 0; i < count; i++)
+    {
+        uint16_t value;
+
+        if (bpp == 16) {
+            value = data[2 * i] | (data[2 * i + 1] << 8);
+        }
+        else
+        {
+            int bit = (x0 + i) * bpp;
+            int index = (data[bit / 8] >> (8 - bpp - bit % 8)) & ((1 << bpp) - 1);
+
+            value = (uint16_t) palette[index];
+        }
+
+        ReferenceDisplay_store(x + i, y, value);
+    }
+}
+
+static void ReferenceDisplay_lineDrawH(const Graphics_Display* display_p, int16_t x1, int16_t x2, int16_t y,
+                                       uint16_t value)
+{
+    int x;
+
+    for (x = x1; x <= x2; x++) {
+        ReferenceDisplay_store(x, y, value);
+    }
+}
+
+static void ReferenceDisplay_lineDrawV(const Graphics_Display* display_p, int16_t x, int16_t y1, int16_t y2,
+                                       uint16_t value)
+{
+    int y;
+
+    for (y = y1; y <= y2; y++) {
+        ReferenceDisplay_store(x, y, value);
+    }
+}
+
+static void ReferenceDisplay_rectFill(const Graphics_Display* display_p, const Graphics_Rectangle* rect_p,
+                                      uint16_t value)
+{
+    int x, y;
+
+    for (y = rect_p->sYMin; y <= rect_p->sYMax; y++)
+    {
+        for (x = rect_p->sXMin; x <= rect_p->sXMax; x++) {
+            ReferenceDisplay_store(x, y, value);
+        }
+    }
+}
+
+/** Keeps the top five bits of red, six of green and five of blue. */
+static uint32_t ReferenceDisplay_colorTranslate(const Graphics_Display* display_p, uint32_t value)
+{
+    uint32_t red = (value >> 16) & 0xFF;
+    uint32_t green = (value >> 8) & 0xFF;
+    uint32_t blue = value & 0xFF;
+
+    return ((red >> 3) << 11) | ((green >> 2) << 5) | (blue >> 3);
+}
+
+static void ReferenceDisplay_flush(const Graphics_Display* display_p)
+{
+}
+
+static void ReferenceDisplay_clearDisplay(const Graphics_Display* display_p, uint16_t value)
+{
+    int x, y;
+
+    for (y = 0; y < REFERENCE_DISPLAY_SIZE; y++)
+    {
+        for (x = 0; x < REFERENCE_DISPLAY_SIZE; x++) {
+            ReferenceDisplay_store(x, y, value);
+        }
+    }
+}
+
+Graphics_Display ReferenceDisplay_display =
+{
+    sizeof(Graphics_Display),
+    0,
+    REFERENCE_DISPLAY_SIZE,
+    REFERENCE_DISPLAY_SIZE,
+};
+
+const Graphics_Display_Functions ReferenceDisplay_funcs =
+{
+    ReferenceDisplay_pixelDraw,
+    ReferenceDisplay_pixelDrawMultiple,
+    ReferenceDisplay_lineDrawH,
+    ReferenceDisplay_lineDrawV,
+    ReferenceDisplay_rectFill,
+    ReferenceDisplay_colorTranslate,
+    ReferenceDisplay_flush,
+    ReferenceDisplay_clearDisplay
+};
+
+/**
+ * Sets the orientation later drawings are rotated by.
+ *
+ * @param newOrientation:   One of the LCD_ORIENTATION_ values
+ */
+void ReferenceDisplay_setOrientation(uint8_t newOrientation)
+{
+    orientation = newOrientation;
+}
+
+/**
+ * Fills the frame buffer with what the ST7735 model shows.
+ */
+void ReferenceDisplay_load()
+{
+    int x, y;
+
+    for (y = 0; y < REFERENCE_DISPLAY_SIZE; y++)
+    {
+        for (x = 0; x < REFERENCE_DISPLAY_SIZE; x++) {
+            frame[y][x] = ST7735Model_getPixel(x, y);
+        }
+    }
+}
+
+/**
+ * Returns the pixel the user would see at (x, y).
+ */
+uint16_t ReferenceDisplay_getPixel(int x, int y)
+{
+    return frame[y][x];
+}
+
+/**
+ * Returns how many pixels were drawn since the start, including any which
+ * fell off the display.
+ */
+uint64_t ReferenceDisplay_getPixelCount()
+{
+    return pixelCount;
+}
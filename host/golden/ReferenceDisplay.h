@@ -0,0 +1,51 @@
+/*
+ * ReferenceDisplay.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HOST_GOLDEN_REFERENCEDISPLAY_H_
+#define HOST_GOLDEN_REFERENCEDISPLAY_H_
+
+#include <stdint.h>
+#include <ti/grlib/grlib.h>
+
+#define REFERENCE_DISPLAY_SIZE  128
+
+/**=============================================================================
+ * A grlib display which draws into a plain frame buffer, one pixel at a time,
+ * with none of the windowing, byte streaming or orientation tricks of the
+ * Crystalfontz driver. grlib does its clipping and rasterization the same
+ * way for both displays, so whatever the driver and the ST7735 model end up
+ * showing for a drawing has to match what this one shows, pixel for pixel.
+ *
+ * The frame buffer is kept the way the user sees the panel, as
+ * ST7735Model_getPixel() reads it. Each orientation is a plain rotation of
+ * the drawing coordinates into it:
+ *
+ *   LCD_ORIENTATION_UP     as drawn
+ *   LCD_ORIENTATION_LEFT   a quarter turn clockwise
+ *   LCD_ORIENTATION_DOWN   a half turn
+ *   LCD_ORIENTATION_RIGHT  a quarter turn counterclockwise
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * There is one frame buffer, shared by every context drawing on the display.
+ */
+
+extern Graphics_Display ReferenceDisplay_display;
+extern const Graphics_Display_Functions ReferenceDisplay_funcs;
+
+// Sets the orientation later drawings are rotated by.
+void ReferenceDisplay_setOrientation(uint8_t orientation);
+
+// Fills the frame buffer from the ST7735 model, so both start out the same.
+void ReferenceDisplay_load();
+
+// Returns the pixel the user would see at (x, y).
+uint16_t ReferenceDisplay_getPixel(int x, int y);
+
+// Returns how many pixels were drawn, in total.
+uint64_t ReferenceDisplay_getPixelCount();
+
+#endif /* HOST_GOLDEN_REFERENCEDISPLAY_H_ */
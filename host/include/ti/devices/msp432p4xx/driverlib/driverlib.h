@@ -0,0 +1,543 @@
+/*
+ * driverlib.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HOST_DRIVERLIB_H_
+#define HOST_DRIVERLIB_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**=============================================================================
+ * The host stand-in for the MSP432 driverlib and the CMSIS device header.
+ * It declares the subset of driverlib this project calls, with the same names
+ * and argument values as the SDK, and backs every call with the peripheral
+ * models in host/sim. The registers the HAL touches directly (the port
+ * registers, ADC14 results, eUSCI_A0 flags and the LCD's eUSCI_B0) are plain
+ * host memory here.
+ *
+ * Host builds leave __MSP432P401R__ undefined, which switches the HAL to its
+ * portable code paths: driverlib calls instead of bit-band aliases, and the
+ * Profiler's installable clock instead of the DWT.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * Only what this project uses is declared. A new driverlib call compiles on
+ * the board and fails to compile here until it is added to this header and
+ * to host/sim/SimDriverlib.c.
+ */
+
+//*****************************************************************************
+// CMSIS core
+//*****************************************************************************
+
+#define BIT0    0x01
+#define BIT1    0x02
+#define BIT2    0x04
+#define BIT3    0x08
+#define BIT4    0x10
+#define BIT5    0x20
+#define BIT6    0x40
+#define BIT7    0x80
+
+// Count leading zeros, which the Cortex-M4 defines as 32 for zero
+#define __CLZ(x)            ((x) ? (uint8_t) __builtin_clz(x) : 32)
+
+// Bit-band writes go to a proxy word, which lands in the register at the
+// next call into the simulation
+#define BITBAND_PERI(x, b)  (*SimGPIO_bitband(&(x), (b)))
+
+volatile uint32_t* SimGPIO_bitband(volatile uint8_t* register_p, int bit);
+
+//*****************************************************************************
+// Interrupts
+//*****************************************************************************
+
+#define FAULT_SYSTICK   15
+#define INT_TA0_0       24
+#define INT_EUSCIA0     32
+#define INT_ADC14       40
+#define INT_T32_INT1    41
+#define INT_T32_INT2    42
+#define INT_DMA_ERR     46
+#define INT_DMA_INT3    47
+#define INT_DMA_INT2    48
+#define INT_DMA_INT1    49
+#define INT_DMA_INT0    50
+#define INT_PORT1       51
+#define INT_PORT2       52
+#define INT_PORT3       53
+#define INT_PORT4       54
+#define INT_PORT5       55
+#define INT_PORT6       56
+
+bool Interrupt_enableMaster(void);
+bool Interrupt_disableMaster(void);
+void Interrupt_enableInterrupt(uint32_t interruptNumber);
+void Interrupt_disableInterrupt(uint32_t interruptNumber);
+
+//*****************************************************************************
+// GPIO
+//*****************************************************************************
+
+#define GPIO_PORT_P1    1
+#define GPIO_PORT_P2    2
+#define GPIO_PORT_P3    3
+#define GPIO_PORT_P4    4
+#define GPIO_PORT_P5    5
+#define GPIO_PORT_P6    6
+
+#define GPIO_PIN0       0x0001
+#define GPIO_PIN1       0x0002
+#define GPIO_PIN2       0x0004
+#define GPIO_PIN3       0x0008
+#define GPIO_PIN4       0x0010
+#define GPIO_PIN5       0x0020
+#define GPIO_PIN6       0x0040
+#define GPIO_PIN7       0x0080
+
+#define GPIO_PRIMARY_MODULE_FUNCTION    0x01
+#define GPIO_SECONDARY_MODULE_FUNCTION  0x02
+#define GPIO_TERTIARY_MODULE_FUNCTION   0x03
+
+#define GPIO_HIGH_TO_LOW_TRANSITION     0x01
+#define GPIO_LOW_TO_HIGH_TRANSITION     0x00
+
+#define GPIO_INPUT_PIN_HIGH             0x01
+#define GPIO_INPUT_PIN_LOW              0x00
+
+/**
+ * A pair of ports as one 16-bit port, like PA for P1 and P2. The odd port
+ * is the low byte of every register and the even port the high byte.
+ */
+typedef struct
+{
+    volatile uint16_t IN;
+    volatile uint16_t OUT;
+    volatile uint16_t DIR;
+    volatile uint16_t REN;
+    volatile uint16_t DS;
+    volatile uint16_t SEL0;
+    volatile uint16_t SEL1;
+    volatile uint16_t IES;
+    volatile uint16_t IE;
+    volatile uint16_t IFG;
+} DIO_PORT_Interruptable_Type;
+
+typedef struct
+{
+    volatile uint8_t IN;    uint8_t RESERVED0;
+    volatile uint8_t OUT;   uint8_t RESERVED1;
+    volatile uint8_t DIR;   uint8_t RESERVED2;
+    volatile uint8_t REN;   uint8_t RESERVED3;
+    volatile uint8_t DS;    uint8_t RESERVED4;
+    volatile uint8_t SEL0;  uint8_t RESERVED5;
+    volatile uint8_t SEL1;  uint8_t RESERVED6;
+    volatile uint8_t IES;   uint8_t RESERVED7;
+    volatile uint8_t IE;    uint8_t RESERVED8;
+    volatile uint8_t IFG;   uint8_t RESERVED9;
+} DIO_PORT_Odd_Interruptable_Type;
+
+typedef struct
+{
+    uint8_t RESERVED0;      volatile uint8_t IN;
+    uint8_t RESERVED1;      volatile uint8_t OUT;
+    uint8_t RESERVED2;      volatile uint8_t DIR;
+    uint8_t RESERVED3;      volatile uint8_t REN;
+    uint8_t RESERVED4;      volatile uint8_t DS;
+    uint8_t RESERVED5;      volatile uint8_t SEL0;
+    uint8_t RESERVED6;      volatile uint8_t SEL1;
+    uint8_t RESERVED7;      volatile uint8_t IES;
+    uint8_t RESERVED8;      volatile uint8_t IE;
+    uint8_t RESERVED9;      volatile uint8_t IFG;
+} DIO_PORT_Even_Interruptable_Type;
+
+extern DIO_PORT_Interruptable_Type SimGPIO_ports[3];
+
+#define PA  (&SimGPIO_ports[0])
+#define PB  (&SimGPIO_ports[1])
+#define PC  (&SimGPIO_ports[2])
+#define P1  ((DIO_PORT_Odd_Interruptable_Type*)  &SimGPIO_ports[0])
+#define P2  ((DIO_PORT_Even_Interruptable_Type*) &SimGPIO_ports[0])
+#define P3  ((DIO_PORT_Odd_Interruptable_Type*)  &SimGPIO_ports[1])
+#define P4  ((DIO_PORT_Even_Interruptable_Type*) &SimGPIO_ports[1])
+#define P5  ((DIO_PORT_Odd_Interruptable_Type*)  &SimGPIO_ports[2])
+#define P6  ((DIO_PORT_Even_Interruptable_Type*) &SimGPIO_ports[2])
+
+void GPIO_setAsOutputPin(uint_fast8_t selectedPort, uint_fast16_t selectedPins);
+void GPIO_setAsInputPin(uint_fast8_t selectedPort, uint_fast16_t selectedPins);
+void GPIO_setAsInputPinWithPullUpResistor(uint_fast8_t selectedPort, uint_fast16_t selectedPins);
+void GPIO_setAsPeripheralModuleFunctionOutputPin(uint_fast8_t selectedPort, uint_fast16_t selectedPins,
+                                                 uint_fast8_t mode);
+void GPIO_setAsPeripheralModuleFunctionInputPin(uint_fast8_t selectedPort, uint_fast16_t selectedPins,
+                                                uint_fast8_t mode);
+void GPIO_setOutputHighOnPin(uint_fast8_t selectedPort, uint_fast16_t selectedPins);
+void GPIO_setOutputLowOnPin(uint_fast8_t selectedPort, uint_fast16_t selectedPins);
+void GPIO_toggleOutputOnPin(uint_fast8_t selectedPort, uint_fast16_t selectedPins);
+uint8_t GPIO_getInputPinValue(uint_fast8_t selectedPort, uint_fast16_t selectedPins);
+void GPIO_interruptEdgeSelect(uint_fast8_t selectedPort, uint_fast16_t selectedPins, uint_fast8_t edgeSelect);
+void GPIO_enableInterrupt(uint_fast8_t selectedPort, uint_fast16_t selectedPins);
+void GPIO_disableInterrupt(uint_fast8_t selectedPort, uint_fast16_t selectedPins);
+void GPIO_clearInterruptFlag(uint_fast8_t selectedPort, uint_fast16_t selectedPins);
+uint_fast16_t GPIO_getEnabledInterruptStatus(uint_fast8_t selectedPort);
+
+//*****************************************************************************
+// Clock system, power and watchdog
+//*****************************************************************************
+
+#define CS_MCLK                 0x01
+#define CS_ACLK                 0x02
+#define CS_HSMCLK               0x04
+#define CS_SMCLK                0x08
+
+#define CS_DCOCLK_SELECT        0x03
+#define CS_REFOCLK_SELECT       0x02
+#define CS_CLOCK_DIVIDER_1      0x00
+
+void CS_setDCOFrequency(uint32_t dcoFrequency);
+void CS_initClockSignal(uint32_t selectedClockSignal, uint32_t clockSource, uint32_t clockSourceDivider);
+uint32_t CS_getMCLK(void);
+uint32_t CS_getSMCLK(void);
+
+void PCM_gotoLPM0(void);
+
+#define WDT_A_CLOCKSOURCE_SMCLK         0x00
+#define WDT_A_CLOCKITERATIONS_2G        0x00
+#define WDT_A_CLOCKITERATIONS_128M      0x01
+#define WDT_A_CLOCKITERATIONS_8192K     0x02
+#define WDT_A_CLOCKITERATIONS_512K      0x03
+
+void WDT_A_holdTimer(void);
+void WDT_A_startTimer(void);
+void WDT_A_clearTimer(void);
+void WDT_A_initWatchdogTimer(uint_fast8_t clockSelect, uint_fast8_t clockDivider);
+
+//*****************************************************************************
+// Flash
+//*****************************************************************************
+
+#define FLASH_BANK0                     0x00
+#define FLASH_BANK1                     0x01
+#define FLASH_MAIN_MEMORY_SPACE_BANK0   0x01
+#define FLASH_MAIN_MEMORY_SPACE_BANK1   0x02
+#define FLASH_SECTOR30                  0x40000000
+#define FLASH_SECTOR31                  0x80000000
+
+// The simulated flash: the last two sectors of bank 1, where the KVStore
+// lives. Host builds point KV_FLASH_BASE here.
+#define SIM_FLASH_SECTOR_SIZE           4096
+#define SIM_FLASH_FIRST_SECTOR          30
+#define SIM_FLASH_SIZE                  (2 * SIM_FLASH_SECTOR_SIZE)
+
+extern uint8_t SimFlash_memory[SIM_FLASH_SIZE];
+
+void FlashCtl_setWaitState(uint32_t bank, uint32_t waitState);
+bool FlashCtl_unprotectSector(uint_fast8_t memorySpace, uint32_t sectorMask);
+bool FlashCtl_protectSector(uint_fast8_t memorySpace, uint32_t sectorMask);
+bool FlashCtl_eraseSector(uint32_t addr);
+bool FlashCtl_programMemory(void* src, void* dest, uint32_t length);
+
+//*****************************************************************************
+// SysTick and Timer32
+//*****************************************************************************
+
+void SysTick_enableModule(void);
+void SysTick_disableModule(void);
+void SysTick_setPeriod(uint32_t period);
+void SysTick_enableInterrupt(void);
+void SysTick_disableInterrupt(void);
+
+#define TIMER32_0_BASE          0x4000C000
+#define TIMER32_1_BASE          0x4000C020
+
+#define TIMER32_PRESCALER_1     0x00
+#define TIMER32_16BIT           0x00
+#define TIMER32_32BIT           0x01
+#define TIMER32_FREE_RUN_MODE   0x00
+#define TIMER32_PERIODIC_MODE   0x40
+
+void Timer32_initModule(uint32_t timer, uint32_t preScaler, uint32_t resolution, uint32_t mode);
+void Timer32_setCount(uint32_t timer, uint32_t count);
+uint32_t Timer32_getValue(uint32_t timer);
+void Timer32_startTimer(uint32_t timer, bool oneShot);
+void Timer32_haltTimer(uint32_t timer);
+void Timer32_enableInterrupt(uint32_t timer);
+void Timer32_disableInterrupt(uint32_t timer);
+void Timer32_clearInterruptFlag(uint32_t timer);
+uint32_t Timer32_getInterruptStatus(uint32_t timer);
+
+//*****************************************************************************
+// Timer_A
+//*****************************************************************************
+
+#define TIMER_A0_BASE                               0x40000000
+#define TIMER_A1_BASE                               0x40000400
+#define TIMER_A2_BASE                               0x40000800
+#define TIMER_A3_BASE                               0x40000C00
+
+// The registers RGBLED writes its duty cycles to
+typedef struct
+{
+    volatile uint16_t CTL;
+    volatile uint16_t CCTL[7];
+    volatile uint16_t R;
+    volatile uint16_t CCR[7];
+} Timer_A_Type;
+
+extern Timer_A_Type SimTimerA_registers[4];
+
+#define TIMER_A0    (&SimTimerA_registers[0])
+#define TIMER_A1    (&SimTimerA_registers[1])
+#define TIMER_A2    (&SimTimerA_registers[2])
+#define TIMER_A3    (&SimTimerA_registers[3])
+
+#define TIMER_A_CLOCKSOURCE_SMCLK                   0x0200
+#define TIMER_A_CLOCKSOURCE_DIVIDER_1               0x01
+#define TIMER_A_CLOCKSOURCE_DIVIDER_48              0x30
+#define TIMER_A_TAIE_INTERRUPT_DISABLE              0x00
+#define TIMER_A_CCIE_CCR0_INTERRUPT_DISABLE         0x00
+#define TIMER_A_CAPTURECOMPARE_INTERRUPT_DISABLE    0x00
+#define TIMER_A_DO_CLEAR                            0x0004
+#define TIMER_A_SKIP_CLEAR                          0x00
+#define TIMER_A_UP_MODE                             0x0010
+
+#define TIMER_A_CAPTURECOMPARE_REGISTER_0           0x02
+#define TIMER_A_CAPTURECOMPARE_REGISTER_1           0x04
+#define TIMER_A_CAPTURECOMPARE_REGISTER_2           0x06
+#define TIMER_A_CAPTURECOMPARE_REGISTER_3           0x08
+#define TIMER_A_CAPTURECOMPARE_REGISTER_4           0x0A
+
+#define TIMER_A_OUTPUTMODE_OUTBITVALUE              0x00
+#define TIMER_A_OUTPUTMODE_SET_RESET                0x60
+#define TIMER_A_OUTPUTMODE_RESET_SET                0xE0
+
+typedef struct
+{
+    uint_fast16_t clockSource;
+    uint_fast16_t clockSourceDivider;
+    uint_fast16_t timerPeriod;
+    uint_fast16_t timerInterruptEnable_TAIE;
+    uint_fast16_t captureCompareInterruptEnable_CCR0_CCIE;
+    uint_fast16_t timerClear;
+} Timer_A_UpModeConfig;
+
+typedef struct
+{
+    uint_fast16_t compareRegister;
+    uint_fast16_t compareInterruptEnable;
+    uint_fast16_t compareOutputMode;
+    uint_fast16_t compareValue;
+} Timer_A_CompareModeConfig;
+
+typedef struct
+{
+    uint_fast16_t clockSource;
+    uint_fast16_t clockSourceDivider;
+    uint_fast16_t timerPeriod;
+    uint_fast16_t compareRegister;
+    uint_fast16_t compareOutputMode;
+    uint_fast16_t dutyCycle;
+} Timer_A_PWMConfig;
+
+void Timer_A_configureUpMode(uint32_t timer, const Timer_A_UpModeConfig* config);
+void Timer_A_initCompare(uint32_t timer, const Timer_A_CompareModeConfig* compareConfig);
+void Timer_A_startCounter(uint32_t timer, uint_fast16_t timerMode);
+void Timer_A_stopTimer(uint32_t timer);
+void Timer_A_generatePWM(uint32_t timer, const Timer_A_PWMConfig* config);
+void Timer_A_setCompareValue(uint32_t timer, uint_fast16_t compareRegister, uint_fast16_t compareValue);
+
+//*****************************************************************************
+// ADC14
+//*****************************************************************************
+
+#define ADC_CLOCKSOURCE_ADCOSC          0x00000000
+#define ADC_PREDIVIDER_1                0x00000000
+#define ADC_DIVIDER_1                   0x00000000
+#define ADC_MEM0                        0x00000001
+#define ADC_MEM1                        0x00000002
+#define ADC_VREFPOS_AVCC_VREFNEG_VSS    0x00000000
+#define ADC_INPUT_A9                    0x00000009
+#define ADC_INPUT_A15                   0x0000000F
+#define ADC_NONDIFFERENTIAL_INPUTS      false
+#define ADC_TRIGGER_ADCSC               0x00000000
+#define ADC_TRIGGER_SOURCE7             0x0E000000
+
+typedef struct
+{
+    volatile uint32_t CTL0;
+    volatile uint32_t CTL1;
+    volatile uint32_t MCTL[32];
+    volatile uint32_t MEM[32];
+} ADC14_Type;
+
+extern ADC14_Type SimADC14;
+
+#define ADC14   (&SimADC14)
+
+void ADC14_enableModule(void);
+bool ADC14_initModule(uint32_t clockSource, uint32_t clockPredivider, uint32_t clockDivider,
+                      uint32_t internalChannelMask);
+bool ADC14_configureMultiSequenceMode(uint32_t memoryStart, uint32_t memoryEnd, bool repeatMode);
+bool ADC14_configureConversionMemory(uint32_t memorySelect, uint32_t refSelect, uint32_t channelSelect,
+                                     bool differntialMode);
+bool ADC14_setSampleHoldTrigger(uint32_t source, bool invertSignal);
+bool ADC14_enableConversion(void);
+
+//*****************************************************************************
+// DMA
+//*****************************************************************************
+
+// Channel and source of each assignment, as channel | (source << 24)
+#define DMA_CH0_EUSCIA0TX               0x00000000
+#define DMA_CH2_TIMERA1CCR0             0x04000002
+#define DMA_CH3_TIMERA1CCR2             0x04000003
+#define DMA_CH7_ADC14                   0x07000007
+
+#define DMA_INT0                        INT_DMA_INT0
+#define DMA_INT1                        INT_DMA_INT1
+#define DMA_INT2                        INT_DMA_INT2
+#define DMA_INT3                        INT_DMA_INT3
+
+#define UDMA_PRI_SELECT                 0x00000000
+#define UDMA_ALT_SELECT                 0x00000020
+
+#define UDMA_ATTR_ALTSELECT             0x00000002
+
+#define UDMA_MODE_STOP                  0x00000000
+#define UDMA_MODE_BASIC                 0x00000001
+#define UDMA_MODE_AUTO                  0x00000002
+#define UDMA_MODE_PINGPONG              0x00000003
+#define UDMA_MODE_MEM_SCATTER_GATHER    0x00000004
+#define UDMA_MODE_PER_SCATTER_GATHER    0x00000006
+#define UDMA_MODE_ALT_SELECT            0x00000001
+
+#define UDMA_DST_INC_8                  0x00000000
+#define UDMA_DST_INC_16                 0x40000000
+#define UDMA_DST_INC_32                 0x80000000
+#define UDMA_DST_INC_NONE               0xC0000000
+#define UDMA_SRC_INC_8                  0x00000000
+#define UDMA_SRC_INC_16                 0x04000000
+#define UDMA_SRC_INC_32                 0x08000000
+#define UDMA_SRC_INC_NONE               0x0C000000
+#define UDMA_SIZE_8                     0x00000000
+#define UDMA_SIZE_16                    0x11000000
+#define UDMA_SIZE_32                    0x22000000
+#define UDMA_ARB_1                      0x00000000
+#define UDMA_ARB_2                      0x00004000
+
+/**
+ * A channel control structure. Unlike the uDMA, which keeps the address of
+ * the last item, the host model keeps the address of the first.
+ */
+typedef struct
+{
+    volatile void* srcEndAddr;
+    volatile void* dstEndAddr;
+    volatile uint32_t control;
+    volatile uint32_t spare;
+} DMA_ControlTable;
+
+#define DMA_TaskStructEntry(transferCount, itemSize, srcIncrement, srcAddr, dstIncrement, dstAddr, arbSize, mode) \
+    { (void*) (srcAddr), (void*) (dstAddr),                                                     \
+      (srcIncrement) | (dstIncrement) | (itemSize) | (arbSize) | (((transferCount) - 1) << 4) | \
+      ((((mode) == UDMA_MODE_MEM_SCATTER_GATHER) || ((mode) == UDMA_MODE_PER_SCATTER_GATHER))   \
+          ? (mode) | UDMA_MODE_ALT_SELECT : (mode)), 0 }
+
+void DMA_enableModule(void);
+void DMA_setControlBase(void* controlTable);
+void DMA_assignChannel(uint32_t mapping);
+void DMA_assignInterrupt(uint32_t interruptNumber, uint32_t channel);
+void DMA_setChannelControl(uint32_t channelStructIndex, uint32_t control);
+void DMA_setChannelTransfer(uint32_t channelStructIndex, uint32_t mode, void* srcAddr, void* dstAddr,
+                            uint32_t transferSize);
+void DMA_setChannelScatterGather(uint32_t channelNum, uint32_t taskCount, void* taskList,
+                                 uint32_t isPeriphSG);
+void DMA_enableChannel(uint32_t channelNum);
+void DMA_disableChannel(uint32_t channelNum);
+uint32_t DMA_getChannelAttribute(uint32_t channelNum);
+uint32_t DMA_getChannelSize(uint32_t channelStructIndex);
+uint32_t DMA_getInterruptStatus(void);
+void DMA_clearInterruptFlag(uint32_t intChannel);
+void DMA_requestSoftwareTransfer(uint32_t channel);
+
+//*****************************************************************************
+// eUSCI: the backchannel UART on eUSCI_A0 and the LCD's SPI on eUSCI_B0
+//*****************************************************************************
+
+#define EUSCI_A0_BASE                                           0x40001000
+#define EUSCI_B0_BASE                                           0x40002000
+
+#define EUSCI_A_UART_CLOCKSOURCE_SMCLK                          0x0080
+#define EUSCI_A_UART_NO_PARITY                                  0x00
+#define EUSCI_A_UART_LSB_FIRST                                  0x00
+#define EUSCI_A_UART_ONE_STOP_BIT                               0x00
+#define EUSCI_A_UART_MODE                                       0x00
+#define EUSCI_A_UART_OVERSAMPLING_BAUDRATE_GENERATION           0x01
+#define EUSCI_A_UART_8_BIT_LEN                                  0x00
+
+#define EUSCI_B_SPI_CLOCKSOURCE_SMCLK                           0x0080
+#define EUSCI_B_SPI_MSB_FIRST                                   0x2000
+#define EUSCI_B_SPI_PHASE_DATA_CAPTURED_ONFIRST_CHANGED_ON_NEXT 0x8000
+#define EUSCI_B_SPI_CLOCKPOLARITY_INACTIVITY_LOW                0x00
+#define EUSCI_B_SPI_3PIN                                        0x00
+
+#define EUSCI_A_IFG_TXIFG                                       0x0002
+
+typedef struct
+{
+    uint_fast8_t selectClockSource;
+    uint_fast16_t clockPrescalar;
+    uint_fast8_t firstModReg;
+    uint_fast8_t secondModReg;
+    uint_fast8_t parity;
+    uint_fast16_t msborLsbFirst;
+    uint_fast16_t numberofStopBits;
+    uint_fast16_t uartMode;
+    uint_fast8_t overSampling;
+    uint_fast16_t dataLength;
+} eUSCI_UART_ConfigV1;
+
+typedef struct
+{
+    uint_fast8_t selectClockSource;
+    uint32_t clockSourceFrequency;
+    uint32_t desiredSpiClock;
+    uint_fast16_t msbFirst;
+    uint_fast16_t clockPhase;
+    uint_fast16_t clockPolarity;
+    uint_fast16_t spiMode;
+} eUSCI_SPI_MasterConfig;
+
+typedef struct
+{
+    volatile uint16_t TXBUF;
+    volatile uint16_t IFG;
+} EUSCI_A_Type;
+
+extern EUSCI_A_Type SimUART_registers;
+
+#define EUSCI_A0    (&SimUART_registers)
+
+bool UART_initModule(uint32_t moduleInstance, const eUSCI_UART_ConfigV1* config);
+void UART_enableModule(uint32_t moduleInstance);
+
+bool SPI_initMaster(uint32_t moduleInstance, const eUSCI_SPI_MasterConfig* config);
+void SPI_enableModule(uint32_t moduleInstance);
+
+// The LCD driver polls UCB0STATW and writes UCB0TXBUF directly. A write only
+// stores the byte; the next status read shifts it out to the panel model
+// and advances the clock by the time the byte takes on the bus.
+#define UCBUSY          0x0001
+#define UCB0TXBUF       (SimSPI_txbuf)
+#define UCB0STATW       (SimSPI_status())
+
+extern volatile uint16_t SimSPI_txbuf;
+uint16_t SimSPI_status(void);
+
+// Runs a delay loop of three cycles per count, for the LCD driver's SysCtlDelay()
+void SimCPU_delay(uint32_t count);
+
+#endif /* HOST_DRIVERLIB_H_ */
@@ -0,0 +1,240 @@
+/*
+ * ST7735Model.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <sim/ST7735Model.h>
+
+// The commands the model acts on, as in Crystalfontz128x128_ST7735.h
+#define ST7735_SWRESET          0x01
+#define ST7735_CASET            0x2A
+#define ST7735_RASET            0x2B
+#define ST7735_RAMWR            0x2C
+#define ST7735_MADCTL           0x36
+
+#define ST7735_MADCTL_MY        0x80
+#define ST7735_MADCTL_MX        0x40
+#define ST7735_MADCTL_MV        0x20
+
+#define ST7735_NO_COMMAND       -1
+
+static uint16_t gram[ST7735_GRAM_HEIGHT][ST7735_GRAM_WIDTH];
+
+static int command = ST7735_NO_COMMAND;
+static int paramIndex = 0;
+static uint8_t params[4];
+
+static uint8_t madctl = 0;
+static uint16_t colStart = 0, colEnd = ST7735_GRAM_WIDTH - 1;
+static uint16_t rowStart = 0, rowEnd = ST7735_GRAM_HEIGHT - 1;
+
+// The window position of the next pixel, and the first half of a pixel
+static uint16_t col = 0, row = 0;
+static uint8_t highByte;
+static bool haveHighByte = false;
+
+static ST7735Stats stats;
+
+/** Printable names of the commands the driver sends. */
+static const char* ST7735Model_commandName(uint8_t code)
+{
+    switch (code)
+    {
+        case 0x01: return "SWRESET";
+        case 0x11: return "SLPOUT";
+        case 0x13: return "NORON";
+        case 0x26: return "GAMSET";
+        case 0x28: return "DISPOFF";
+        case 0x29: return "DISPON";
+        case 0x2A: return "CASET";
+        case 0x2B: return "RASET";
+        case 0x2C: return "RAMWR";
+        case 0x36: return "MADCTL";
+        case 0x3A: return "COLMOD";
+        case 0xB1: return "SETPWCTR";
+        case 0xC0: return "SETSTBA";
+        default:   return "?";
+    }
+}
+
+/**
+ * Stores one pixel at the current window position, going through MADCTL
+ * the way the controller does: MV exchanges the column and row, then MX and
+ * MY mirror the frame memory address.
+ */
+static void ST7735Model_storePixel(uint16_t value)
+{
+    int x = (madctl & ST7735_MADCTL_MV) ? row : col;
+    int y = (madctl & ST7735_MADCTL_MV) ? col : row;
+
+    if (madctl & ST7735_MADCTL_MX) {
+        x = ST7735_GRAM_WIDTH - 1 - x;
+    }
+    if (madctl & ST7735_MADCTL_MY) {
+        y = ST7735_GRAM_HEIGHT - 1 - y;
+    }
+
+    stats.pixels++;
+
+    if (x >= 0 && x < ST7735_GRAM_WIDTH && y >= 0 && y < ST7735_GRAM_HEIGHT) {
+        gram[y][x] = value;
+    }
+
+    if (x < ST7735_PANEL_X || x >= ST7735_PANEL_X + ST7735_PANEL_SIZE ||
+        y < ST7735_PANEL_Y || y >= ST7735_PANEL_Y + ST7735_PANEL_SIZE)
+    {
+        stats.hiddenPixels++;
+    }
+
+    // Columns first, then rows, wrapping back to the start of the window
+    if (++col > colEnd)
+    {
+        col = colStart;
+        if (++row > rowEnd) {
+            row = rowStart;
+        }
+    }
+}
+
+/** Starts a command. Commands without parameters take effect at once. */
+static void ST7735Model_command(uint8_t code)
+{
+    command = code;
+    paramIndex = 0;
+    haveHighByte = false;
+
+    stats.commandBytes++;
+    stats.commands[code]++;
+
+    if (code == ST7735_RAMWR)
+    {
+        col = colStart;
+        row = rowStart;
+    }
+    else if (code == ST7735_SWRESET)
+    {
+        madctl = 0;
+        colStart = 0;
+        colEnd = ST7735_GRAM_WIDTH - 1;
+        rowStart = 0;
+        rowEnd = ST7735_GRAM_HEIGHT - 1;
+    }
+}
+
+/** Takes one parameter or pixel byte of the current command. */
+static void ST7735Model_data(uint8_t byte)
+{
+    stats.dataBytes++;
+
+    switch (command)
+    {
+        case ST7735_RAMWR:
+            if (haveHighByte) {
+                ST7735Model_storePixel(((uint16_t) highByte << 8) | byte);
+            }
+            else {
+                highByte = byte;
+            }
+            haveHighByte = !haveHighByte;
+            break;
+
+        case ST7735_CASET:
+        case ST7735_RASET:
+            if (paramIndex < 4) {
+                params[paramIndex++] = byte;
+            }
+
+            if (paramIndex == 4)
+            {
+                uint16_t start = ((uint16_t) params[0] << 8) | params[1];
+                uint16_t end = ((uint16_t) params[2] << 8) | params[3];
+
+                if (command == ST7735_CASET)
+                {
+                    colStart = start;
+                    colEnd = end;
+                }
+                else
+                {
+                    rowStart = start;
+                    rowEnd = end;
+                    stats.windows++;
+                }
+                paramIndex++;
+            }
+            break;
+
+        case ST7735_MADCTL:
+            if (paramIndex++ == 0) {
+                madctl = byte;
+            }
+            break;
+
+        default:
+            // Parameters of commands which do not change what is drawn
+            break;
+    }
+}
+
+/**
+ * Feeds one byte from the bus.
+ *
+ * @param byte:     The byte the SPI shifted out
+ * @param isData:   The level of the data/command pin, high for data
+ */
+void ST7735Model_write(uint8_t byte, bool isData)
+{
+    stats.bytes++;
+
+    if (isData) {
+        ST7735Model_data(byte);
+    }
+    else {
+        ST7735Model_command(byte);
+    }
+}
+
+/**
+ * Returns a pixel of the visible panel, as the user sees it with the board
+ * held for LCD_ORIENTATION_UP.
+ *
+ * @param x:    The column, from 0 on the left to 127
+ * @param y:    The row, from 0 at the top to 127
+ * @return the 16-bit pixel value last written there
+ */
+uint16_t ST7735Model_getPixel(int x, int y)
+{
+    return gram[ST7735_PANEL_Y + ST7735_PANEL_SIZE - 1 - y][ST7735_PANEL_X + ST7735_PANEL_SIZE - 1 - x];
+}
+
+/**
+ * Returns what the controller was sent so far.
+ */
+const ST7735Stats* ST7735Model_getStats()
+{
+    return &stats;
+}
+
+/**
+ * Prints the statistics.
+ *
+ * @param file:     Where to print them
+ */
+void ST7735Model_report(FILE* file)
+{
+    int code;
+
+    fprintf(file, "lcd: %llu bytes (%llu command, %llu data), %llu pixels (%llu hidden), %u windows\n",
+            (unsigned long long) stats.bytes, (unsigned long long) stats.commandBytes,
+            (unsigned long long) stats.dataBytes, (unsigned long long) stats.pixels,
+            (unsigned long long) stats.hiddenPixels, stats.windows);
+
+    for (code = 0; code < 256; code++)
+    {
+        if (stats.commands[code] != 0) {
+            fprintf(file, "lcd: command 0x%02X %-8s sent %u times\n",
+                    code, ST7735Model_commandName(code), stats.commands[code]);
+        }
+    }
+}
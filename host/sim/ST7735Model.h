@@ -0,0 +1,69 @@
+/*
+ * ST7735Model.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HOST_SIM_ST7735MODEL_H_
+#define HOST_SIM_ST7735MODEL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+// The controller's frame memory, as strapped on the Crystalfontz panel
+#define ST7735_GRAM_WIDTH       132
+#define ST7735_GRAM_HEIGHT      132
+
+// The visible 128x128 pixels, in frame memory coordinates with no MADCTL
+// mirroring. The driver's per-orientation offsets all land on this window.
+#define ST7735_PANEL_SIZE       128
+#define ST7735_PANEL_X          2
+#define ST7735_PANEL_Y          1
+
+/**
+ * Everything the controller was sent, and what it did with it.
+ */
+struct _ST7735Stats
+{
+    uint64_t bytes;                 // Every byte on the bus, commands included
+    uint64_t commandBytes;
+    uint64_t dataBytes;
+    uint64_t pixels;                // Pixels written by RAMWR
+    uint64_t hiddenPixels;          // Pixels written outside the visible panel
+    uint32_t windows;               // CASET/RASET pairs, counted by their RASET
+    uint32_t commands[256];         // Times each command was sent
+};
+typedef struct _ST7735Stats ST7735Stats;
+
+/**=============================================================================
+ * A behavioral model of the ST7735 controller on the Boosterpack's LCD. It
+ * is fed one byte at a time from the SPI, together with the level of the
+ * data/command pin, and follows CASET, RASET, RAMWR and MADCTL the way the
+ * controller does: RAMWR data fills the window column by column and row by
+ * row, wrapping to its start, and MADCTL's MX, MY and MV bits decide where
+ * each window position lands in frame memory. Every other command is counted
+ * and its parameters are skipped.
+ *
+ * [ST7735Model_getPixel()] reads the visible panel as the user sees it, with
+ * the board held the way LCD_ORIENTATION_UP draws upright.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * Pixels are kept as the 16-bit values written, with no BGR swap. Reads,
+ * scrolling and partial mode are not modeled.
+ */
+
+// Feeds one byte from the bus. isData is the level of the data/command pin.
+void ST7735Model_write(uint8_t byte, bool isData);
+
+// Returns the pixel the user sees at (x, y) of the visible panel.
+uint16_t ST7735Model_getPixel(int x, int y);
+
+// Returns what the controller was sent so far.
+const ST7735Stats* ST7735Model_getStats();
+
+// Prints the statistics, with a line per command which was sent at least once.
+void ST7735Model_report(FILE* file);
+
+#endif /* HOST_SIM_ST7735MODEL_H_ */
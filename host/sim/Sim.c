@@ -0,0 +1,737 @@
+/*
+ * Sim.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <sim/Sim.h>
+#include <sim/SimPeripherals.h>
+#include <sim/ST7735Model.h>
+#include <sim/SimCost.h>
+#include <HAL/Profiler.h>
+#include <HAL/SpiTrace.h>
+#include <HAL/LatencyTrace.h>
+#include <HAL/Timer.h>
+
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_DEFAULT_RUN_MS      10000
+#define SIM_MAX_ACTIONS         65536
+
+// How many owners of deadlines Sim_sleep() keeps track of, and how long after
+// the last input action it waits before it skips SysTicks: longer than the
+// lockout of an edge-interrupt button, which is timed without a deadline
+#define SIM_MAX_DEADLINES       64
+#define SIM_IDLE_SETTLE_MS      50
+
+/**
+ * The ISRs of the application, by exception number. They are weak, so an
+ * application which leaves one out still links, and its line never runs.
+ */
+extern void SysTick_Handler(void)       __attribute__((weak));
+extern void T32_INT1_IRQHandler(void)   __attribute__((weak));
+extern void T32_INT2_IRQHandler(void)   __attribute__((weak));
+extern void DMA_INT0_IRQHandler(void)   __attribute__((weak));
+extern void DMA_INT1_IRQHandler(void)   __attribute__((weak));
+extern void DMA_INT2_IRQHandler(void)   __attribute__((weak));
+extern void DMA_INT3_IRQHandler(void)   __attribute__((weak));
+extern void PORT1_IRQHandler(void)      __attribute__((weak));
+extern void PORT2_IRQHandler(void)      __attribute__((weak));
+extern void PORT3_IRQHandler(void)      __attribute__((weak));
+extern void PORT4_IRQHandler(void)      __attribute__((weak));
+extern void PORT5_IRQHandler(void)      __attribute__((weak));
+extern void PORT6_IRQHandler(void)      __attribute__((weak));
+
+static void (*handlers[SIM_NUM_INTERRUPTS])(void);
+
+/**
+ * One step of the input script: a level for some pins of a port, or a
+ * result for an ADC14 conversion memory.
+ */
+struct _SimAction
+{
+    uint64_t when;
+    uint8_t port;                   // 0 for an ADC action
+    uint8_t pins;
+    bool high;
+    int memory;
+    uint16_t value;
+};
+typedef struct _SimAction SimAction;
+
+/**
+ * The names the input script knows. A button is pressed by driving its pin
+ * low; the joystick is pushed by moving one axis to either end.
+ */
+struct _SimInput
+{
+    const char* name;
+    uint8_t port;
+    uint8_t pins;
+    int memory;
+    uint16_t value;
+};
+typedef struct _SimInput SimInput;
+
+static const SimInput inputs[] =
+{
+    { "S1",    GPIO_PORT_P5, GPIO_PIN1, 0, 0 },
+    { "S2",    GPIO_PORT_P3, GPIO_PIN5, 0, 0 },
+    { "JS",    GPIO_PORT_P4, GPIO_PIN1, 0, 0 },
+    { "LS1",   GPIO_PORT_P1, GPIO_PIN1, 0, 0 },
+    { "LS2",   GPIO_PORT_P1, GPIO_PIN4, 0, 0 },
+    { "up",    0, 0, SIM_JOYSTICK_Y_MEM, SIM_JOYSTICK_MAX },
+    { "down",  0, 0, SIM_JOYSTICK_Y_MEM, 0 },
+    { "right", 0, 0, SIM_JOYSTICK_X_MEM, SIM_JOYSTICK_MAX },
+    { "left",  0, 0, SIM_JOYSTICK_X_MEM, 0 }
+};
+
+#define SIM_NUM_INPUTS  (sizeof(inputs) / sizeof(inputs[0]))
+
+static uint64_t now = 0;
+static SimEvent* events = NULL;
+
+static uint64_t pending = 0;
+static uint64_t enabled = 1ULL << SIM_SYSTICK;
+static bool masterEnabled = true;
+static bool inHandler = false;
+
+static SimAction actions[SIM_MAX_ACTIONS];
+static int numActions = 0;
+static int nextAction = 0;
+static SimEvent inputEvent;
+static SimEvent endEvent;
+static uint64_t lastInputTime = 0;
+
+/**
+ * The last deadline of a timer, alarm or task, noted by Timer.c. A deadline
+ * which recurs at most once per SysTick is the release of a task which polls
+ * the inputs on every tick, and does not stop Sim_sleep() from skipping.
+ */
+struct _SimDeadline
+{
+    const void* owner_p;
+    uint64_t when;
+    uint64_t periodCycles;
+};
+typedef struct _SimDeadline SimDeadline;
+
+static SimDeadline deadlines[SIM_MAX_DEADLINES];
+static int numDeadlines = 0;
+static bool skipIdleTicks = true;
+static bool deadlinesLost = false;
+
+static bool quiet = false;
+static SimStats stats;
+
+/** The Profiler runs on the low 32 bits of the virtual clock. */
+static uint32_t Sim_profilerClock()
+{
+    return (uint32_t) now;
+}
+
+/**
+ * Returns the current cycle count.
+ */
+uint64_t Sim_now()
+{
+    return now;
+}
+
+/**
+ * Arms an event, keeping the list of armed events sorted by firing time.
+ * Events which fire at the same cycle fire in the order they were armed.
+ *
+ * @param event_p:  The event to arm, which may already be armed
+ * @param when:     The cycle at which to fire it
+ */
+void Sim_schedule(SimEvent* event_p, uint64_t when)
+{
+    Sim_cancel(event_p);
+
+    event_p->when = when;
+    event_p->armed = true;
+
+    SimEvent** link_p = &events;
+    while (*link_p != NULL && (*link_p)->when <= when) {
+        link_p = &(*link_p)->next;
+    }
+
+    event_p->next = *link_p;
+    *link_p = event_p;
+}
+
+/**
+ * Disarms an event. Does nothing if it is not armed.
+ *
+ * @param event_p:  The event to disarm
+ */
+void Sim_cancel(SimEvent* event_p)
+{
+    if (!event_p->armed) {
+        return;
+    }
+
+    SimEvent** link_p = &events;
+    while (*link_p != event_p) {
+        link_p = &(*link_p)->next;
+    }
+
+    *link_p = event_p->next;
+    event_p->armed = false;
+}
+
+/**
+ * Fires the first armed event, after moving the clock to it.
+ */
+static void Sim_fireNext()
+{
+    SimEvent* event_p = events;
+
+    events = event_p->next;
+    event_p->armed = false;
+
+    // An event which came due while an ISR was being charged fires late
+    if (event_p->when > now) {
+        now = event_p->when;
+    }
+
+    event_p->fire();
+}
+
+/**
+ * Advances the clock, firing every event on the way in order. The ISRs of
+ * each event run before the next event fires.
+ *
+ * @param cycles:   The number of cycles to advance by
+ */
+void Sim_advance(uint64_t cycles)
+{
+    uint64_t target = now + cycles;
+
+    while (events != NULL && events->when <= target)
+    {
+        Sim_fireNext();
+        Sim_dispatch();
+    }
+
+    // The ISRs run on the way may have taken the clock past the target
+    if (target > now) {
+        now = target;
+    }
+    Sim_dispatch();
+}
+
+/**
+ * Keeps the deadline Timer.c noted for an owner, replacing the last one. A
+ * deadline two SysTicks in the past has been seen by the task which polls
+ * for it, so its entry may be reused. If none is free, the deadline is lost,
+ * and idle SysTicks are no longer skipped.
+ *
+ * @param owner_p:      The timer, alarm or task which falls due
+ * @param when:         The cycle at which it falls due
+ * @param periodCycles: The period of a deadline which recurs, or 0
+ */
+static void Sim_noteDeadline(const void* owner_p, uint64_t when, uint64_t periodCycles)
+{
+    uint64_t expired = 2ULL * SimSysTick_getPeriod();
+    SimDeadline* free_p = NULL;
+    int i;
+
+    for (i = 0; i < numDeadlines; i++)
+    {
+        if (deadlines[i].owner_p == owner_p) {
+            free_p = &deadlines[i];
+            break;
+        }
+
+        if (free_p == NULL && deadlines[i].when + expired <= now) {
+            free_p = &deadlines[i];
+        }
+    }
+
+    if (free_p == NULL && numDeadlines < SIM_MAX_DEADLINES) {
+        free_p = &deadlines[numDeadlines++];
+    }
+
+    if (free_p == NULL)
+    {
+        deadlinesLost = true;
+        return;
+    }
+
+    free_p->owner_p = owner_p;
+    free_p->when = when;
+    free_p->periodCycles = periodCycles;
+}
+
+/**
+ * Moves SysTick to the tick before the next deadline, or before the next
+ * input action or the end of the run, skipping the ticks in between. Those
+ * ticks would only wake the CPU for the input task to find that time passed,
+ * which changes nothing until a deadline falls due. Since only an interrupt
+ * wakes the CPU, and the input task runs on every wake-up, whatever an ISR
+ * changes is still seen at once. Ticks are only skipped once the last input
+ * action has settled. A tick skipped past a deadline noted since is brought
+ * back to where it would be.
+ */
+static void Sim_skipIdleTicks()
+{
+    SimEvent* tick_p = SimSysTick_getEvent();
+
+    if (tick_p == NULL || tick_p->when <= now) {
+        return;
+    }
+
+    uint64_t period = SimSysTick_getPeriod();
+    uint64_t next = tick_p->when - (tick_p->when - now) / period * period;
+    uint64_t until = next;
+    int i;
+
+    if (!deadlinesLost && now >= lastInputTime + (uint64_t) SIM_IDLE_SETTLE_MS * SIM_CYCLES_PER_MS)
+    {
+        until = endEvent.when;
+
+        if (inputEvent.armed && inputEvent.when < until) {
+            until = inputEvent.when;
+        }
+
+        for (i = 0; i < numDeadlines; i++)
+        {
+            const SimDeadline* deadline_p = &deadlines[i];
+
+            if (deadline_p->periodCycles != 0 && deadline_p->periodCycles <= period) {
+                continue;
+            }
+
+            // A deadline which fell due less than two ticks ago still gets every tick
+            if (deadline_p->when + 2 * period > now && deadline_p->when < until) {
+                until = deadline_p->when;
+            }
+        }
+    }
+
+    uint64_t target = next;
+    if (until >= next + 2 * period) {
+        target = next + (until - period - next) / period * period;
+    }
+
+    if (target != tick_p->when)
+    {
+        stats.ticksSkipped += (uint32_t) ((target - next) / period);
+        stats.ticksSkipped -= (uint32_t) ((tick_p->when - next) / period);
+        Sim_schedule(tick_p, target);
+    }
+}
+
+/**
+ * Sleeps until the next event. On the board the CPU sleeps even with
+ * interrupts masked, and wakes up without running the ISR. Unless SIM_NO_SKIP
+ * is set, while SysTick runs the CPU sleeps until an interrupt is pending,
+ * as it does on the board, and through every idle SysTick, which is most of
+ * them while the game waits for the user.
+ */
+void Sim_sleep()
+{
+    if (events == NULL)
+    {
+        fprintf(stderr, "sim: nothing left to wake up for at cycle %llu\n", (unsigned long long) now);
+        exit(1);
+    }
+
+    uint64_t start = now;
+
+    if (!skipIdleTicks || SimSysTick_getEvent() == NULL) {
+        Sim_fireNext();
+    }
+    else
+    {
+        do {
+            Sim_skipIdleTicks();
+            Sim_fireNext();
+        } while ((pending & enabled) == 0);
+    }
+
+    stats.sleepCycles += now - start;
+    stats.sleeps++;
+
+    Sim_dispatch();
+}
+
+/**
+ * Marks an interrupt pending. It runs as soon as it is enabled, interrupts
+ * are unmasked, and no other ISR is running.
+ *
+ * @param interrupt:    The INT_ number, or SIM_SYSTICK
+ */
+void Sim_raise(int interrupt)
+{
+    pending |= 1ULL << interrupt;
+}
+
+/**
+ * Enables or disables an interrupt line. A line which is enabled while it is
+ * pending runs at once.
+ *
+ * @param interrupt:    The INT_ number
+ * @param isEnabled:    Whether the line may interrupt the CPU
+ */
+void Sim_setInterruptEnabled(int interrupt, bool isEnabled)
+{
+    if (isEnabled) {
+        enabled |= 1ULL << interrupt;
+    }
+    else {
+        enabled &= ~(1ULL << interrupt);
+    }
+
+    Sim_dispatch();
+}
+
+/**
+ * Sets or clears PRIMASK.
+ *
+ * @param isEnabled:    Whether interrupts may run
+ * @return whether interrupts were masked before the call, like Interrupt_disableMaster()
+ */
+bool Sim_setMasterEnabled(bool isEnabled)
+{
+    bool wasMasked = !masterEnabled;
+
+    masterEnabled = isEnabled;
+    Sim_dispatch();
+
+    return wasMasked;
+}
+
+/**
+ * Runs every interrupt which is pending and enabled, lowest number first,
+ * until none is left. Interrupts raised by an ISR run after it returns.
+ */
+void Sim_dispatch()
+{
+    if (!masterEnabled || inHandler) {
+        return;
+    }
+
+    uint64_t ready;
+    while ((ready = pending & enabled) != 0)
+    {
+        int interrupt = __builtin_ctzll(ready);
+        pending &= ~(1ULL << interrupt);
+
+        if (handlers[interrupt] == NULL) {
+            continue;
+        }
+
+        stats.interrupts[interrupt]++;
+
+        // Entry and exit are charged half each, around the ISR
+        inHandler = true;
+        Sim_advance(SimCost_cycles(SimCost_get()->interrupt / 2));
+        handlers[interrupt]();
+        Sim_advance(SimCost_cycles(SimCost_get()->interrupt - SimCost_get()->interrupt / 2));
+        inHandler = false;
+
+        if (!masterEnabled) {
+            return;
+        }
+    }
+}
+
+/**
+ * Returns what the simulation has done so far.
+ */
+const SimStats* Sim_getStats()
+{
+    return &stats;
+}
+
+/** Applies every input action which is due, and arms the next one. */
+static void Sim_fireInput()
+{
+    while (nextAction < numActions && actions[nextAction].when <= now)
+    {
+        SimAction* action_p = &actions[nextAction++];
+
+        if (action_p->port != 0) {
+            SimGPIO_setInputs(action_p->port, action_p->pins, action_p->high);
+        }
+        else {
+            SimADC_setResult(action_p->memory, action_p->value);
+        }
+
+        lastInputTime = now;
+    }
+
+    if (nextAction < numActions) {
+        Sim_schedule(&inputEvent, actions[nextAction].when);
+    }
+}
+
+/** Ends the run. The report is printed by the atexit() handler. */
+static void Sim_fireEnd()
+{
+    exit(0);
+}
+
+/** Sorts the script by time. Actions at the same time keep their order. */
+static void Sim_sortActions()
+{
+    int i, j;
+
+    for (i = 1; i < numActions; i++)
+    {
+        SimAction action = actions[i];
+
+        for (j = i; j > 0 && actions[j - 1].when > action.when; j--) {
+            actions[j] = actions[j - 1];
+        }
+        actions[j] = action;
+    }
+}
+
+/** Adds one action to the script, ignoring actions past SIM_MAX_ACTIONS. */
+static void Sim_addAction(uint64_t when, const SimInput* input_p, bool pushed)
+{
+    if (numActions == SIM_MAX_ACTIONS) {
+        return;
+    }
+
+    SimAction* action_p = &actions[numActions++];
+    action_p->when = when;
+    action_p->port = input_p->port;
+    action_p->pins = input_p->pins;
+    action_p->high = !pushed;
+    action_p->memory = input_p->memory;
+    action_p->value = pushed ? input_p->value : SIM_JOYSTICK_CENTER;
+}
+
+/**
+ * Parses the input script: whitespace-separated steps of the form
+ * "ms:name" or "ms:name/hold", where ms is when the input is pushed, name
+ * is one of the inputs above, and hold is how many milliseconds it stays
+ * pushed, SIM_TAP_MS by default.
+ *
+ * @param script:   The script, from SIM_INPUT
+ */
+static void Sim_parseInput(const char* script)
+{
+    while (*script != '\0')
+    {
+        char name[16];
+        unsigned long ms;
+        unsigned long hold = SIM_TAP_MS;
+        int length = 0;
+
+        if (sscanf(script, " %lu:%15[^/ \t\n]%n", &ms, name, &length) < 2)
+        {
+            fprintf(stderr, "sim: bad SIM_INPUT near \"%s\"\n", script);
+            exit(2);
+        }
+        script += length;
+
+        if (*script == '/')
+        {
+            int holdLength = 0;
+            sscanf(script, "/%lu%n", &hold, &holdLength);
+            script += holdLength;
+        }
+
+        unsigned i;
+        for (i = 0; i < SIM_NUM_INPUTS && strcmp(inputs[i].name, name) != 0; i++);
+
+        if (i == SIM_NUM_INPUTS)
+        {
+            fprintf(stderr, "sim: unknown input \"%s\"\n", name);
+            exit(2);
+        }
+
+        Sim_addAction((uint64_t) ms * SIM_CYCLES_PER_MS, &inputs[i], true);
+        Sim_addAction((uint64_t) (ms + hold) * SIM_CYCLES_PER_MS, &inputs[i], false);
+
+        while (*script == ' ' || *script == '\t' || *script == '\n') {
+            script++;
+        }
+    }
+
+    Sim_sortActions();
+}
+
+/**
+ * Reads the input script from a file, for scripts too long for the
+ * environment. The buffer is kept for the whole run.
+ *
+ * @param path:     The file, from SIM_INPUT=@path
+ * @return the script
+ */
+static const char* Sim_readScript(const char* path)
+{
+    FILE* file = fopen(path, "r");
+    char* script;
+    long size;
+
+    if (file == NULL)
+    {
+        perror(path);
+        exit(2);
+    }
+
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    rewind(file);
+
+    script = size < 0 ? NULL : malloc(size + 1);
+    if (script == NULL)
+    {
+        fprintf(stderr, "sim: cannot read the input script %s\n", path);
+        exit(2);
+    }
+
+    script[fread(script, 1, size, file)] = '\0';
+    fclose(file);
+
+    return script;
+}
+
+/**
+ * Writes the bytes left in the SPI trace ring to a file, six bytes each: the
+ * cycle stamp and the value of the SpiTraceEntry, both little-endian.
+ */
+static void Sim_writeSpiTrace(const char* path)
+{
+    FILE* file = fopen(path, "wb");
+    uint32_t count = SpiTrace_getCount();
+    uint32_t i;
+
+    if (file == NULL)
+    {
+        perror(path);
+        return;
+    }
+
+    if (!SPI_TRACE_ENABLED) {
+        fprintf(stderr, "sim: SPI trace is not compiled in; build with TRACE=1\n");
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        SpiTraceEntry entry = SpiTrace_peek(i);
+        uint8_t bytes[6] =
+        {
+            entry.cycles, entry.cycles >> 8, entry.cycles >> 16, entry.cycles >> 24,
+            entry.value, entry.value >> 8
+        };
+
+        fwrite(bytes, 1, sizeof(bytes), file);
+    }
+
+    fclose(file);
+
+    if (SpiTrace_getStats()->recorded > count) {
+        fprintf(stderr, "sim: SPI trace kept the last %u of %u bytes\n",
+                count, SpiTrace_getStats()->recorded);
+    }
+}
+
+/** Prints what the run did, and saves the flash and the SPI trace. */
+static void Sim_report()
+{
+    const char* tracePath = getenv("SIM_SPI_TRACE");
+
+    if (tracePath != NULL) {
+        Sim_writeSpiTrace(tracePath);
+    }
+
+    if (!quiet)
+    {
+        fprintf(stderr, "sim: %.3f ms simulated, %.1f%% asleep in %u sleeps, "
+                "%u idle SysTicks skipped\n",
+                now / (double) SIM_CYCLES_PER_MS,
+                now ? 100.0 * stats.sleepCycles / now : 0.0, stats.sleeps, stats.ticksSkipped);
+
+        int i;
+        for (i = 0; i < SIM_NUM_INTERRUPTS; i++)
+        {
+            if (stats.interrupts[i] != 0) {
+                fprintf(stderr, "sim: interrupt %2d ran %u times\n", i, stats.interrupts[i]);
+            }
+        }
+
+        for (i = 0; i < NUM_LATENCY_TYPES; i++)
+        {
+            const LatencyStats* latency_p = LatencyTrace_getStats((LatencyType) i);
+
+            if (latency_p->count != 0)
+            {
+                fprintf(stderr, "latency: %-14s %6u inputs, p50 %u us, p99 %u us, max %u us\n",
+                        LatencyTrace_getName((LatencyType) i), latency_p->count,
+                        LatencyTrace_getPercentileUS((LatencyType) i, 500),
+                        LatencyTrace_getPercentileUS((LatencyType) i, 990), latency_p->max_us);
+            }
+        }
+
+        const LatencyInputStats* inputs_p = LatencyTrace_getInputStats();
+        fprintf(stderr, "latency: traces: %u started, %u skipped while one was in flight, "
+                "%u dropped without a transition\n",
+                inputs_p->traced, inputs_p->skipped, inputs_p->dropped);
+
+        ST7735Model_report(stderr);
+        SimCost_report(stderr);
+    }
+
+    SimPeripherals_report(stderr, quiet);
+}
+
+/**
+ * Sets up the simulation before main() runs: the interrupt table, the
+ * script, the end of the run and the peripherals.
+ */
+__attribute__((constructor))
+static void Sim_start()
+{
+    handlers[SIM_SYSTICK]   = SysTick_Handler;
+    handlers[INT_T32_INT1]  = T32_INT1_IRQHandler;
+    handlers[INT_T32_INT2]  = T32_INT2_IRQHandler;
+    handlers[INT_DMA_INT0]  = DMA_INT0_IRQHandler;
+    handlers[INT_DMA_INT1]  = DMA_INT1_IRQHandler;
+    handlers[INT_DMA_INT2]  = DMA_INT2_IRQHandler;
+    handlers[INT_DMA_INT3]  = DMA_INT3_IRQHandler;
+    handlers[INT_PORT1]     = PORT1_IRQHandler;
+    handlers[INT_PORT2]     = PORT2_IRQHandler;
+    handlers[INT_PORT3]     = PORT3_IRQHandler;
+    handlers[INT_PORT4]     = PORT4_IRQHandler;
+    handlers[INT_PORT5]     = PORT5_IRQHandler;
+    handlers[INT_PORT6]     = PORT6_IRQHandler;
+
+    Profiler_setClock(Sim_profilerClock);
+    HWTimer_setClock(Sim_now);
+    HWTimer_setDeadlineListener(Sim_noteDeadline);
+
+    const char* runMs = getenv("SIM_RUN_MS");
+    const char* script = getenv("SIM_INPUT");
+    quiet = getenv("SIM_QUIET") != NULL;
+    skipIdleTicks = getenv("SIM_NO_SKIP") == NULL;
+
+    uint64_t runCycles = (uint64_t) (runMs ? strtoull(runMs, NULL, 10) : SIM_DEFAULT_RUN_MS) * SIM_CYCLES_PER_MS;
+
+    endEvent.fire = Sim_fireEnd;
+    Sim_schedule(&endEvent, runCycles);
+
+    inputEvent.fire = Sim_fireInput;
+    if (script != NULL)
+    {
+        Sim_parseInput(script[0] == '@' ? Sim_readScript(script + 1) : script);
+        if (numActions > 0) {
+            Sim_schedule(&inputEvent, actions[0].when);
+        }
+    }
+
+    SimCost_init();
+    SimPeripherals_init();
+    atexit(Sim_report);
+}
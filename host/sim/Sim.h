@@ -0,0 +1,121 @@
+/*
+ * Sim.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HOST_SIM_SIM_H_
+#define HOST_SIM_SIM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// The simulated CPU clock, which is also MCLK, HSMCLK and SMCLK
+#define SIM_CLOCK_HZ            48000000
+#define SIM_CYCLES_PER_MS       (SIM_CLOCK_HZ / 1000)
+
+// Number of exception and interrupt numbers; the INT_ numbers of driverlib.h
+// are below this
+#define SIM_NUM_INTERRUPTS      64
+
+// The exception number of SysTick, FAULT_SYSTICK in driverlib.h
+#define SIM_SYSTICK             15
+
+// How long a scripted tap holds a button or the joystick, in milliseconds
+#define SIM_TAP_MS              60
+
+/**
+ * Something the simulated hardware will do at a given cycle, such as a timer
+ * rolling over or a DMA transfer finishing. Every peripheral owns its
+ * events, and keeps them armed with Sim_schedule().
+ */
+struct _SimEvent
+{
+    uint64_t when;                  // Cycle at which the event fires
+    bool armed;
+    void (*fire)(void);             // Called once the clock reaches the event
+    struct _SimEvent* next;         // The next armed event, in firing order
+};
+typedef struct _SimEvent SimEvent;
+
+/**
+ * What the simulation has done, for the report printed at exit.
+ */
+struct _SimStats
+{
+    uint64_t sleepCycles;           // Cycles spent in LPM0 waiting for an event
+    uint32_t sleeps;
+    uint32_t interrupts[SIM_NUM_INTERRUPTS];
+    uint32_t sysTicks;
+    uint32_t ticksSkipped;          // Idle SysTicks slept through, see Sim_sleep()
+};
+typedef struct _SimStats SimStats;
+
+/**=============================================================================
+ * The core of the host simulation: a virtual cycle counter, the events which
+ * fire as it advances, and an interrupt controller which calls the ISRs of
+ * the application.
+ *
+ * Time only moves when the simulated hardware says it does: an SPI byte, a
+ * flash erase or a delay loop advances the clock by what they would take on
+ * the board, and PCM_gotoLPM0() jumps straight to the next event, or further
+ * while the CPU is idle, as Sim_sleep() explains. Timer.c
+ * reads the same clock, installed with HWTimer_setClock(), so every SWTimer
+ * and scheduler deadline runs on virtual time rather than wall time. The CPU
+ * work around them is charged by the cost model in SimCost.h; everything
+ * else the CPU does is free. An interrupt which becomes pending while
+ * interrupts are enabled runs at once, from inside whatever call advanced
+ * the clock, just as it would preempt the main loop on the board.
+ *
+ * The run is controlled by environment variables, read before main():
+ *
+ *   SIM_RUN_MS     Exit after this many simulated milliseconds (default 10000)
+ *   SIM_INPUT      Input script, as in "500:S1 900:down 1500:S2", or @file to
+ *                  read a longer one from a file; see Sim.c
+ *   SIM_FLASH      File which holds the simulated flash between runs
+ *   SIM_UART       File which receives every byte sent on the backchannel UART
+ *   SIM_SPI_TRACE  File which receives the SPI trace at exit, if built with
+ *                  TRACE=1; see HAL/SpiTrace.h and tools/spitrace.py
+ *   SIM_COST       Overrides of the cost model, as in "lcdByte=22"; see SimCost.h
+ *   SIM_QUIET      Set to anything to skip the report at exit
+ *   SIM_NO_SKIP    Set to anything to wake up for every idle SysTick
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * Interrupts never nest: an interrupt which becomes pending inside an ISR
+ * runs after it. Interrupt priorities are not modeled either; pending lines
+ * run in the order of their INT_ numbers, so SysTick goes first.
+ */
+
+// Returns the current cycle count.
+uint64_t Sim_now();
+
+// Advances the clock by some cycles, firing events and interrupts on the way.
+void Sim_advance(uint64_t cycles);
+
+// Sleeps until the next event, as WFI would, skipping idle SysTicks. Exits if nothing is left to
+// wake up for.
+void Sim_sleep();
+
+// Arms an event to fire at an absolute cycle, replacing any earlier arming.
+void Sim_schedule(SimEvent* event_p, uint64_t when);
+
+// Disarms an event.
+void Sim_cancel(SimEvent* event_p);
+
+// Marks an interrupt line pending. SIM_SYSTICK is the SysTick exception.
+void Sim_raise(int interrupt);
+
+// Enables or disables one interrupt line in the NVIC.
+void Sim_setInterruptEnabled(int interrupt, bool enabled);
+
+// Sets PRIMASK. Returns whether interrupts were disabled before the call.
+bool Sim_setMasterEnabled(bool enabled);
+
+// Runs every pending and enabled interrupt, unless interrupts are masked.
+void Sim_dispatch();
+
+// Returns what the simulation has done so far.
+const SimStats* Sim_getStats();
+
+#endif /* HOST_SIM_SIM_H_ */
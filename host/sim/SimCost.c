@@ -0,0 +1,169 @@
+/*
+ * SimCost.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <sim/SimCost.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * The defaults, estimated from the code and the datasheets; see SimCost.h
+ * for how to calibrate them.
+ *
+ *   lcdByte            Call and return, the two UCBUSY polls, the TXBUF
+ *                      store, the latency stamp and byte counter, and a
+ *                      pass of the driver's pixel loop
+ *   lcdPrimitive       grlib's clipping and dispatch, and the driver's
+ *                      SetDrawFrame around its eight window bytes
+ *   gpioCall           A driverlib GPIO_ call: argument setup, the port
+ *                      table lookup and the read-modify-write
+ *   bitband            A single store to the bit-band alias
+ *   interrupt          Exception entry and exit on the Cortex-M4, 12 cycles
+ *                      each with no tail-chaining
+ *   dmaItem            One bus cycle lost to each DMA read or write
+ *   fetchInstructions  Two 16-bit Thumb instructions per 32-bit fetch
+ */
+static SimCost cost =
+{
+    20,     // lcdByte
+    80,     // lcdPrimitive
+    24,     // gpioCall
+    2,      // bitband
+    24,     // interrupt
+    2,      // dmaItem
+    2       // fetchInstructions
+};
+
+static uint32_t waitStates = 0;
+static uint64_t estimated = 0;     // Cycles charged from the constants so far
+
+/**
+ * Reads SIM_COST, a comma-separated list of name=value pairs, over the
+ * defaults. Unknown names end the run, so a typo cannot go unnoticed.
+ */
+void SimCost_init()
+{
+    static const struct
+    {
+        const char* name;
+        uint32_t* value_p;
+    } names[] =
+    {
+        { "lcdByte", &cost.lcdByte },
+        { "lcdPrimitive", &cost.lcdPrimitive },
+        { "gpioCall", &cost.gpioCall },
+        { "bitband", &cost.bitband },
+        { "interrupt", &cost.interrupt },
+        { "dmaItem", &cost.dmaItem },
+        { "fetchInstructions", &cost.fetchInstructions },
+    };
+
+    const char* setting = getenv("SIM_COST");
+    char buffer[256];
+    char* pair;
+
+    if (setting == NULL) {
+        return;
+    }
+
+    strncpy(buffer, setting, sizeof(buffer) - 1);
+    buffer[sizeof(buffer) - 1] = '\0';
+
+    for (pair = strtok(buffer, ","); pair != NULL; pair = strtok(NULL, ","))
+    {
+        char* equals = strchr(pair, '=');
+        size_t i;
+
+        if (equals != NULL)
+        {
+            *equals = '\0';
+
+            for (i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+            {
+                if (strcmp(pair, names[i].name) == 0)
+                {
+                    *names[i].value_p = strtoul(equals + 1, NULL, 0);
+                    break;
+                }
+            }
+        }
+
+        if (equals == NULL || i == sizeof(names) / sizeof(names[0]))
+        {
+            fprintf(stderr, "sim: unknown SIM_COST setting \"%s\"\n", pair);
+            exit(2);
+        }
+    }
+
+    if (cost.fetchInstructions == 0) {
+        cost.fetchInstructions = 1;
+    }
+}
+
+/**
+ * Returns the constants in use.
+ */
+const SimCost* SimCost_get()
+{
+    return &cost;
+}
+
+/**
+ * Records the flash wait states. Both banks hold code, so the larger of the
+ * two settings wins.
+ */
+void SimCost_setWaitStates(uint32_t states)
+{
+    if (states > waitStates) {
+        waitStates = states;
+    }
+}
+
+/**
+ * Returns the cycles taken by code run from flash: one per instruction, plus
+ * the wait states of every fetch. They are counted as estimated.
+ *
+ * @param instructions: The number of instructions
+ * @return the cycles they take
+ */
+uint64_t SimCost_code(uint32_t instructions)
+{
+    return SimCost_cycles(instructions + (uint64_t) waitStates * instructions / cost.fetchInstructions);
+}
+
+/**
+ * Counts cycles which come from the constants rather than from a hardware
+ * clock, so that the share of a prediction which is estimated is known.
+ *
+ * @param cycles:   The cycles about to be charged
+ * @return cycles, unchanged
+ */
+uint64_t SimCost_cycles(uint64_t cycles)
+{
+    estimated += cycles;
+    return cycles;
+}
+
+/**
+ * Returns every cycle counted by SimCost_code() and SimCost_cycles().
+ */
+uint64_t SimCost_getEstimated()
+{
+    return estimated;
+}
+
+/**
+ * Prints the constants in use.
+ *
+ * @param file:     Where to print them
+ */
+void SimCost_report(FILE* file)
+{
+    fprintf(file, "cost: lcdByte=%u lcdPrimitive=%u gpioCall=%u bitband=%u interrupt=%u dmaItem=%u "
+                  "fetchInstructions=%u, %u flash wait states\n",
+            cost.lcdByte, cost.lcdPrimitive, cost.gpioCall, cost.bitband, cost.interrupt,
+            cost.dmaItem, cost.fetchInstructions, waitStates);
+}
@@ -0,0 +1,88 @@
+/*
+ * SimCost.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HOST_SIM_SIMCOST_H_
+#define HOST_SIM_SIMCOST_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * The constants of the cost model. Code costs are in instructions, which
+ * SimCost_code() turns into cycles with the flash wait states the
+ * application programmed; bus and DMA costs are already in cycles.
+ */
+struct _SimCost
+{
+    uint32_t lcdByte;           // HAL_LCD_writeData() and its caller's loop, beyond the shift
+    uint32_t lcdPrimitive;      // One grlib call into the driver, charged at its RAMWR
+    uint32_t gpioCall;          // One driverlib GPIO_ call
+    uint32_t bitband;           // One FAST_GPIO_ bit-band access
+    uint32_t interrupt;         // Cycles to enter and leave an ISR
+    uint32_t dmaItem;           // Bus cycles the CPU loses per DMA item
+    uint32_t fetchInstructions; // Instructions per flash fetch, over which a fetch's wait states spread
+};
+typedef struct _SimCost SimCost;
+
+/**=============================================================================
+ * The cost model of the host simulation, which turns a host run into a
+ * prediction of the time the same code takes on the board.
+ *
+ * The simulation charges time for the hardware it models: an LCD byte takes
+ * 8 * SYSTEM_CLOCK / LCD_SPI_CLOCK_SPEED cycles on the bus, a UART byte ten
+ * bit times, a flash erase or program its datasheet time. On top of that,
+ * the model charges the CPU work that sits between the hardware steps and
+ * dominates the display path: the instructions around each LCD byte and
+ * each driver primitive, GPIO accesses, interrupt entry and exit, and the
+ * bus cycles DMA takes from the CPU. Code runs from flash, so each
+ * instruction count is scaled by the wait states set with
+ * FlashCtl_setWaitState(): with read buffering off, every fetch of
+ * fetchInstructions instructions pays them.
+ *
+ * The defaults are estimates from the instruction counts of the code paths
+ * and the Cortex-M4 and MSP432P401R datasheets, and have not been measured
+ * on a board yet. Every cycle charged from them is counted, so "make bench"
+ * reports how much of each prediction is estimated, and how far off it is if
+ * they are off by a factor of two. To calibrate, run the same screens on the board and on the
+ * host and compare the PROF_ probes, which on the host read the simulated
+ * clock: PROF_GFX_CLEAR is almost all lcdByte, PROF_GFX_PRINT adds
+ * lcdPrimitive, and PROF_GPIO_DRIVERLIB and PROF_GPIO_FAST measure gpioCall
+ * and bitband directly. SIM_COST overrides any constant without a rebuild:
+ *
+ *   SIM_COST="lcdByte=22,lcdPrimitive=90" make bench
+ *
+ * and the calibrated values then go into SimCost.c.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * Computation which never reaches the hardware, such as the FSM, the event
+ * queue or the rasterization inside grlib, is not charged beyond
+ * lcdPrimitive. Predictions are for the display and I/O paths, and are
+ * lower bounds elsewhere.
+ */
+
+// Reads SIM_COST, if set, over the defaults.
+void SimCost_init();
+
+// Returns the constants in use.
+const SimCost* SimCost_get();
+
+// Records the flash wait states the application programmed.
+void SimCost_setWaitStates(uint32_t waitStates);
+
+// Returns the cycles taken by the given number of instructions run from flash.
+uint64_t SimCost_code(uint32_t instructions);
+
+// Counts cycles charged from a constant which is already in cycles. Returns them.
+uint64_t SimCost_cycles(uint64_t cycles);
+
+// Returns the cycles charged from the constants so far, the estimated part of the clock.
+uint64_t SimCost_getEstimated();
+
+// Prints the constants in use.
+void SimCost_report(FILE* file);
+
+#endif /* HOST_SIM_SIMCOST_H_ */
@@ -0,0 +1,1265 @@
+/*
+ * SimDriverlib.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <sim/Sim.h>
+#include <sim/SimPeripherals.h>
+#include <sim/ST7735Model.h>
+#include <sim/SimCost.h>
+
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+#include <HAL/LcdDriver/HAL_MSP_EXP432P401R_Crystalfontz128x128_ST7735.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Marks an empty SPI transmit buffer; a written byte is always below 0x100
+#define SIM_SPI_EMPTY           0xFFFF
+
+#define SIM_DMA_CHANNELS        8
+#define SIM_DMA_UART_CHANNEL    0
+#define SIM_DMA_CCR0_CHANNEL    2       // Timer_A1 CCR0 trigger, as PortSampler maps it
+#define SIM_DMA_CCR2_CHANNEL    3       // Timer_A1 CCR2 trigger
+#define SIM_DMA_ADC_CHANNEL     7
+
+// A Timer32 counts down from its load value, so it rolls over every load + 1 cycles
+#define SIM_TIMER32_PERIOD(timer_p)     ((uint64_t) (timer_p)->load + 1)
+
+static SimPeripheralStats stats;
+
+//*****************************************************************************
+// GPIO
+//*****************************************************************************
+
+// Every input idles high, as the buttons have pull-ups and are active low
+DIO_PORT_Interruptable_Type SimGPIO_ports[3] =
+{
+    { 0xFFFF }, { 0xFFFF }, { 0xFFFF }
+};
+
+// One byte-wide register of a port, from P1 to P6
+#define SIM_GPIO_REGISTER(port, field) \
+    (((volatile uint8_t*) &SimGPIO_ports[((port) - 1) >> 1].field)[((port) - 1) & 1])
+
+// The bit-band write which has not reached its register yet
+static volatile uint8_t* bitbandRegister = NULL;
+static int bitbandBit;
+static volatile uint32_t bitbandProxy;
+
+// The ST7735 command which starts every driver primitive's pixels
+#define SIM_ST7735_RAMWR        0x2C
+
+/** Charges the CPU time of one driverlib GPIO_ call. */
+static void SimGPIO_chargeCall()
+{
+    Sim_advance(SimCost_code(SimCost_get()->gpioCall));
+}
+
+/** Moves a pending bit-band write into its register. */
+static void SimGPIO_flushBitband()
+{
+    if (bitbandRegister == NULL) {
+        return;
+    }
+
+    if (bitbandProxy & 1) {
+        *bitbandRegister |= 1 << bitbandBit;
+    }
+    else {
+        *bitbandRegister &= ~(1 << bitbandBit);
+    }
+
+    bitbandRegister = NULL;
+}
+
+/**
+ * Returns the word which stands in for the bit-band alias of one register
+ * bit. It reads as the bit's current value, and a write to it reaches the
+ * register at the next call into the simulated driverlib.
+ */
+volatile uint32_t* SimGPIO_bitband(volatile uint8_t* register_p, int bit)
+{
+    // Charged first, as an ISR which runs meanwhile may use the proxy too
+    Sim_advance(SimCost_code(SimCost_get()->bitband));
+    SimGPIO_flushBitband();
+
+    bitbandRegister = register_p;
+    bitbandBit = bit;
+    bitbandProxy = (*register_p >> bit) & 1;
+
+    return &bitbandProxy;
+}
+
+void GPIO_setAsOutputPin(uint_fast8_t selectedPort, uint_fast16_t selectedPins)
+{
+    SimGPIO_chargeCall();
+    SimGPIO_flushBitband();
+    SIM_GPIO_REGISTER(selectedPort, DIR) |= selectedPins;
+    SIM_GPIO_REGISTER(selectedPort, SEL0) &= ~selectedPins;
+    SIM_GPIO_REGISTER(selectedPort, SEL1) &= ~selectedPins;
+}
+
+void GPIO_setAsInputPin(uint_fast8_t selectedPort, uint_fast16_t selectedPins)
+{
+    SimGPIO_chargeCall();
+    SimGPIO_flushBitband();
+    SIM_GPIO_REGISTER(selectedPort, DIR) &= ~selectedPins;
+    SIM_GPIO_REGISTER(selectedPort, REN) &= ~selectedPins;
+}
+
+void GPIO_setAsInputPinWithPullUpResistor(uint_fast8_t selectedPort, uint_fast16_t selectedPins)
+{
+    SimGPIO_chargeCall();
+    SimGPIO_flushBitband();
+    SIM_GPIO_REGISTER(selectedPort, DIR) &= ~selectedPins;
+    SIM_GPIO_REGISTER(selectedPort, REN) |= selectedPins;
+    SIM_GPIO_REGISTER(selectedPort, OUT) |= selectedPins;
+}
+
+void GPIO_setAsPeripheralModuleFunctionOutputPin(uint_fast8_t selectedPort, uint_fast16_t selectedPins,
+                                                 uint_fast8_t mode)
+{
+    SimGPIO_chargeCall();
+    SimGPIO_flushBitband();
+    SIM_GPIO_REGISTER(selectedPort, DIR) |= selectedPins;
+    SIM_GPIO_REGISTER(selectedPort, SEL0) |= (mode & 1) ? selectedPins : 0;
+    SIM_GPIO_REGISTER(selectedPort, SEL1) |= (mode & 2) ? selectedPins : 0;
+}
+
+void GPIO_setAsPeripheralModuleFunctionInputPin(uint_fast8_t selectedPort, uint_fast16_t selectedPins,
+                                                uint_fast8_t mode)
+{
+    SimGPIO_chargeCall();
+    SimGPIO_flushBitband();
+    SIM_GPIO_REGISTER(selectedPort, DIR) &= ~selectedPins;
+    SIM_GPIO_REGISTER(selectedPort, SEL0) |= (mode & 1) ? selectedPins : 0;
+    SIM_GPIO_REGISTER(selectedPort, SEL1) |= (mode & 2) ? selectedPins : 0;
+}
+
+void GPIO_setOutputHighOnPin(uint_fast8_t selectedPort, uint_fast16_t selectedPins)
+{
+    SimGPIO_chargeCall();
+    SimGPIO_flushBitband();
+    SIM_GPIO_REGISTER(selectedPort, OUT) |= selectedPins;
+}
+
+void GPIO_setOutputLowOnPin(uint_fast8_t selectedPort, uint_fast16_t selectedPins)
+{
+    SimGPIO_chargeCall();
+    SimGPIO_flushBitband();
+    SIM_GPIO_REGISTER(selectedPort, OUT) &= ~selectedPins;
+}
+
+void GPIO_toggleOutputOnPin(uint_fast8_t selectedPort, uint_fast16_t selectedPins)
+{
+    SimGPIO_chargeCall();
+    SimGPIO_flushBitband();
+    SIM_GPIO_REGISTER(selectedPort, OUT) ^= selectedPins;
+}
+
+uint8_t GPIO_getInputPinValue(uint_fast8_t selectedPort, uint_fast16_t selectedPins)
+{
+    SimGPIO_chargeCall();
+    SimGPIO_flushBitband();
+    return (SIM_GPIO_REGISTER(selectedPort, IN) & selectedPins) ? GPIO_INPUT_PIN_HIGH : GPIO_INPUT_PIN_LOW;
+}
+
+/**
+ * Selects the edge of some pins. Changing PxIES can set PxIFG, as the TRM
+ * warns: a pin switched to falling edges while it is low, or to rising edges
+ * while it is high, may raise a flag with no edge at all. The board only may;
+ * the simulation always does, as the worse case for the driver.
+ */
+void GPIO_interruptEdgeSelect(uint_fast8_t selectedPort, uint_fast16_t selectedPins, uint_fast8_t edgeSelect)
+{
+    SimGPIO_chargeCall();
+
+    uint8_t before = SIM_GPIO_REGISTER(selectedPort, IES);
+    if (edgeSelect == GPIO_HIGH_TO_LOW_TRANSITION) {
+        SIM_GPIO_REGISTER(selectedPort, IES) |= selectedPins;
+    }
+    else {
+        SIM_GPIO_REGISTER(selectedPort, IES) &= ~selectedPins;
+    }
+
+    uint8_t after = SIM_GPIO_REGISTER(selectedPort, IES);
+    uint8_t in = SIM_GPIO_REGISTER(selectedPort, IN);
+    uint8_t spurious = (~before & after & ~in) | (before & ~after & in);
+
+    if (spurious != 0)
+    {
+        SIM_GPIO_REGISTER(selectedPort, IFG) |= spurious;
+        if (SIM_GPIO_REGISTER(selectedPort, IFG) & SIM_GPIO_REGISTER(selectedPort, IE)) {
+            Sim_raise(INT_PORT1 + selectedPort - GPIO_PORT_P1);
+        }
+    }
+}
+
+void GPIO_enableInterrupt(uint_fast8_t selectedPort, uint_fast16_t selectedPins)
+{
+    SimGPIO_chargeCall();
+    SIM_GPIO_REGISTER(selectedPort, IE) |= selectedPins;
+}
+
+void GPIO_disableInterrupt(uint_fast8_t selectedPort, uint_fast16_t selectedPins)
+{
+    SimGPIO_chargeCall();
+    SIM_GPIO_REGISTER(selectedPort, IE) &= ~selectedPins;
+}
+
+void GPIO_clearInterruptFlag(uint_fast8_t selectedPort, uint_fast16_t selectedPins)
+{
+    SimGPIO_chargeCall();
+    SIM_GPIO_REGISTER(selectedPort, IFG) &= ~selectedPins;
+}
+
+uint_fast16_t GPIO_getEnabledInterruptStatus(uint_fast8_t selectedPort)
+{
+    SimGPIO_chargeCall();
+    return SIM_GPIO_REGISTER(selectedPort, IFG) & SIM_GPIO_REGISTER(selectedPort, IE);
+}
+
+/**
+ * Drives input pins to a level. Each edge which matches a pin's IES sets its
+ * IFG, and the port's interrupt is raised while any enabled flag is set.
+ *
+ * @param port:     The port, from GPIO_PORT_P1 to GPIO_PORT_P6
+ * @param pins:     The pins to drive
+ * @param high:     The new level
+ */
+void SimGPIO_setInputs(uint8_t port, uint8_t pins, bool high)
+{
+    uint8_t before = SIM_GPIO_REGISTER(port, IN);
+    uint8_t after = high ? before | pins : before & ~pins;
+    uint8_t rising = (before ^ after) & after;
+    uint8_t falling = (before ^ after) & before;
+    uint8_t ies = SIM_GPIO_REGISTER(port, IES);
+
+    SIM_GPIO_REGISTER(port, IN) = after;
+    SIM_GPIO_REGISTER(port, IFG) |= (falling & ies) | (rising & ~ies);
+
+    if (SIM_GPIO_REGISTER(port, IFG) & SIM_GPIO_REGISTER(port, IE)) {
+        Sim_raise(INT_PORT1 + port - GPIO_PORT_P1);
+    }
+}
+
+/**
+ * Returns the output register of a port, with any pending bit-band write.
+ */
+uint8_t SimGPIO_getOutputs(uint8_t port)
+{
+    SimGPIO_flushBitband();
+    return SIM_GPIO_REGISTER(port, OUT);
+}
+
+//*****************************************************************************
+// Interrupts, clocks, power and watchdog
+//*****************************************************************************
+
+bool Interrupt_enableMaster(void)
+{
+    SimGPIO_flushBitband();
+    return Sim_setMasterEnabled(true);
+}
+
+bool Interrupt_disableMaster(void)
+{
+    return Sim_setMasterEnabled(false);
+}
+
+void Interrupt_enableInterrupt(uint32_t interruptNumber)
+{
+    Sim_setInterruptEnabled(interruptNumber, true);
+}
+
+void Interrupt_disableInterrupt(uint32_t interruptNumber)
+{
+    Sim_setInterruptEnabled(interruptNumber, false);
+}
+
+void CS_setDCOFrequency(uint32_t dcoFrequency)
+{
+    if (dcoFrequency != SIM_CLOCK_HZ) {
+        fprintf(stderr, "sim: DCO set to %u Hz, but the simulation runs at %u Hz\n",
+                (unsigned) dcoFrequency, (unsigned) SIM_CLOCK_HZ);
+    }
+}
+
+void CS_initClockSignal(uint32_t selectedClockSignal, uint32_t clockSource, uint32_t clockSourceDivider)
+{
+}
+
+uint32_t CS_getMCLK(void)
+{
+    return SIM_CLOCK_HZ;
+}
+
+uint32_t CS_getSMCLK(void)
+{
+    return SIM_CLOCK_HZ;
+}
+
+void PCM_gotoLPM0(void)
+{
+    SimGPIO_flushBitband();
+    Sim_sleep();
+}
+
+static SimEvent watchdogEvent;
+static uint64_t watchdogInterval = 1ULL << 31;
+
+/** The watchdog expired: on the board this resets the MCU, so the run ends. */
+static void SimWDT_fire()
+{
+    fprintf(stderr, "sim: watchdog reset at %.3f ms\n", Sim_now() / (double) SIM_CYCLES_PER_MS);
+    exit(3);
+}
+
+void WDT_A_holdTimer(void)
+{
+    Sim_cancel(&watchdogEvent);
+}
+
+void WDT_A_initWatchdogTimer(uint_fast8_t clockSelect, uint_fast8_t clockDivider)
+{
+    static const uint64_t intervals[] = { 1ULL << 31, 1ULL << 27, 1ULL << 23, 1ULL << 19 };
+
+    watchdogInterval = intervals[clockDivider & 3];
+}
+
+void WDT_A_startTimer(void)
+{
+    watchdogEvent.fire = SimWDT_fire;
+    Sim_schedule(&watchdogEvent, Sim_now() + watchdogInterval);
+}
+
+void WDT_A_clearTimer(void)
+{
+    if (watchdogEvent.armed) {
+        Sim_schedule(&watchdogEvent, Sim_now() + watchdogInterval);
+    }
+}
+
+/**
+ * The delay loop of the LCD driver, three cycles per count.
+ */
+void SimCPU_delay(uint32_t count)
+{
+    stats.delayCycles += 3 * count;
+    Sim_advance(3ULL * count);
+}
+
+//*****************************************************************************
+// Flash
+//*****************************************************************************
+
+uint8_t SimFlash_memory[SIM_FLASH_SIZE] __attribute__((aligned(SIM_FLASH_SECTOR_SIZE)));
+
+static uint32_t unprotectedSectors = 0;
+static const char* flashPath = NULL;
+static int32_t flashPowerBytes = -1;    // Bytes left before the power cut, or -1 for none
+
+void FlashCtl_setWaitState(uint32_t bank, uint32_t waitState)
+{
+    SimCost_setWaitStates(waitState);
+}
+
+bool FlashCtl_unprotectSector(uint_fast8_t memorySpace, uint32_t sectorMask)
+{
+    if (memorySpace == FLASH_MAIN_MEMORY_SPACE_BANK1) {
+        unprotectedSectors |= sectorMask;
+    }
+    return true;
+}
+
+bool FlashCtl_protectSector(uint_fast8_t memorySpace, uint32_t sectorMask)
+{
+    if (memorySpace == FLASH_MAIN_MEMORY_SPACE_BANK1) {
+        unprotectedSectors &= ~sectorMask;
+    }
+    return true;
+}
+
+/**
+ * Returns the offset of an address in the simulated flash, or -1 if it is
+ * outside it or in a protected sector.
+ */
+static long SimFlash_offset(uintptr_t address)
+{
+    uintptr_t base = (uintptr_t) SimFlash_memory;
+
+    if (address < base || address >= base + SIM_FLASH_SIZE) {
+        return -1;
+    }
+
+    long offset = address - base;
+    int sector = SIM_FLASH_FIRST_SECTOR + offset / SIM_FLASH_SECTOR_SIZE;
+
+    return (unprotectedSectors & (1UL << sector)) ? offset : -1;
+}
+
+/**
+ * Cuts the power to the flash after some more bytes have been programmed.
+ * From then on, every program and erase fails and changes nothing, as if
+ * the CPU had stopped there, until the power is restored.
+ *
+ * @param bytes:    How many more bytes get programmed, or -1 to restore the power
+ */
+void SimFlash_cutPowerAfter(int32_t bytes)
+{
+    flashPowerBytes = bytes;
+}
+
+bool FlashCtl_eraseSector(uint32_t addr)
+{
+    if (flashPowerBytes == 0) {
+        return false;
+    }
+
+    // The address is truncated to 32 bits by the prototype; rebuild it from the base
+    uintptr_t address = ((uintptr_t) SimFlash_memory & ~(uintptr_t) 0xFFFFFFFF) | addr;
+    long offset = SimFlash_offset(address);
+
+    if (offset < 0)
+    {
+        stats.flashFaults++;
+        return false;
+    }
+
+    offset -= offset % SIM_FLASH_SECTOR_SIZE;
+    memset(&SimFlash_memory[offset], 0xFF, SIM_FLASH_SECTOR_SIZE);
+
+    stats.flashErases++;
+    Sim_advance(SIM_FLASH_ERASE_CYCLES);
+
+    return true;
+}
+
+/**
+ * Programs bytes the way flash does: bits can only go from 1 to 0. Like
+ * driverlib, which verifies what it programmed, fails if any byte did not
+ * end up as requested.
+ */
+bool FlashCtl_programMemory(void* src, void* dest, uint32_t length)
+{
+    const uint8_t* source = (const uint8_t*) src;
+    bool verified = true;
+    uint32_t i;
+
+    for (i = 0; i < length; i++)
+    {
+        long offset = SimFlash_offset((uintptr_t) dest + i);
+
+        if (offset < 0)
+        {
+            stats.flashFaults++;
+            return false;
+        }
+
+        if (flashPowerBytes == 0) {
+            return false;
+        }
+        if (flashPowerBytes > 0) {
+            flashPowerBytes--;
+        }
+
+        SimFlash_memory[offset] &= source[i];
+        verified &= SimFlash_memory[offset] == source[i];
+    }
+
+    uint32_t words = (length + 3) / 4;
+    stats.flashWordsProgrammed += words;
+    Sim_advance((uint64_t) words * SIM_FLASH_PROGRAM_CYCLES_PER_WORD);
+
+    return verified;
+}
+
+//*****************************************************************************
+// SysTick and Timer32
+//*****************************************************************************
+
+static SimEvent sysTickEvent;
+static uint32_t sysTickPeriod = 0x01000000;
+static bool sysTickEnabled = false;
+static bool sysTickInterruptEnabled = false;
+
+/** One SysTick period went by. */
+static void SimSysTick_fire()
+{
+    if (sysTickInterruptEnabled) {
+        Sim_raise(SIM_SYSTICK);
+    }
+
+    Sim_schedule(&sysTickEvent, sysTickEvent.when + sysTickPeriod);
+}
+
+void SysTick_enableModule(void)
+{
+    sysTickEnabled = true;
+    sysTickEvent.fire = SimSysTick_fire;
+    Sim_schedule(&sysTickEvent, Sim_now() + sysTickPeriod);
+}
+
+void SysTick_disableModule(void)
+{
+    sysTickEnabled = false;
+    Sim_cancel(&sysTickEvent);
+}
+
+void SysTick_setPeriod(uint32_t period)
+{
+    sysTickPeriod = period;
+    if (sysTickEnabled) {
+        Sim_schedule(&sysTickEvent, Sim_now() + sysTickPeriod);
+    }
+}
+
+void SysTick_enableInterrupt(void)
+{
+    sysTickInterruptEnabled = true;
+}
+
+void SysTick_disableInterrupt(void)
+{
+    sysTickInterruptEnabled = false;
+}
+
+/**
+ * Returns the event of SysTick, which Sim_sleep() moves past the ticks it
+ * sleeps through, as long as SysTick runs with its interrupt enabled.
+ */
+SimEvent* SimSysTick_getEvent()
+{
+    return sysTickEnabled && sysTickInterruptEnabled ? &sysTickEvent : NULL;
+}
+
+uint32_t SimSysTick_getPeriod()
+{
+    return sysTickPeriod;
+}
+
+/**
+ * One of the two Timer32 modules. While it runs, its counter is computed from
+ * the clock rather than stored.
+ */
+struct _SimTimer32
+{
+    uint32_t load;
+    uint64_t start;                 // Cycle at which the counter was last loaded
+    bool running;
+    bool oneShot;
+    bool interruptEnabled;
+    bool interruptFlag;             // RIS: set at every rollover until cleared
+    uint32_t interrupt;
+    SimEvent event;
+};
+typedef struct _SimTimer32 SimTimer32;
+
+// The interrupt enable bit of a Timer32 is set out of reset
+static SimTimer32 timer32s[2] =
+{
+    { 0xFFFFFFFF, 0, false, false, true, false, INT_T32_INT1 },
+    { 0xFFFFFFFF, 0, false, false, true, false, INT_T32_INT2 }
+};
+
+static SimTimer32* SimTimer32_get(uint32_t timer)
+{
+    return timer == TIMER32_0_BASE ? &timer32s[0] : &timer32s[1];
+}
+
+/** A Timer32 reached zero. */
+static void SimTimer32_fire(SimTimer32* timer_p)
+{
+    timer_p->interruptFlag = true;
+
+    if (timer_p->interruptEnabled) {
+        Sim_raise(timer_p->interrupt);
+    }
+
+    if (timer_p->oneShot)
+    {
+        timer_p->running = false;
+        return;
+    }
+
+    timer_p->start = timer_p->event.when;
+    Sim_schedule(&timer_p->event, timer_p->start + SIM_TIMER32_PERIOD(timer_p));
+}
+
+static void SimTimer32_fire0() { SimTimer32_fire(&timer32s[0]); }
+static void SimTimer32_fire1() { SimTimer32_fire(&timer32s[1]); }
+
+/** Reloads a running Timer32, which then counts a whole period again. */
+static void SimTimer32_restart(SimTimer32* timer_p)
+{
+    timer_p->event.fire = timer_p == &timer32s[0] ? SimTimer32_fire0 : SimTimer32_fire1;
+    timer_p->start = Sim_now();
+    Sim_schedule(&timer_p->event, timer_p->start + SIM_TIMER32_PERIOD(timer_p));
+}
+
+void Timer32_initModule(uint32_t timer, uint32_t preScaler, uint32_t resolution, uint32_t mode)
+{
+    SimTimer32* timer_p = SimTimer32_get(timer);
+
+    timer_p->running = false;
+    timer_p->load = 0xFFFFFFFF;
+    Sim_cancel(&timer_p->event);
+}
+
+void Timer32_setCount(uint32_t timer, uint32_t count)
+{
+    SimTimer32* timer_p = SimTimer32_get(timer);
+
+    timer_p->load = count;
+    if (timer_p->running) {
+        SimTimer32_restart(timer_p);
+    }
+}
+
+uint32_t Timer32_getValue(uint32_t timer)
+{
+    SimTimer32* timer_p = SimTimer32_get(timer);
+
+    if (!timer_p->running) {
+        return timer_p->oneShot ? 0 : timer_p->load;
+    }
+
+    return timer_p->load - (uint32_t) ((Sim_now() - timer_p->start) % SIM_TIMER32_PERIOD(timer_p));
+}
+
+void Timer32_startTimer(uint32_t timer, bool oneShot)
+{
+    SimTimer32* timer_p = SimTimer32_get(timer);
+
+    timer_p->oneShot = oneShot;
+    timer_p->running = true;
+    SimTimer32_restart(timer_p);
+}
+
+void Timer32_haltTimer(uint32_t timer)
+{
+    SimTimer32* timer_p = SimTimer32_get(timer);
+
+    timer_p->running = false;
+    Sim_cancel(&timer_p->event);
+}
+
+void Timer32_enableInterrupt(uint32_t timer)
+{
+    SimTimer32_get(timer)->interruptEnabled = true;
+}
+
+void Timer32_disableInterrupt(uint32_t timer)
+{
+    SimTimer32_get(timer)->interruptEnabled = false;
+}
+
+void Timer32_clearInterruptFlag(uint32_t timer)
+{
+    SimTimer32_get(timer)->interruptFlag = false;
+}
+
+/** Reads MIS, which is the raw flag masked by the timer's own interrupt enable. */
+uint32_t Timer32_getInterruptStatus(uint32_t timer)
+{
+    SimTimer32* timer_p = SimTimer32_get(timer);
+
+    return timer_p->interruptFlag && timer_p->interruptEnabled;
+}
+
+//*****************************************************************************
+// ADC14 and Timer_A
+//*****************************************************************************
+
+ADC14_Type SimADC14;
+
+// What each conversion memory reads at its next conversion
+static uint16_t analogInputs[2] = { SIM_JOYSTICK_CENTER, SIM_JOYSTICK_CENTER };
+static bool conversionsEnabled = false;
+static bool timerTriggered = false;
+
+static void SimDMA_request(int channel);
+
+void ADC14_enableModule(void)
+{
+}
+
+bool ADC14_initModule(uint32_t clockSource, uint32_t clockPredivider, uint32_t clockDivider,
+                      uint32_t internalChannelMask)
+{
+    return true;
+}
+
+bool ADC14_configureMultiSequenceMode(uint32_t memoryStart, uint32_t memoryEnd, bool repeatMode)
+{
+    return true;
+}
+
+bool ADC14_configureConversionMemory(uint32_t memorySelect, uint32_t refSelect, uint32_t channelSelect,
+                                     bool differntialMode)
+{
+    return true;
+}
+
+bool ADC14_setSampleHoldTrigger(uint32_t source, bool invertSignal)
+{
+    timerTriggered = source == ADC_TRIGGER_SOURCE7;
+    return true;
+}
+
+bool ADC14_enableConversion(void)
+{
+    conversionsEnabled = true;
+    return true;
+}
+
+void SimADC_setResult(int memory, uint16_t value)
+{
+    analogInputs[memory] = value;
+}
+
+/** Timer_A3's CCR1 rose: convert the joystick sequence and request its DMA. */
+static void SimADC_trigger()
+{
+    if (!conversionsEnabled || !timerTriggered) {
+        return;
+    }
+
+    SimADC14.MEM[SIM_JOYSTICK_X_MEM] = analogInputs[SIM_JOYSTICK_X_MEM];
+    SimADC14.MEM[SIM_JOYSTICK_Y_MEM] = analogInputs[SIM_JOYSTICK_Y_MEM];
+
+    SimDMA_request(SIM_DMA_ADC_CHANNEL);
+}
+
+/**
+ * One of the four Timer_A modules. Only two of them trigger anything:
+ * Timer_A3's period triggers the ADC, and Timer_A1's CCR0 and CCR2 trigger
+ * the DMA channels of the PortSampler. The rest only keep their period.
+ */
+struct _SimTimerA
+{
+    uint32_t period;                // Cycles per up-mode period
+    uint32_t divider;               // Cycles per count
+    uint32_t compare2;              // CCR2, in counts
+    SimEvent event;                 // The end of each period, where CCR0 matches
+    SimEvent compareEvent;          // CCR2 matching, partway through each period
+};
+typedef struct _SimTimerA SimTimerA;
+
+static SimTimerA timerAs[4];
+
+Timer_A_Type SimTimerA_registers[4];
+
+static SimTimerA* SimTimerA_get(uint32_t timer)
+{
+    return &timerAs[((timer - TIMER_A0_BASE) >> 10) & 3];
+}
+
+static void SimTimerA3_fire()
+{
+    SimTimerA* timer_p = &timerAs[3];
+
+    SimADC_trigger();
+    Sim_schedule(&timer_p->event, timer_p->event.when + timer_p->period);
+}
+
+/** Timer_A1's counter reached CCR0. */
+static void SimTimerA1_fire()
+{
+    SimTimerA* timer_p = &timerAs[1];
+
+    SimDMA_request(SIM_DMA_CCR0_CHANNEL);
+    Sim_schedule(&timer_p->event, timer_p->event.when + timer_p->period);
+}
+
+/** Timer_A1's counter reached CCR2. */
+static void SimTimerA1_fireCompare()
+{
+    SimTimerA* timer_p = &timerAs[1];
+
+    SimDMA_request(SIM_DMA_CCR2_CHANNEL);
+    Sim_schedule(&timer_p->compareEvent, timer_p->compareEvent.when + timer_p->period);
+}
+
+void Timer_A_configureUpMode(uint32_t timer, const Timer_A_UpModeConfig* config)
+{
+    SimTimerA* timer_p = SimTimerA_get(timer);
+
+    timer_p->divider = config->clockSourceDivider;
+    timer_p->period = (config->timerPeriod + 1) * config->clockSourceDivider;
+}
+
+void Timer_A_initCompare(uint32_t timer, const Timer_A_CompareModeConfig* compareConfig)
+{
+    if (compareConfig->compareRegister == TIMER_A_CAPTURECOMPARE_REGISTER_2) {
+        SimTimerA_get(timer)->compare2 = compareConfig->compareValue;
+    }
+}
+
+void Timer_A_startCounter(uint32_t timer, uint_fast16_t timerMode)
+{
+    SimTimerA* timer_p = SimTimerA_get(timer);
+
+    if (timer_p->period == 0) {
+        return;
+    }
+
+    if (timer == TIMER_A3_BASE)
+    {
+        timer_p->event.fire = SimTimerA3_fire;
+        Sim_schedule(&timer_p->event, Sim_now() + timer_p->period);
+    }
+    else if (timer == TIMER_A1_BASE)
+    {
+        timer_p->event.fire = SimTimerA1_fire;
+        timer_p->compareEvent.fire = SimTimerA1_fireCompare;
+        Sim_schedule(&timer_p->event, Sim_now() + timer_p->period);
+        Sim_schedule(&timer_p->compareEvent, Sim_now() + (uint64_t) timer_p->compare2 * timer_p->divider);
+    }
+}
+
+void Timer_A_stopTimer(uint32_t timer)
+{
+    Sim_cancel(&SimTimerA_get(timer)->event);
+    Sim_cancel(&SimTimerA_get(timer)->compareEvent);
+}
+
+void Timer_A_generatePWM(uint32_t timer, const Timer_A_PWMConfig* config)
+{
+    SimTimerA* timer_p = SimTimerA_get(timer);
+
+    timer_p->divider = config->clockSourceDivider;
+    timer_p->period = (config->timerPeriod + 1) * config->clockSourceDivider;
+}
+
+void Timer_A_setCompareValue(uint32_t timer, uint_fast16_t compareRegister, uint_fast16_t compareValue)
+{
+}
+
+//*****************************************************************************
+// DMA
+//*****************************************************************************
+
+/**
+ * One DMA channel. Three kinds of transfer are modeled: basic transfers to
+ * the UART, peripheral scatter-gather from the ADC, and ping-pong transfers
+ * from a port, as the PortSampler's Timer_A1 triggers request them.
+ */
+struct _SimDMAChannel
+{
+    bool enabled;
+    uint32_t interrupt;             // The INT_DMA_INTn the channel completes on
+    DMA_ControlTable primary;       // The basic transfer, from setChannelControl/Transfer
+    DMA_ControlTable alternate;     // The other half of a ping-pong transfer
+    uint32_t sizes[2];              // Items in the primary and alternate transfers
+    bool alternateActive;           // Which structure the next ping-pong item goes through
+    const DMA_ControlTable* tasks;  // The scatter-gather task list, or NULL
+    uint32_t numTasks;
+    uint32_t nextTask;
+    SimEvent event;
+};
+typedef struct _SimDMAChannel SimDMAChannel;
+
+static SimDMAChannel channels[SIM_DMA_CHANNELS];
+static uint32_t dmaInterruptStatus = 0;
+
+EUSCI_A_Type SimUART_registers = { 0, EUSCI_A_IFG_TXIFG };
+
+static uint32_t uartByteCycles = 0;
+static FILE* uartFile = NULL;
+static void (*uartListener)(const uint8_t* bytes, uint32_t count) = NULL;
+
+/** Ends a channel's transfer, raising its completion interrupt. */
+static void SimDMA_complete(int channel)
+{
+    channels[channel].enabled = false;
+    dmaInterruptStatus |= 1 << channel;
+    Sim_raise(channels[channel].interrupt);
+}
+
+/**
+ * Runs one task of a scatter-gather list, which the ADC requests once per
+ * conversion sequence. The list ends with its first basic-mode task.
+ */
+static void SimDMA_runTask(SimDMAChannel* channel_p, const DMA_ControlTable* task_p)
+{
+    uint32_t control = task_p->control;
+    uint32_t count = ((control >> 4) & 0x3FF) + 1;
+    uint32_t size = 1 << ((control >> 28) & 3);
+    uint32_t srcInc = ((control >> 26) & 3) == 3 ? 0 : 1 << ((control >> 26) & 3);
+    uint32_t dstInc = ((control >> 30) & 3) == 3 ? 0 : 1 << ((control >> 30) & 3);
+    const volatile uint8_t* src = (const volatile uint8_t*) task_p->srcEndAddr;
+    volatile uint8_t* dst = (volatile uint8_t*) task_p->dstEndAddr;
+    uint32_t i, byte;
+
+    Sim_advance(SimCost_cycles((uint64_t) count * SimCost_get()->dmaItem));
+
+    for (i = 0; i < count; i++)
+    {
+        for (byte = 0; byte < size; byte++) {
+            dst[i * dstInc + byte] = src[i * srcInc + byte];
+        }
+    }
+}
+
+/**
+ * Moves one item of a ping-pong transfer. When the active structure runs
+ * out, it stops, the channel's interrupt is raised, and the next request
+ * goes through the other structure. If the ISR has not re-armed that one
+ * yet either, requests are dropped, as the controller would.
+ */
+static void SimDMA_pingPong(int channel)
+{
+    SimDMAChannel* channel_p = &channels[channel];
+    DMA_ControlTable* active_p = channel_p->alternateActive ? &channel_p->alternate : &channel_p->primary;
+    uint32_t control = active_p->control;
+
+    if ((control & 7) != UDMA_MODE_PINGPONG) {
+        return;
+    }
+
+    uint32_t remaining = ((control >> 4) & 0x3FF) + 1;
+    uint32_t item = channel_p->sizes[channel_p->alternateActive] - remaining;
+    uint32_t size = 1 << ((control >> 28) & 3);
+    uint32_t srcInc = ((control >> 26) & 3) == 3 ? 0 : 1 << ((control >> 26) & 3);
+    uint32_t dstInc = ((control >> 30) & 3) == 3 ? 0 : 1 << ((control >> 30) & 3);
+    const volatile uint8_t* src = (const volatile uint8_t*) active_p->srcEndAddr + item * srcInc;
+    volatile uint8_t* dst = (volatile uint8_t*) active_p->dstEndAddr + item * dstInc;
+    uint32_t byte;
+
+    for (byte = 0; byte < size; byte++) {
+        dst[byte] = src[byte];
+    }
+
+    if (remaining > 1) {
+        active_p->control = control - (1 << 4);
+    }
+    else
+    {
+        active_p->control = control & ~0x3FF7;
+        channel_p->alternateActive = !channel_p->alternateActive;
+        dmaInterruptStatus |= 1 << channel;
+        Sim_raise(channel_p->interrupt);
+    }
+
+    Sim_advance(SimCost_cycles(SimCost_get()->dmaItem));
+}
+
+/** A peripheral asked a channel for its next transfer. */
+static void SimDMA_request(int channel)
+{
+    SimDMAChannel* channel_p = &channels[channel];
+
+    if (!channel_p->enabled) {
+        return;
+    }
+
+    if (channel_p->tasks == NULL)
+    {
+        SimDMA_pingPong(channel);
+        return;
+    }
+
+    const DMA_ControlTable* task_p = &channel_p->tasks[channel_p->nextTask++];
+    SimDMA_runTask(channel_p, task_p);
+
+    if ((task_p->control & 7) == UDMA_MODE_BASIC || channel_p->nextTask == channel_p->numTasks)
+    {
+        stats.adcBlocks++;
+        SimDMA_complete(channel);
+    }
+}
+
+/** The UART shifted out the last byte of a DMA transfer. */
+static void SimDMA_fireUART()
+{
+    SimDMAChannel* channel_p = &channels[SIM_DMA_UART_CHANNEL];
+    uint32_t count = ((channel_p->primary.control >> 4) & 0x3FF) + 1;
+
+    if (uartFile != NULL) {
+        fwrite((const void*) channel_p->primary.srcEndAddr, 1, count, uartFile);
+    }
+    if (uartListener != NULL) {
+        uartListener((const uint8_t*) channel_p->primary.srcEndAddr, count);
+    }
+
+    stats.uartBytes += count;
+    stats.uartTransfers++;
+
+    // The transfer took its bus cycles from the CPU a byte at a time; they
+    // are charged in one go at the end
+    Sim_advance(SimCost_cycles((uint64_t) count * SimCost_get()->dmaItem));
+
+    SimDMA_complete(SIM_DMA_UART_CHANNEL);
+}
+
+/**
+ * Hands every byte the UART sends from now on to a function, a transfer at a
+ * time, as it leaves the wire.
+ *
+ * @param listener: The function, or NULL to stop
+ */
+void SimUART_setListener(void (*listener)(const uint8_t* bytes, uint32_t count))
+{
+    uartListener = listener;
+}
+
+void DMA_enableModule(void)
+{
+}
+
+void DMA_setControlBase(void* controlTable)
+{
+}
+
+void DMA_assignChannel(uint32_t mapping)
+{
+    SimDMAChannel* channel_p = &channels[mapping & 7];
+
+    if (channel_p->interrupt == 0) {
+        channel_p->interrupt = INT_DMA_INT0;
+    }
+}
+
+void DMA_assignInterrupt(uint32_t interruptNumber, uint32_t channel)
+{
+    channels[channel & 7].interrupt = interruptNumber;
+}
+
+/** Returns the primary or alternate structure of a channel. */
+static DMA_ControlTable* SimDMA_structure(uint32_t channelStructIndex)
+{
+    SimDMAChannel* channel_p = &channels[channelStructIndex & 7];
+
+    return (channelStructIndex & UDMA_ALT_SELECT) ? &channel_p->alternate : &channel_p->primary;
+}
+
+void DMA_setChannelControl(uint32_t channelStructIndex, uint32_t control)
+{
+    SimDMA_structure(channelStructIndex)->control = control;
+}
+
+void DMA_setChannelTransfer(uint32_t channelStructIndex, uint32_t mode, void* srcAddr, void* dstAddr,
+                            uint32_t transferSize)
+{
+    SimDMAChannel* channel_p = &channels[channelStructIndex & 7];
+    DMA_ControlTable* structure_p = SimDMA_structure(channelStructIndex);
+
+    structure_p->srcEndAddr = srcAddr;
+    structure_p->dstEndAddr = dstAddr;
+    structure_p->control = (structure_p->control & ~0x3FF7) | ((transferSize - 1) << 4) | mode;
+    channel_p->sizes[(channelStructIndex & UDMA_ALT_SELECT) != 0] = transferSize;
+    channel_p->tasks = NULL;
+}
+
+void DMA_setChannelScatterGather(uint32_t channelNum, uint32_t taskCount, void* taskList,
+                                 uint32_t isPeriphSG)
+{
+    SimDMAChannel* channel_p = &channels[channelNum & 7];
+
+    channel_p->tasks = (const DMA_ControlTable*) taskList;
+    channel_p->numTasks = taskCount;
+    channel_p->nextTask = 0;
+}
+
+void DMA_enableChannel(uint32_t channelNum)
+{
+    SimDMAChannel* channel_p = &channels[channelNum & 7];
+
+    channel_p->enabled = true;
+
+    // The UART takes a byte per TXIFG, so a basic transfer to it lasts as
+    // long as its bytes take on the wire
+    if (channelNum == SIM_DMA_UART_CHANNEL && channel_p->tasks == NULL && uartByteCycles != 0)
+    {
+        uint32_t count = ((channel_p->primary.control >> 4) & 0x3FF) + 1;
+
+        channel_p->event.fire = SimDMA_fireUART;
+        Sim_schedule(&channel_p->event, Sim_now() + (uint64_t) count * uartByteCycles);
+    }
+}
+
+void DMA_disableChannel(uint32_t channelNum)
+{
+    channels[channelNum & 7].enabled = false;
+    Sim_cancel(&channels[channelNum & 7].event);
+}
+
+uint32_t DMA_getChannelAttribute(uint32_t channelNum)
+{
+    return channels[channelNum & 7].alternateActive ? UDMA_ATTR_ALTSELECT : 0;
+}
+
+/** Items left in a structure, or 0 once it has stopped. */
+uint32_t DMA_getChannelSize(uint32_t channelStructIndex)
+{
+    uint32_t control = SimDMA_structure(channelStructIndex)->control;
+
+    if ((control & 7) == UDMA_MODE_STOP) {
+        return 0;
+    }
+
+    return ((control >> 4) & 0x3FF) + 1;
+}
+
+uint32_t DMA_getInterruptStatus(void)
+{
+    return dmaInterruptStatus;
+}
+
+void DMA_clearInterruptFlag(uint32_t intChannel)
+{
+    dmaInterruptStatus &= ~(1 << (intChannel & 31));
+}
+
+void DMA_requestSoftwareTransfer(uint32_t channel)
+{
+}
+
+//*****************************************************************************
+// eUSCI: UART and SPI
+//*****************************************************************************
+
+/**
+ * Sets the UART's byte time from its baud rate settings: with oversampling,
+ * a bit takes 16 times the prescaler plus the first modulation stage in
+ * BRCLK cycles, and a byte takes ten bits with its start and stop bits.
+ */
+bool UART_initModule(uint32_t moduleInstance, const eUSCI_UART_ConfigV1* config)
+{
+    uint32_t bitCycles = config->overSampling ? 16 * config->clockPrescalar + config->firstModReg
+                                              : config->clockPrescalar;
+
+    uartByteCycles = 10 * bitCycles;
+    return true;
+}
+
+void UART_enableModule(uint32_t moduleInstance)
+{
+}
+
+volatile uint16_t SimSPI_txbuf = SIM_SPI_EMPTY;
+static uint32_t spiByteCycles = 0;
+
+/** Sets the SPI byte time from the ratio of the source clock to the SPI clock. */
+bool SPI_initMaster(uint32_t moduleInstance, const eUSCI_SPI_MasterConfig* config)
+{
+    spiByteCycles = 8 * (config->clockSourceFrequency / config->desiredSpiClock);
+    return true;
+}
+
+void SPI_enableModule(uint32_t moduleInstance)
+{
+}
+
+/**
+ * Reads UCB0STATW. If a byte was written to UCB0TXBUF since the last read,
+ * it goes to the panel model now, with the data/command pin as the driver
+ * left it, and the clock advances by its time on the bus. The bus is never
+ * busy by the time the status is returned.
+ */
+uint16_t SimSPI_status(void)
+{
+    if (SimSPI_txbuf != SIM_SPI_EMPTY)
+    {
+        uint8_t byte = (uint8_t) SimSPI_txbuf;
+        SimSPI_txbuf = SIM_SPI_EMPTY;
+
+        bool selected = (SimGPIO_getOutputs(LCD_CS_PORT) & LCD_CS_PIN) == 0;
+        bool isData = (SimGPIO_getOutputs(LCD_DC_PORT) & LCD_DC_PIN) != 0;
+
+        if (selected) {
+            ST7735Model_write(byte, isData);
+        }
+
+        uint64_t cycles = spiByteCycles + SimCost_code(SimCost_get()->lcdByte);
+        if (!isData && byte == SIM_ST7735_RAMWR) {
+            cycles += SimCost_code(SimCost_get()->lcdPrimitive);
+        }
+
+        Sim_advance(cycles);
+    }
+
+    return 0;
+}
+
+//*****************************************************************************
+// Setup and report
+//*****************************************************************************
+
+/**
+ * Starts the peripherals in their reset state: erased flash, unless SIM_FLASH
+ * names a file saved by an earlier run, and a centered joystick.
+ */
+void SimPeripherals_init()
+{
+    const char* uartPath = getenv("SIM_UART");
+    flashPath = getenv("SIM_FLASH");
+
+    memset(SimFlash_memory, 0xFF, SIM_FLASH_SIZE);
+
+    if (flashPath != NULL)
+    {
+        FILE* file = fopen(flashPath, "rb");
+        if (file != NULL)
+        {
+            if (fread(SimFlash_memory, 1, SIM_FLASH_SIZE, file) != SIM_FLASH_SIZE) {
+                memset(SimFlash_memory, 0xFF, SIM_FLASH_SIZE);
+            }
+            fclose(file);
+        }
+    }
+
+    if (uartPath != NULL && (uartFile = fopen(uartPath, "wb")) == NULL)
+    {
+        perror(uartPath);
+        exit(2);
+    }
+
+    SimADC14.MEM[SIM_JOYSTICK_X_MEM] = SIM_JOYSTICK_CENTER;
+    SimADC14.MEM[SIM_JOYSTICK_Y_MEM] = SIM_JOYSTICK_CENTER;
+}
+
+/**
+ * Saves the flash file and closes the UART file, then prints the statistics.
+ *
+ * @param file:     Where to print the statistics
+ * @param quiet:    Only save, print nothing
+ */
+void SimPeripherals_report(FILE* file, bool quiet)
+{
+    if (flashPath != NULL)
+    {
+        FILE* flashFile = fopen(flashPath, "wb");
+        if (flashFile != NULL)
+        {
+            fwrite(SimFlash_memory, 1, SIM_FLASH_SIZE, flashFile);
+            fclose(flashFile);
+        }
+    }
+
+    if (uartFile != NULL) {
+        fclose(uartFile);
+    }
+
+    if (quiet) {
+        return;
+    }
+
+    fprintf(file, "flash: %u words programmed, %u sector erases, %u faults\n",
+            stats.flashWordsProgrammed, stats.flashErases, stats.flashFaults);
+    fprintf(file, "uart: %u bytes in %u DMA transfers\n", stats.uartBytes, stats.uartTransfers);
+    fprintf(file, "adc: %u joystick blocks; delay loops: %.3f ms\n",
+            stats.adcBlocks, stats.delayCycles / (double) SIM_CYCLES_PER_MS);
+}
+
+/**
+ * Returns what the peripherals have done so far.
+ */
+const SimPeripheralStats* SimPeripherals_getStats()
+{
+    return &stats;
+}
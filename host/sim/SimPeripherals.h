@@ -0,0 +1,80 @@
+/*
+ * SimPeripherals.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HOST_SIM_SIMPERIPHERALS_H_
+#define HOST_SIM_SIMPERIPHERALS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include <sim/Sim.h>
+
+// The ADC14 results of a centered joystick, and of one pushed all the way
+#define SIM_JOYSTICK_CENTER     8192
+#define SIM_JOYSTICK_MAX        16383
+
+// The conversion memories the joystick sequence writes its X and Y axes to
+#define SIM_JOYSTICK_X_MEM      0
+#define SIM_JOYSTICK_Y_MEM      1
+
+// Rough flash timings of the MSP432P401R, which block the CPU in driverlib
+#define SIM_FLASH_PROGRAM_CYCLES_PER_WORD   (20 * (SIM_CLOCK_HZ / 1000000))
+#define SIM_FLASH_ERASE_CYCLES              (15 * SIM_CYCLES_PER_MS)
+
+/**
+ * What the simulated peripherals have done, for the report printed at exit.
+ */
+struct _SimPeripheralStats
+{
+    uint32_t flashWordsProgrammed;
+    uint32_t flashErases;
+    uint32_t flashFaults;           // Writes to protected or missing flash
+    uint32_t uartBytes;
+    uint32_t uartTransfers;
+    uint32_t adcBlocks;             // Joystick DMA blocks completed
+    uint32_t delayCycles;           // Cycles spent in SysCtlDelay()
+};
+typedef struct _SimPeripheralStats SimPeripheralStats;
+
+/**=============================================================================
+ * The hooks between the simulated driverlib in SimDriverlib.c and the rest
+ * of the simulation. Sim.c drives the inputs from its script, and the SPI
+ * model reads the LCD's data/command pin.
+ * =============================================================================
+ */
+
+// Opens the flash and UART files named by SIM_FLASH and SIM_UART.
+void SimPeripherals_init();
+
+// Saves the flash file and prints the peripheral statistics.
+void SimPeripherals_report(FILE* file, bool quiet);
+
+// Drives some input pins of a port high or low, raising port interrupts on matching edges.
+void SimGPIO_setInputs(uint8_t port, uint8_t pins, bool high);
+
+// Returns the output register of a port.
+uint8_t SimGPIO_getOutputs(uint8_t port);
+
+// Lets only the given number of bytes more be programmed into flash, as if the power failed; -1 restores it.
+void SimFlash_cutPowerAfter(int32_t bytes);
+
+// Hands the bytes the UART sends to a function, one DMA transfer at a time; NULL stops.
+void SimUART_setListener(void (*listener)(const uint8_t* bytes, uint32_t count));
+
+// Sets the next result of an ADC14 conversion memory.
+void SimADC_setResult(int memory, uint16_t value);
+
+// Returns the event of SysTick while it interrupts the CPU, or NULL.
+SimEvent* SimSysTick_getEvent();
+
+// Returns the SysTick period, in cycles.
+uint32_t SimSysTick_getPeriod();
+
+// Returns what the peripherals have done so far.
+const SimPeripheralStats* SimPeripherals_getStats();
+
+#endif /* HOST_SIM_SIMPERIPHERALS_H_ */
@@ -0,0 +1,95 @@
+/*
+ * Test.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <test/Test.h>
+
+#include <stdio.h>
+#include <inttypes.h>
+
+static const char* currentTest = "main";
+static uint32_t checks = 0;
+static uint32_t failures = 0;
+static uint32_t tests = 0;
+static uint32_t failedTests = 0;
+
+/**
+ * Runs one test function.
+ *
+ * @param name:     The name to report its failures under
+ * @param test:     The test function
+ */
+void Test_run(const char* name, void (*test)(void))
+{
+    uint32_t failuresBefore = failures;
+
+    currentTest = name;
+    test();
+    currentTest = "main";
+
+    tests++;
+    if (failures != failuresBefore) {
+        failedTests++;
+    }
+}
+
+/**
+ * Records one check, and prints it if it failed.
+ *
+ * @param passed:   Whether the check held
+ * @param text:     The checked condition, as written
+ * @param file:     The source file of the check
+ * @param line:     The source line of the check
+ */
+void Test_check(bool passed, const char* text, const char* file, int line)
+{
+    checks++;
+
+    if (!passed)
+    {
+        failures++;
+        printf("%s:%d: %s: FAILED %s\n", file, line, currentTest, text);
+    }
+}
+
+/**
+ * Records one comparison of two integers, and prints both if they differ.
+ *
+ * @param actual:       The value computed by the test
+ * @param expected:     The value it should have
+ * @param actualText:   The expression of the actual value, as written
+ * @param expectedText: The expression of the expected value, as written
+ * @param file:         The source file of the check
+ * @param line:         The source line of the check
+ */
+void Test_checkEqual(int64_t actual, int64_t expected, const char* actualText, const char* expectedText,
+                     const char* file, int line)
+{
+    checks++;
+
+    if (actual != expected)
+    {
+        failures++;
+        printf("%s:%d: %s: FAILED %s == %s: got %" PRId64 ", expected %" PRId64 "\n",
+               file, line, currentTest, actualText, expectedText, actual, expected);
+    }
+}
+
+/**
+ * Prints how many tests and checks ran, and how many of them failed.
+ *
+ * @return 0 if every check passed, 1 otherwise
+ */
+int Test_finish()
+{
+    printf("%u tests, %u checks: %s", tests, checks, failures ? "" : "passed\n");
+
+    if (failures != 0) {
+        printf("%u checks in %u tests FAILED\n", failures, failedTests);
+    }
+
+    fflush(stdout);
+    return failures != 0;
+}
@@ -0,0 +1,53 @@
+/*
+ * Test.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HOST_TEST_TEST_H_
+#define HOST_TEST_TEST_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Checks a condition, and reports it with its source line if it is false
+#define TEST_CHECK(condition) \
+    Test_check((condition), #condition, __FILE__, __LINE__)
+
+// Checks that two integers are equal, and reports both values if they are not
+#define TEST_CHECK_EQUAL(actual, expected) \
+    Test_checkEqual((int64_t) (actual), (int64_t) (expected), #actual, #expected, __FILE__, __LINE__)
+
+// Runs a test function, under its own name
+#define TEST_RUN(test)  Test_run(#test, test)
+
+/**=============================================================================
+ * A minimal harness for the host tests. Every file in host/test other than
+ * this one is a test program of its own, linked against the game, the HAL and
+ * the simulation the same way as the benchmark. Its main() runs its test
+ * functions with TEST_RUN() and returns Test_finish(). "make test" builds and
+ * runs every test program, and fails on the first one which fails.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * The tests of one program share the simulated clock, the simulated hardware
+ * and the static state of every HAL module, none of which can be reset. Each
+ * test must leave them as the next one expects, or go in a program of its
+ * own. A failed check does not end its test. Sim.c still ends the run after
+ * SIM_RUN_MS, which "make test" sets far beyond any test.
+ */
+
+// Runs one test function, reporting its name if any of its checks fail.
+void Test_run(const char* name, void (*test)(void));
+
+// Records one check. Use TEST_CHECK().
+void Test_check(bool passed, const char* text, const char* file, int line);
+
+// Records one comparison of integers. Use TEST_CHECK_EQUAL().
+void Test_checkEqual(int64_t actual, int64_t expected, const char* actualText, const char* expectedText,
+                     const char* file, int line);
+
+// Prints the totals. Returns the exit status of the test program.
+int Test_finish();
+
+#endif /* HOST_TEST_TEST_H_ */
@@ -0,0 +1,442 @@
+/*
+ * TestButton.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <test/Test.h>
+#include <sim/Sim.h>
+#include <sim/SimPeripherals.h>
+
+#include <HAL/Button.h>
+
+#define TEST_MAX_CHANGES    8192
+#define TEST_MAX_TAPS       64
+#define TEST_CYCLES_PER_US  (SIM_CLOCK_HZ / 1000000)
+
+// A press and release the debouncer should always see as one tap
+#define TEST_HOLD_MS        60
+#define TEST_GAP_MS         100
+
+// How often the latency tests refresh, finer than the 1 ms input task so
+// that the latency of the policy itself can be seen
+#define TEST_STEP_US        50
+
+// Auto-repeat as the cursor uses it
+#define TEST_REPEAT_DELAY_MS    400
+#define TEST_REPEAT_RATE_MS     100
+
+// The most an edge timestamp may trail the edge: the port ISR's entry latency
+#define TEST_ISR_US             20
+
+/**
+ * A scripted level of the button pin, from a given cycle on.
+ */
+struct _PinChange
+{
+    uint64_t when;
+    bool high;
+};
+typedef struct _PinChange PinChange;
+
+static PinChange changes[TEST_MAX_CHANGES];
+static int numChanges = 0;
+static int nextChange = 0;
+static SimEvent changeEvent;
+
+static Button s1;
+static Button polled;           // A polled button on the same pin as s1
+
+static uint64_t tapTimes[TEST_MAX_TAPS];
+
+/** Drives the pin to every level which is due, and arms the next change. */
+static void TestButton_fireChange()
+{
+    while (nextChange < numChanges && changes[nextChange].when <= Sim_now())
+    {
+        SimGPIO_setInputs(BOOSTERPACK_S1_PORT, BOOSTERPACK_S1_PIN, changes[nextChange].high);
+        nextChange++;
+    }
+
+    if (nextChange < numChanges) {
+        Sim_schedule(&changeEvent, changes[nextChange].when);
+    }
+}
+
+/** Adds a change of the pin to the script, which must be given in time order. */
+static void TestButton_change(uint64_t when, bool high)
+{
+    changes[numChanges].when = when;
+    changes[numChanges].high = high;
+    numChanges++;
+
+    if (!changeEvent.armed) {
+        Sim_schedule(&changeEvent, changes[nextChange].when);
+    }
+}
+
+/** Adds a press at a cycle which lasts holdMs, and returns the cycle of the release. */
+static uint64_t TestButton_tap(uint64_t when, uint32_t holdMs)
+{
+    TestButton_change(when, false);
+    TestButton_change(when + (uint64_t) holdMs * SIM_CYCLES_PER_MS, true);
+
+    return when + (uint64_t) holdMs * SIM_CYCLES_PER_MS;
+}
+
+/**
+ * Adds a bouncy press at a cycle: the pin chatters for 1.5 ms before it
+ * settles low, is held for holdMs, and chatters again on release. Returns
+ * the cycle at which the release has settled.
+ */
+static uint64_t TestButton_bouncyTap(uint64_t when, uint32_t holdMs)
+{
+    static const uint32_t pressBounce_us[] = { 0, 200, 500, 900, 1500 };
+    static const uint32_t releaseBounce_us[] = { 0, 300, 700 };
+    uint64_t release = when + (uint64_t) holdMs * SIM_CYCLES_PER_MS;
+    int i;
+
+    for (i = 0; i < 5; i++) {
+        TestButton_change(when + pressBounce_us[i] * TEST_CYCLES_PER_US, i & 1);
+    }
+    for (i = 0; i < 3; i++) {
+        TestButton_change(release + releaseBounce_us[i] * TEST_CYCLES_PER_US, !(i & 1));
+    }
+
+    return release + releaseBounce_us[2] * TEST_CYCLES_PER_US;
+}
+
+/**
+ * Refreshes both buttons every stepUs for some time, and returns the number
+ * of taps one of them reported. The cycle of each of those taps is kept in
+ * tapTimes.
+ */
+static int TestButton_runEvery(Button* watched_p, uint32_t stepUs, uint32_t ms)
+{
+    uint32_t steps = ms * 1000 / stepUs;
+    int taps = 0;
+    uint32_t i;
+
+    for (i = 0; i < steps; i++)
+    {
+        Sim_advance(stepUs * TEST_CYCLES_PER_US);
+        Button_refresh(&s1);
+        Button_refresh(&polled);
+
+        if (Button_isTapped(watched_p))
+        {
+            if (taps < TEST_MAX_TAPS) {
+                tapTimes[taps] = Sim_now();
+            }
+            taps++;
+        }
+    }
+
+    return taps;
+}
+
+/**
+ * Refreshes the buttons once per millisecond for some time, as the input task
+ * does, and returns the number of taps s1 reported.
+ */
+static int TestButton_run(uint32_t ms)
+{
+    return TestButton_runEvery(&s1, 1000, ms);
+}
+
+/** Clean presses are each one tap, and every edge is queued once. */
+static void TestButton_cleanTaps()
+{
+    uint32_t queued = Button_getEdgeStats()->queued;
+    uint64_t t = Sim_now() + SIM_CYCLES_PER_MS;
+    int i;
+
+    for (i = 0; i < 10; i++) {
+        t = TestButton_tap(t, TEST_HOLD_MS) + TEST_GAP_MS * SIM_CYCLES_PER_MS;
+    }
+
+    TEST_CHECK_EQUAL(TestButton_run(10 * (TEST_HOLD_MS + TEST_GAP_MS) + 10), 10);
+    TEST_CHECK_EQUAL(Button_getEdgeStats()->queued - queued, 20);
+    TEST_CHECK(!Button_isPressed(&s1));
+}
+
+/**
+ * A second change of the pin while the ISR of the first one is still running,
+ * swept across the whole ISR. Whatever the ISR reads, the queue must keep
+ * alternating, so an even number of edges has been queued once the button is
+ * released again, and every press is still one tap.
+ */
+static void TestButton_bounceDuringInterrupt()
+{
+    uint32_t queued = Button_getEdgeStats()->queued;
+    uint32_t duplicates = Button_getEdgeStats()->duplicates;
+    uint64_t t = Sim_now() + SIM_CYCLES_PER_MS;
+    int presses = 0;
+    int offset;
+
+    for (offset = 0; offset < 600; offset += 3)
+    {
+        // Press, bounce back up and down again mid-ISR, release cleanly
+        TestButton_change(t, false);
+        TestButton_change(t + offset, true);
+        TestButton_change(t + offset + 40, false);
+        t = TestButton_tap(t + offset + 80, TEST_HOLD_MS) + TEST_GAP_MS * SIM_CYCLES_PER_MS;
+        presses++;
+    }
+
+    TEST_CHECK_EQUAL(TestButton_run(presses * (TEST_HOLD_MS + TEST_GAP_MS) + 10), presses);
+    TEST_CHECK_EQUAL((Button_getEdgeStats()->queued - queued) % 2, 0);
+    TEST_CHECK(Button_getEdgeStats()->duplicates > duplicates);
+    TEST_CHECK_EQUAL(Button_getEdgeStats()->overflows, 0);
+}
+
+/**
+ * Taps made while the main loop stalls are all captured, and are reported on
+ * consecutive refreshes rather than merged into one.
+ */
+static void TestButton_tapsDuringStall()
+{
+    uint64_t t = Sim_now() + SIM_CYCLES_PER_MS;
+    int i;
+
+    for (i = 0; i < 3; i++) {
+        t = TestButton_tap(t, TEST_HOLD_MS) + TEST_GAP_MS * SIM_CYCLES_PER_MS;
+    }
+
+    Sim_advance(3 * (TEST_HOLD_MS + TEST_GAP_MS) * SIM_CYCLES_PER_MS);
+
+    for (i = 0; i < 3; i++)
+    {
+        Button_refresh(&s1);
+        TEST_CHECK(Button_isTapped(&s1));
+    }
+
+    Button_refresh(&s1);
+    TEST_CHECK(!Button_isTapped(&s1));
+}
+
+/**
+ * Plays presses with chatter on both edges to one button and returns the
+ * worst latency from the first edge of a press to its tap, in microseconds.
+ * Every press must be exactly one tap.
+ */
+static uint32_t TestButton_bouncyLatency(Button* button_p)
+{
+    uint64_t presses[8];
+    uint64_t t = Sim_now() + SIM_CYCLES_PER_MS;
+    uint32_t worst = 0;
+    int i;
+
+    for (i = 0; i < 8; i++)
+    {
+        presses[i] = t;
+        t = TestButton_bouncyTap(t, TEST_HOLD_MS) + TEST_GAP_MS * SIM_CYCLES_PER_MS;
+    }
+
+    TEST_CHECK_EQUAL(TestButton_runEvery(button_p, TEST_STEP_US, 8 * (TEST_HOLD_MS + TEST_GAP_MS) + 10), 8);
+
+    for (i = 0; i < 8; i++)
+    {
+        uint32_t latency = (uint32_t) (tapTimes[i] - presses[i]) / TEST_CYCLES_PER_US;
+        if (latency > worst) {
+            worst = latency;
+        }
+    }
+
+    return worst;
+}
+
+/**
+ * A leading-edge button reports a bouncy press on the first refresh after its
+ * first edge, where an integrating one waits until the chatter has settled
+ * for DEBOUNCE_TIME_MS. Both see every press exactly once.
+ */
+static void TestButton_leadingEdgeLatency()
+{
+    uint32_t settled_us = 1500 + DEBOUNCE_TIME_MS * 1000;
+
+    TEST_CHECK(TestButton_bouncyLatency(&s1) >= settled_us);
+    TEST_CHECK(TestButton_bouncyLatency(&polled) >= settled_us);
+
+    TEST_CHECK(Button_setDebouncePolicy(&s1, DEBOUNCE_LEADING_EDGE, DEFAULT_LOCKOUT_TIME_MS));
+    TEST_CHECK(Button_setDebouncePolicy(&polled, DEBOUNCE_LEADING_EDGE, DEFAULT_LOCKOUT_TIME_MS));
+
+    TEST_CHECK(TestButton_bouncyLatency(&s1) <= TEST_STEP_US);
+    TEST_CHECK(TestButton_bouncyLatency(&polled) <= TEST_STEP_US);
+}
+
+/**
+ * The price of the leading edge: a single 200 us glitch is a tap, which the
+ * integrating policy ignores.
+ */
+static void TestButton_glitch()
+{
+    uint64_t t = Sim_now() + SIM_CYCLES_PER_MS;
+
+    TestButton_change(t, false);
+    TestButton_change(t + 200 * TEST_CYCLES_PER_US, true);
+    TEST_CHECK_EQUAL(TestButton_runEvery(&s1, TEST_STEP_US, TEST_GAP_MS), 1);
+
+    Button_setDebouncePolicy(&s1, DEBOUNCE_INTEGRATING, 0);
+
+    t = Sim_now() + SIM_CYCLES_PER_MS;
+    TestButton_change(t, false);
+    TestButton_change(t + 200 * TEST_CYCLES_PER_US, true);
+    TEST_CHECK_EQUAL(TestButton_runEvery(&s1, TEST_STEP_US, TEST_GAP_MS), 0);
+}
+
+/**
+ * A bouncy press held for a second reports one tap, then repeats after the
+ * delay and at the rate, each within one refresh of when it is due, and
+ * nothing once released. The chatter on the press does not restart the delay.
+ */
+static void TestButton_autoRepeat()
+{
+    uint32_t holdMs = TEST_REPEAT_DELAY_MS + 6 * TEST_REPEAT_RATE_MS + TEST_REPEAT_RATE_MS / 2;
+    uint64_t t = Sim_now() + SIM_CYCLES_PER_MS;
+    int i;
+
+    Button_setDebouncePolicy(&s1, DEBOUNCE_LEADING_EDGE, DEFAULT_LOCKOUT_TIME_MS);
+    Button_setAutoRepeat(&s1, TEST_REPEAT_DELAY_MS, TEST_REPEAT_RATE_MS);
+
+    TestButton_bouncyTap(t, holdMs);
+    TEST_CHECK_EQUAL(TestButton_run(holdMs + TEST_GAP_MS), 8);
+
+    for (i = 1; i < 8; i++)
+    {
+        uint32_t expected_ms = i == 1 ? TEST_REPEAT_DELAY_MS : TEST_REPEAT_RATE_MS;
+        uint32_t gap_us = (uint32_t) (tapTimes[i] - tapTimes[i - 1]) / TEST_CYCLES_PER_US;
+
+        TEST_CHECK(gap_us >= expected_ms * 1000);
+        TEST_CHECK(gap_us <= expected_ms * 1000 + 1000);
+    }
+
+    // Turned off, a long hold is one tap again
+    Button_setAutoRepeat(&s1, 0, 0);
+    TestButton_bouncyTap(Sim_now() + SIM_CYCLES_PER_MS, holdMs);
+    TEST_CHECK_EQUAL(TestButton_run(holdMs + TEST_GAP_MS), 1);
+}
+
+/**
+ * Auto-repeat turned on while the button is held, as the B2 press which
+ * starts a round does, waits a whole delay before the first repeat.
+ */
+static void TestButton_autoRepeatWhileHeld()
+{
+    uint32_t holdMs = TEST_REPEAT_DELAY_MS;
+
+    TestButton_bouncyTap(Sim_now() + SIM_CYCLES_PER_MS, holdMs);
+    TEST_CHECK_EQUAL(TestButton_run(TEST_HOLD_MS), 1);
+
+    Button_setAutoRepeat(&s1, TEST_REPEAT_DELAY_MS, TEST_REPEAT_RATE_MS);
+    TEST_CHECK_EQUAL(TestButton_run(holdMs - TEST_HOLD_MS + TEST_GAP_MS), 0);
+
+    Button_setAutoRepeat(&s1, 0, 0);
+}
+
+/** Takes every event out of the queue, keeps the first max, and returns how many there were. */
+static int TestButton_pollAll(ButtonEvent* events_p, int max)
+{
+    ButtonEvent event;
+    int count = 0;
+
+    while (Button_pollEvent(&event))
+    {
+        if (count < max) {
+            events_p[count] = event;
+        }
+        count++;
+    }
+
+    return count;
+}
+
+/**
+ * Bouncy presses made while the main loop stalls come out of
+ * Button_pollEvent() as one press and one release each, in order, and each
+ * is stamped with the first raw edge of its chatter. Polling events does not
+ * take the taps away from Button_isTapped().
+ */
+static void TestButton_pollEvents()
+{
+    ButtonEvent events[8];
+    uint64_t edges[6];
+    uint64_t t = Sim_now() + SIM_CYCLES_PER_MS;
+    int i;
+
+    Button_setDebouncePolicy(&s1, DEBOUNCE_LEADING_EDGE, DEFAULT_LOCKOUT_TIME_MS);
+    TestButton_pollAll(events, 0);
+
+    for (i = 0; i < 3; i++)
+    {
+        edges[2 * i] = t;
+        edges[2 * i + 1] = t + TEST_HOLD_MS * SIM_CYCLES_PER_MS;
+        t = TestButton_bouncyTap(t, TEST_HOLD_MS) + TEST_GAP_MS * SIM_CYCLES_PER_MS;
+    }
+
+    Sim_advance(t - Sim_now());
+
+    TEST_CHECK_EQUAL(TestButton_pollAll(events, 8), 6);
+    for (i = 0; i < 6; i++)
+    {
+        TEST_CHECK_EQUAL(events[i].port, BOOSTERPACK_S1_PORT);
+        TEST_CHECK_EQUAL(events[i].pin, BOOSTERPACK_S1_PIN);
+        TEST_CHECK_EQUAL(events[i].pushState, (i & 1) ? RELEASED : PRESSED);
+        TEST_CHECK(!events[i].repeat);
+        TEST_CHECK(events[i].timestamp - (uint32_t) edges[i] <= TEST_ISR_US * TEST_CYCLES_PER_US);
+    }
+
+    TEST_CHECK_EQUAL(TestButton_pollAll(events, 0), 0);
+
+    // Button_isTapped() still reports the same presses, one per refresh
+    TEST_CHECK_EQUAL(TestButton_run(TEST_GAP_MS), 3);
+}
+
+/**
+ * The repeats of a held auto-repeat button are presses with repeat set,
+ * between the press and the release.
+ */
+static void TestButton_pollRepeats()
+{
+    uint32_t holdMs = TEST_REPEAT_DELAY_MS + 2 * TEST_REPEAT_RATE_MS + TEST_REPEAT_RATE_MS / 2;
+    ButtonEvent events[8];
+    int i;
+
+    Button_setAutoRepeat(&s1, TEST_REPEAT_DELAY_MS, TEST_REPEAT_RATE_MS);
+    TestButton_pollAll(events, 0);
+
+    TestButton_bouncyTap(Sim_now() + SIM_CYCLES_PER_MS, holdMs);
+    TEST_CHECK_EQUAL(TestButton_run(holdMs + TEST_GAP_MS), 4);
+
+    TEST_CHECK_EQUAL(TestButton_pollAll(events, 8), 5);
+    for (i = 0; i < 4; i++)
+    {
+        TEST_CHECK_EQUAL(events[i].pushState, PRESSED);
+        TEST_CHECK_EQUAL(events[i].repeat, i > 0);
+    }
+    TEST_CHECK_EQUAL(events[4].pushState, RELEASED);
+    TEST_CHECK(!events[4].repeat);
+
+    Button_setAutoRepeat(&s1, 0, 0);
+}
+
+int main()
+{
+    InitSystemTiming();
+
+    changeEvent.fire = TestButton_fireChange;
+    s1 = Button_constructInterrupt(BOOSTERPACK_S1_PORT, BOOSTERPACK_S1_PIN);
+    polled = Button_construct(BOOSTERPACK_S1_PORT, BOOSTERPACK_S1_PIN);
+
+    TEST_RUN(TestButton_cleanTaps);
+    TEST_RUN(TestButton_bounceDuringInterrupt);
+    TEST_RUN(TestButton_tapsDuringStall);
+    TEST_RUN(TestButton_leadingEdgeLatency);
+    TEST_RUN(TestButton_glitch);
+    TEST_RUN(TestButton_autoRepeat);
+    TEST_RUN(TestButton_autoRepeatWhileHeld);
+    TEST_RUN(TestButton_pollEvents);
+    TEST_RUN(TestButton_pollRepeats);
+
+    return Test_finish();
+}
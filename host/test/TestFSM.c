@@ -0,0 +1,140 @@
+/*
+ * TestFSM.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <test/Test.h>
+#include <sim/Sim.h>
+
+#include <App_GuessTheColor.h>
+
+static HAL hal;
+static App_GuessTheColor app;
+
+/**
+ * Delivers one event to the game, and checks that it lands in the expected
+ * state and that it was ignored exactly when no row of the table handles it.
+ * A transition to another state shows that state's screen exactly once, and
+ * no other screen; anything else shows no screen at all.
+ */
+static void TestFSM_expect(AppEvent event, GameState next, bool handled, int line)
+{
+    GameState previous = App_GuessTheColor_getState(&app);
+    uint32_t dispatched = FSM_getEventsDispatched(&app.fsm);
+    uint32_t ignored = FSM_getEventsIgnored(&app.fsm);
+    uint32_t shows[NUM_GAME_STATES];
+    int screen;
+
+    for (screen = 0; screen < NUM_GAME_STATES; screen++) {
+        shows[screen] = UI_getScreenStats(screen)->shows;
+    }
+
+    App_GuessTheColor_dispatch(&app, event);
+
+    Test_checkEqual(App_GuessTheColor_getState(&app), next, "state", "next", __FILE__, line);
+    Test_checkEqual(FSM_getEventsDispatched(&app.fsm) - dispatched, 1, "dispatched", "1", __FILE__, line);
+    Test_checkEqual(FSM_getEventsIgnored(&app.fsm) - ignored, !handled, "ignored", "!handled", __FILE__, line);
+
+    for (screen = 0; screen < NUM_GAME_STATES; screen++)
+    {
+        bool entered = handled && screen == next && next != previous;
+        Test_checkEqual(UI_getScreenStats(screen)->shows - shows[screen], entered,
+                        "shows", "entered", __FILE__, line);
+    }
+}
+
+#define TEST_EXPECT(event, next, handled)   TestFSM_expect(event, next, handled, __LINE__)
+
+/** The title screen only leaves on its timeout; every input is ignored. */
+static void TestFSM_titleScreen()
+{
+    TEST_CHECK_EQUAL(App_GuessTheColor_getState(&app), TITLE_SCREEN);
+    TEST_CHECK_EQUAL(UI_getScreenStats(TITLE_SCREEN)->shows, 1);
+
+    TEST_EXPECT(EVENT_S1_TAP, TITLE_SCREEN, false);
+    TEST_EXPECT(EVENT_S2_TAP, TITLE_SCREEN, false);
+    TEST_EXPECT(EVENT_JOYSTICK_UP, TITLE_SCREEN, false);
+    TEST_EXPECT(EVENT_JOYSTICK_DOWN, TITLE_SCREEN, false);
+    TEST_EXPECT(EVENT_TIMEOUT, INSTRUCTIONS_SCREEN, true);
+}
+
+/** The instructions wait for S2, and nothing else. */
+static void TestFSM_instructionsScreen()
+{
+    TEST_EXPECT(EVENT_TIMEOUT, INSTRUCTIONS_SCREEN, false);
+    TEST_EXPECT(EVENT_S1_TAP, INSTRUCTIONS_SCREEN, false);
+    TEST_EXPECT(EVENT_JOYSTICK_UP, INSTRUCTIONS_SCREEN, false);
+    TEST_EXPECT(EVENT_JOYSTICK_DOWN, INSTRUCTIONS_SCREEN, false);
+    TEST_EXPECT(EVENT_S2_TAP, GAME_SCREEN, true);
+}
+
+/**
+ * The game screen handles every input internally, except S1 on "End
+ * Guessing", and has no timeout. The guard of S1 picks between selecting a
+ * color and ending the round.
+ */
+static void TestFSM_gameScreen()
+{
+    TEST_CHECK_EQUAL(app.cursor, CURSOR_0);
+
+    TEST_EXPECT(EVENT_TIMEOUT, GAME_SCREEN, false);
+    TEST_EXPECT(EVENT_JOYSTICK_DOWN, GAME_SCREEN, true);
+    TEST_CHECK_EQUAL(app.cursor, CURSOR_1);
+    TEST_EXPECT(EVENT_JOYSTICK_UP, GAME_SCREEN, true);
+    TEST_CHECK_EQUAL(app.cursor, CURSOR_0);
+    TEST_EXPECT(EVENT_JOYSTICK_UP, GAME_SCREEN, true);
+    TEST_CHECK_EQUAL(app.cursor, CURSOR_3);
+    TEST_EXPECT(EVENT_S2_TAP, GAME_SCREEN, true);
+    TEST_CHECK_EQUAL(app.cursor, CURSOR_0);
+
+    // On a color, S1 selects it and stays
+    TEST_EXPECT(EVENT_S1_TAP, GAME_SCREEN, true);
+    TEST_CHECK(app.redSelected);
+
+    // On "End Guessing", S1 ends the round
+    TEST_EXPECT(EVENT_JOYSTICK_UP, GAME_SCREEN, true);
+    TEST_CHECK_EQUAL(app.cursor, CURSOR_3);
+    TEST_EXPECT(EVENT_S1_TAP, RESULT_SCREEN, true);
+}
+
+/** The result screen only leaves on its timeout, back to the instructions. */
+static void TestFSM_resultScreen()
+{
+    TEST_EXPECT(EVENT_S1_TAP, RESULT_SCREEN, false);
+    TEST_EXPECT(EVENT_S2_TAP, RESULT_SCREEN, false);
+    TEST_EXPECT(EVENT_JOYSTICK_UP, RESULT_SCREEN, false);
+    TEST_EXPECT(EVENT_JOYSTICK_DOWN, RESULT_SCREEN, false);
+    TEST_EXPECT(EVENT_TIMEOUT, INSTRUCTIONS_SCREEN, true);
+
+    // A second round starts with the cursor back at the top
+    TEST_EXPECT(EVENT_S2_TAP, GAME_SCREEN, true);
+    TEST_CHECK_EQUAL(app.cursor, CURSOR_0);
+    TEST_CHECK(!app.redSelected);
+}
+
+/** Every event in every state has been dispatched, and the ignored ones counted. */
+static void TestFSM_totals()
+{
+    TEST_CHECK_EQUAL(FSM_getEventsDispatched(&app.fsm), 5 + 5 + 8 + 6);
+    TEST_CHECK_EQUAL(FSM_getEventsIgnored(&app.fsm), 4 + 4 + 1 + 4);
+}
+
+int main()
+{
+    WDT_A_holdTimer();
+    InitSystemTiming();
+    Profiler_init();
+
+    hal = HAL_construct();
+    app = App_GuessTheColor_construct(&hal);
+    App_GuessTheColor_start(&app);
+
+    TEST_RUN(TestFSM_titleScreen);
+    TEST_RUN(TestFSM_instructionsScreen);
+    TEST_RUN(TestFSM_gameScreen);
+    TEST_RUN(TestFSM_resultScreen);
+    TEST_RUN(TestFSM_totals);
+
+    return Test_finish();
+}
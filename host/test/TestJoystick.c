@@ -0,0 +1,147 @@
+/*
+ * TestJoystick.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <test/Test.h>
+#include <sim/Sim.h>
+#include <sim/SimPeripherals.h>
+
+#include <HAL/Joystick.h>
+
+// Long enough for two whole DMA blocks, so the average holds only new samples
+#define TEST_SETTLE_MS      (2 * JOYSTICK_FRAMES_PER_BLOCK * 1000 / JOYSTICK_SAMPLE_RATE_HZ + 4)
+
+// The first deflections classified as pushed, and the last still held
+#define TEST_PRESS_HIGH     (JOYSTICK_CENTER + JOYSTICK_PRESS_THRESHOLD + 1)
+#define TEST_RELEASE_HIGH   (JOYSTICK_CENTER + JOYSTICK_RELEASE_THRESHOLD + 1)
+#define TEST_PRESS_LOW      (JOYSTICK_CENTER - JOYSTICK_PRESS_THRESHOLD - 1)
+#define TEST_RELEASE_LOW    (JOYSTICK_CENTER - JOYSTICK_RELEASE_THRESHOLD - 1)
+
+static Joystick joystick;
+
+/**
+ * Sweeps a value from one end to the other, threading the state through, and
+ * returns the value at which the classification first became expected.
+ */
+static int32_t TestJoystick_sweep(int32_t from, int32_t to, int8_t state, int8_t expected)
+{
+    int32_t step = from < to ? 1 : -1;
+    int32_t value;
+
+    for (value = from; value != to + step; value += step)
+    {
+        state = Joystick_classifyAxis((uint16_t) value, state);
+        if (state == expected) {
+            return value;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * Pushing out takes a deflection past the press threshold, and coming back
+ * takes one inside the release threshold, on both sides.
+ */
+static void TestJoystick_thresholds()
+{
+    TEST_CHECK_EQUAL(TestJoystick_sweep(JOYSTICK_CENTER, 16383, 0, 1), TEST_PRESS_HIGH);
+    TEST_CHECK_EQUAL(TestJoystick_sweep(16383, JOYSTICK_CENTER, 1, 0), TEST_RELEASE_HIGH - 1);
+    TEST_CHECK_EQUAL(TestJoystick_sweep(JOYSTICK_CENTER, 0, 0, -1), TEST_PRESS_LOW);
+    TEST_CHECK_EQUAL(TestJoystick_sweep(0, JOYSTICK_CENTER, -1, 0), TEST_RELEASE_LOW + 1);
+
+    // Inside the hysteresis band, the previous state is kept
+    TEST_CHECK_EQUAL(Joystick_classifyAxis(TEST_PRESS_HIGH - 1, 0), 0);
+    TEST_CHECK_EQUAL(Joystick_classifyAxis(TEST_PRESS_HIGH - 1, 1), 1);
+    TEST_CHECK_EQUAL(Joystick_classifyAxis(TEST_PRESS_LOW + 1, 0), 0);
+    TEST_CHECK_EQUAL(Joystick_classifyAxis(TEST_PRESS_LOW + 1, -1), -1);
+
+    // Swinging straight across takes the press threshold of the other side
+    TEST_CHECK_EQUAL(Joystick_classifyAxis(TEST_RELEASE_LOW, 1), 0);
+    TEST_CHECK_EQUAL(Joystick_classifyAxis(TEST_PRESS_LOW, 1), -1);
+    TEST_CHECK_EQUAL(Joystick_classifyAxis(0, 1), -1);
+    TEST_CHECK_EQUAL(Joystick_classifyAxis(16383, -1), 1);
+}
+
+/**
+ * An axis resting right at a threshold with noise as wide as the band
+ * changes state once, not on every sample.
+ */
+static void TestJoystick_noNoiseChatter()
+{
+    int8_t state = 0;
+    int changes = 0;
+    int i;
+
+    for (i = 0; i < 1000; i++)
+    {
+        int32_t noise = (i * 7919) % (JOYSTICK_PRESS_THRESHOLD - JOYSTICK_RELEASE_THRESHOLD) -
+                        (JOYSTICK_PRESS_THRESHOLD - JOYSTICK_RELEASE_THRESHOLD) / 2;
+        int8_t next = Joystick_classifyAxis(TEST_PRESS_HIGH + noise, state);
+
+        changes += next != state;
+        state = next;
+    }
+
+    TEST_CHECK_EQUAL(changes, 1);
+    TEST_CHECK_EQUAL(state, 1);
+}
+
+/** Holds the stick at a position until the DMA averages have caught up, and refreshes once. */
+static void TestJoystick_hold(uint16_t x, uint16_t y)
+{
+    SimADC_setResult(SIM_JOYSTICK_X_MEM, x);
+    SimADC_setResult(SIM_JOYSTICK_Y_MEM, y);
+    Sim_advance(TEST_SETTLE_MS * SIM_CYCLES_PER_MS);
+    Joystick_refresh(&joystick);
+}
+
+/**
+ * Through the ADC, DMA and block averages: each push is one tap in its
+ * direction, a push held inside the band stays pushed, and a diagonal keeps
+ * the axis which got there first.
+ */
+static void TestJoystick_directions()
+{
+    TestJoystick_hold(JOYSTICK_CENTER, 16383);
+    TEST_CHECK(Joystick_isTapped(&joystick, JOYSTICK_UP));
+
+    TestJoystick_hold(JOYSTICK_CENTER, TEST_RELEASE_HIGH);
+    TEST_CHECK_EQUAL(Joystick_getDirection(&joystick), JOYSTICK_UP);
+    TEST_CHECK(!Joystick_isTapped(&joystick, JOYSTICK_UP));
+
+    TestJoystick_hold(JOYSTICK_CENTER, TEST_RELEASE_HIGH - 1);
+    TEST_CHECK_EQUAL(Joystick_getDirection(&joystick), JOYSTICK_CENTERED);
+
+    TestJoystick_hold(0, JOYSTICK_CENTER);
+    TEST_CHECK(Joystick_isTapped(&joystick, JOYSTICK_LEFT));
+    TestJoystick_hold(JOYSTICK_CENTER, JOYSTICK_CENTER);
+
+    // Right first, then down as well: still right, with no second tap
+    TestJoystick_hold(16383, JOYSTICK_CENTER);
+    TEST_CHECK(Joystick_isTapped(&joystick, JOYSTICK_RIGHT));
+    TestJoystick_hold(16383, 0);
+    TEST_CHECK_EQUAL(Joystick_getDirection(&joystick), JOYSTICK_RIGHT);
+    TEST_CHECK(!Joystick_isTapped(&joystick, JOYSTICK_DOWN));
+
+    // Letting go of right leaves down, which is then a tap
+    TestJoystick_hold(JOYSTICK_CENTER, 0);
+    TEST_CHECK(Joystick_isTapped(&joystick, JOYSTICK_DOWN));
+    TestJoystick_hold(JOYSTICK_CENTER, JOYSTICK_CENTER);
+    TEST_CHECK_EQUAL(Joystick_getDirection(&joystick), JOYSTICK_CENTERED);
+}
+
+int main()
+{
+    InitSystemTiming();
+
+    joystick = Joystick_construct();
+
+    TEST_RUN(TestJoystick_thresholds);
+    TEST_RUN(TestJoystick_noNoiseChatter);
+    TEST_RUN(TestJoystick_directions);
+
+    return Test_finish();
+}
@@ -0,0 +1,241 @@
+/*
+ * TestKVStore.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <test/Test.h>
+#include <sim/Sim.h>
+#include <sim/SimPeripherals.h>
+
+#include <string.h>
+
+#include <HAL/KVStore.h>
+#include <HAL/Timer.h>
+
+// The key which fills the log, and the last value it was set to before the log was full
+#define TEST_FILL_KEY       3
+#define TEST_FILL_LAST      (KV_SLOTS_PER_SECTOR - 4)
+
+// The bytes a compaction of the four keys programs: one record each, then the header
+#define TEST_COMPACTION_BYTES   (4 * KV_RECORD_SIZE + sizeof(KVSectorHeader))
+
+// The flash with the active sector full, saved once and restored before each power cut
+static uint8_t fullFlash[SIM_FLASH_SIZE];
+
+/** Erases the whole simulated flash, as on a new board. */
+static void TestKVStore_eraseChip()
+{
+    memset(SimFlash_memory, 0xFF, SIM_FLASH_SIZE);
+}
+
+/** Restores the power and mounts the store again, as after a reset. */
+static void TestKVStore_reset()
+{
+    SimFlash_cutPowerAfter(-1);
+    KVStore_mount();
+}
+
+/** Runs KVStore_service() until it has nothing left to do, or a few times while the power is cut. */
+static void TestKVStore_serviceAll()
+{
+    int i;
+
+    for (i = 0; i < 8 && KVStore_service(); i++);
+}
+
+/** Returns whether keys 0 to 2 still hold the values TestKVStore_fill() gave them. */
+static bool TestKVStore_othersIntact()
+{
+    return KVStore_get(0) == 11 && KVStore_get(1) == 22 && KVStore_get(2) == 33;
+}
+
+/**
+ * Sets keys 0 to 2 once, then sets TEST_FILL_KEY until the active sector has
+ * no free slot left, and saves the flash in fullFlash.
+ */
+static void TestKVStore_fill()
+{
+    uint32_t i;
+
+    TestKVStore_eraseChip();
+    TestKVStore_reset();
+
+    KVStore_set(0, 11);
+    KVStore_set(1, 22);
+    KVStore_set(2, 33);
+    TestKVStore_serviceAll();
+
+    for (i = 0; i <= TEST_FILL_LAST; i++)
+    {
+        KVStore_set(TEST_FILL_KEY, i);
+        TestKVStore_serviceAll();
+    }
+
+    memcpy(fullFlash, SimFlash_memory, SIM_FLASH_SIZE);
+}
+
+/**
+ * The power fails after every possible number of bytes of a record. A torn
+ * record is skipped by the next mount, which keeps the value before it, and
+ * the log goes on after it.
+ */
+static void TestKVStore_tornRecord()
+{
+    int wrong = 0;
+    int torn = 0;
+    int cut;
+
+    for (cut = 0; cut <= KV_RECORD_SIZE; cut++)
+    {
+        TestKVStore_eraseChip();
+        TestKVStore_reset();
+
+        KVStore_set(0, 100);
+        KVStore_set(1, 7);
+        TestKVStore_serviceAll();
+
+        KVStore_set(0, 200);
+        SimFlash_cutPowerAfter(cut);
+        KVStore_service();
+        TestKVStore_reset();
+
+        wrong += KVStore_get(0) != (cut == KV_RECORD_SIZE ? 200 : 100);
+        wrong += KVStore_get(1) != 7;
+        torn += KVStore_getStats()->recordsTorn;
+
+        KVStore_set(0, 300);
+        TestKVStore_serviceAll();
+        TestKVStore_reset();
+
+        wrong += KVStore_get(0) != 300;
+    }
+
+    TEST_CHECK_EQUAL(wrong, 0);
+    TEST_CHECK_EQUAL(torn, KV_RECORD_SIZE - 1);
+}
+
+/**
+ * The power fails after every possible number of bytes of a compaction. Until
+ * the header of the new sector is complete, the next mount keeps the old
+ * sector and every value in it; after, it has the new values. Either way the
+ * next compaction succeeds.
+ */
+static void TestKVStore_tornCompaction()
+{
+    int wrong = 0;
+    int cut;
+
+    for (cut = 0; cut <= TEST_COMPACTION_BYTES; cut++)
+    {
+        memcpy(SimFlash_memory, fullFlash, SIM_FLASH_SIZE);
+        TestKVStore_reset();
+
+        uint32_t compactions = KVStore_getStats()->compactions;
+
+        KVStore_set(TEST_FILL_KEY, 1000);
+        SimFlash_cutPowerAfter(cut);
+        KVStore_service();
+
+        wrong += KVStore_getStats()->compactions != compactions + (cut == TEST_COMPACTION_BYTES);
+
+        TestKVStore_reset();
+
+        wrong += KVStore_get(TEST_FILL_KEY) != (cut == TEST_COMPACTION_BYTES ? 1000 : TEST_FILL_LAST);
+        wrong += !TestKVStore_othersIntact();
+
+        KVStore_set(TEST_FILL_KEY, 2000);
+        TestKVStore_serviceAll();
+        TestKVStore_reset();
+
+        wrong += KVStore_get(TEST_FILL_KEY) != 2000;
+        wrong += !TestKVStore_othersIntact();
+    }
+
+    TEST_CHECK_EQUAL(wrong, 0);
+}
+
+/**
+ * A reset between the generation and the magic of a header leaves a sector
+ * which is not formatted, both in a compaction and when formatting a new
+ * board. The mount ignores it, and the sector is erased before it is used.
+ */
+static void TestKVStore_generationWithoutMagic()
+{
+    const KVSectorHeader* spare_p = (const KVSectorHeader*) (SimFlash_memory + KV_SECTOR_SIZE);
+    const KVSectorHeader* first_p = (const KVSectorHeader*) SimFlash_memory;
+
+    // In a compaction, from sector 0 into sector 1
+    memcpy(SimFlash_memory, fullFlash, SIM_FLASH_SIZE);
+    TestKVStore_reset();
+
+    KVStore_set(TEST_FILL_KEY, 1000);
+    SimFlash_cutPowerAfter(4 * KV_RECORD_SIZE + sizeof(spare_p->generation));
+    KVStore_service();
+    TestKVStore_reset();
+
+    TEST_CHECK_EQUAL(spare_p->generation, first_p->generation + 1);
+    TEST_CHECK_EQUAL(spare_p->magic, 0xFFFFFFFF);
+    TEST_CHECK_EQUAL(KVStore_get(TEST_FILL_KEY), TEST_FILL_LAST);
+    TEST_CHECK(TestKVStore_othersIntact());
+
+    // On a new board, whose first mount formats sector 0
+    TestKVStore_eraseChip();
+    SimFlash_cutPowerAfter(sizeof(first_p->generation));
+    KVStore_mount();
+    TestKVStore_reset();
+
+    TEST_CHECK_EQUAL(first_p->magic, 0xFFFFFFFF);
+    TEST_CHECK_EQUAL(spare_p->magic, KV_SECTOR_MAGIC);
+
+    KVStore_set(0, 5);
+    TestKVStore_serviceAll();
+    TestKVStore_reset();
+
+    TEST_CHECK_EQUAL(KVStore_get(0), 5);
+    TEST_CHECK_EQUAL(first_p->generation, 0xFFFFFFFF);
+}
+
+/**
+ * A record which fails to program during a compaction, here on a bit stuck
+ * at zero, leaves its key dirty, so it reaches the new sector before the old
+ * one is erased.
+ */
+static void TestKVStore_compactionProgramFails()
+{
+    uint8_t* badSlot_p = SimFlash_memory + KV_SECTOR_SIZE + 2 * KV_RECORD_SIZE;
+
+    TestKVStore_fill();
+
+    uint32_t compactions = KVStore_getStats()->compactions;
+
+    // A new sector's second slot holds key 1
+    *badSlot_p = 0x00;
+
+    KVStore_set(TEST_FILL_KEY, 1000);
+    TEST_CHECK(KVStore_service());
+    TEST_CHECK_EQUAL(KVStore_getStats()->compactions, compactions + 1);
+    TEST_CHECK(KVStore_isDirty());
+
+    TestKVStore_serviceAll();
+    TEST_CHECK(!KVStore_isDirty());
+    TestKVStore_reset();
+
+    TEST_CHECK_EQUAL(KVStore_getStats()->recordsTorn, 1);
+    TEST_CHECK_EQUAL(KVStore_get(TEST_FILL_KEY), 1000);
+    TEST_CHECK(TestKVStore_othersIntact());
+}
+
+int main()
+{
+    InitSystemTiming();
+
+    TestKVStore_fill();
+
+    TEST_RUN(TestKVStore_tornRecord);
+    TEST_RUN(TestKVStore_tornCompaction);
+    TEST_RUN(TestKVStore_generationWithoutMagic);
+    TEST_RUN(TestKVStore_compactionProgramFails);
+
+    return Test_finish();
+}
@@ -0,0 +1,153 @@
+/*
+ * TestLEDGroup.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <test/Test.h>
+#include <sim/Sim.h>
+#include <sim/SimCost.h>
+#include <sim/SimPeripherals.h>
+
+#include <HAL/LEDGroup.h>
+
+// A pin of P2 outside the group, which the group must never touch
+#define TEST_OTHER_PIN      GPIO_PIN0
+
+static LEDGroup group;
+static int leds[4];
+
+/** The pins of the group, in the order they were added: two on P2, one on P5 and one on P1 */
+static const uint8_t ledPorts[4] = { GPIO_PORT_P2, GPIO_PORT_P2, GPIO_PORT_P5, GPIO_PORT_P1 };
+static const uint8_t ledPins[4] = { GPIO_PIN6, GPIO_PIN4, GPIO_PIN6, GPIO_PIN0 };
+
+/** Returns the output register a port should hold for a pattern, outside pins included. */
+static uint8_t TestLEDGroup_expected(uint8_t port, uint8_t pattern, uint8_t outside)
+{
+    uint8_t output = outside;
+    int i;
+
+    for (i = 0; i < 4; i++)
+    {
+        if (ledPorts[i] == port && (pattern & (1 << leds[i]))) {
+            output |= ledPins[i];
+        }
+    }
+
+    return output;
+}
+
+/** Returns how many ports have exactly one pin which differs between two patterns. */
+static int TestLEDGroup_singlePinPorts(uint8_t from, uint8_t to)
+{
+    static const uint8_t ports[3] = { GPIO_PORT_P1, GPIO_PORT_P2, GPIO_PORT_P5 };
+    int count = 0;
+    int i;
+
+    for (i = 0; i < 3; i++)
+    {
+        uint8_t changed = TestLEDGroup_expected(ports[i], from, 0) ^ TestLEDGroup_expected(ports[i], to, 0);
+        count += changed != 0 && (changed & (changed - 1)) == 0;
+    }
+
+    return count;
+}
+
+/**
+ * Every transition between two of the 16 patterns leaves exactly the group's
+ * pins of each port as the pattern says, and every other pin as it was, with
+ * the other pin of P2 flipped between transitions as an ISR might do.
+ */
+static void TestLEDGroup_everyTransition()
+{
+    int mismatches = 0;
+    int from, to;
+
+    for (from = 0; from < LED_GROUP_PATTERNS; from++)
+    {
+        for (to = 0; to < LED_GROUP_PATTERNS; to++)
+        {
+            uint8_t outside = (from + to) & 1 ? TEST_OTHER_PIN : 0;
+
+            LEDGroup_apply(&group, from);
+            if (outside) {
+                GPIO_setOutputHighOnPin(GPIO_PORT_P2, TEST_OTHER_PIN);
+            }
+            else {
+                GPIO_setOutputLowOnPin(GPIO_PORT_P2, TEST_OTHER_PIN);
+            }
+            LEDGroup_apply(&group, to);
+
+            mismatches += SimGPIO_getOutputs(GPIO_PORT_P1) != TestLEDGroup_expected(GPIO_PORT_P1, to, 0);
+            mismatches += SimGPIO_getOutputs(GPIO_PORT_P2) != TestLEDGroup_expected(GPIO_PORT_P2, to, outside);
+            mismatches += SimGPIO_getOutputs(GPIO_PORT_P5) != TestLEDGroup_expected(GPIO_PORT_P5, to, 0);
+            mismatches += LEDGroup_getPattern(&group) != to;
+        }
+    }
+
+    TEST_CHECK_EQUAL(mismatches, 0);
+}
+
+/**
+ * A port with one changed pin is written through the bit-band alias, which is
+ * the only store the simulation charges for, and a port with two changed pins
+ * through one read-modify-write of its output register.
+ */
+static void TestLEDGroup_writePaths()
+{
+    uint64_t bitband = SimCost_code(SimCost_get()->bitband);
+    uint8_t both = (1 << leds[0]) | (1 << leds[1]);
+    int wrong = 0;
+    int from, to;
+
+    // Only the two P2 pins change: one masked write, and no bit-band store
+    LEDGroup_apply(&group, 0);
+    uint64_t start = Sim_now();
+    LEDGroup_apply(&group, both);
+    TEST_CHECK_EQUAL(Sim_now() - start, 0);
+    TEST_CHECK_EQUAL(SimGPIO_getOutputs(GPIO_PORT_P2) & (GPIO_PIN6 | GPIO_PIN4), GPIO_PIN6 | GPIO_PIN4);
+
+    // Only one P2 pin changes: one bit-band store
+    start = Sim_now();
+    LEDGroup_apply(&group, 1 << leds[0]);
+    TEST_CHECK_EQUAL(Sim_now() - start, bitband);
+    TEST_CHECK_EQUAL(SimGPIO_getOutputs(GPIO_PORT_P2) & (GPIO_PIN6 | GPIO_PIN4), GPIO_PIN6);
+
+    // Every transition: one bit-band store per port with a single changed pin
+    for (from = 0; from < LED_GROUP_PATTERNS; from++)
+    {
+        for (to = 0; to < LED_GROUP_PATTERNS; to++)
+        {
+            LEDGroup_apply(&group, from);
+            start = Sim_now();
+            LEDGroup_apply(&group, to);
+            wrong += Sim_now() - start != TestLEDGroup_singlePinPorts(from, to) * bitband;
+        }
+    }
+
+    TEST_CHECK_EQUAL(wrong, 0);
+}
+
+/** A full group refuses a fifth LED. */
+static void TestLEDGroup_full()
+{
+    TEST_CHECK_EQUAL(LEDGroup_addLED(&group, GPIO_PORT_P6, GPIO_PIN1), -1);
+}
+
+int main()
+{
+    int i;
+
+    group = LEDGroup_construct();
+    GPIO_setAsOutputPin(GPIO_PORT_P2, TEST_OTHER_PIN);
+
+    for (i = 0; i < 4; i++) {
+        leds[i] = LEDGroup_addLED(&group, ledPorts[i], ledPins[i]);
+    }
+
+    TEST_RUN(TestLEDGroup_everyTransition);
+    TEST_RUN(TestLEDGroup_writePaths);
+    TEST_RUN(TestLEDGroup_full);
+
+    return Test_finish();
+}
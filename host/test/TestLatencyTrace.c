@@ -0,0 +1,96 @@
+/*
+ * TestLatencyTrace.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <test/Test.h>
+#include <sim/Sim.h>
+
+#include <HAL/LatencyTrace.h>
+
+#define TEST_CYCLES_PER_US  (SIM_CLOCK_HZ / 1000000)
+
+/** Returns the low 32 bits of the hardware timer, as the trace stamps use. */
+static uint32_t TestLatencyTrace_now()
+{
+    return (uint32_t) HWTimer_getCycles();
+}
+
+/**
+ * A second input arriving before the first one's event is dispatched is
+ * skipped, and the transition is charged to the first input.
+ */
+static void TestLatencyTrace_secondInputSkipped()
+{
+    const LatencyStats* stats_p = LatencyTrace_getStats(LATENCY_SELECT);
+
+    LatencyTrace_markInput(TestLatencyTrace_now());
+    Sim_advance(1000 * TEST_CYCLES_PER_US);
+    LatencyTrace_markInput(TestLatencyTrace_now());
+    Sim_advance(1000 * TEST_CYCLES_PER_US);
+
+    LatencyTrace_markTransition(LATENCY_SELECT);
+    LatencyTrace_complete();
+
+    TEST_CHECK_EQUAL(stats_p->count, 1);
+    TEST_CHECK_EQUAL(stats_p->max_us, 2000);
+    TEST_CHECK_EQUAL(LatencyTrace_getInputStats()->traced, 1);
+    TEST_CHECK_EQUAL(LatencyTrace_getInputStats()->skipped, 1);
+}
+
+/**
+ * An input whose dispatch caused no transition, or which posted no event at
+ * all, is dropped, and the next input is traced from its own edge.
+ */
+static void TestLatencyTrace_unmatchedInputDropped()
+{
+    const LatencyStats* stats_p = LatencyTrace_getStats(LATENCY_CURSOR_MOVE);
+
+    LatencyTrace_markInput(TestLatencyTrace_now());
+    LatencyTrace_complete();
+
+    LatencyTrace_markInput(TestLatencyTrace_now());
+    LatencyTrace_cancel();
+    TEST_CHECK_EQUAL(LatencyTrace_getInputStats()->dropped, 2);
+
+    Sim_advance(5000 * TEST_CYCLES_PER_US);
+    LatencyTrace_markInput(TestLatencyTrace_now());
+    Sim_advance(500 * TEST_CYCLES_PER_US);
+    LatencyTrace_markTransition(LATENCY_CURSOR_MOVE);
+    LatencyTrace_complete();
+
+    TEST_CHECK_EQUAL(stats_p->count, 1);
+    TEST_CHECK_EQUAL(stats_p->max_us, 500);
+    TEST_CHECK_EQUAL(LatencyTrace_getInputStats()->skipped, 0);
+}
+
+/** Once the input has caused a transition, cancelling it has no effect. */
+static void TestLatencyTrace_cancelAfterTransition()
+{
+    const LatencyStats* stats_p = LatencyTrace_getStats(LATENCY_END_GUESSING);
+
+    LatencyTrace_markInput(TestLatencyTrace_now());
+    LatencyTrace_markTransition(LATENCY_END_GUESSING);
+    LatencyTrace_cancel();
+    LatencyTrace_complete();
+
+    TEST_CHECK_EQUAL(stats_p->count, 1);
+    TEST_CHECK_EQUAL(LatencyTrace_getInputStats()->dropped, 0);
+}
+
+int main()
+{
+    InitSystemTiming();
+
+    LatencyTrace_reset();
+    TEST_RUN(TestLatencyTrace_secondInputSkipped);
+
+    LatencyTrace_reset();
+    TEST_RUN(TestLatencyTrace_unmatchedInputDropped);
+
+    LatencyTrace_reset();
+    TEST_RUN(TestLatencyTrace_cancelAfterTransition);
+
+    return Test_finish();
+}
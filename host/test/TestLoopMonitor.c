@@ -0,0 +1,73 @@
+/*
+ * TestLoopMonitor.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <test/Test.h>
+#include <sim/Sim.h>
+
+#include <HAL/LoopMonitor.h>
+
+#define TEST_BUDGET_US      5000
+#define TEST_CYCLES_PER_US  (SIM_CLOCK_HZ / 1000000)
+
+static LoopMonitor monitor;
+
+/** Marked passes are recorded under the tag of their start, skipped ones are not. */
+static void TestLoopMonitor_skipIsNotRecorded()
+{
+    monitor = LoopMonitor_construct(TEST_BUDGET_US);
+
+    Sim_advance(1000 * TEST_CYCLES_PER_US);
+    LoopMonitor_mark(&monitor, 1);
+
+    // A long sleep, then a short pass
+    Sim_advance(400000 * TEST_CYCLES_PER_US);
+    LoopMonitor_skip(&monitor, 2);
+    Sim_advance(300 * TEST_CYCLES_PER_US);
+    LoopMonitor_mark(&monitor, 2);
+
+    TEST_CHECK_EQUAL(LoopMonitor_getStats(&monitor, 0)->iterations, 1);
+    TEST_CHECK_EQUAL(LoopMonitor_getStats(&monitor, 0)->max_us, 1000);
+    TEST_CHECK_EQUAL(LoopMonitor_getStats(&monitor, 1)->iterations, 0);
+    TEST_CHECK_EQUAL(LoopMonitor_getStats(&monitor, 2)->iterations, 1);
+    TEST_CHECK_EQUAL(LoopMonitor_getStats(&monitor, 2)->max_us, 300);
+    TEST_CHECK_EQUAL(LoopMonitor_getOverBudgetCount(&monitor), 0);
+
+    Sim_advance(6000 * TEST_CYCLES_PER_US);
+    LoopMonitor_mark(&monitor, 2);
+    TEST_CHECK_EQUAL(LoopMonitor_getOverBudgetCount(&monitor), 1);
+}
+
+/**
+ * An armed watchdog survives passes as long as a full-screen redraw and
+ * sleeps between them. The simulated watchdog ends the run if it expires.
+ */
+static void TestLoopMonitor_watchdogOutlastsRedraws()
+{
+    int i;
+
+    LoopMonitor_armWatchdog(&monitor);
+
+    for (i = 0; i < 20; i++)
+    {
+        Sim_advance(250 * SIM_CYCLES_PER_MS);
+        LoopMonitor_mark(&monitor, 0);
+        Sim_advance(1000 * SIM_CYCLES_PER_MS);
+        LoopMonitor_skip(&monitor, 0);
+    }
+
+    TEST_CHECK_EQUAL(LoopMonitor_getStats(&monitor, 0)->max_us, 250000);
+    WDT_A_holdTimer();
+}
+
+int main()
+{
+    InitSystemTiming();
+
+    TEST_RUN(TestLoopMonitor_skipIsNotRecorded);
+    TEST_RUN(TestLoopMonitor_watchdogOutlastsRedraws);
+
+    return Test_finish();
+}
@@ -0,0 +1,140 @@
+/*
+ * TestPortSampler.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <test/Test.h>
+#include <sim/Sim.h>
+#include <sim/SimPeripherals.h>
+
+#include <HAL/Button.h>
+
+// S2 is on P3, so the CH2 / DMA_INT1 channel samples it
+#define TEST_CHANNEL        (DMA_CH2_TIMERA1CCR0 & 0x0F)
+#define TEST_INTERRUPT      INT_DMA_INT1
+#define TEST_HALF_SIZE      (PORT_SAMPLE_BUFFER_SIZE / 2)
+
+// A press every TEST_PERIOD_MS lasting TEST_HOLD_MS. 150 ms does not divide
+// 256 ms, so presses keep landing across the switch between the halves.
+#define TEST_PERIOD_MS      150
+#define TEST_HOLD_MS        60
+#define TEST_RUN_MS         (14 * TEST_PERIOD_MS)
+
+static Button s2;
+
+/** Holds S2 down or lets it go. */
+static void TestPortSampler_press(bool pressed)
+{
+    SimGPIO_setInputs(BOOSTERPACK_S2_PORT, BOOSTERPACK_S2_PIN, !pressed);
+}
+
+/** Returns whether the channel is writing into the alternate half. */
+static bool TestPortSampler_alternateActive()
+{
+    return (DMA_getChannelAttribute(TEST_CHANNEL) & UDMA_ATTR_ALTSELECT) != 0;
+}
+
+/**
+ * Runs the input task once per millisecond for some time while pressing S2
+ * every TEST_PERIOD_MS, and returns the number of taps it reported. The
+ * number of presses made is added to presses_p, and the number of times the
+ * channel switched halves to switches_p.
+ */
+static int TestPortSampler_run(uint32_t ms, int* presses_p, int* switches_p)
+{
+    bool alternate = TestPortSampler_alternateActive();
+    int taps = 0;
+    uint32_t i;
+
+    for (i = 0; i < ms; i++)
+    {
+        if (i % TEST_PERIOD_MS == 0) {
+            TestPortSampler_press(true);
+            (*presses_p)++;
+        }
+        else if (i % TEST_PERIOD_MS == TEST_HOLD_MS) {
+            TestPortSampler_press(false);
+        }
+
+        Sim_advance(SIM_CYCLES_PER_MS);
+        PortSampler_process();
+        Button_refresh(&s2);
+        taps += Button_isTapped(&s2);
+
+        if (TestPortSampler_alternateActive() != alternate) {
+            alternate = !alternate;
+            (*switches_p)++;
+        }
+    }
+
+    TestPortSampler_press(false);
+
+    return taps;
+}
+
+/**
+ * The two halves take turns: one DMA interrupt and one switch of ALTSELECT
+ * every 256 samples, with every press straddling a switch still one tap
+ * and nothing lost while the task keeps up.
+ */
+static void TestPortSampler_bufferSwitching()
+{
+    uint32_t interrupts = Sim_getStats()->interrupts[TEST_INTERRUPT];
+    uint32_t overruns = PortSampler_getOverruns();
+    int presses = 0;
+    int switches = 0;
+
+    // Four whole buffers, ending on a whole number of press periods
+    int taps = TestPortSampler_run(TEST_RUN_MS, &presses, &switches);
+
+    TEST_CHECK_EQUAL(taps, presses);
+    TEST_CHECK_EQUAL(presses, TEST_RUN_MS / TEST_PERIOD_MS);
+    TEST_CHECK_EQUAL(Sim_getStats()->interrupts[TEST_INTERRUPT] - interrupts, switches);
+    TEST_CHECK(switches >= TEST_RUN_MS / TEST_HALF_SIZE);
+    TEST_CHECK_EQUAL(PortSampler_getOverruns(), overruns);
+}
+
+/**
+ * A stall longer than the whole buffer loses exactly the samples which were
+ * overwritten, on both channels, and a press in the samples which were kept
+ * is still reported.
+ */
+static void TestPortSampler_overrun()
+{
+    uint32_t overruns = PortSampler_getOverruns();
+    uint32_t interrupts = Sim_getStats()->interrupts[TEST_INTERRUPT];
+    uint32_t stallMs = PORT_SAMPLE_BUFFER_SIZE + 188;
+
+    // The press lands in the last 512 samples, and so survives the stall
+    Sim_advance(300 * SIM_CYCLES_PER_MS);
+    TestPortSampler_press(true);
+    Sim_advance(TEST_HOLD_MS * SIM_CYCLES_PER_MS);
+    TestPortSampler_press(false);
+    Sim_advance((stallMs - 300 - TEST_HOLD_MS) * SIM_CYCLES_PER_MS);
+
+    PortSampler_process();
+    Button_refresh(&s2);
+
+    TEST_CHECK_EQUAL(PortSampler_getOverruns() - overruns, 2 * 188);
+    TEST_CHECK(Button_isTapped(&s2));
+    TEST_CHECK(Sim_getStats()->interrupts[TEST_INTERRUPT] - interrupts >= stallMs / TEST_HALF_SIZE);
+
+    // Once caught up, nothing more is lost
+    Sim_advance(SIM_CYCLES_PER_MS);
+    PortSampler_process();
+    TEST_CHECK_EQUAL(PortSampler_getOverruns() - overruns, 2 * 188);
+}
+
+int main()
+{
+    InitSystemTiming();
+
+    TestPortSampler_press(false);
+    s2 = Button_constructDMASampled(BOOSTERPACK_S2_PORT, BOOSTERPACK_S2_PIN);
+
+    TEST_RUN(TestPortSampler_bufferSwitching);
+    TEST_RUN(TestPortSampler_overrun);
+
+    return Test_finish();
+}
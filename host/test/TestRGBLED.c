@@ -0,0 +1,56 @@
+/*
+ * TestRGBLED.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <test/Test.h>
+#include <sim/Sim.h>
+
+#include <HAL/RGBLED.h>
+
+static RGBLED rgbLED;
+
+/**
+ * For every component on every channel, the channel is lit exactly when the
+ * compare register written for it is above zero, so the PWM output is high
+ * for part of each period.
+ */
+static void TestRGBLED_litMatchesDuty()
+{
+    int component;
+    int mismatches = 0;
+
+    for (component = 0; component < 256; component++)
+    {
+        RGBLED_setColor(&rgbLED, RGB_COLOR(component, component, component));
+
+        mismatches += RGBLED_isLit(&rgbLED, RGB_RED) != (RGBLED_RED_TIMER->CCR[RGBLED_RED_CCR] != 0);
+        mismatches += RGBLED_isLit(&rgbLED, RGB_GREEN) != (RGBLED_GREEN_TIMER->CCR[RGBLED_GREEN_CCR] != 0);
+        mismatches += RGBLED_isLit(&rgbLED, RGB_BLUE) != (RGBLED_BLUE_TIMER->CCR[RGBLED_BLUE_CCR] != 0);
+    }
+
+    TEST_CHECK_EQUAL(mismatches, 0);
+}
+
+/** The dimmest components round to a duty cycle of zero and are dark. */
+static void TestRGBLED_dimComponentsDark()
+{
+    RGBLED_setColor(&rgbLED, RGB_COLOR(7, 0, 8));
+
+    TEST_CHECK_EQUAL(RGBLED_gamma(7), 0);
+    TEST_CHECK(!RGBLED_isLit(&rgbLED, RGB_RED));
+    TEST_CHECK(!RGBLED_isLit(&rgbLED, RGB_GREEN));
+    TEST_CHECK(RGBLED_isLit(&rgbLED, RGB_BLUE));
+    TEST_CHECK_EQUAL(RGBLED_getColor(&rgbLED), RGB_COLOR(7, 0, 8));
+}
+
+int main()
+{
+    rgbLED = RGBLED_construct();
+
+    TEST_RUN(TestRGBLED_litMatchesDuty);
+    TEST_RUN(TestRGBLED_dimComponentsDark);
+
+    return Test_finish();
+}
@@ -0,0 +1,104 @@
+/*
+ * TestRandom.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <test/Test.h>
+
+#include <HAL/Random.h>
+
+// Draws per bucket in the chi-square checks
+#define TEST_DRAWS_PER_BUCKET   10000
+
+/**
+ * The first ten outputs of xoshiro128** from the state {1, 2, 3, 4}, as given
+ * by the reference implementation (and checked by the rand_xoshiro crate).
+ */
+static const uint32_t referenceOutputs[10] =
+{
+    11520, 0, 5927040, 70819200, 2031721883,
+    1637235492, 1287239034, 3734860849u, 3729100597u, 4258142804u
+};
+
+/** Returns a generator in a known state, bypassing the entropy pool. */
+static Random TestRandom_seeded(uint32_t s0, uint32_t s1, uint32_t s2, uint32_t s3)
+{
+    Random random;
+
+    random.state[0] = s0;
+    random.state[1] = s1;
+    random.state[2] = s2;
+    random.state[3] = s3;
+
+    return random;
+}
+
+/** Random_next() matches the reference xoshiro128** output, bit for bit. */
+static void TestRandom_referenceVectors()
+{
+    Random random = TestRandom_seeded(1, 2, 3, 4);
+    int mismatches = 0;
+    int i;
+
+    for (i = 0; i < 10; i++) {
+        mismatches += Random_next(&random) != referenceOutputs[i];
+    }
+
+    TEST_CHECK_EQUAL(mismatches, 0);
+}
+
+/**
+ * Draws TEST_DRAWS_PER_BUCKET numbers per value below bound and returns the
+ * chi-square statistic of the counts against a uniform distribution.
+ */
+static double TestRandom_chiSquare(Random* random_p, uint32_t bound)
+{
+    uint32_t counts[16] = { 0 };
+    uint32_t draws = bound * TEST_DRAWS_PER_BUCKET;
+    double statistic = 0;
+    uint32_t i;
+
+    for (i = 0; i < draws; i++)
+    {
+        uint32_t value = Random_below(random_p, bound);
+
+        if (value >= bound) {
+            return -1;
+        }
+        counts[value]++;
+    }
+
+    for (i = 0; i < bound; i++)
+    {
+        double difference = (double) counts[i] - TEST_DRAWS_PER_BUCKET;
+        statistic += difference * difference / TEST_DRAWS_PER_BUCKET;
+    }
+
+    return statistic;
+}
+
+/**
+ * Random_below() is uniform, for the bound the game draws colors with and for
+ * a power of two, at the 0.1% significance level: the critical values of the
+ * chi-square distribution are 22.458 with 6 degrees of freedom and 24.322
+ * with 7. The seeds are fixed, so the test never fails by chance.
+ */
+static void TestRandom_belowUniform()
+{
+    Random random = TestRandom_seeded(0x9E3779B9, 0x243F6A88, 0xB7E15162, 0x01234567);
+
+    double colors = TestRandom_chiSquare(&random, 7);
+    double power = TestRandom_chiSquare(&random, 8);
+
+    TEST_CHECK(colors >= 0 && colors < 22.458);
+    TEST_CHECK(power >= 0 && power < 24.322);
+}
+
+int main()
+{
+    TEST_RUN(TestRandom_referenceVectors);
+    TEST_RUN(TestRandom_belowUniform);
+
+    return Test_finish();
+}
@@ -0,0 +1,168 @@
+/*
+ * TestSim.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <test/Test.h>
+#include <sim/Sim.h>
+
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+#include <HAL/Timer.h>
+
+#define TEST_EVENTS     4
+
+static SimEvent events[TEST_EVENTS];
+static uint64_t firedAt[TEST_EVENTS];
+static int firingOrder[TEST_EVENTS];
+static int numFired;
+
+/** Records which event fired, and when. */
+static void TestSim_record(int event)
+{
+    firedAt[event] = Sim_now();
+    firingOrder[numFired++] = event;
+}
+
+static void TestSim_fire0() { TestSim_record(0); }
+static void TestSim_fire1() { TestSim_record(1); }
+static void TestSim_fire2() { TestSim_record(2); }
+static void TestSim_fire3() { TestSim_record(3); }
+
+/** Arms every test event fresh. */
+static void TestSim_arm(const uint64_t* offsets)
+{
+    static void (*const fires[TEST_EVENTS])(void) = { TestSim_fire0, TestSim_fire1, TestSim_fire2, TestSim_fire3 };
+    uint64_t start = Sim_now();
+    int i;
+
+    numFired = 0;
+    for (i = 0; i < TEST_EVENTS; i++)
+    {
+        events[i].fire = fires[i];
+        Sim_schedule(&events[i], start + offsets[i]);
+    }
+}
+
+/** Events fire in time order, ties in arming order, each with the clock at its time. */
+static void TestSim_eventOrder()
+{
+    static const uint64_t offsets[TEST_EVENTS] = { 300, 100, 300, 200 };
+    uint64_t start = Sim_now();
+
+    TestSim_arm(offsets);
+    Sim_advance(1000);
+
+    TEST_CHECK_EQUAL(numFired, 4);
+    TEST_CHECK_EQUAL(firingOrder[0], 1);
+    TEST_CHECK_EQUAL(firingOrder[1], 3);
+    TEST_CHECK_EQUAL(firingOrder[2], 0);
+    TEST_CHECK_EQUAL(firingOrder[3], 2);
+    TEST_CHECK_EQUAL(firedAt[1] - start, 100);
+    TEST_CHECK_EQUAL(firedAt[2] - start, 300);
+    TEST_CHECK_EQUAL(Sim_now() - start, 1000);
+}
+
+/** A cancelled or re-armed event fires once, at its last arming. */
+static void TestSim_cancelAndRearm()
+{
+    static const uint64_t offsets[TEST_EVENTS] = { 100, 200, 300, 400 };
+    uint64_t start = Sim_now();
+
+    TestSim_arm(offsets);
+    Sim_cancel(&events[0]);
+    Sim_cancel(&events[0]);
+    Sim_schedule(&events[3], start + 50);
+    Sim_advance(1000);
+
+    TEST_CHECK_EQUAL(numFired, 3);
+    TEST_CHECK_EQUAL(firingOrder[0], 3);
+    TEST_CHECK_EQUAL(firedAt[3] - start, 50);
+}
+
+/** Sleeping jumps the clock to the next event, and counts as sleep. */
+static void TestSim_sleep()
+{
+    static const uint64_t offsets[TEST_EVENTS] = { 5000, 7000, 9000, 11000 };
+    uint64_t start = Sim_now();
+    uint64_t slept = Sim_getStats()->sleepCycles;
+
+    TestSim_arm(offsets);
+    Sim_sleep();
+
+    TEST_CHECK_EQUAL(numFired, 1);
+    TEST_CHECK_EQUAL(Sim_now() - start, 5000);
+    TEST_CHECK_EQUAL(Sim_getStats()->sleepCycles - slept, 5000);
+
+    Sim_advance(10000);
+    TEST_CHECK_EQUAL(numFired, 4);
+}
+
+/** A pending interrupt waits while interrupts are masked, and runs once unmasked. */
+static void TestSim_maskedInterrupt()
+{
+    uint32_t before = Sim_getStats()->interrupts[SIM_SYSTICK];
+
+    Interrupt_disableMaster();
+    Sim_raise(SIM_SYSTICK);
+    Sim_advance(100);
+    TEST_CHECK_EQUAL(Sim_getStats()->interrupts[SIM_SYSTICK], before);
+
+    Interrupt_enableMaster();
+    TEST_CHECK_EQUAL(Sim_getStats()->interrupts[SIM_SYSTICK], before + 1);
+}
+
+/**
+ * With SysTick running and no input for a while, sleeping skips the idle
+ * ticks up to the one before a noted deadline, wakes up for every tick until
+ * the deadline is two ticks old, and then skips again.
+ */
+static void TestSim_skipIdleTicks()
+{
+    static const int owner = 0;
+    uint64_t period = SIM_CYCLES_PER_MS;
+    int wrong = 0;
+
+    SysTick_setPeriod(period);
+    SysTick_enableModule();
+    SysTick_enableInterrupt();
+
+    // Well past the settling time of the last input action
+    Sim_advance(100 * period);
+
+    uint64_t deadline = Sim_now() + 20 * period;
+    uint32_t skipped = Sim_getStats()->ticksSkipped;
+    HWTimer_noteDeadline(&owner, HWTimer_getCycles() + 20 * period, 0);
+
+    Sim_sleep();
+    TEST_CHECK(Sim_now() < deadline);
+    TEST_CHECK(Sim_now() + 3 * period > deadline);
+    TEST_CHECK(Sim_getStats()->ticksSkipped - skipped >= 17);
+
+    while (Sim_now() < deadline + 2 * period)
+    {
+        uint64_t start = Sim_now();
+
+        Sim_sleep();
+        wrong += Sim_now() - start != period;
+    }
+
+    TEST_CHECK_EQUAL(wrong, 0);
+
+    uint64_t start = Sim_now();
+    Sim_sleep();
+    TEST_CHECK(Sim_now() - start > period);
+
+    SysTick_disableModule();
+}
+
+int main()
+{
+    TEST_RUN(TestSim_eventOrder);
+    TEST_RUN(TestSim_cancelAndRearm);
+    TEST_RUN(TestSim_sleep);
+    TEST_RUN(TestSim_maskedInterrupt);
+    TEST_RUN(TestSim_skipIdleTicks);
+
+    return Test_finish();
+}
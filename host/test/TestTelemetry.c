@@ -0,0 +1,168 @@
+/*
+ * TestTelemetry.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <test/Test.h>
+#include <sim/Sim.h>
+#include <sim/SimPeripherals.h>
+
+#include <string.h>
+
+#include <HAL/Telemetry.h>
+
+// Records offered, one every TEST_SEND_CYCLES for 200 ms: about 600 KB/s, far more than
+// either rate carries, and long enough for several transfers of a full ring at 115200
+#define TEST_RECORDS            10000
+#define TEST_SEND_CYCLES        (20 * (SIM_CLOCK_HZ / 1000000))
+#define TEST_RECORD_TYPE        0x7F
+
+// The largest record sent: its index and a full 32-bit padding field
+#define TEST_MAX_RECORD_SIZE    (TELEMETRY_OVERHEAD + 2 + 5)
+
+// How long the ring gets to drain, in steps of 10 us
+#define TEST_DRAIN_STEP         (10 * (SIM_CLOCK_HZ / 1000000))
+#define TEST_DRAIN_STEPS        100000
+
+// Everything the UART sent since the flood started
+static uint8_t wire[32768];
+static uint32_t wireLength;
+
+/** Collects the bytes the UART sends, in the order they leave the wire. */
+static void TestTelemetry_receive(const uint8_t* bytes, uint32_t count)
+{
+    if (count > sizeof(wire) - wireLength) {
+        count = sizeof(wire) - wireLength;
+    }
+
+    memcpy(&wire[wireLength], bytes, count);
+    wireLength += count;
+}
+
+/** Returns the first varint of a payload. */
+static uint32_t TestTelemetry_firstVarint(const uint8_t* payload)
+{
+    uint32_t value = 0;
+    int shift = 0;
+
+    do {
+        value |= (uint32_t) (*payload & 0x7F) << shift;
+        shift += 7;
+    } while (*payload++ & 0x80);
+
+    return value;
+}
+
+/**
+ * Offers TEST_RECORDS numbered records much faster than the link carries
+ * them, lets the ring drain, and decodes what reached the wire. Every record
+ * which arrived is intact, its sequence is its number modulo 256, and the
+ * numbers missing are exactly the records counted as dropped. The ring fills
+ * up to within a record of its size, and the UART never idles while it holds
+ * bytes, so the wire carries the full baud rate.
+ *
+ * @param baudRate: TELEMETRY_BAUD_115200 or TELEMETRY_BAUD_1M
+ */
+static void TestTelemetry_flood(uint32_t baudRate)
+{
+    const TelemetryStats* stats_p = Telemetry_getStats();
+    uint32_t refused = 0;
+    uint32_t received = 0;
+    uint32_t missing = 0;
+    uint32_t nextIndex = 0;
+    int corrupt = 0;
+    int discontinuous = 0;
+    uint32_t i;
+
+    Telemetry_init(baudRate);
+    wireLength = 0;
+
+    uint64_t start = Sim_now();
+
+    for (i = 0; i < TEST_RECORDS; i++)
+    {
+        TelemetryRecord record;
+
+        Telemetry_begin(&record, TEST_RECORD_TYPE);
+        Telemetry_putVarint(&record, i);
+        Telemetry_putVarint(&record, 0xFFFFFFFF);
+
+        refused += !Telemetry_send(&record);
+        Sim_advance(TEST_SEND_CYCLES);
+    }
+
+    for (i = 0; i < TEST_DRAIN_STEPS && Telemetry_getFill() != 0; i++) {
+        Sim_advance(TEST_DRAIN_STEP);
+    }
+
+    uint64_t elapsed = Sim_now() - start;
+    uint32_t at = 0;
+
+    while (at < wireLength)
+    {
+        if (wire[at] != TELEMETRY_SYNC || at + 4 > wireLength || at + 4 + wire[at + 2] > wireLength)
+        {
+            corrupt++;
+            break;
+        }
+
+        uint8_t length = wire[at + 2];
+        uint8_t checksum = 0;
+        uint32_t j;
+
+        for (j = at + 1; j < at + 3 + length; j++) {
+            checksum += wire[j];
+        }
+        corrupt += checksum != wire[at + 3 + length];
+
+        uint32_t index = TestTelemetry_firstVarint(&wire[at + 4]);
+
+        discontinuous += index < nextIndex || wire[at + 3] != (index & 0xFF);
+        missing += index - nextIndex;
+        nextIndex = index + 1;
+        received++;
+
+        at += 4 + length;
+    }
+    missing += TEST_RECORDS - nextIndex;
+
+    TEST_CHECK_EQUAL(corrupt, 0);
+    TEST_CHECK_EQUAL(discontinuous, 0);
+    TEST_CHECK(stats_p->recordsDropped > 0);
+    TEST_CHECK_EQUAL(stats_p->recordsSent + stats_p->recordsDropped, TEST_RECORDS);
+    TEST_CHECK_EQUAL(refused, stats_p->recordsDropped);
+    TEST_CHECK_EQUAL(missing, stats_p->recordsDropped);
+    TEST_CHECK_EQUAL(received, stats_p->recordsSent);
+    TEST_CHECK_EQUAL(wireLength, stats_p->bytesSent);
+
+    TEST_CHECK(stats_p->maxFill <= TELEMETRY_BUFFER_SIZE);
+    TEST_CHECK(stats_p->maxFill > TELEMETRY_BUFFER_SIZE - TEST_MAX_RECORD_SIZE);
+
+    // 10 bits per byte; the 115200 divider runs 0.16% fast
+    uint64_t capacity = elapsed * baudRate / (10ULL * SIM_CLOCK_HZ);
+
+    TEST_CHECK(wireLength * 100ULL >= capacity * 98 && wireLength * 100ULL <= capacity * 101);
+}
+
+/** At 115200 baud, the link carries about 11.5 KB/s. */
+static void TestTelemetry_flood115200()
+{
+    TestTelemetry_flood(TELEMETRY_BAUD_115200);
+}
+
+/** At 1 Mbaud, the link carries 100 KB/s. */
+static void TestTelemetry_flood1M()
+{
+    TestTelemetry_flood(TELEMETRY_BAUD_1M);
+}
+
+int main()
+{
+    SimUART_setListener(TestTelemetry_receive);
+
+    TEST_RUN(TestTelemetry_flood115200);
+    TEST_RUN(TestTelemetry_flood1M);
+
+    return Test_finish();
+}
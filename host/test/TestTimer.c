@@ -0,0 +1,96 @@
+/*
+ * TestTimer.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <test/Test.h>
+#include <sim/Sim.h>
+
+#include <HAL/Timer.h>
+
+// One whole period of TIMER32_0_BASE
+#define TEST_PERIOD     ((uint64_t) LOADVALUE + 1)
+
+static uint64_t startCycle;
+
+/** Cycles since InitSystemTiming(), as the simulation counts them. */
+static uint64_t TestTimer_expected()
+{
+    return Sim_now() - startCycle;
+}
+
+/** The count follows the clock across rollovers whose ISR runs at once. */
+static void TestTimer_rolloverWithInterrupts()
+{
+    Sim_advance(TEST_PERIOD - 1000);
+    TEST_CHECK_EQUAL(HWTimer_getCycles(), TestTimer_expected());
+
+    Sim_advance(2000);
+    TEST_CHECK_EQUAL(HWTimer_getCycles(), TestTimer_expected());
+
+    Sim_advance(3 * TEST_PERIOD);
+    TEST_CHECK_EQUAL(HWTimer_getCycles(), TestTimer_expected());
+}
+
+/**
+ * With interrupts masked, as in an ISR or a critical section, the rollover
+ * ISR cannot run. The count must still move on, and must not jump once the
+ * ISR does run.
+ */
+static void TestTimer_rolloverWhileMasked()
+{
+    uint64_t toNextRollover = TEST_PERIOD - TestTimer_expected() % TEST_PERIOD;
+    uint64_t before;
+
+    Interrupt_disableMaster();
+
+    Sim_advance(toNextRollover - 10);
+    before = HWTimer_getCycles();
+    TEST_CHECK_EQUAL(before, TestTimer_expected());
+
+    // Exactly on the rollover, the counter has just reloaded
+    Sim_advance(10);
+    TEST_CHECK_EQUAL(HWTimer_getCycles(), TestTimer_expected());
+
+    Sim_advance(10);
+    TEST_CHECK_EQUAL(HWTimer_getCycles(), TestTimer_expected());
+    TEST_CHECK(HWTimer_getCycles() > before);
+
+    Interrupt_enableMaster();
+    TEST_CHECK_EQUAL(HWTimer_getCycles(), TestTimer_expected());
+}
+
+/** An SWTimer started with interrupts masked still expires on time. */
+static void TestTimer_swTimerWhileMasked()
+{
+    SWTimer timer = SWTimer_construct(10);
+    uint64_t toNextRollover = TEST_PERIOD - TestTimer_expected() % TEST_PERIOD;
+
+    Sim_advance(toNextRollover - 5 * SIM_CYCLES_PER_MS);
+    Interrupt_disableMaster();
+    SWTimer_start(&timer);
+
+    Sim_advance(9 * SIM_CYCLES_PER_MS);
+    TEST_CHECK(!SWTimer_expired(&timer));
+
+    Sim_advance(2 * SIM_CYCLES_PER_MS);
+    TEST_CHECK(SWTimer_expired(&timer));
+
+    Interrupt_enableMaster();
+    TEST_CHECK(SWTimer_expired(&timer));
+}
+
+int main()
+{
+    // Run on the simulated TIMER32_0_BASE rather than on the virtual clock
+    HWTimer_setClock(NULL);
+    startCycle = Sim_now();
+    InitSystemTiming();
+
+    TEST_RUN(TestTimer_rolloverWithInterrupts);
+    TEST_RUN(TestTimer_rolloverWhileMasked);
+    TEST_RUN(TestTimer_swTimerWhileMasked);
+
+    return Test_finish();
+}
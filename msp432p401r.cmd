@@ -44,7 +44,9 @@
 
 MEMORY
 {
-    MAIN       (RX) : origin = 0x00000000, length = 0x00040000
+    /* The last two sectors of bank 1 (0x0003E000 - 0x0003FFFF) are left out */
+    /* of MAIN: they hold the KVStore log. See HAL/KVStore.h.                */
+    MAIN       (RX) : origin = 0x00000000, length = 0x0003E000
     INFO       (RX) : origin = 0x00200000, length = 0x00004000
 #ifdef  __TI_COMPILER_VERSION__
 #if     __TI_COMPILER_VERSION__ >= 15009000
@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+"""
+mkframes.py
+
+Converts 128x128 screens into RLE-compressed RGB565 frames, and writes them
+out as a C file for GFX_showFrame().
+
+The screens are binary PPMs (P6). Every host build renders the static
+widgets of the instructions and game screens with the grlib of its SDK, the
+same grlib the firmware compiles, and runs this script on them. A frame
+therefore matches what GFX_print() draws pixel for pixel, and
+"make -C host golden" checks that it still does. The frames are never
+committed; "make -C host frames" copies them to frames.c for the firmware.
+
+Usage:
+    make -C host SDK=... frames
+    python3 tools/mkframes.py --ppm instructionsFrame=instructions.ppm -o frames.c
+
+The output format is described next to GFXFrame in HAL/Graphics.h.
+
+Created on: Oct 18, 2026
+"""
+
+import argparse
+import re
+import sys
+
+WIDTH = 128
+HEIGHT = 128
+
+MAX_RUN = 128   # GFX_FRAME_MAX_RUN
+
+
+def readPPM(path):
+    """Reads a binary PPM and converts it to RGB565."""
+    with open(path, "rb") as f:
+        data = f.read()
+
+    tokens = re.match(rb"P6\s+(?:#[^\n]*\n\s*)*(\d+)\s+(\d+)\s+(\d+)\s", data)
+    if tokens is None:
+        sys.exit("%s: not a binary PPM" % path)
+
+    width, height = int(tokens.group(1)), int(tokens.group(2))
+    if (width, height) != (WIDTH, HEIGHT):
+        sys.exit("%s: must be %dx%d" % (path, WIDTH, HEIGHT))
+
+    body = data[tokens.end():]
+    pixels = []
+    for y in range(height):
+        row = []
+        for x in range(width):
+            r, g, b = body[(y * width + x) * 3:(y * width + x) * 3 + 3]
+            row.append(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3))
+        pixels.append(row)
+    return pixels
+
+
+def compress(pixels):
+    """RLE-compresses pixels in panel order, as decoded by GFX_showFrame()."""
+    flat = [p for row in pixels for p in row]
+    out = bytearray()
+    literals = []
+
+    def flushLiterals():
+        while literals:
+            chunk = literals[:MAX_RUN]
+            del literals[:MAX_RUN]
+            out.append(len(chunk) - 1)
+            for p in chunk:
+                out.extend((p >> 8, p & 0xFF))
+
+    i = 0
+    while i < len(flat):
+        run = 1
+        while i + run < len(flat) and flat[i + run] == flat[i] and run < MAX_RUN:
+            run += 1
+
+        # A run of two costs as much as two literals, so only longer runs pay
+        if run >= 3:
+            flushLiterals()
+            out.append(0x80 | (run - 1))
+            out.extend((flat[i] >> 8, flat[i] & 0xFF))
+        else:
+            literals.extend(flat[i:i + run])
+        i += run
+
+    flushLiterals()
+    return bytes(out)
+
+
+def emit(frames, out):
+    out.write("/*\n * frames.c\n *\n * Generated by the host build with tools/mkframes.py. DO NOT EDIT.\n */\n\n")
+    out.write("#include <HAL/Graphics.h>\n")
+
+    for name, data in frames:
+        out.write("\n// %d pixels in %d bytes\n" % (WIDTH * HEIGHT, len(data)))
+        out.write("static const uint8_t %sData[%d] =\n{\n" % (name, len(data)))
+        for i in range(0, len(data), 16):
+            out.write("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",\n")
+        out.write("};\n\n")
+        out.write("const GFXFrame %s =\n{\n    0, 0, %d, %d, sizeof(%sData), %sData\n};\n"
+                  % (name, WIDTH, HEIGHT, name, name))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[1])
+    parser.add_argument("--ppm", action="append", default=[], metavar="NAME=FILE",
+                        help="convert a 128x128 PPM into a frame called NAME")
+    parser.add_argument("-o", "--output", default="frames.c")
+    args = parser.parse_args()
+
+    frames = []
+
+    for spec in args.ppm:
+        name, _, path = spec.partition("=")
+        frames.append((name, compress(readPPM(path))))
+
+    if not frames:
+        parser.error("nothing to do: give at least one --ppm")
+
+    with open(args.output, "w") as out:
+        emit(frames, out)
+
+    for name, data in frames:
+        print("%-20s %6d bytes (%.1f%% of raw)" % (name, len(data), 100.0 * len(data) / (WIDTH * HEIGHT * 2)))
+
+
+if __name__ == "__main__":
+    main()
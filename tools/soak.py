@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+"""
+soak.py
+
+Plays thousands of complete GuessTheColor sessions on the host build, and
+checks every one of them through the telemetry stream.
+
+Usage:
+    make -C host SDK=...
+    python3 tools/soak.py                           # 2000 sessions
+    python3 tools/soak.py --sessions 20000 --jobs 8 --seed 7
+
+Each run of host/build/guess-the-color gets a script of --per-run sessions:
+wait out the title screen, start a round with S2, move the cursor and select
+colors at random with S2, S1 and the joystick, then move to "End Guessing",
+press S1 and wait out the result screen. Runs go --jobs at a time. The
+simulation runs on virtual time, so a session of several simulated seconds
+takes milliseconds of one core, and sessions/s scales with --jobs.
+
+A run passes if its telemetry shows every round it was given, every guess
+on the color the script put the cursor on, no record lost or corrupted, and
+no event dropped or ignored by the FSM. The input latency lines of the
+simulation report are gathered across runs.
+
+Created on: Oct 18, 2026
+"""
+
+import argparse
+import os
+import random
+import re
+import subprocess
+import sys
+import tempfile
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from telemetry import Decoder
+
+BINARY = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "host", "build", "guess-the-color")
+
+# As in App_GuessTheColor.h
+TITLE_SCREEN_WAIT = 3000
+RESULT_SCREEN_WAIT = 3000
+NUM_TEST_OPTIONS = 4
+END_GUESSING = 3
+
+TELEMETRY_GUESS = 3
+TELEMETRY_RESULT = 4
+TELEMETRY_HEALTH = 5
+
+# Milliseconds to leave after a screen change, which takes up to ~210 ms to
+# draw, and between two inputs
+SETTLE_MS = 400
+MIN_GAP_MS = 250
+MAX_GAP_MS = 600
+MAX_MOVES = 6
+
+LATENCY = re.compile(r"latency: (.+?)\s+(\d+) inputs, p50 (\d+) us, p99 (\d+) us, max (\d+) us")
+
+
+def plan(rng, sessions):
+    """Returns the script of a run, and the colors guessed in each session."""
+    steps = []
+    guesses = []
+    t = TITLE_SCREEN_WAIT + SETTLE_MS
+
+    for _ in range(sessions):
+        steps.append("%d:S2" % t)
+        t += SETTLE_MS
+        cursor = 0
+        guessed = []
+
+        for _ in range(rng.randint(0, MAX_MOVES)):
+            name = rng.choice(("S2", "down", "up", "S1"))
+            if name == "S1" and cursor == END_GUESSING:
+                name = "down"
+
+            if name == "up":
+                cursor = (cursor + NUM_TEST_OPTIONS - 1) % NUM_TEST_OPTIONS
+            elif name != "S1":
+                cursor = (cursor + 1) % NUM_TEST_OPTIONS
+            else:
+                guessed.append(cursor)
+
+            steps.append("%d:%s" % (t, name))
+            t += rng.randint(MIN_GAP_MS, MAX_GAP_MS)
+
+        while cursor != END_GUESSING:
+            steps.append("%d:down" % t)
+            cursor = (cursor + 1) % NUM_TEST_OPTIONS
+            t += rng.randint(MIN_GAP_MS, MAX_GAP_MS)
+
+        steps.append("%d:S1" % t)
+        t += RESULT_SCREEN_WAIT + SETTLE_MS + SETTLE_MS
+        guesses.append(guessed)
+
+    return " ".join(steps), guesses, t
+
+
+def run(binary, seed, sessions):
+    """Plays one run, and returns (sessions played, simulated ms, failures, latency lines)."""
+    rng = random.Random(seed)
+    script, guesses, end = plan(rng, sessions)
+    failures = []
+
+    with tempfile.TemporaryDirectory() as directory:
+        scriptPath = os.path.join(directory, "input")
+        uartPath = os.path.join(directory, "uart")
+
+        with open(scriptPath, "w") as stream:
+            stream.write(script)
+
+        env = dict(os.environ, SIM_INPUT="@" + scriptPath, SIM_UART=uartPath, SIM_RUN_MS=str(end))
+        env.pop("SIM_QUIET", None)
+        env.pop("SIM_FLASH", None)
+        process = subprocess.run([binary], env=env, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE,
+                                 universal_newlines=True)
+
+        if process.returncode != 0:
+            failures.append("seed %d: exited with %d" % (seed, process.returncode))
+
+        with open(uartPath, "rb") as stream:
+            data = stream.read()
+
+    decoder = Decoder()
+    played = []
+    current = []
+
+    for recordType, sequence, fields in decoder.feed(data):
+        if recordType == TELEMETRY_GUESS:
+            current.append(fields[0])
+        elif recordType == TELEMETRY_RESULT:
+            played.append(current)
+            current = []
+        elif recordType == TELEMETRY_HEALTH and (fields[0] or fields[2] or fields[3]):
+            failures.append("seed %d: session %d: %d events dropped, %d ignored, %d records dropped" %
+                            (seed, len(played), fields[0], fields[2], fields[3]))
+
+    if decoder.lost or decoder.corrupt:
+        failures.append("seed %d: %d records lost, %d corrupt" % (seed, decoder.lost, decoder.corrupt))
+
+    if len(played) != len(guesses):
+        failures.append("seed %d: %d of %d sessions played" % (seed, len(played), len(guesses)))
+
+    for session, (expected, actual) in enumerate(zip(guesses, played)):
+        if expected != actual:
+            failures.append("seed %d: session %d guessed %s, expected %s" % (seed, session, actual, expected))
+            break
+
+    latencies = [match.groups() for match in LATENCY.finditer(process.stderr)]
+
+    return len(played), end, failures, latencies
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[1])
+    parser.add_argument("--sessions", type=int, default=2000, help="sessions to play (default 2000)")
+    parser.add_argument("--per-run", type=int, default=200, help="sessions in each run (default 200)")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count() or 1, help="runs at a time")
+    parser.add_argument("--seed", type=int, default=1, help="seed of the first run; each run adds one")
+    parser.add_argument("--binary", default=BINARY, help="the host build (default %(default)s)")
+    args = parser.parse_args()
+
+    counts = [args.per_run] * (args.sessions // args.per_run)
+    if args.sessions % args.per_run:
+        counts.append(args.sessions % args.per_run)
+
+    start = time.time()
+    with ThreadPoolExecutor(args.jobs) as executor:
+        results = list(executor.map(lambda job: run(args.binary, args.seed + job[0], job[1]), enumerate(counts)))
+    seconds = time.time() - start
+
+    played = sum(result[0] for result in results)
+    simulated = sum(result[1] for result in results) / 1000.0
+    failures = [failure for result in results for failure in result[2]]
+
+    print("%d sessions in %d runs: %.1f s simulated in %.2f s, %.0f sessions/s" %
+          (played, len(counts), simulated, seconds, played / seconds if seconds else 0))
+
+    # Percentiles cannot be merged across runs, so the worst run is shown
+    types = {}
+    for result in results:
+        for name, count, p50, p99, worst in result[3]:
+            total, worstP50, worstP99, maximum = types.get(name, (0, 0, 0, 0))
+            types[name] = (total + int(count), max(worstP50, int(p50)), max(worstP99, int(p99)),
+                           max(maximum, int(worst)))
+
+    for name, (total, p50, p99, maximum) in sorted(types.items()):
+        print("latency: %-14s %7d inputs, worst run p50 %u us, p99 %u us, max %u us" %
+              (name, total, p50, p99, maximum))
+
+    for failure in failures:
+        print("FAILED " + failure)
+
+    sys.exit(1 if failures else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,328 @@
+#!/usr/bin/env python3
+"""
+spitrace.py
+
+Analyzes a trace of the bytes GuessTheColor sent to the LCD, to find waste
+in the display path.
+
+Usage:
+    python3 tools/spitrace.py trace.bin                 # from SIM_SPI_TRACE of the host build
+    python3 tools/spitrace.py --telemetry capture.bin   # from the telemetry stream
+    python3 tools/spitrace.py --gap-ms 5 --verbose trace.bin
+
+A trace from the host build is a sequence of six-byte entries: the cycle
+stamp and the value of an SpiTraceEntry, both little-endian. In a telemetry
+capture, the bytes come in TELEMETRY_SPI_TRACE records as laid out by
+SpiTrace_send() in HAL/SpiTrace.c.
+
+The bytes are replayed into a model of the ST7735's window and address
+logic, and split into bursts wherever the bus was idle for longer than
+--gap-ms. A burst is one screen transition or update. For each burst, and
+in total, the report gives:
+
+  - bytes on the wire, and how many of them set up windows
+  - redundant window setups: CASET or RASET which repeat the current
+    window, and windows which were replaced before any pixel went in
+  - overdraw: pixels written more than once in the same burst, and pixels
+    rewritten with the value they already had
+  - idle time between bytes, beyond the time a byte takes on the bus,
+    split into setup (around commands) and pixel streaming
+
+Created on: Oct 18, 2026
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+DATA = 0x100            # SPI_TRACE_DATA
+
+CASET = 0x2A
+RASET = 0x2B
+RAMWR = 0x2C
+MADCTL = 0x36
+
+MADCTL_MY = 0x80
+MADCTL_MX = 0x40
+MADCTL_MV = 0x20
+
+GRAM_SIZE = 132
+
+CLOCK_HZ = 48000000
+BYTE_CYCLES = 24        # 8 bits at the 16 MHz LCD_SPI_CLOCK_SPEED
+
+TELEMETRY_SPI_TRACE = 6
+
+# Upper bounds of the idle gap histogram, in cycles
+GAP_BUCKETS = (0, 8, 32, 128, 512, 2048, 8192)
+
+
+def read_file(path):
+    """Yields (cycles, value) from a host trace file."""
+    with open(path, "rb") as stream:
+        data = stream.read()
+
+    for offset in range(0, len(data) - len(data) % 6, 6):
+        yield struct.unpack_from("<IH", data, offset)
+
+
+def read_telemetry(path):
+    """Yields (cycles, value) from a telemetry capture; None marks a discontinuity."""
+    sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+    from telemetry import Decoder
+
+    decoder = Decoder()
+    lost = 0
+
+    with open(path, "rb") as stream:
+        data = stream.read()
+
+    for recordType, sequence, fields in decoder.feed(data):
+        if recordType != TELEMETRY_SPI_TRACE or len(fields) < 3:
+            continue
+
+        # Bytes overwritten on the device, or records lost on the link
+        if fields[0] != 0 or decoder.lost != lost:
+            lost = decoder.lost
+            yield None
+
+        cycles = fields[1]
+        yield cycles, fields[2]
+
+        for i in range(3, len(fields) - 1, 2):
+            cycles = (cycles + fields[i]) & 0xFFFFFFFF
+            yield cycles, fields[i + 1]
+
+
+class Burst:
+    """What happened on the bus between two idle periods."""
+
+    def __init__(self, start):
+        self.start = start
+        self.end = start
+        self.bytes = 0
+        self.commandBytes = 0
+        self.setupBytes = 0         # CASET, RASET, RAMWR and their parameters
+        self.windows = 0
+        self.redundantWindows = 0   # CASET or RASET which changed nothing
+        self.unusedWindows = 0      # Windows replaced before any pixel went in
+        self.pixels = 0
+        self.overdrawn = 0          # Pixels written again in the same burst
+        self.unchanged = 0          # Pixels rewritten with the value they had
+        self.setupIdle = 0
+        self.pixelIdle = 0
+        self.gaps = [0] * (len(GAP_BUCKETS) + 1)
+        self.written = set()
+
+    def add(self, other):
+        for name in ("bytes", "commandBytes", "setupBytes", "windows", "redundantWindows",
+                     "unusedWindows", "pixels", "overdrawn", "unchanged", "setupIdle", "pixelIdle"):
+            setattr(self, name, getattr(self, name) + getattr(other, name))
+        self.gaps = [a + b for a, b in zip(self.gaps, other.gaps)]
+
+
+class Controller:
+    """Follows the window and address logic of the ST7735, as in host/sim/ST7735Model.c."""
+
+    def __init__(self):
+        self.gram = {}
+        self.command = None
+        self.params = []
+        self.madctl = 0
+        self.window = [0, GRAM_SIZE - 1, 0, GRAM_SIZE - 1]   # colStart, colEnd, rowStart, rowEnd
+        self.col = 0
+        self.row = 0
+        self.high = None
+        self.windowUsed = True
+
+    def address(self):
+        x, y = (self.row, self.col) if self.madctl & MADCTL_MV else (self.col, self.row)
+        if self.madctl & MADCTL_MX:
+            x = GRAM_SIZE - 1 - x
+        if self.madctl & MADCTL_MY:
+            y = GRAM_SIZE - 1 - y
+        return x, y
+
+    def feed(self, value, burst):
+        """Takes one byte, and charges what it does to the burst."""
+        burst.bytes += 1
+
+        if not value & DATA:
+            burst.commandBytes += 1
+            self.command = value
+            self.params = []
+            self.high = None
+
+            if value in (CASET, RASET, RAMWR):
+                burst.setupBytes += 1
+            if value == RAMWR:
+                self.col, self.row = self.window[0], self.window[2]
+            return
+
+        byte = value & 0xFF
+
+        if self.command == RAMWR:
+            if self.high is None:
+                self.high = byte
+                return
+
+            self.pixel((self.high << 8) | byte, burst)
+            self.high = None
+
+        elif self.command in (CASET, RASET):
+            burst.setupBytes += 1
+            self.params.append(byte)
+
+            if len(self.params) == 4:
+                start = (self.params[0] << 8) | self.params[1]
+                end = (self.params[2] << 8) | self.params[3]
+                at = 0 if self.command == CASET else 2
+
+                if self.window[at:at + 2] == [start, end]:
+                    burst.redundantWindows += 1
+                self.window[at:at + 2] = [start, end]
+
+                # A window is complete with its RASET, as the driver sends CASET first
+                if self.command == RASET:
+                    burst.windows += 1
+                    if not self.windowUsed:
+                        burst.unusedWindows += 1
+                    self.windowUsed = False
+
+        elif self.command == MADCTL and not self.params:
+            self.params.append(byte)
+            self.madctl = byte
+
+    def pixel(self, value, burst):
+        address = self.address()
+
+        burst.pixels += 1
+        if address in burst.written:
+            burst.overdrawn += 1
+        burst.written.add(address)
+
+        if self.gram.get(address) == value:
+            burst.unchanged += 1
+        self.gram[address] = value
+        self.windowUsed = True
+
+        colStart, colEnd, rowStart, rowEnd = self.window
+        self.col += 1
+        if self.col > colEnd:
+            self.col = colStart
+            self.row += 1
+            if self.row > rowEnd:
+                self.row = rowStart
+
+
+def analyze(entries, gapCycles, byteCycles):
+    """Replays the entries, and returns the list of bursts."""
+    controller = Controller()
+    bursts = []
+    burst = None
+    last = None
+    lastWasSetup = False
+
+    for entry in entries:
+        if entry is None:
+            # Unknown bytes were lost: start over with an unknown window
+            controller = Controller()
+            burst = None
+            last = None
+            continue
+
+        cycles, value = entry
+        delta = (cycles - last) & 0xFFFFFFFF if last is not None else None
+
+        if burst is None or delta >= gapCycles:
+            burst = Burst(cycles)
+            bursts.append(burst)
+        elif delta is not None:
+            idle = max(0, delta - byteCycles)
+            isSetup = lastWasSetup or not value & DATA or controller.command != RAMWR
+
+            if isSetup:
+                burst.setupIdle += idle
+            else:
+                burst.pixelIdle += idle
+
+            bucket = 0
+            while bucket < len(GAP_BUCKETS) and idle > GAP_BUCKETS[bucket]:
+                bucket += 1
+            burst.gaps[bucket] += 1
+
+        controller.feed(value, burst)
+        burst.end = cycles + byteCycles
+        lastWasSetup = not value & DATA or controller.command != RAMWR
+        last = cycles
+
+    return bursts
+
+
+def ms(cycles):
+    return 1000.0 * cycles / CLOCK_HZ
+
+
+def percent(part, whole):
+    return 100.0 * part / whole if whole else 0.0
+
+
+def report(bursts, byteCycles, verbose):
+    total = Burst(0)
+
+    print("%4s %10s %8s %8s %7s %6s %6s %8s %8s %8s %9s %9s" %
+          ("#", "start ms", "ms", "bytes", "setup", "win", "redund", "pixels", "overdraw",
+           "unchanged", "setup idle", "pixel idle"))
+
+    for index, burst in enumerate(bursts):
+        total.add(burst)
+
+        if verbose or len(bursts) <= 50:
+            print("%4d %10.3f %8.3f %8d %7d %6d %6d %8d %8d %8d %8.3fms %8.3fms" %
+                  (index, ms(burst.start), ms(burst.end - burst.start), burst.bytes, burst.setupBytes,
+                   burst.windows, burst.redundantWindows + burst.unusedWindows, burst.pixels,
+                   burst.overdrawn, burst.unchanged, ms(burst.setupIdle), ms(burst.pixelIdle)))
+
+    busy = total.bytes * byteCycles
+    idle = total.setupIdle + total.pixelIdle
+
+    print()
+    print("%d bursts, %d bytes (%d commands), %.3f ms on the bus" %
+          (len(bursts), total.bytes, total.commandBytes, ms(busy)))
+    print("bytes per burst: %.0f on average" % (total.bytes / len(bursts) if bursts else 0))
+    print("window setup: %d bytes (%.1f%%) for %d windows" %
+          (total.setupBytes, percent(total.setupBytes, total.bytes), total.windows))
+    print("redundant windows: %d CASET/RASET repeating the window, %d windows never written" %
+          (total.redundantWindows, total.unusedWindows))
+    print("pixels: %d written, %d overdrawn within a burst (%.1f%%), %d unchanged (%.1f%%)" %
+          (total.pixels, total.overdrawn, percent(total.overdrawn, total.pixels),
+           total.unchanged, percent(total.unchanged, total.pixels)))
+    print("idle between bytes: %.3f ms (%.1f%% of burst time), %.3f ms around setup, %.3f ms between pixels" %
+          (ms(idle), percent(idle, idle + busy), ms(total.setupIdle), ms(total.pixelIdle)))
+
+    labels = ["0"] + ["<=%d" % bound for bound in GAP_BUCKETS[1:]] + [">%d" % GAP_BUCKETS[-1]]
+    print("idle gap histogram (cycles beyond %d per byte):" % byteCycles)
+    for label, count in zip(labels, total.gaps):
+        print("  %6s %9d" % (label, count))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[1])
+    parser.add_argument("trace", help="trace file from SIM_SPI_TRACE, or a telemetry capture")
+    parser.add_argument("--telemetry", action="store_true", help="the trace is a telemetry capture")
+    parser.add_argument("--gap-ms", type=float, default=10.0,
+                        help="idle time which ends a burst (default 10 ms)")
+    parser.add_argument("--byte-cycles", type=int, default=BYTE_CYCLES,
+                        help="cycles a byte takes on the bus (default %d)" % BYTE_CYCLES)
+    parser.add_argument("--verbose", action="store_true", help="list every burst, however many")
+    args = parser.parse_args()
+
+    entries = read_telemetry(args.trace) if args.telemetry else read_file(args.trace)
+    bursts = analyze(entries, int(args.gap_ms * CLOCK_HZ / 1000), args.byte_cycles)
+
+    report(bursts, args.byte_cycles, args.verbose)
+
+
+if __name__ == "__main__":
+    main()
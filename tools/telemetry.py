@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+"""
+telemetry.py
+
+Decodes the binary telemetry stream of GuessTheColor, from the launchpad's
+backchannel UART or from a capture of it.
+
+Usage:
+    python3 tools/telemetry.py /dev/ttyACM0                 # live, 115200 baud
+    python3 tools/telemetry.py --baud 1000000 /dev/ttyACM0  # live, TELEMETRY_BAUD_1M
+    python3 tools/telemetry.py --check capture.bin          # decode a file, fail on any loss
+
+A record is framed as described in HAL/Telemetry.h:
+
+    0xA5 | type | length | sequence | payload (length - 1 bytes) | checksum
+
+and its payload is a list of unsigned LEB128 varints. The field names below
+must be kept in step with TelemetryType in App_GuessTheColor.h.
+
+On exit, a summary counts the records lost to full rings on the device (gaps
+in the sequence) or to the link (bad checksums), and compares the measured
+byte rate with what the UART can carry at each supported baud rate.
+
+Live decoding needs pyserial.
+
+Created on: Oct 18, 2026
+"""
+
+import argparse
+import sys
+import time
+
+SYNC = 0xA5
+
+# 8 data bits, plus a start and a stop bit
+BITS_PER_BYTE = 10
+
+BAUD_RATES = (115200, 1000000)
+
+RECORD_TYPES = {
+    1: ("boot", ("rounds", "wins", "losses")),
+    2: ("round_start", ("round", "target")),
+    3: ("guess", ("color", "elapsed_ms")),
+    4: ("result", ("match", "selected", "target", "duration_ms")),
+    5: ("health", ("events_dropped", "max_queue_depth", "events_ignored",
+                   "records_dropped", "max_ring_fill", "events_per_second")),
+    6: ("spi_trace", ("overwritten", "cycles", "value")),   # then delta/value pairs; see spitrace.py
+}
+
+
+def varints(data):
+    """Splits a payload into its unsigned LEB128 fields."""
+    values = []
+    value = 0
+    shift = 0
+
+    for byte in data:
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            values.append(value)
+            value = 0
+            shift = 0
+
+    return values
+
+
+class Decoder:
+    """Finds records in a byte stream, resynchronizing on errors."""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.lastSequence = None
+        self.records = 0
+        self.bytes = 0
+        self.lost = 0           # Records missing from the sequence
+        self.corrupt = 0        # Records with a bad checksum
+        self.skipped = 0        # Bytes thrown away while looking for a sync byte
+
+    def feed(self, data):
+        """Adds bytes, and yields every complete record as (type, sequence, fields)."""
+        self.buffer.extend(data)
+
+        while True:
+            start = self.buffer.find(SYNC)
+            if start < 0:
+                self.skipped += len(self.buffer)
+                self.buffer.clear()
+                return
+
+            if start > 0:
+                self.skipped += start
+                del self.buffer[:start]
+
+            if len(self.buffer) < 3:
+                return
+
+            length = self.buffer[2]
+            size = length + 4
+            if len(self.buffer) < size:
+                return
+
+            record = self.buffer[:size]
+            if length == 0 or sum(record[1:-1]) & 0xFF != record[-1]:
+                # Not a record after all: drop the sync byte and look again
+                self.corrupt += 1
+                self.skipped += 1
+                del self.buffer[:1]
+                continue
+
+            del self.buffer[:size]
+
+            sequence = record[3]
+            if self.lastSequence is not None:
+                self.lost += (sequence - self.lastSequence - 1) & 0xFF
+            self.lastSequence = sequence
+
+            self.records += 1
+            self.bytes += size
+
+            yield record[1], sequence, varints(record[4:-1])
+
+
+def describe(recordType, sequence, fields):
+    name, fieldNames = RECORD_TYPES.get(recordType, ("type%d" % recordType, ()))
+    parts = []
+
+    for i, value in enumerate(fields):
+        label = fieldNames[i] if i < len(fieldNames) else "field%d" % i
+        parts.append("%s=%d" % (label, value))
+
+    return "%3d %-12s %s" % (sequence, name, " ".join(parts))
+
+
+def summarize(decoder, seconds):
+    print("\n%d records, %d bytes in %.1f s" % (decoder.records, decoder.bytes, seconds), file=sys.stderr)
+    print("lost %d, corrupt %d, %d bytes skipped" % (decoder.lost, decoder.corrupt, decoder.skipped),
+          file=sys.stderr)
+
+    if seconds > 0:
+        rate = decoder.bytes / seconds
+        for baud in BAUD_RATES:
+            capacity = baud / BITS_PER_BYTE
+            print("%7d baud: %.1f B/s of %.0f B/s (%.2f%%)" % (baud, rate, capacity, 100.0 * rate / capacity),
+                  file=sys.stderr)
+
+
+def open_source(path, baud):
+    """Returns a function which reads the next chunk of bytes, or b"" at the end."""
+    if path == "-":
+        return lambda: sys.stdin.buffer.read1(4096)
+
+    try:
+        import serial
+        port = serial.Serial(path, baud, timeout=0.1)
+        return lambda: port.read(4096)
+    except (ImportError, ValueError, OSError):
+        pass
+
+    stream = open(path, "rb")
+    return lambda: stream.read(4096)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[1])
+    parser.add_argument("source", help="serial port, capture file, or - for stdin")
+    parser.add_argument("--baud", type=int, default=115200, choices=BAUD_RATES)
+    parser.add_argument("--check", action="store_true",
+                        help="exit with an error if any record was lost or corrupted")
+    args = parser.parse_args()
+
+    read = open_source(args.source, args.baud)
+    decoder = Decoder()
+    first = None
+    last = None
+
+    try:
+        while True:
+            chunk = read()
+            if not chunk and not args.source.startswith("/dev/"):
+                break
+
+            for recordType, sequence, fields in decoder.feed(chunk):
+                now = time.time()
+                first = first or now
+                last = now
+                print(describe(recordType, sequence, fields))
+                sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+
+    # A capture has no timing, so its rate is only meaningful for live streams
+    summarize(decoder, (last - first) if first and last != first else 0)
+
+    if args.check and (decoder.lost or decoder.corrupt):
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()